@@ -40,6 +40,10 @@
 
 #include "arayeh.h"
 
+#if defined(__BMI2__)
+#    include <immintrin.h>
+#endif
+
 // To ensure that the names declared in this portion of code have C linkage,
 // and thus C++ name mangling is not performed while using this code with C++.
 #undef __BEGIN_DECLS
@@ -54,6 +58,106 @@
 
 __BEGIN_DECLS
 
+// number of cells given to a thread at a time by parallel methods.
+#define AA_ARAYEH_PARALLEL_BLOCK 65536
+
+// hint the processor to load a memory location into cache.
+#if defined(__GNUC__) || defined(__clang__)
+#    define AA_ARAYEH_PREFETCH(address) __builtin_prefetch(address)
+#else
+#    define AA_ARAYEH_PREFETCH(address) ((void) (address))
+#endif
+
+// this function returns the number of trailing zero bits of a non-zero word.
+static inline unsigned int count_trailing_zeros(uint64_t word)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return (unsigned int) __builtin_ctzll(word);
+#else
+    unsigned int count = 0;
+    while ((word & 1) == 0) {
+        word >>= 1;
+        count++;
+    }
+    return count;
+#endif
+}
+
+// this function returns the number of set bits in a word.
+static inline unsigned int count_set_bits(uint64_t word)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return (unsigned int) __builtin_popcountll(word);
+#else
+    unsigned int count = 0;
+    while (word != 0) {
+        word &= word - 1;
+        count++;
+    }
+    return count;
+#endif
+}
+
+// this function returns bit "index" of packed boolean cells "words".
+static inline int read_bit(const uint64_t *words, size_t index)
+{
+    return (int) ((words[index / 64] >> (index % 64)) & 1);
+}
+
+// this function sets bit "index" of packed boolean cells "words" to "value".
+static inline void write_bit(uint64_t *words, size_t index, int value)
+{
+    uint64_t bit = (uint64_t) 1 << (index % 64);
+
+    words[index / 64] = value ? (words[index / 64] | bit) : (words[index / 64] & ~bit);
+}
+
+// this function returns "length" (at most 64) bits of packed boolean cells "words"
+// starting from bit "index", bit "index" is the lowest bit.
+static inline uint64_t read_bits(const uint64_t *words, size_t index, size_t length)
+{
+    size_t offset = index % 64;
+    uint64_t bits = words[index / 64] >> offset;
+
+    if (offset != 0 && offset + length > 64) {
+        bits |= words[index / 64 + 1] << (64 - offset);
+    }
+
+    return (length == 64) ? bits : bits & (((uint64_t) 1 << length) - 1);
+}
+
+// this function sets "length" (at most 64) bits of packed boolean cells "words"
+// starting from bit "index" to the low bits of "bits".
+static inline void write_bits(uint64_t *words, size_t index, uint64_t bits, size_t length)
+{
+    size_t offset = index % 64;
+    uint64_t mask = (length == 64) ? UINT64_MAX : ((uint64_t) 1 << length) - 1;
+
+    bits &= mask;
+    words[index / 64] = (words[index / 64] & ~(mask << offset)) | (bits << offset);
+
+    // bits that don't fit in the first word.
+    if (offset != 0 && offset + length > 64) {
+        uint64_t high         = mask >> (64 - offset);
+        words[index / 64 + 1] = (words[index / 64 + 1] & ~high) | (bits >> (64 - offset));
+    }
+}
+
+// this function gathers the bits of "value" whose bit is set in "mask" into the
+// low bits of the result, keeping their order.
+static inline uint64_t extract_bits(uint64_t value, uint64_t mask)
+{
+#if defined(__BMI2__)
+    return _pext_u64(value, mask);
+#else
+    uint64_t result = 0;
+    for (unsigned int position = 0; mask != 0; mask &= mask - 1, position++) {
+        result |= ((value >> count_trailing_zeros(mask)) & 1) << position;
+    }
+    return result;
+#endif
+}
+
 // this function will calculate the extension size of memory.
 size_t growth_factor_python(arayeh *arayeh);
 
@@ -61,6 +165,78 @@ size_t growth_factor_python(arayeh *arayeh);
 // empty [available] slot in the array.
 void update_next_index(arayeh *self);
 
+// This function returns the index of the first empty cell from index (inclusive)
+// "start_index" to index (exclusive) "end_index", or "end_index" if there is none.
+size_t find_empty_cell(const char *map, size_t start_index, size_t end_index);
+
+// This function returns one past the index of the last filled cell, or zero if
+// the arayeh is empty.
+size_t find_top_index(arayeh *self);
+
+// This function returns the number of filled cells from index (inclusive)
+// "start_index" to index (exclusive) "end_index".
+size_t count_filled_cells(const char *map, size_t start_index, size_t end_index);
+
+// This function moves "count" cells and their map from "source_index" to
+// "destination_index", the ranges may overlap.
+void move_cells(arayeh *self, size_t destination_index, size_t source_index,
+                size_t count);
+
+// This function converts "length" (at most 64) cells of the map starting from
+// "index" into a bitmask of filled cells, cell "index" is the lowest bit.
+uint64_t map_block_mask(const char *map, size_t index, size_t length);
+
+// This function copies the cells of a block whose bit is set in "mask" to the
+// beginning of "destination" and returns the number of copied cells.
+size_t compress_block(char *destination, const char *source, size_t length,
+                      uint64_t mask, size_t element_size);
+
+// This function copies the cells at "indices" into "destination", empty cells are
+// replaced by "fill_value" unless it's NULL, returns the position of the first
+// index out of range or "count" if all of them are valid.
+size_t gather_cells(char *destination, const char *array, const char *map, size_t size,
+                    const size_t *indices, size_t count, size_t element_size,
+                    const void *fill_value);
+
+// This function converts a logical index to the index of the cell in memory,
+// skipping the gap of gap buffer mode.
+size_t gap_physical_index(arayeh *self, size_t index);
+
+// This function moves the gap of gap buffer mode so it starts at logical "index".
+void move_gap(arayeh *self, size_t index);
+
+// This function moves the gap of gap buffer mode to the end of arayeh, so every
+// cell is at its logical index.
+void close_gap(arayeh *self);
+
+// This function copies filled cells from index (inclusive) "start_index" to index
+// (exclusive) "end_index" to "destination" and returns their number.
+size_t load_filled_cells(arayeh *self, size_t start_index, size_t end_index,
+                         char *destination);
+
+// This function runs "count" elements of "block" through the stages of
+// "pipeline" and returns the number of elements left.
+size_t run_pipeline_stages(arayeh_pipeline *pipeline, void *block, size_t count);
+
+// This function calls "visitor" for filled cells from index (inclusive)
+// "start_index" to index (exclusive) "end_index".
+void visit_cells(arayeh *self, size_t start_index, size_t end_index,
+                 arayeh_visitor visitor, void *context);
+
+// This function calls "transformer" for filled cells from index (inclusive)
+// "start_index" to index (exclusive) "end_index".
+void transform_cells(arayeh *self, size_t start_index, size_t end_index,
+                     arayeh_transformer transformer, void *context);
+
+// This function calls "mapper" for filled cells from index (inclusive)
+// "start_index" to index (exclusive) "end_index", results are written to the
+// same index of "result".
+void map_cells(arayeh *self, size_t start_index, size_t end_index,
+               arayeh_mapper mapper, arayeh *result, void *context);
+
+// This function copies an element of "element_size" bytes.
+void copy_element(void *destination, const void *source, size_t element_size);
+
 __END_DECLS
 
 #endif    //__AA_A_ALGORITHMS_H__
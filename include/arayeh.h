@@ -39,6 +39,7 @@
 #define __AA_A_ARAYEH_H__
 
 #include <limits.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 
@@ -74,6 +75,8 @@
 #define AA_ARAYEH_WRONG_INDEX      6
 #define AA_ARAYEH_NOT_ENOUGH_SPACE 7
 #define AA_ARAYEH_WRONG_STEP       8
+#define AA_ARAYEH_NOT_FOUND        9
+#define AA_ARAYEH_EMPTY            10
 
 // map characters.
 #define AA_ARAYEH_OFF    '0'
@@ -88,11 +91,130 @@
 #define AA_ARAYEH_TYPE_FLOAT  5
 #define AA_ARAYEH_TYPE_DOUBLE 6
 
+// arayeh of user defined elements (e.g. structs), see ArayehGeneric().
+#define AA_ARAYEH_TYPE_GENERIC 7
+
+// fixed-width integer types.
+#define AA_ARAYEH_TYPE_INT8   8
+#define AA_ARAYEH_TYPE_INT16  9
+#define AA_ARAYEH_TYPE_INT32  10
+#define AA_ARAYEH_TYPE_INT64  11
+#define AA_ARAYEH_TYPE_UINT8  12
+#define AA_ARAYEH_TYPE_UINT16 13
+#define AA_ARAYEH_TYPE_UINT32 14
+#define AA_ARAYEH_TYPE_UINT64 15
+
+// 16 bit floating point types, IEEE 754 half precision and bfloat16 (the high
+// half of a float). cells hold 2 bytes, elements of add, insert, fill, get, pop
+// and the search methods are floats converted to and from the cells, pipelines
+// run on blocks of floats. methods that copy C arrays or hand out arayeh memory
+// work on the 16 bit cells (uint16_t), see arayeh_typed.h for conversions.
+#define AA_ARAYEH_TYPE_FLOAT16  16
+#define AA_ARAYEH_TYPE_BFLOAT16 17
+
+// variable-length strings, cells hold the offset and length of a string in a
+// byte arena owned by arayeh. elements of add, insert, fill, get, pop and the
+// search methods are arayeh_string views, strings are copied into the arena and
+// get returns a pointer into it, valid until the next call that adds strings or
+// compacts the arena. methods that copy C arrays or hand out arayeh memory work
+// on the arayeh_string_cell cells, arayeh_view.arena holds their bytes.
+#define AA_ARAYEH_TYPE_STRING 18
+
+// booleans, elements are chars that are 0 (false) or 1 (true), any other value
+// is stored as 1. cells are packed 64 to a 64 bit word, bit (i % 64) of word
+// (i / 64) is cell i. methods that copy cells into C arrays unpack them on the
+// fly, like narrowed arayehs, methods that hand out arayeh memory unpack the
+// cells to one char each and narrow method packs them again.
+#define AA_ARAYEH_TYPE_BOOL 19
+
+// storage type of packed boolean arayehs, not a type of arayeh elements.
+#define AA_ARAYEH_STORAGE_BIT 20
+
+// operations of bitwise method.
+#define AA_ARAYEH_AND 0
+#define AA_ARAYEH_OR  1
+#define AA_ARAYEH_XOR 2
+#define AA_ARAYEH_NOT 3
+
+// operations of compare method, between is inclusive on both ends.
+#define AA_ARAYEH_LESS          0
+#define AA_ARAYEH_LESS_EQUAL    1
+#define AA_ARAYEH_EQUAL         2
+#define AA_ARAYEH_GREATER_EQUAL 3
+#define AA_ARAYEH_GREATER       4
+#define AA_ARAYEH_BETWEEN       5
+
+// operations of scan methods.
+#define AA_ARAYEH_SUM 0
+#define AA_ARAYEH_MIN 1
+#define AA_ARAYEH_MAX 2
+
+// modes of scan methods, a cell of an inclusive scan holds the result of the
+// cells up to and including it, of an exclusive scan of the cells before it.
+#define AA_ARAYEH_INCLUSIVE 0
+#define AA_ARAYEH_EXCLUSIVE 1
+
+// conversion modes of change_type and convert_to methods, strict conversion
+// fails with AA_ARAYEH_OVERFLOW if a filled cell doesn't fit in the new type,
+// saturation clamps it to the range of the new type (NaN becomes 0) and wrapping
+// converts like a C cast, integers keep their low bits, doubles become infinity
+// in a float and floating point values saturate in an integer type.
+#define AA_ARAYEH_CONVERT_STRICT   0
+#define AA_ARAYEH_CONVERT_SATURATE 1
+#define AA_ARAYEH_CONVERT_WRAP     2
+
+// rounding modes of floating point values converted into integers, or'ed with a
+// conversion mode, e.g. AA_ARAYEH_CONVERT_SATURATE | AA_ARAYEH_ROUND_NEAREST.
+#define AA_ARAYEH_ROUND_TRUNCATE 0
+#define AA_ARAYEH_ROUND_NEAREST  4
+
+// number of cells that go through all stages of a pipeline at once.
+#define AA_ARAYEH_PIPELINE_BLOCK 4096
+
+// number of 64 bit words needed by a bitmap that covers "size" arayeh cells,
+// bit (i % 64) of word (i / 64) represents cell i.
+#define AA_ARAYEH_MASK_SIZE(size) (((size) + 63) / 64)
+
 __BEGIN_DECLS
 
 // Prototype of arayeh struct.
 typedef struct arayeh_struct arayeh;
 
+// Element of string arayehs, "length" bytes at "bytes", NUL bytes are allowed
+// and the string doesn't need to be NUL terminated.
+typedef struct {
+
+    // pointer to the first byte.
+    const char *bytes;
+
+    // number of bytes.
+    size_t length;
+
+} arayeh_string;
+
+// Cell of string arayehs, bytes of the string start at "offset" in the arena.
+typedef struct {
+
+    // offset of the first byte in the arena.
+    size_t offset;
+
+    // number of bytes.
+    size_t length;
+
+} arayeh_string_cell;
+
+// Range of char arayeh cells from index (inclusive) "start" to index (exclusive)
+// "end", e.g. a field found by split method.
+typedef struct {
+
+    // index of the first cell.
+    size_t start;
+
+    // one past the index of the last cell.
+    size_t end;
+
+} arayeh_range;
+
 // Supported arayeh types.
 typedef union {
 
@@ -114,8 +236,140 @@ typedef union {
     // pointer to the array of type double.
     double *double_pointer;
 
+    // pointers to the arrays of fixed-width integer types.
+    int8_t *int8_pointer;
+    int16_t *int16_pointer;
+    int32_t *int32_pointer;
+    int64_t *int64_pointer;
+    uint8_t *uint8_pointer;
+    uint16_t *uint16_pointer;
+    uint32_t *uint32_pointer;
+    uint64_t *uint64_pointer;
+
+    // pointers to the arrays of 16 bit floating point cells.
+    uint16_t *float16_pointer;
+    uint16_t *bfloat16_pointer;
+
+    // pointer to the array of string cells.
+    arayeh_string_cell *string_pointer;
+
+    // pointer to the words of packed boolean cells.
+    uint64_t *bool_pointer;
+
 } arayeh_types;
 
+// Read only view of arayeh memory, it's valid until the next call
+// that changes the arayeh.
+typedef struct {
+
+    // holds type of arayeh.
+    size_t type;
+
+    // holds the number of cells.
+    size_t size;
+
+    // holds the number of filled cells.
+    size_t used;
+
+    // holds size of an arayeh element in bytes.
+    size_t element_size;
+
+    // typed pointer to the arayeh cells, use the member of arayeh type.
+    arayeh_types array;
+
+    // pointer to the map, cell i is filled if map[i] == AA_ARAYEH_ON.
+    const char *map;
+
+    // pointer to the bytes of string cells, NULL for other types.
+    const char *arena;
+
+} arayeh_view;
+
+// Iterator over filled cells of arayeh, it's valid until the next call
+// that changes the arayeh.
+typedef struct {
+
+    // index of the current cell.
+    size_t index;
+
+    // pointer to the current cell, cast it to a pointer of arayeh type.
+    void *element;
+
+    // first index of the next map block to be scanned.
+    size_t _block_index;
+
+    // filled cells of the map block that are not visited yet.
+    uint64_t _block_mask;
+
+} arayeh_iterator;
+
+// Writer of reserved cells, it's prepared by writer_open method, cells are
+// written with push functions of arayeh_typed.h and committed by writer_close
+// method. arayeh must not be changed by other calls while it's open.
+typedef struct {
+
+    // next cell to be written.
+    char *cursor;
+
+    // first reserved cell.
+    char *begin;
+
+    // one past the last reserved cell.
+    char *end;
+
+    // index of the first reserved cell.
+    size_t start_index;
+
+    // size of an arayeh element in bytes.
+    size_t element_size;
+
+} arayeh_writer;
+
+// Callback of for_each, it reads the element of arayeh type at "element".
+typedef void (*arayeh_visitor)(size_t index, const void *element, void *context);
+
+// Callback of transform, it changes the element of arayeh type at "element".
+typedef void (*arayeh_transformer)(size_t index, void *element, void *context);
+
+// Callback of map_to, it writes the result of "element" into "result", which
+// has the type of the new arayeh.
+typedef void (*arayeh_mapper)(size_t index, const void *element, void *result,
+                              void *context);
+
+// Stage of a pipeline, it works in place on "count" elements of arayeh type at
+// "block" and returns the number of elements kept at the beginning of "block".
+// a map stage changes elements and returns "count", a filter stage moves the
+// kept elements forward and returns their number. blocks of float16 and bfloat16
+// arayehs hold floats.
+typedef size_t (*arayeh_stage_function)(void *block, size_t count, void *context);
+
+// Reducer of a pipeline, it folds "count" elements of "block" into "accumulator",
+// so float16 and bfloat16 arayehs are reduced in float.
+typedef void (*arayeh_reducer)(const void *block, size_t count, void *accumulator);
+
+// A stage and its user context.
+typedef struct {
+
+    // function that processes blocks of elements.
+    arayeh_stage_function function;
+
+    // pointer passed to every call of "function".
+    void *context;
+
+} arayeh_stage;
+
+// Lazy pipeline of stages, nothing runs until it's reduced or collected, then
+// every block of arayeh goes through all stages while it's still in cache.
+typedef struct {
+
+    // stages in order of execution.
+    arayeh_stage *stages;
+
+    // number of stages.
+    size_t stage_count;
+
+} arayeh_pipeline;
+
 typedef struct {
 
     // allow extending arayeh size when using add method.
@@ -147,6 +401,18 @@ typedef struct {
     // holds method specific size extension settings.
     arayeh_size_settings *method_size;
 
+    // allow building a hash index of values on the first search and keeping it
+    // up to date on every change, makes contains, find and count O(1).
+    char hash_index;
+
+    // keep a movable gap at the edit point of insert_shift, insert_range_shift and
+    // shifting deletes, so repeated edits near a cursor don't move the whole tail.
+    char gap_buffer;
+
+    // allow for_each, transform and map_to to split arayeh between threads, it
+    // needs a library built with OpenMP and callbacks that are thread safe.
+    char parallel;
+
 } arayeh_settings;
 
 // Arayeh definition.
@@ -175,6 +441,11 @@ typedef struct arayeh_struct {
         // holds type of arayeh.
         size_t type;
 
+        // holds type of arayeh cells, a narrower integer type than "type" if
+        // arayeh is narrowed, elements are converted on add and get, or
+        // AA_ARAYEH_STORAGE_BIT if boolean cells are packed.
+        size_t storage_type;
+
         // holds next pointer, the pointer is pointing
         // at the next empty cell in the arayeh.
         size_t next;
@@ -185,6 +456,12 @@ typedef struct arayeh_struct {
         // holds current size of arayeh.
         size_t size;
 
+        // holds size of an arayeh element in bytes.
+        size_t element_size;
+
+        // holds alignment of arayeh memory in bytes.
+        size_t alignment;
+
         // holds actual array.
         arayeh_types array;
 
@@ -195,6 +472,46 @@ typedef struct arayeh_struct {
         // hold settings for arayeh.
         arayeh_settings *settings;
 
+        // holds "settings" resolved once by set_settings and set_size_settings
+        // methods, so methods don't decode them on every call.
+        struct arayeh_policy {
+
+            // AA_ARAYEH_TRUE if debug messages are on.
+            int debug;
+
+            // AA_ARAYEH_TRUE if the method may extend arayeh size.
+            int extend_add;
+            int extend_insert;
+            int extend_fill;
+            int extend_merge_arayeh;
+            int extend_merge_array;
+
+        } policy;
+
+        // holds the hash index of values or NULL if arayeh isn't indexed.
+        struct arayeh_hash_index *hash_index;
+
+        // holds the bytes of string arayehs, bytes of deleted or overwritten
+        // strings stay in the arena until compact_arena method is called.
+        struct arayeh_arena {
+
+            // pointer to the bytes.
+            char *bytes;
+
+            // number of bytes written.
+            size_t used;
+
+            // number of bytes allocated.
+            size_t size;
+
+        } arena;
+
+        // holds the gap of gap buffer mode, cells from index (inclusive)
+        // "gap_start" to index (exclusive) "gap_end" are the empty cells at the
+        // logical end of arayeh. the gap is closed when both are equal.
+        size_t gap_start;
+        size_t gap_end;
+
     } _private_properties;
 
     // Public methods of arayehs, accessible for everyone.
@@ -241,10 +558,188 @@ typedef struct arayeh_struct {
         // "destination" memory location.
         int (*get)(arayeh *self, size_t index, void *destination);
 
-        // TODO: write methods -> getArray, arayehSlice, arraySlice,
-        // TODO: reduceSize, compact, max, min, sum, multiply, changeType
-        // TODO: deleteItem, deleteSlice, pop, popArayeh, popArraySlice,
-        // TODO: contains, count, reorder, shuffle, reverse, sort, isEmpty, showSettings
+        // this function inserts "element" at "index" and moves the cells after it
+        // one cell forward.
+        int (*insert_shift)(arayeh *self, size_t index, void *element);
+
+        // this function inserts "count" elements of C array "array" at "index" and
+        // moves the cells after it "count" cells forward.
+        int (*insert_range_shift)(arayeh *self, size_t index, size_t count, void *array);
+
+        // this function empties the cell at "index", if "shift" is AA_ARAYEH_ON the
+        // cells after it move one cell backward to close the gap.
+        int (*delete_item)(arayeh *self, size_t index, char shift);
+
+        // this function empties cells from index (inclusive) "start_index" to index
+        // (exclusive) "end_index" with step size "step", if "shift" is AA_ARAYEH_ON
+        // the remaining cells move backward to close the gaps.
+        int (*delete_slice)(arayeh *self, size_t start_index, size_t step,
+                            size_t end_index, char shift);
+
+        // this function copies the last filled cell to "destination" (unless it's
+        // NULL) and empties it.
+        int (*pop)(arayeh *self, void *destination);
+
+        // this function copies "count" cells starting from "start_index" into the
+        // C array "destination", empty cells are replaced by "fill_value" unless
+        // it's NULL.
+        int (*get_range)(arayeh *self, size_t start_index, size_t count,
+                         void *destination, void *fill_value);
+
+        // this function copies the cells at "indices" into the C array
+        // "destination", empty cells are replaced by "fill_value" unless it's NULL.
+        int (*get_indices)(arayeh *self, size_t *indices, size_t count,
+                           void *destination, void *fill_value);
+
+        // this function fills "view" with pointers to the arayeh memory and map,
+        // so elements can be read without copying them. it widens a narrowed
+        // arayeh and unpacks a bool one, they stay so until narrow is called.
+        int (*view)(arayeh *self, arayeh_view *view);
+
+        // this function prepares "iterator" for visiting filled cells of arayeh,
+        // it widens and unpacks cells like view method.
+        int (*iter_begin)(arayeh *self, arayeh_iterator *iterator);
+
+        // this function moves "iterator" to the next filled cell, it returns
+        // AA_ARAYEH_TRUE or AA_ARAYEH_FALSE when there is no filled cell left.
+        int (*iter_next)(arayeh *self, arayeh_iterator *iterator);
+
+        // this function runs filled cells through "pipeline" and folds the
+        // result into "accumulator" with "reducer", in a single pass.
+        int (*pipeline_reduce)(arayeh *self, arayeh_pipeline *pipeline,
+                               arayeh_reducer reducer, void *accumulator);
+
+        // this function runs filled cells through "pipeline" and returns the
+        // result in a new arayeh, or NULL in case of error.
+        arayeh *(*pipeline_collect)(arayeh *self, arayeh_pipeline *pipeline);
+
+        // this function reserves "count" empty cells after the last filled cell
+        // and prepares "writer" for writing them without any check, bool and
+        // string arayehs have no writer.
+        int (*writer_open)(arayeh *self, arayeh_writer *writer, size_t count);
+
+        // this function marks the cells written by "writer" as filled.
+        int (*writer_close)(arayeh *self, arayeh_writer *writer);
+
+        // this function calls "visitor" for every filled cell.
+        int (*for_each)(arayeh *self, arayeh_visitor visitor, void *context);
+
+        // this function calls "transformer" for every filled cell to change it.
+        int (*transform)(arayeh *self, arayeh_transformer transformer, void *context);
+
+        // this function returns a new arayeh of "type", filled cells of it are
+        // the results of "mapper" for filled cells of arayeh. "type" is a numeric
+        // or bool type or the type of arayeh, not string, bool results are 0 or 1.
+        arayeh *(*map_to)(arayeh *self, size_t type, arayeh_mapper mapper,
+                          void *context);
+
+        // this function checks if an "element" exists in the filled cells of the
+        // arayeh, returns AA_ARAYEH_TRUE or AA_ARAYEH_FALSE.
+        // float and double use the == operator: NaN never matches and 0.0 matches -0.0.
+        int (*contains)(arayeh *self, void *element);
+
+        // this function finds the first filled cell that holds "element" and
+        // writes its index into "index".
+        int (*find)(arayeh *self, void *element, size_t *index);
+
+        // this function counts the filled cells that hold "element".
+        size_t (*count)(arayeh *self, void *element);
+
+        // this function marks every filled cell that holds "element" in "bitmap"
+        // (AA_ARAYEH_MASK_SIZE(size) words) and returns the number of matches.
+        size_t (*find_all)(arayeh *self, void *element, uint64_t *bitmap);
+
+        // this function builds a hash index of values which is kept up to date by
+        // every method that changes the arayeh and is used by the search methods.
+        int (*build_hash_index)(arayeh *self);
+
+        // this function frees the hash index of values.
+        void (*drop_hash_index)(arayeh *self);
+
+        // this function moves all filled cells to the beginning of the arayeh,
+        // keeping their order, so the arayeh has no empty cell between elements.
+        int (*compact)(arayeh *self);
+
+        // this function copies all filled cells into the C array "destination"
+        // (at least "used" elements long) and their original indices into
+        // "indices" if it isn't NULL, returns the number of copied elements.
+        size_t (*pack)(arayeh *self, void *destination, size_t *indices);
+
+        // this function converts arayeh elements into "type" in place, values that
+        // don't fit in the new type are handled by "mode", one of
+        // AA_ARAYEH_CONVERT_* or'ed with one of AA_ARAYEH_ROUND_*.
+        int (*change_type)(arayeh *self, size_t type, int mode);
+
+        // this function creates a new arayeh of "type" with the same map, its
+        // cells hold the elements of arayeh converted by "mode".
+        arayeh *(*convert_to)(arayeh *self, size_t type, int mode);
+
+        // this function re-stores an integer arayeh in the narrowest integer type
+        // that holds its filled cells, get still returns elements of arayeh type
+        // and adding a value that doesn't fit widens it again.
+        int (*narrow)(arayeh *self);
+
+        // this function re-stores a narrowed arayeh in arayeh type, methods that
+        // hand out arayeh memory widen it first.
+        int (*widen)(arayeh *self);
+
+        // this function appends "count" strings to a string arayeh after its last
+        // filled cell, string i is the bytes of "bytes" from offset "offsets[i]"
+        // (inclusive) to "offsets[i + 1]" (exclusive), all bytes are copied at once.
+        int (*add_strings)(arayeh *self, const char *bytes, const size_t *offsets,
+                           size_t count);
+
+        // this function drops the bytes of deleted and overwritten strings from the
+        // arena of a string arayeh and shrinks it to the bytes of filled cells.
+        int (*compact_arena)(arayeh *self);
+
+        // this function appends "count" bytes to a char arayeh after its last
+        // filled cell with a single memcpy.
+        int (*append_bytes)(arayeh *self, const char *bytes, size_t count);
+
+        // this function finds the first occurrence of "length" bytes of "needle" in
+        // the text of a char arayeh from index "start_index" (inclusive).
+        int (*find_bytes)(arayeh *self, size_t start_index, const char *needle,
+                          size_t length, size_t *index);
+
+        // this function splits the text of a char arayeh on "delimiter", writes at
+        // most "capacity" fields to "ranges" and returns the number of fields.
+        size_t (*split)(arayeh *self, char delimiter, arayeh_range *ranges,
+                        size_t capacity);
+
+        // this function returns the text of a char arayeh as a NUL terminated
+        // string in arayeh memory without copying it.
+        const char *(*c_string)(arayeh *self, size_t *length);
+
+        // this function returns the number of filled cells of a boolean arayeh that
+        // are true, 64 cells at a time.
+        size_t (*popcount)(arayeh *self);
+
+        // this function applies AA_ARAYEH_AND, OR, XOR (with "other") or NOT to the
+        // filled cells of a boolean arayeh, 64 cells at a time.
+        int (*bitwise)(arayeh *self, int operation, arayeh *other);
+
+        // this function marks the filled cells of a numeric arayeh that satisfy
+        // "operation" with "value" (and "upper" for between) in a bitmap.
+        size_t (*compare)(arayeh *self, int operation, void *value, void *upper,
+                          uint64_t *bitmap);
+
+        // this function returns a new arayeh of the filled cells whose bit is set
+        // in "bitmap", keeping their order.
+        arayeh *(*select)(arayeh *self, const uint64_t *bitmap);
+
+        // this function replaces the filled cells of a numeric arayeh by their
+        // running AA_ARAYEH_SUM, MIN or MAX, inclusive or exclusive.
+        int (*scan)(arayeh *self, int operation, int mode);
+
+        // this function returns a new arayeh of the running AA_ARAYEH_SUM, MIN or
+        // MAX of the filled cells, inclusive or exclusive.
+        arayeh *(*scan_to)(arayeh *self, int operation, int mode);
+
+        // TODO: write methods -> arayehSlice, arraySlice,
+        // TODO: reduceSize, max, min, sum, multiply
+        // TODO: popArayeh, popArraySlice,
+        // TODO: reorder, shuffle, reverse, sort, isEmpty, showSettings
         // TODO: complete error tracing.
 
         // this function will override arayeh default settings.
@@ -297,10 +792,28 @@ typedef struct arayeh_struct {
         // memory location provided by caller.
         void (*get_from_arayeh)(arayeh *self, size_t index, void *destination);
 
+        // this function compares "length" (at most 64) cells starting from "index"
+        // with an element and returns a bitmask of equal cells, cell "index" is
+        // represented by the lowest bit, the map is not checked.
+        uint64_t (*match_block)(arayeh *self, size_t index, size_t length,
+                                void *element);
+
+        // this function converts an element into a hash index key, equal elements
+        // have equal keys, returns AA_ARAYEH_FALSE if element can't be equal to any
+        // element (NaN), it's NULL if arayeh elements have no hash keys.
+        int (*hash_key)(void *element, uint64_t *key);
+
     } _private_methods;
 
 } arayeh;
 
+// Private properties of arayeh, C++ scopes the struct inside arayeh_struct.
+#ifdef __cplusplus
+typedef struct arayeh_struct::private_properties arayeh_private_properties;
+#else
+typedef struct private_properties arayeh_private_properties;
+#endif
+
 arayeh *Arayeh(size_t type, size_t initial_size);
 /*
  * This function will create an arayeh of type "type"
@@ -318,6 +831,27 @@ arayeh *Arayeh(size_t type, size_t initial_size);
  * return NULL in case of error.
  */
 
+arayeh *ArayehGeneric(size_t element_size, size_t alignment, size_t initial_size);
+/*
+ * This function will create an arayeh of type AA_ARAYEH_TYPE_GENERIC with
+ * elements of "element_size" bytes and memory aligned to "alignment" bytes
+ * (0 for the default alignment), e.g. for an arayeh of a struct:
+ * ArayehGeneric(sizeof(struct x), _Alignof(struct x), initial_size).
+ *
+ * elements are copied as bytes and compared as bytes, so padding bytes of
+ * structs must be cleared (e.g. with memset) to find equal elements.
+ *
+ * ARGUMENTS:
+ * element_size  size of an arayeh element in bytes.
+ * alignment     alignment of arayeh memory in bytes.
+ * initial_size  size of arayeh.
+ *
+ * RETURN:
+ * A pointer to the initialized arayeh.
+ * or
+ * return NULL in case of error.
+ */
+
 __END_DECLS
 
 #endif    //__AA_A_ARAYEH_H__
@@ -0,0 +1,398 @@
+/** include/arayeh.hpp
+ *
+ * This file is a part of:
+ * Azadeh Afzar - Arayehsaz (AA-A).
+ *
+ * Copyright (C) 2020 - 2021 Azadeh Afzar.
+ * Copyright (C) 2020 - 2021 Mohammad Mahdi Baghbani Pourvahid.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgement in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#ifndef __AA_A_ARAYEH_HPP__
+#define __AA_A_ARAYEH_HPP__
+
+// arayeh.h uses anonymous structs, they are standard in C11 but an extension in C++.
+#if defined(__GNUC__) || defined(__clang__)
+#    pragma GCC diagnostic push
+#    pragma GCC diagnostic ignored "-Wpedantic"
+#endif
+
+#include "arayeh.h"
+
+#if defined(__GNUC__) || defined(__clang__)
+#    pragma GCC diagnostic pop
+#endif
+
+#include <cstddef>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+// std::span views need C++20.
+#if __cplusplus >= 202002L && defined(__has_include)
+#    if __has_include(<span>)
+#        include <span>
+#        define AA_ARAYEH_HAS_SPAN 1
+#    endif
+#endif
+
+namespace aa {
+
+// Maps a C++ type to its arayeh type and typed pointer at compile time, only the
+// specialized types can be stored in an arayeh.
+template <typename T> struct arayeh_traits;
+
+#define AA_ARAYEH_TRAITS(cpp_type, arayeh_type, member)              \
+    template <> struct arayeh_traits<cpp_type> {                     \
+        static constexpr size_t type = arayeh_type;                  \
+        static cpp_type *pointer(const arayeh_types &array) noexcept \
+        {                                                            \
+            return array.member;                                     \
+        }                                                            \
+    };
+
+AA_ARAYEH_TRAITS(char, AA_ARAYEH_TYPE_CHAR, char_pointer)
+AA_ARAYEH_TRAITS(short int, AA_ARAYEH_TYPE_SINT, short_int_pointer)
+AA_ARAYEH_TRAITS(int, AA_ARAYEH_TYPE_INT, int_pointer)
+AA_ARAYEH_TRAITS(long int, AA_ARAYEH_TYPE_LINT, long_int_pointer)
+AA_ARAYEH_TRAITS(float, AA_ARAYEH_TYPE_FLOAT, float_pointer)
+AA_ARAYEH_TRAITS(double, AA_ARAYEH_TYPE_DOUBLE, double_pointer)
+
+#undef AA_ARAYEH_TRAITS
+
+// The other integer types are stored in the fixed-width integer arayeh of their
+// size and signedness. int8_t ... uint64_t are aliases of integer types, e.g.
+// int16_t is short int, so they are covered by the traits above or below and
+// never specialized twice.
+template <typename T> struct arayeh_fixed_width_traits {
+    static_assert(sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8,
+                  "no fixed-width arayeh type of this size");
+
+    static constexpr size_t type =
+        std::is_signed<T>::value
+            ? (sizeof(T) == 1   ? AA_ARAYEH_TYPE_INT8
+               : sizeof(T) == 2 ? AA_ARAYEH_TYPE_INT16
+               : sizeof(T) == 4 ? AA_ARAYEH_TYPE_INT32
+                                : AA_ARAYEH_TYPE_INT64)
+            : (sizeof(T) == 1   ? AA_ARAYEH_TYPE_UINT8
+               : sizeof(T) == 2 ? AA_ARAYEH_TYPE_UINT16
+               : sizeof(T) == 4 ? AA_ARAYEH_TYPE_UINT32
+                                : AA_ARAYEH_TYPE_UINT64);
+
+    static T *pointer(const arayeh_types &array) noexcept
+    {
+        return reinterpret_cast<T *>(array.char_pointer);
+    }
+};
+
+template <> struct arayeh_traits<signed char> : arayeh_fixed_width_traits<signed char> {
+};
+template <>
+struct arayeh_traits<unsigned char> : arayeh_fixed_width_traits<unsigned char> {
+};
+template <>
+struct arayeh_traits<unsigned short int> : arayeh_fixed_width_traits<unsigned short int> {
+};
+template <>
+struct arayeh_traits<unsigned int> : arayeh_fixed_width_traits<unsigned int> {
+};
+template <>
+struct arayeh_traits<unsigned long int> : arayeh_fixed_width_traits<unsigned long int> {
+};
+template <>
+struct arayeh_traits<long long int> : arayeh_fixed_width_traits<long long int> {
+};
+template <> struct arayeh_traits<unsigned long long int>
+    : arayeh_fixed_width_traits<unsigned long long int> {
+};
+
+// Owning C++ handle of an arayeh of T.
+//
+// the arayeh is freed by the destructor, copies duplicate it and moves steal it,
+// so a moved from object holds no arayeh and may only be assigned or destroyed.
+//
+// data(), operator[] and iterators are inline and unchecked, they see cells at
+// their logical index unless the gap buffer setting is on, call view() of the
+// native arayeh first in that mode. they widen a narrowed arayeh first, so its
+// cells are of type T, and throw std::runtime_error if it can't be widened.
+//
+// writes through the mutable ones leave the map and used count as they are, so
+// write to filled cells or use add() and insert(). the mutable ones also drop
+// the hash index, the next search builds it again if the hash index setting is
+// on, otherwise call build_hash_index() of the native arayeh after writing.
+template <typename T> class arayeh
+{
+  public:
+    using value_type      = T;
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference       = T &;
+    using const_reference = const T &;
+    using pointer         = T *;
+    using const_pointer   = const T *;
+    using iterator        = T *;
+    using const_iterator  = const T *;
+
+    // creates an arayeh with "size" empty cells.
+    explicit arayeh(size_type size = 0) : handle_(Arayeh(arayeh_traits<T>::type, size))
+    {
+        if (handle_ == nullptr) {
+            throw std::bad_alloc();
+        }
+    }
+
+    // takes ownership of an arayeh created by the C API, its type must match T.
+    explicit arayeh(::arayeh *handle) noexcept : handle_(handle)
+    {
+    }
+
+    arayeh(const arayeh &other) : handle_(nullptr)
+    {
+        if (other.handle_ != nullptr) {
+            handle_ = other.handle_->duplicate(other.handle_);
+            if (handle_ == nullptr) {
+                throw std::bad_alloc();
+            }
+        }
+    }
+
+    arayeh(arayeh &&other) noexcept : handle_(other.handle_)
+    {
+        other.handle_ = nullptr;
+    }
+
+    arayeh &operator=(const arayeh &other)
+    {
+        if (this != &other) {
+            arayeh copy(other);
+            swap(copy);
+        }
+        return *this;
+    }
+
+    arayeh &operator=(arayeh &&other) noexcept
+    {
+        if (this != &other) {
+            reset();
+            handle_       = other.handle_;
+            other.handle_ = nullptr;
+        }
+        return *this;
+    }
+
+    ~arayeh()
+    {
+        reset();
+    }
+
+    void swap(arayeh &other) noexcept
+    {
+        std::swap(handle_, other.handle_);
+    }
+
+    // returns the C arayeh, it's still owned by this object.
+    ::arayeh *native() const noexcept
+    {
+        return handle_;
+    }
+
+    // returns the C arayeh and gives up its ownership.
+    ::arayeh *release() noexcept
+    {
+        ::arayeh *handle = handle_;
+        handle_          = nullptr;
+        return handle;
+    }
+
+    // number of cells.
+    size_type size() const noexcept
+    {
+        return handle_ != nullptr ? handle_->_private_properties.size : 0;
+    }
+
+    // number of filled cells.
+    size_type used() const noexcept
+    {
+        return handle_ != nullptr ? handle_->_private_properties.used : 0;
+    }
+
+    bool empty() const noexcept
+    {
+        return used() == 0;
+    }
+
+    // unchecked, tells if cell at "index" is filled.
+    bool filled(size_type index) const noexcept
+    {
+        return handle_->_private_properties.map[index] == AA_ARAYEH_ON;
+    }
+
+    // unchecked accessors, the mutable ones drop the hash index.
+    T *data()
+    {
+        if (handle_ != nullptr && handle_->_private_properties.hash_index != nullptr) {
+            handle_->drop_hash_index(handle_);
+        }
+        return cells();
+    }
+
+    const T *data() const
+    {
+        return cells();
+    }
+
+    T &operator[](size_type index)
+    {
+        return data()[index];
+    }
+
+    const T &operator[](size_type index) const
+    {
+        return data()[index];
+    }
+
+    // checked accessors, they throw std::out_of_range.
+    T &at(size_type index)
+    {
+        if (index >= size()) {
+            throw std::out_of_range("aa::arayeh::at");
+        }
+        return data()[index];
+    }
+
+    const T &at(size_type index) const
+    {
+        if (index >= size()) {
+            throw std::out_of_range("aa::arayeh::at");
+        }
+        return data()[index];
+    }
+
+    // random access iterators over all cells.
+    iterator begin()
+    {
+        return data();
+    }
+
+    iterator end()
+    {
+        return data() + size();
+    }
+
+    const_iterator begin() const
+    {
+        return data();
+    }
+
+    const_iterator end() const
+    {
+        return data() + size();
+    }
+
+    const_iterator cbegin() const
+    {
+        return data();
+    }
+
+    const_iterator cend() const
+    {
+        return data() + size();
+    }
+
+#ifdef AA_ARAYEH_HAS_SPAN
+    // views of all cells.
+    std::span<T> span()
+    {
+        return std::span<T>(data(), size());
+    }
+
+    std::span<const T> span() const
+    {
+        return std::span<const T>(data(), size());
+    }
+#endif
+
+    // methods of the C API, they throw std::runtime_error on failure.
+    void add(const T &element)
+    {
+        check(handle_->add(handle_, const_cast<T *>(&element)), "aa::arayeh::add");
+    }
+
+    void insert(size_type index, const T &element)
+    {
+        check(handle_->insert(handle_, index, const_cast<T *>(&element)),
+              "aa::arayeh::insert");
+    }
+
+    void resize(size_type new_size)
+    {
+        check(handle_->resize_memory(handle_, new_size), "aa::arayeh::resize");
+    }
+
+  private:
+    static void check(int state, const char *what)
+    {
+        if (state != AA_ARAYEH_SUCCESS) {
+            throw std::runtime_error(what);
+        }
+    }
+
+    // pointer to the cells, a narrowed arayeh is widened so they are of type T.
+    T *cells() const
+    {
+        if (handle_ == nullptr) {
+            return nullptr;
+        }
+        const auto *properties = &handle_->_private_properties;
+        if (properties->storage_type != properties->type) {
+            check(handle_->widen(handle_), "aa::arayeh::widen");
+        }
+        return arayeh_traits<T>::pointer(handle_->_private_properties.array);
+    }
+
+    void reset() noexcept
+    {
+        if (handle_ != nullptr) {
+            handle_->free_arayeh(&handle_);
+        }
+    }
+
+    ::arayeh *handle_;
+};
+
+template <typename T> void swap(arayeh<T> &first, arayeh<T> &second) noexcept
+{
+    first.swap(second);
+}
+
+}    // namespace aa
+
+#endif    //__AA_A_ARAYEH_HPP__
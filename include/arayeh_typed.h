@@ -0,0 +1,325 @@
+/** include/arayeh_typed.h
+ *
+ * This file is a part of:
+ * Azadeh Afzar - Arayehsaz (AA-A).
+ *
+ * Copyright (C) 2020 - 2021 Azadeh Afzar.
+ * Copyright (C) 2020 - 2021 Mohammad Mahdi Baghbani Pourvahid.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgement in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#ifndef __AA_A_ARAYEH_TYPED_H__
+#define __AA_A_ARAYEH_TYPED_H__
+
+#include "arayeh.h"
+
+#include <string.h>
+
+#if defined(__F16C__)
+#    include <immintrin.h>
+#endif
+
+// To ensure that the names declared in this portion of code have C linkage,
+// and thus C++ name mangling is not performed while using this code with C++.
+#undef __BEGIN_DECLS
+#undef __END_DECLS
+#ifdef __cplusplus
+#    define __BEGIN_DECLS extern "C" {
+#    define __END_DECLS   }
+#else
+#    define __BEGIN_DECLS /* empty */
+#    define __END_DECLS   /* empty */
+#endif
+
+__BEGIN_DECLS
+
+// Half precision conversions, float16 is IEEE 754 binary16 and bfloat16 is the
+// upper half of a float. floats are rounded to nearest even, NaNs stay NaNs.
+// F16C instructions are used when the compiler targets them.
+
+// this function returns the float of "half".
+static inline float arayeh_float16_to_float(uint16_t half)
+{
+#if defined(__F16C__)
+    return _cvtsh_ss(half);
+#else
+    union {
+        uint32_t bits;
+        float value;
+    } result;
+    uint32_t sign = (uint32_t) (half & 0x8000) << 16;
+
+    // move exponent and mantissa to their float place.
+    result.bits = (uint32_t) (half & 0x7FFF) << 13;
+    if ((half & 0x7C00) == 0x7C00) {
+        // infinity or NaN.
+        result.bits |= 0x7F800000;
+    } else {
+        // rebias exponent, subnormal halves become normal floats here.
+        result.value *= 0x1p112f;
+    }
+    result.bits |= sign;
+
+    return result.value;
+#endif
+}
+
+// this function returns the float16 nearest to "value".
+static inline uint16_t arayeh_float_to_float16(float value)
+{
+#if defined(__F16C__)
+    return _cvtss_sh(value, _MM_FROUND_TO_NEAREST_INT);
+#else
+    union {
+        uint32_t bits;
+        float value;
+    } number, magic;
+    uint32_t sign;
+    uint32_t mantissa_odd;
+    uint16_t half;
+
+    number.value = value;
+    sign         = number.bits & 0x80000000u;
+    number.bits ^= sign;
+
+    if (number.bits >= 0x47800000u) {
+        // overflow becomes infinity, NaN stays quiet NaN.
+        half = number.bits > 0x7F800000u ? 0x7E00 : 0x7C00;
+    } else if (number.bits < 0x38800000u) {
+        // subnormal or zero, let float addition do the rounding.
+        magic.bits = 0x3F000000u;
+        number.value += magic.value;
+        half = (uint16_t) (number.bits - magic.bits);
+    } else {
+        // normal, rebias exponent and round mantissa to nearest even.
+        mantissa_odd = (number.bits >> 13) & 1;
+        number.bits += ((uint32_t) (15 - 127) << 23) + 0xFFF + mantissa_odd;
+        half = (uint16_t) (number.bits >> 13);
+    }
+
+    return (uint16_t) (half | (sign >> 16));
+#endif
+}
+
+// this function returns the float of "half".
+static inline float arayeh_bfloat16_to_float(uint16_t half)
+{
+    union {
+        uint32_t bits;
+        float value;
+    } result;
+
+    result.bits = (uint32_t) half << 16;
+
+    return result.value;
+}
+
+// this function returns the bfloat16 nearest to "value".
+static inline uint16_t arayeh_float_to_bfloat16(float value)
+{
+    union {
+        uint32_t bits;
+        float value;
+    } number;
+
+    number.value = value;
+    if ((number.bits & 0x7FFFFFFFu) > 0x7F800000u) {
+        // keep NaN quiet, rounding could turn it to infinity.
+        return (uint16_t) ((number.bits >> 16) | 0x40);
+    }
+    number.bits += 0x7FFF + ((number.bits >> 16) & 1);
+
+    return (uint16_t) (number.bits >> 16);
+}
+
+// Typed API, generated for every arayeh type as arayeh_<name>_add, _get, _set,
+// _data, _push, e.g. arayeh_int_add(a, 42) or arayeh_double_get(a, i).
+//
+// these functions are static inline and work on the typed pointer of arayeh, so
+// compilers can inline them and vectorize loops. the arayeh must have the type of
+// the function, nothing is checked at runtime. they fall back to the methods of
+// arayeh only when the bookkeeping needs them: a full arayeh, an open gap of gap
+// buffer mode, a hash index, cells of a narrowed arayeh or a "next" pointer that
+// must be searched.
+//
+// add      same as arayeh.add method.
+// get      returns the element at "index", unchecked.
+// set      same as arayeh.insert method for an index less than arayeh size.
+// data     returns the typed pointer to arayeh cells, in gap buffer mode call
+//          arayeh.view method first to put cells at their logical index, a
+//          narrowed arayeh must be widened by arayeh.widen method first.
+// push     stores "element" in the next cell reserved by arayeh.writer_open
+//          method and moves the writer cursor, unchecked.
+#define AA_ARAYEH_TYPED_CELL_API(name, type, cell_type, member, to_cell, from_cell)     \
+    static inline int arayeh_##name##_add(arayeh *self, type element)                   \
+    {                                                                                   \
+        arayeh_private_properties *properties = &self->_private_properties;             \
+        size_t next                           = properties->next;                       \
+                                                                                        \
+        if (next + 1 >= properties->size ||                                             \
+            properties->map[next + 1] != AA_ARAYEH_OFF ||                               \
+            properties->hash_index != NULL ||                                           \
+            properties->element_size != sizeof(cell_type) ||                            \
+            properties->gap_start != properties->gap_end) {                             \
+            return self->add(self, &element);                                           \
+        }                                                                               \
+                                                                                        \
+        properties->array.member[next] = to_cell(element);                              \
+        properties->map[next]          = AA_ARAYEH_ON;                                  \
+        properties->used++;                                                             \
+        properties->next++;                                                             \
+        self->used = properties->used;                                                  \
+        self->next = properties->next;                                                  \
+                                                                                        \
+        return AA_ARAYEH_SUCCESS;                                                       \
+    }                                                                                   \
+                                                                                        \
+    static inline type arayeh_##name##_get(arayeh *self, size_t index)                  \
+    {                                                                                   \
+        arayeh_private_properties *properties = &self->_private_properties;             \
+                                                                                        \
+        if (properties->gap_start != properties->gap_end ||                             \
+            properties->element_size != sizeof(cell_type)) {                            \
+            type element;                                                               \
+            self->get(self, index, &element);                                           \
+            return element;                                                             \
+        }                                                                               \
+                                                                                        \
+        return from_cell(properties->array.member[index]);                              \
+    }                                                                                   \
+                                                                                        \
+    static inline int arayeh_##name##_set(arayeh *self, size_t index, type element)     \
+    {                                                                                   \
+        arayeh_private_properties *properties = &self->_private_properties;             \
+                                                                                        \
+        if (index >= properties->size || index == properties->next ||                   \
+            properties->hash_index != NULL ||                                           \
+            properties->element_size != sizeof(cell_type) ||                            \
+            properties->gap_start != properties->gap_end) {                             \
+            return self->insert(self, index, &element);                                 \
+        }                                                                               \
+                                                                                        \
+        properties->array.member[index] = to_cell(element);                             \
+        if (properties->map[index] != AA_ARAYEH_ON) {                                   \
+            properties->map[index] = AA_ARAYEH_ON;                                      \
+            properties->used++;                                                         \
+            self->used = properties->used;                                              \
+        }                                                                               \
+                                                                                        \
+        return AA_ARAYEH_SUCCESS;                                                       \
+    }                                                                                   \
+                                                                                        \
+    static inline cell_type *arayeh_##name##_data(arayeh *self)                         \
+    {                                                                                   \
+        return self->_private_properties.array.member;                                  \
+    }                                                                                   \
+                                                                                        \
+    static inline void arayeh_##name##_push(arayeh_writer *writer, type element)        \
+    {                                                                                   \
+        *(cell_type *) writer->cursor = to_cell(element);                               \
+        writer->cursor += sizeof(cell_type);                                            \
+    }
+
+// cells of arayeh type are the elements.
+#define AA_ARAYEH_SAME_CELL(element) (element)
+
+#define AA_ARAYEH_TYPED_API(name, type, member)                                         \
+    AA_ARAYEH_TYPED_CELL_API(name, type, type, member, AA_ARAYEH_SAME_CELL,             \
+                             AA_ARAYEH_SAME_CELL)
+
+// this function stores "element" of arayeh type in the next reserved cell of
+// "writer" and moves the cursor, unchecked.
+static inline void arayeh_writer_push(arayeh_writer *writer, const void *element)
+{
+    memcpy(writer->cursor, element, writer->element_size);
+    writer->cursor += writer->element_size;
+}
+
+AA_ARAYEH_TYPED_API(char, char, char_pointer)
+AA_ARAYEH_TYPED_API(short_int, short int, short_int_pointer)
+AA_ARAYEH_TYPED_API(int, int, int_pointer)
+AA_ARAYEH_TYPED_API(long_int, long int, long_int_pointer)
+AA_ARAYEH_TYPED_API(float, float, float_pointer)
+AA_ARAYEH_TYPED_API(double, double, double_pointer)
+AA_ARAYEH_TYPED_API(int8, int8_t, int8_pointer)
+AA_ARAYEH_TYPED_API(int16, int16_t, int16_pointer)
+AA_ARAYEH_TYPED_API(int32, int32_t, int32_pointer)
+AA_ARAYEH_TYPED_API(int64, int64_t, int64_pointer)
+AA_ARAYEH_TYPED_API(uint8, uint8_t, uint8_pointer)
+AA_ARAYEH_TYPED_API(uint16, uint16_t, uint16_pointer)
+AA_ARAYEH_TYPED_API(uint32, uint32_t, uint32_pointer)
+AA_ARAYEH_TYPED_API(uint64, uint64_t, uint64_pointer)
+AA_ARAYEH_TYPED_CELL_API(float16, float, uint16_t, float16_pointer,
+                         arayeh_float_to_float16, arayeh_float16_to_float)
+AA_ARAYEH_TYPED_CELL_API(bfloat16, float, uint16_t, bfloat16_pointer,
+                         arayeh_float_to_bfloat16, arayeh_bfloat16_to_float)
+
+// String API of string arayehs.
+//
+// get      returns the string at "index" without copying its bytes, unchecked,
+//          it's valid until the next call that adds strings or compacts the arena.
+// add      adds the NUL terminated "string", same as arayeh.add method.
+static inline arayeh_string arayeh_string_get(arayeh *self, size_t index)
+{
+    arayeh_private_properties *properties = &self->_private_properties;
+    arayeh_string element;
+
+    if (properties->gap_start != properties->gap_end) {
+        self->get(self, index, &element);
+        return element;
+    }
+
+    arayeh_string_cell cell = properties->array.string_pointer[index];
+    char *bytes             = properties->arena.bytes;
+    element.bytes           = (bytes == NULL) ? "" : bytes + cell.offset;
+    element.length          = cell.length;
+
+    return element;
+}
+
+static inline int arayeh_string_add(arayeh *self, const char *string)
+{
+    arayeh_string element = {string, strlen(string)};
+
+    return self->add(self, &element);
+}
+
+// Text API of char arayehs.
+//
+// append   appends the NUL terminated "string" without its NUL, same as
+//          arayeh.append_bytes method.
+static inline int arayeh_text_append(arayeh *self, const char *string)
+{
+    return self->append_bytes(self, string, strlen(string));
+}
+
+__END_DECLS
+
+#endif    //__AA_A_ARAYEH_TYPED_H__
@@ -0,0 +1,82 @@
+/** include/arena.h
+ *
+ * This file is a part of:
+ * Azadeh Afzar - Arayehsaz (AA-A).
+ *
+ * Copyright (C) 2020 - 2021 Azadeh Afzar.
+ * Copyright (C) 2020 - 2021 Mohammad Mahdi Baghbani Pourvahid.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgement in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+
+#ifndef __AA_A_ARENA_H__
+#define __AA_A_ARENA_H__
+
+#include "arayeh.h"
+
+// To ensure that the names declared in this portion of code have C linkage,
+// and thus C++ name mangling is not performed while using this code with C++.
+#undef __BEGIN_DECLS
+#undef __END_DECLS
+#ifdef __cplusplus
+#    define __BEGIN_DECLS extern "C" {
+#    define __END_DECLS   }
+#else
+#    define __BEGIN_DECLS /* empty */
+#    define __END_DECLS   /* empty */
+#endif
+
+__BEGIN_DECLS
+
+// this function makes room for "bytes" more bytes in the arena of arayeh.
+int arena_reserve(arayeh *self, size_t bytes);
+
+// this function returns the number of bytes "count" strings need in the arena,
+// strings that are already in the arena need none.
+size_t arena_new_bytes(arayeh *self, const arayeh_string *strings, size_t count);
+
+// this function makes room for the string "element" if arayeh is a string arayeh.
+int arena_reserve_element(arayeh *self, const void *element);
+
+// this function stores "string" in the cell at "index", "base" and "used" are the
+// arena before room was made for it.
+void arena_store(arayeh *self, size_t index, const arayeh_string *string,
+                 uintptr_t base, size_t used);
+
+// this function copies the bytes of filled cells into a new arena in order of
+// their offset, shared bytes once, and frees the old one.
+int arena_compact(arayeh *self);
+
+// this function frees the arena of arayeh.
+void arena_free(arayeh *self);
+
+__END_DECLS
+
+#endif    //__AA_A_ARENA_H__
@@ -0,0 +1,70 @@
+/** include/compare.h
+ *
+ * This file is a part of:
+ * Azadeh Afzar - Arayehsaz (AA-A).
+ *
+ * Copyright (C) 2020 - 2021 Azadeh Afzar.
+ * Copyright (C) 2020 - 2021 Mohammad Mahdi Baghbani Pourvahid.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgement in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+
+#ifndef __AA_A_COMPARE_H__
+#define __AA_A_COMPARE_H__
+
+#include "arayeh.h"
+
+// To ensure that the names declared in this portion of code have C linkage,
+// and thus C++ name mangling is not performed while using this code with C++.
+#undef __BEGIN_DECLS
+#undef __END_DECLS
+#ifdef __cplusplus
+#    define __BEGIN_DECLS extern "C" {
+#    define __END_DECLS   }
+#else
+#    define __BEGIN_DECLS /* empty */
+#    define __END_DECLS   /* empty */
+#endif
+
+__BEGIN_DECLS
+
+// this function returns AA_ARAYEH_TRUE if "operation" is an AA_ARAYEH_LESS ...
+// AA_ARAYEH_BETWEEN operation of compare method.
+int is_compare_operation(int operation);
+
+// this function compares "length" (at most 64) cells of numeric "type" with "value"
+// (and "upper" for between) and returns the result as a bitmask, cell 0 is the
+// lowest bit.
+uint64_t compare_block(const void *cells, size_t type, size_t length, int operation,
+                       const void *value, const void *upper);
+
+__END_DECLS
+
+#endif    //__AA_A_COMPARE_H__
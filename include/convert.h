@@ -0,0 +1,114 @@
+/** include/convert.h
+ *
+ * This file is a part of:
+ * Azadeh Afzar - Arayehsaz (AA-A).
+ *
+ * Copyright (C) 2020 - 2021 Azadeh Afzar.
+ * Copyright (C) 2020 - 2021 Mohammad Mahdi Baghbani Pourvahid.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgement in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#ifndef __AA_A_CONVERT_H__
+#define __AA_A_CONVERT_H__
+
+#include "arayeh.h"
+
+// To ensure that the names declared in this portion of code have C linkage,
+// and thus C++ name mangling is not performed while using this code with C++.
+#undef __BEGIN_DECLS
+#undef __END_DECLS
+#ifdef __cplusplus
+#    define __BEGIN_DECLS extern "C" {
+#    define __END_DECLS   }
+#else
+#    define __BEGIN_DECLS /* empty */
+#    define __END_DECLS   /* empty */
+#endif
+
+__BEGIN_DECLS
+
+// this function returns AA_ARAYEH_TRUE if "type" is an integer arayeh type.
+int is_integer_type(size_t type);
+
+// this function returns AA_ARAYEH_TRUE if "type" is a signed arayeh type.
+int is_signed_type(size_t type);
+
+// this function returns AA_ARAYEH_TRUE if the integer "element" of "type" can be
+// stored in "target_type" without changing its value.
+int integer_fits(const void *element, size_t type, size_t target_type);
+
+// this function converts "count" integers of "source_type" into "destination_type",
+// source and destination may be the same memory.
+void convert_integers(void *destination, size_t destination_type, const void *source,
+                      size_t source_type, size_t count);
+
+// this function returns AA_ARAYEH_TRUE if "type" is a numeric arayeh type.
+int is_numeric_type(size_t type);
+
+// this function returns AA_ARAYEH_TRUE if "type" is a half precision arayeh type.
+int is_half_type(size_t type);
+
+// this function converts "count" values of "source_type" into "destination_type",
+// out of range values are handled by "mode", source and destination may be the
+// same memory.
+void convert_values(void *destination, size_t destination_type, const void *source,
+                    size_t source_type, size_t count, int mode);
+
+// this function returns AA_ARAYEH_TRUE if a filled cell of arayeh doesn't fit in
+// "type".
+int convert_overflows(arayeh *self, size_t type, int mode);
+
+// this function returns the narrowest fixed-width integer type that holds all
+// filled cells of an integer arayeh.
+size_t narrowest_type(arayeh *self);
+
+// this function assigns private functions of arayeh for its storage type.
+void set_storage_methods(arayeh *self);
+
+// this function re-stores the cells of arayeh in "storage_type".
+int convert_storage(arayeh *self, size_t storage_type, int mode);
+
+// this function re-stores the cells of a narrowed arayeh in arayeh type, so
+// methods can work on its memory directly.
+int widen_storage(arayeh *self);
+
+// this function widens a narrowed arayeh if "element" doesn't fit in its cells.
+int widen_to_fit(arayeh *self, const void *element);
+
+// this function returns the size of a cell of arayeh stored in arayeh type.
+size_t wide_cell_size(arayeh *self);
+
+// this function copies "count" cells from "start_index" into "destination" as
+// cells of arayeh type, arayeh keeps its storage.
+void read_cells(arayeh *self, void *destination, size_t start_index, size_t count);
+
+__END_DECLS
+
+#endif    //__AA_A_CONVERT_H__
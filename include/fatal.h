@@ -102,6 +102,8 @@
     WARN("wrong arayeh type? failed in " what, allow_print)
 #define WARN_T_OVERFLOW(what, allow_print) \
     WARN("possible size_t overflow, failed in " what, allow_print)
+#define WARN_VALUE_OVERFLOW(what, allow_print) \
+    WARN("value doesn't fit in the new type, failed in " what, allow_print)
 #define WARN_NEW_SIZE(what, allow_print) \
     WARN("new size is less than current size, failed in " what, allow_print)
 #define WARN_WRONG_INDEX(what, allow_print)        WARN("failed in " what, allow_print)
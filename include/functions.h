@@ -57,6 +57,28 @@ __BEGIN_DECLS
 // This function will calculate the extension size of memory and extends arayeh size.
 int auto_extend_memory(arayeh *self);
 
+// This function extends arayeh size once, so it can hold at least "min_size" cells.
+int auto_extend_memory_to(arayeh *self, size_t min_size);
+
+// this function reserves "count" empty cells after the last filled cell for
+// "writer", for any type of arayeh.
+int open_writer(arayeh *self, arayeh_writer *writer, size_t count);
+
+// this function resolves arayeh settings into the policy of methods.
+void resolve_policy(arayeh *self);
+
+// this function creates an empty arayeh with the element type of "self".
+arayeh *create_arayeh_like(arayeh *self, size_t initial_size);
+
+// this function returns the size of an element of arayeh type in bytes.
+size_t type_size(size_t type);
+
+// this function returns the size of the elements that methods take and return.
+size_t element_value_size(arayeh *self);
+
+// this function returns AA_ARAYEH_TRUE if arayeh cells hold its elements as they are.
+int cells_are_elements(arayeh *self);
+
 // this function assigns pointers to public functions of an arayeh instance.
 void set_public_methods(arayeh *self);
 
@@ -0,0 +1,120 @@
+/** include/hash.h
+ *
+ * This file is a part of:
+ * Azadeh Afzar - Arayehsaz (AA-A).
+ *
+ * Copyright (C) 2020 - 2021 Azadeh Afzar.
+ * Copyright (C) 2020 - 2021 Mohammad Mahdi Baghbani Pourvahid.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgement in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#ifndef __AA_A_HASH_H__
+#define __AA_A_HASH_H__
+
+#include "arayeh.h"
+
+// To ensure that the names declared in this portion of code have C linkage,
+// and thus C++ name mangling is not performed while using this code with C++.
+#undef __BEGIN_DECLS
+#undef __END_DECLS
+#ifdef __cplusplus
+#    define __BEGIN_DECLS extern "C" {
+#    define __END_DECLS   }
+#else
+#    define __BEGIN_DECLS /* empty */
+#    define __END_DECLS   /* empty */
+#endif
+
+__BEGIN_DECLS
+
+// marks the end of a chain of indices.
+#define AA_ARAYEH_HASH_NONE SIZE_MAX
+
+// A slot of the hash table, holds one distinct value of the arayeh.
+struct arayeh_hash_slot {
+
+    // key of the value.
+    uint64_t key;
+
+    // smallest and biggest index of the cells holding the value.
+    size_t head;
+    size_t tail;
+
+    // number of cells holding the value, zero means the slot is empty.
+    size_t count;
+};
+
+// Hash index of arayeh values.
+struct arayeh_hash_index {
+
+    // open addressing hash table with linear probing.
+    struct arayeh_hash_slot *slots;
+
+    // number of slots, always a power of two.
+    size_t capacity;
+
+    // number of non-empty slots.
+    size_t filled;
+
+    // cells holding the same value are linked in a chain sorted by index,
+    // chain_next[i] and chain_prev[i] are the neighbours of cell i.
+    size_t *chain_next;
+    size_t *chain_prev;
+
+    // number of cells covered by the chain arrays.
+    size_t chain_size;
+};
+
+// this function builds the hash index of arayeh values.
+int hash_index_build(arayeh *self);
+
+// this function frees the hash index of arayeh values.
+void hash_index_free(arayeh *self);
+
+// this function returns AA_ARAYEH_TRUE if the arayeh has a usable hash index,
+// the index is built here if the settings ask for it.
+int hash_index_ready(arayeh *self);
+
+// this function adjusts the hash index to the new size of the arayeh.
+void hash_index_resize(arayeh *self, size_t new_size);
+
+// this function adds a filled cell to the hash index.
+void hash_index_insert(arayeh *self, size_t index);
+
+// this function removes a filled cell from the hash index, it must be called
+// before the cell is overwritten or emptied.
+void hash_index_remove(arayeh *self, size_t index);
+
+// this function returns the slot of an element or NULL if it isn't indexed.
+struct arayeh_hash_slot *hash_index_lookup(arayeh *self, void *element);
+
+__END_DECLS
+
+#endif    //__AA_A_HASH_H__
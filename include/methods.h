@@ -94,6 +94,138 @@ int _merge_from_array(arayeh *self, size_t start_index, size_t step, size_t arra
 // location.
 int _get_from_arayeh(arayeh *self, size_t index, void *destination);
 
+// this function inserts an element and shifts the cells after it forward.
+int _insert_shift_to_arayeh(arayeh *self, size_t index, void *element);
+
+// this function inserts a C array and shifts the cells after it forward.
+int _insert_range_shift_to_arayeh(arayeh *self, size_t index, size_t count,
+                                  void *array);
+
+// this function empties the cell at "index" and may close the gap.
+int _delete_item_from_arayeh(arayeh *self, size_t index, char shift);
+
+// this function empties a slice of cells and may close the gaps.
+int _delete_slice_from_arayeh(arayeh *self, size_t start_index, size_t step,
+                              size_t end_index, char shift);
+
+// this function copies the last filled cell to "destination" and empties it.
+int _pop_from_arayeh(arayeh *self, void *destination);
+
+// this function copies a range of cells into a C array.
+int _get_range_from_arayeh(arayeh *self, size_t start_index, size_t count,
+                           void *destination, void *fill_value);
+
+// this function copies the cells at "indices" into a C array.
+int _get_indices_from_arayeh(arayeh *self, size_t *indices, size_t count,
+                             void *destination, void *fill_value);
+
+// this function fills "view" with pointers to the arayeh memory and map.
+int _view_arayeh(arayeh *self, arayeh_view *view);
+
+// this function prepares an iterator over filled cells.
+int _iter_begin_arayeh(arayeh *self, arayeh_iterator *iterator);
+
+// this function moves an iterator to the next filled cell.
+int _iter_next_arayeh(arayeh *self, arayeh_iterator *iterator);
+
+// this function runs filled cells through a pipeline and reduces the result.
+int _pipeline_reduce_arayeh(arayeh *self, arayeh_pipeline *pipeline,
+                            arayeh_reducer reducer, void *accumulator);
+
+// this function runs filled cells through a pipeline into a new arayeh.
+arayeh *_pipeline_collect_arayeh(arayeh *self, arayeh_pipeline *pipeline);
+
+// this function reserves empty cells for a writer.
+int _writer_open_arayeh(arayeh *self, arayeh_writer *writer, size_t count);
+
+// this function commits the cells written by a writer.
+int _writer_close_arayeh(arayeh *self, arayeh_writer *writer);
+
+// this function calls a callback for every filled cell.
+int _for_each_arayeh(arayeh *self, arayeh_visitor visitor, void *context);
+
+// this function changes every filled cell with a callback.
+int _transform_arayeh(arayeh *self, arayeh_transformer transformer, void *context);
+
+// this function maps filled cells into a new arayeh with a callback.
+arayeh *_map_to_arayeh(arayeh *self, size_t type, arayeh_mapper mapper, void *context);
+
+// this function checks if an "element" exists in the filled cells of the arayeh.
+int _contains_in_arayeh(arayeh *self, void *element);
+
+// this function finds the index of the first filled cell that holds "element".
+int _find_in_arayeh(arayeh *self, void *element, size_t *index);
+
+// this function counts the filled cells that hold "element".
+size_t _count_in_arayeh(arayeh *self, void *element);
+
+// this function marks every filled cell that holds "element" in a bitmap.
+size_t _find_all_in_arayeh(arayeh *self, void *element, uint64_t *bitmap);
+
+// this function builds a hash index of arayeh values.
+int _build_hash_index(arayeh *self);
+
+// this function frees the hash index of arayeh values.
+void _drop_hash_index(arayeh *self);
+
+// this function moves all filled cells to the beginning of the arayeh.
+int _compact_arayeh(arayeh *self);
+
+// this function copies all filled cells and their indices into C arrays.
+size_t _pack_arayeh(arayeh *self, void *destination, size_t *indices);
+
+// this function converts arayeh elements into "type" in place.
+int _change_type_arayeh(arayeh *self, size_t type, int mode);
+
+// this function creates a new arayeh with arayeh elements converted into "type".
+arayeh *_convert_to_arayeh(arayeh *self, size_t type, int mode);
+
+// this function re-stores an integer arayeh in the narrowest integer type.
+int _narrow_arayeh(arayeh *self);
+
+// this function re-stores a narrowed arayeh in arayeh type.
+int _widen_arayeh(arayeh *self);
+
+// this function appends "count" strings to a string arayeh in bulk.
+int _add_strings_arayeh(arayeh *self, const char *bytes, const size_t *offsets,
+                        size_t count);
+
+// this function drops the bytes of deleted and overwritten strings from the arena.
+int _compact_arena_arayeh(arayeh *self);
+
+// this function appends "count" bytes to a char arayeh with a single memcpy.
+int _append_bytes_arayeh(arayeh *self, const char *bytes, size_t count);
+
+// this function finds the first occurrence of bytes of "needle" in a char arayeh.
+int _find_bytes_in_arayeh(arayeh *self, size_t start_index, const char *needle,
+                          size_t length, size_t *index);
+
+// this function splits the text of a char arayeh on "delimiter" into ranges.
+size_t _split_arayeh(arayeh *self, char delimiter, arayeh_range *ranges,
+                     size_t capacity);
+
+// this function returns the text of a char arayeh as a NUL terminated string.
+const char *_c_string_arayeh(arayeh *self, size_t *length);
+
+// this function returns the number of true cells of a boolean arayeh.
+size_t _popcount_arayeh(arayeh *self);
+
+// this function applies a bitwise operation to the cells of a boolean arayeh.
+int _bitwise_arayeh(arayeh *self, int operation, arayeh *other);
+
+// this function marks the filled cells of arayeh that satisfy a comparison.
+size_t _compare_arayeh(arayeh *self, int operation, void *value, void *upper,
+                       uint64_t *bitmap);
+
+// this function copies the filled cells marked in a bitmap into a new arayeh.
+arayeh *_select_arayeh(arayeh *self, const uint64_t *bitmap);
+
+// this function replaces the filled cells of arayeh by their running operation.
+int _scan_arayeh(arayeh *self, int operation, int mode);
+
+// this function returns a new arayeh of the running operation of the filled cells.
+arayeh *_scan_to_arayeh(arayeh *self, int operation, int mode);
+
 // this function will override arayeh default settings with new one.
 void _set_settings(arayeh *self, arayeh_settings *new_settings);
 
@@ -0,0 +1,102 @@
+/** include/scan.h
+ *
+ * This file is a part of:
+ * Azadeh Afzar - Arayehsaz (AA-A).
+ *
+ * Copyright (C) 2020 - 2021 Azadeh Afzar.
+ * Copyright (C) 2020 - 2021 Mohammad Mahdi Baghbani Pourvahid.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgement in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+
+#ifndef __AA_A_SCAN_H__
+#define __AA_A_SCAN_H__
+
+#include "arayeh.h"
+
+// To ensure that the names declared in this portion of code have C linkage,
+// and thus C++ name mangling is not performed while using this code with C++.
+#undef __BEGIN_DECLS
+#undef __END_DECLS
+#ifdef __cplusplus
+#    define __BEGIN_DECLS extern "C" {
+#    define __END_DECLS   }
+#else
+#    define __BEGIN_DECLS /* empty */
+#    define __END_DECLS   /* empty */
+#endif
+
+__BEGIN_DECLS
+
+// running value of a scan, the member of arayeh type is used, half precision
+// types use the float.
+typedef union {
+    char char_value;
+    short int short_int_value;
+    int int_value;
+    long int long_int_value;
+    float float_value;
+    double double_value;
+    int8_t int8_value;
+    int16_t int16_value;
+    int32_t int32_value;
+    int64_t int64_value;
+    uint8_t uint8_value;
+    uint16_t uint16_value;
+    uint32_t uint32_value;
+    uint64_t uint64_value;
+} scan_value;
+
+// this function returns AA_ARAYEH_TRUE if "operation" is an operation of scan
+// methods.
+int is_scan_operation(int operation);
+
+// this function sets "value" to the value that doesn't change a scan of "operation",
+// 0 for sums, the largest value of "type" for min and the smallest for max.
+void scan_identity(scan_value *value, size_t type, int operation);
+
+// this function combines "value" into "total" by "operation".
+void scan_combine(scan_value *total, const scan_value *value, size_t type,
+                  int operation);
+
+// this function combines the filled cells from index (inclusive) "start_index" to
+// index (exclusive) "end_index" into "total" by "operation".
+void scan_reduce(scan_value *total, const void *cells, const char *map, size_t type,
+                 size_t start_index, size_t end_index, int operation);
+
+// this function replaces the filled cells from index (inclusive) "start_index" to
+// index (exclusive) "end_index" by their running "operation", starting from "carry",
+// and leaves the total in "carry".
+void scan_cells(void *cells, const char *map, size_t type, size_t start_index,
+                size_t end_index, int operation, int mode, scan_value *carry);
+
+__END_DECLS
+
+#endif    //__AA_A_SCAN_H__
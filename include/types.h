@@ -68,6 +68,8 @@ int _init_pointer_type_float(arayeh *self, arayeh_types *array, size_t initial_s
 
 int _init_pointer_type_double(arayeh *self, arayeh_types *array, size_t initial_size);
 
+int _init_pointer_type_generic(arayeh *self, arayeh_types *array, size_t initial_size);
+
 // Allocate memory for arayeh.
 
 int _malloc_type_char(arayeh *self, arayeh_types *array, size_t initial_size);
@@ -82,6 +84,8 @@ int _malloc_type_float(arayeh *self, arayeh_types *array, size_t initial_size);
 
 int _malloc_type_double(arayeh *self, arayeh_types *array, size_t initial_size);
 
+int _malloc_type_generic(arayeh *self, arayeh_types *array, size_t initial_size);
+
 // Re-allocate memory for arayeh.
 
 int _realloc_type_char(arayeh *self, arayeh_types *array, size_t new_size);
@@ -96,6 +100,8 @@ int _realloc_type_float(arayeh *self, arayeh_types *array, size_t new_size);
 
 int _realloc_type_double(arayeh *self, arayeh_types *array, size_t new_size);
 
+int _realloc_type_generic(arayeh *self, arayeh_types *array, size_t new_size);
+
 // Free arayeh memory.
 
 void _free_type_char(arayeh *self);
@@ -110,6 +116,8 @@ void _free_type_float(arayeh *self);
 
 void _free_type_double(arayeh *self);
 
+void _free_type_generic(arayeh *self);
+
 // Assign the initialized pointer of an array to the arayeh structs pointer.
 
 void _set_memory_pointer_type_char(arayeh *self, arayeh_types *array);
@@ -124,6 +132,8 @@ void _set_memory_pointer_type_float(arayeh *self, arayeh_types *array);
 
 void _set_memory_pointer_type_double(arayeh *self, arayeh_types *array);
 
+void _set_memory_pointer_type_generic(arayeh *self, arayeh_types *array);
+
 // Add an element of a specific type to the arayeh.
 
 void _add_type_char(arayeh *self, size_t index, void *element);
@@ -138,6 +148,8 @@ void _add_type_float(arayeh *self, size_t index, void *element);
 
 void _add_type_double(arayeh *self, size_t index, void *element);
 
+void _add_type_generic(arayeh *self, size_t index, void *element);
+
 // Merge an arayeh of a specific type into another arayeh.
 
 int _merge_arayeh_type_char(arayeh *self, size_t start_index, size_t step,
@@ -157,6 +169,9 @@ int _merge_arayeh_type_float(arayeh *self, size_t start_index, size_t step,
 int _merge_arayeh_type_double(arayeh *self, size_t start_index, size_t step,
                               arayeh *source);
 
+int _merge_arayeh_type_generic(arayeh *self, size_t start_index, size_t step,
+                               arayeh *source);
+
 // Merge a C standard array of a specific type into the arayeh.
 
 int _merge_array_type_char(arayeh *self, size_t start_index, size_t step,
@@ -177,6 +192,9 @@ int _merge_array_type_float(arayeh *self, size_t start_index, size_t step,
 int _merge_array_type_double(arayeh *self, size_t start_index, size_t step,
                              size_t array_size, void *array);
 
+int _merge_array_type_generic(arayeh *self, size_t start_index, size_t step,
+                              size_t array_size, void *array);
+
 // Get an element from arayeh.
 
 void _get_type_char(arayeh *self, size_t index, void *element);
@@ -191,6 +209,112 @@ void _get_type_float(arayeh *self, size_t index, void *element);
 
 void _get_type_double(arayeh *self, size_t index, void *element);
 
+void _get_type_generic(arayeh *self, size_t index, void *element);
+
+// Compare a block of arayeh cells with an element.
+
+uint64_t _match_type_char(arayeh *self, size_t index, size_t length, void *element);
+
+uint64_t _match_type_short_int(arayeh *self, size_t index, size_t length,
+                               void *element);
+
+uint64_t _match_type_int(arayeh *self, size_t index, size_t length, void *element);
+
+uint64_t _match_type_long_int(arayeh *self, size_t index, size_t length,
+                              void *element);
+
+uint64_t _match_type_int64(arayeh *self, size_t index, size_t length, void *element);
+
+uint64_t _match_type_float(arayeh *self, size_t index, size_t length, void *element);
+
+uint64_t _match_type_double(arayeh *self, size_t index, size_t length, void *element);
+
+uint64_t _match_type_generic(arayeh *self, size_t index, size_t length, void *element);
+
+// Convert an element into a hash index key.
+
+int _hash_key_type_char(void *element, uint64_t *key);
+
+int _hash_key_type_short_int(void *element, uint64_t *key);
+
+int _hash_key_type_int(void *element, uint64_t *key);
+
+int _hash_key_type_long_int(void *element, uint64_t *key);
+
+int _hash_key_type_int64(void *element, uint64_t *key);
+
+int _hash_key_type_float(void *element, uint64_t *key);
+
+int _hash_key_type_double(void *element, uint64_t *key);
+
+// Add and get elements of fixed-width integer types.
+
+#define AA_ARAYEH_FIXED_WIDTH_TYPE(name)                                     \
+    void _add_type_##name(arayeh *self, size_t index, void *element);        \
+    void _get_type_##name(arayeh *self, size_t index, void *element);
+
+AA_ARAYEH_FIXED_WIDTH_TYPE(int8)
+AA_ARAYEH_FIXED_WIDTH_TYPE(int16)
+AA_ARAYEH_FIXED_WIDTH_TYPE(int32)
+AA_ARAYEH_FIXED_WIDTH_TYPE(int64)
+AA_ARAYEH_FIXED_WIDTH_TYPE(uint8)
+AA_ARAYEH_FIXED_WIDTH_TYPE(uint16)
+AA_ARAYEH_FIXED_WIDTH_TYPE(uint32)
+AA_ARAYEH_FIXED_WIDTH_TYPE(uint64)
+
+#undef AA_ARAYEH_FIXED_WIDTH_TYPE
+
+// Add, get and compare elements of half precision types.
+
+#define AA_ARAYEH_HALF_TYPE(name)                                            \
+    void _add_type_##name(arayeh *self, size_t index, void *element);        \
+    void _get_type_##name(arayeh *self, size_t index, void *element);        \
+    uint64_t _match_type_##name(arayeh *self, size_t index, size_t length,   \
+                                void *element);
+
+AA_ARAYEH_HALF_TYPE(float16)
+AA_ARAYEH_HALF_TYPE(bfloat16)
+
+#undef AA_ARAYEH_HALF_TYPE
+
+// Add, get and compare elements of string type.
+
+void _free_type_string(arayeh *self);
+
+void _add_type_string(arayeh *self, size_t index, void *element);
+
+void _get_type_string(arayeh *self, size_t index, void *element);
+
+uint64_t _match_type_string(arayeh *self, size_t index, size_t length, void *element);
+
+// Add, get and compare elements of boolean type, unpacked and packed.
+
+void _add_type_bool(arayeh *self, size_t index, void *element);
+
+void _get_type_bool(arayeh *self, size_t index, void *element);
+
+uint64_t _match_type_bool(arayeh *self, size_t index, size_t length, void *element);
+
+int _init_pointer_type_bit(arayeh *self, arayeh_types *array, size_t initial_size);
+
+int _malloc_type_bit(arayeh *self, arayeh_types *array, size_t initial_size);
+
+int _realloc_type_bit(arayeh *self, arayeh_types *array, size_t new_size);
+
+void _add_type_bit(arayeh *self, size_t index, void *element);
+
+void _get_type_bit(arayeh *self, size_t index, void *element);
+
+uint64_t _match_type_bit(arayeh *self, size_t index, size_t length, void *element);
+
+// Merge elements of types whose cells are not their elements.
+
+int _merge_arayeh_type_element(arayeh *self, size_t start_index, size_t step,
+                               arayeh *source);
+
+int _merge_array_type_element(arayeh *self, size_t start_index, size_t step,
+                              size_t array_size, void *array);
+
 __END_DECLS
 
 #endif    //__AA_A_TYPES_H__
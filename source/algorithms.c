@@ -37,6 +37,12 @@
 
 #include "../include/algorithms.h"
 
+#include <string.h>
+
+#if defined(__SSE2__)
+#    include <immintrin.h>
+#endif
+
 size_t growth_factor_python(arayeh *arayeh)
 {
     /*
@@ -77,6 +83,279 @@ void update_next_index(arayeh *self)
      * array.next variable to point to next empty [available]
      * slot in the arayeh.
      *
+     * the map is checked 64 cells at a time, so long runs of filled
+     * cells are skipped quickly.
+     *
+     * ARGUMENTS:
+     * self         pointer to the arayeh object.
+     *
+     * RETURN:
+     * no return, it's void dude.
+     *
+     */
+
+    // shorten names for god's sake.
+    struct private_properties *private_properties = &self->_private_properties;
+
+    size_t next = find_empty_cell(private_properties->map, private_properties->next,
+                                  private_properties->size);
+
+    // update both public and private next property.
+    private_properties->next = next;
+    self->next               = next;
+}
+
+size_t find_empty_cell(const char *map, size_t start_index, size_t end_index)
+{
+    /*
+     * This function returns the index of the first empty cell from index
+     * (inclusive) "start_index" to index (exclusive) "end_index", the map is
+     * checked 64 cells at a time.
+     *
+     * ARGUMENTS:
+     * map          pointer to the arayeh map.
+     * start_index  starting index (inclusive).
+     * end_index    ending index (exclusive).
+     *
+     * RETURN:
+     * index of the first empty cell, or "end_index" if all cells are filled.
+     *
+     */
+
+    size_t index = start_index;
+
+    while (index < end_index) {
+        size_t length  = (end_index - index < 64) ? end_index - index : 64;
+        uint64_t full  = (length == 64) ? UINT64_MAX : ((uint64_t) 1 << length) - 1;
+        uint64_t empty = ~map_block_mask(map, index, length) & full;
+
+        if (empty != 0) {
+            return index + count_trailing_zeros(empty);
+        }
+
+        index += length;
+    }
+
+    return end_index;
+}
+
+size_t find_top_index(arayeh *self)
+{
+    /*
+     * This function returns one past the index of the last filled cell.
+     *
+     * an arayeh without empty cells among its filled cells ends at "next",
+     * otherwise the map is checked 64 cells at a time from the end of the arayeh.
+     *
+     * ARGUMENTS:
+     * self         pointer to the arayeh object.
+     *
+     * RETURN:
+     * top          one past the last filled index, zero if arayeh is empty.
+     *
+     */
+
+    // shorten names for god's sake.
+    struct private_properties *private_properties = &self->_private_properties;
+
+    size_t end = private_properties->size;
+
+    // an empty arayeh has no filled cell to find.
+    if (private_properties->used == 0) {
+        return 0;
+    }
+
+    // every cell before "next" is filled, so if their number is "used" there is
+    // no filled cell after it, "next" is a logical index so the gap must be closed.
+    if (private_properties->used == private_properties->next &&
+        private_properties->gap_start == private_properties->gap_end) {
+        return private_properties->next;
+    }
+
+    while (end > 0) {
+        size_t length = (end < 64) ? end : 64;
+        uint64_t mask = map_block_mask(private_properties->map, end - length, length);
+
+        if (mask != 0) {
+            // index of the highest set bit.
+            size_t highest = 63;
+            while ((mask >> highest) == 0) {
+                highest--;
+            }
+            return end - length + highest + 1;
+        }
+
+        end -= length;
+    }
+
+    return 0;
+}
+
+size_t count_filled_cells(const char *map, size_t start_index, size_t end_index)
+{
+    /*
+     * This function returns the number of filled cells in a range of the map,
+     * 64 cells are counted at a time with a population count.
+     *
+     * ARGUMENTS:
+     * map          pointer to the arayeh map.
+     * start_index  starting index (inclusive).
+     * end_index    ending index (exclusive).
+     *
+     * RETURN:
+     * count        number of filled cells.
+     *
+     */
+
+    size_t count = 0;
+
+    for (size_t block = start_index; block < end_index; block += 64) {
+        size_t length = (end_index - block < 64) ? end_index - block : 64;
+        count += count_set_bits(map_block_mask(map, block, length));
+    }
+
+    return count;
+}
+
+void move_cells(arayeh *self, size_t destination_index, size_t source_index,
+                size_t count)
+{
+    /*
+     * This function moves "count" cells and their map from "source_index" to
+     * "destination_index" with memmove, the ranges may overlap. cells left
+     * behind keep their old content, callers update their map. packed boolean
+     * cells are moved as words of bits.
+     *
+     * ARGUMENTS:
+     * self                 pointer to the arayeh object.
+     * destination_index    index of the first destination cell.
+     * source_index         index of the first source cell.
+     * count                number of cells to move.
+     *
+     * RETURN:
+     * no return, it's void dude.
+     *
+     */
+
+    // shorten names for god's sake.
+    struct private_properties *private_properties = &self->_private_properties;
+
+    size_t element_size = private_properties->element_size;
+    char *array_pointer = private_properties->array.char_pointer;
+
+    if (count == 0 || destination_index == source_index) {
+        return;
+    }
+
+    // packed boolean cells move 64 at a time, from the side that is overwritten.
+    if (private_properties->storage_type == AA_ARAYEH_STORAGE_BIT) {
+        uint64_t *words = private_properties->array.bool_pointer;
+
+        for (size_t moved = 0; moved < count; moved += 64) {
+            size_t length = (count - moved < 64) ? count - moved : 64;
+            size_t offset = (destination_index < source_index) ? moved
+                                                               : count - moved - length;
+            write_bits(words, destination_index + offset,
+                       read_bits(words, source_index + offset, length), length);
+        }
+
+        memmove(private_properties->map + destination_index,
+                private_properties->map + source_index, count);
+        return;
+    }
+
+    memmove(array_pointer + destination_index * element_size,
+            array_pointer + source_index * element_size, count * element_size);
+    memmove(private_properties->map + destination_index,
+            private_properties->map + source_index, count);
+}
+
+size_t gap_physical_index(arayeh *self, size_t index)
+{
+    /*
+     * This function converts a logical index to the index of the cell in memory.
+     *
+     * cells before the gap are in place, cells after it are "gap length" cells
+     * further, and the last "gap length" logical cells are the gap itself.
+     *
+     * ARGUMENTS:
+     * self         pointer to the arayeh object.
+     * index        logical index of the cell, less than arayeh size.
+     *
+     * RETURN:
+     * index of the cell in memory.
+     *
+     */
+
+    // shorten names for god's sake.
+    struct private_properties *private_properties = &self->_private_properties;
+
+    size_t gap_start  = private_properties->gap_start;
+    size_t gap_length = private_properties->gap_end - gap_start;
+
+    if (index < gap_start) {
+        return index;
+    }
+
+    if (index < private_properties->size - gap_length) {
+        return index + gap_length;
+    }
+
+    return gap_start + index - (private_properties->size - gap_length);
+}
+
+void move_gap(arayeh *self, size_t index)
+{
+    /*
+     * This function moves the gap so it starts at logical "index", only the
+     * cells between the old and the new place of the gap are moved.
+     *
+     * "index" must be less than or equal to arayeh size minus gap length.
+     *
+     * ARGUMENTS:
+     * self         pointer to the arayeh object.
+     * index        new logical index of the gap.
+     *
+     * RETURN:
+     * no return, it's void dude.
+     *
+     */
+
+    // shorten names for god's sake.
+    struct private_properties *private_properties = &self->_private_properties;
+
+    size_t gap_start  = private_properties->gap_start;
+    size_t gap_end    = private_properties->gap_end;
+    size_t gap_length = gap_end - gap_start;
+    char *map         = private_properties->map;
+
+    if (gap_length != 0 && index < gap_start) {
+        // move cells before the gap to its end.
+        move_cells(self, index + gap_length, index, gap_start - index);
+
+        // empty the cells that weren't overwritten.
+        size_t vacated_end = (gap_start < index + gap_length) ? gap_start
+                                                              : index + gap_length;
+        memset(map + index, AA_ARAYEH_OFF, vacated_end - index);
+    } else if (gap_length != 0 && index > gap_start) {
+        // move cells after the gap to its beginning.
+        move_cells(self, gap_start, gap_end, index - gap_start);
+
+        // empty the cells that weren't overwritten.
+        size_t vacated_start = (index > gap_end) ? index : gap_end;
+        memset(map + vacated_start, AA_ARAYEH_OFF, index + gap_length - vacated_start);
+    }
+
+    private_properties->gap_start = index;
+    private_properties->gap_end   = index + gap_length;
+}
+
+void close_gap(arayeh *self)
+{
+    /*
+     * This function moves the gap to the end of arayeh, afterwards every cell
+     * is at its logical index and the gap is closed.
+     *
      * ARGUMENTS:
      * self         pointer to the arayeh object.
      *
@@ -88,11 +367,459 @@ void update_next_index(arayeh *self)
     // shorten names for god's sake.
     struct private_properties *private_properties = &self->_private_properties;
 
-    while ((private_properties->next < private_properties->size) &&
-           (private_properties->map[private_properties->next] == AA_ARAYEH_ON)) {
-        private_properties->next++;
+    size_t gap_length = private_properties->gap_end - private_properties->gap_start;
+
+    if (gap_length != 0) {
+        move_gap(self, private_properties->size - gap_length);
+    }
+
+    private_properties->gap_start = 0;
+    private_properties->gap_end   = 0;
+}
+
+uint64_t map_block_mask(const char *map, size_t index, size_t length)
+{
+    /*
+     * This function converts "length" (at most 64) cells of the map starting
+     * from "index" into a bitmask of filled cells, bit 0 of the mask represents
+     * the cell at "index".
+     *
+     * ARGUMENTS:
+     * map          pointer to the arayeh map.
+     * index        index of the first cell.
+     * length       number of cells to convert, at most 64.
+     *
+     * RETURN:
+     * mask         bitmask of filled cells.
+     *
+     */
+
+    const char *cells = map + index;
+    uint64_t mask     = 0;
+    size_t offset     = 0;
+
+#if defined(__AVX2__)
+    const __m256i on_256 = _mm256_set1_epi8(AA_ARAYEH_ON);
+    for (; offset + 32 <= length; offset += 32) {
+        __m256i block = _mm256_loadu_si256((const __m256i *) (cells + offset));
+        uint32_t bits = (uint32_t) _mm256_movemask_epi8(_mm256_cmpeq_epi8(block, on_256));
+        mask |= (uint64_t) bits << offset;
+    }
+#endif
+#if defined(__SSE2__)
+    const __m128i on_128 = _mm_set1_epi8(AA_ARAYEH_ON);
+    for (; offset + 16 <= length; offset += 16) {
+        __m128i block = _mm_loadu_si128((const __m128i *) (cells + offset));
+        uint32_t bits = (uint32_t) _mm_movemask_epi8(_mm_cmpeq_epi8(block, on_128));
+        mask |= (uint64_t) bits << offset;
+    }
+#endif
+
+    // remaining cells.
+    for (; offset < length; offset++) {
+        mask |= (uint64_t) (cells[offset] == AA_ARAYEH_ON) << offset;
+    }
+
+    return mask;
+}
+
+void copy_element(void *destination, const void *source, size_t element_size)
+{
+    /*
+     * This function copies an element of "element_size" bytes.
+     *
+     * common sizes use a constant size memcpy, which compilers turn into a
+     * single load and store.
+     *
+     * ARGUMENTS:
+     * destination  pointer to the destination memory location.
+     * source       pointer to the element.
+     * element_size size of the element in bytes.
+     *
+     * RETURN:
+     * no return, it's void dude.
+     *
+     */
+
+    switch (element_size) {
+    case 1:
+        memcpy(destination, source, 1);
+        break;
+    case 2:
+        memcpy(destination, source, 2);
+        break;
+    case 4:
+        memcpy(destination, source, 4);
+        break;
+    case 8:
+        memcpy(destination, source, 8);
+        break;
+    case 16:
+        memcpy(destination, source, 16);
+        break;
+    default:
+        memcpy(destination, source, element_size);
+    }
+}
+
+// distance of software prefetching in gather_cells, in elements.
+#define GATHER_PREFETCH_DISTANCE 16
+
+size_t gather_cells(char *destination, const char *array, const char *map, size_t size,
+                    const size_t *indices, size_t count, size_t element_size,
+                    const void *fill_value)
+{
+    /*
+     * This function copies the cells at "indices" into "destination".
+     *
+     * random indices miss the cache on big arayehs, so the cell and the map of
+     * the index GATHER_PREFETCH_DISTANCE positions ahead are prefetched while
+     * the current one is copied.
+     *
+     * ARGUMENTS:
+     * destination  pointer to the destination memory location.
+     * array        pointer to the arayeh cells.
+     * map          pointer to the arayeh map.
+     * size         number of arayeh cells.
+     * indices      indices of the cells to copy.
+     * count        number of indices.
+     * element_size size of a cell in bytes.
+     * fill_value   pointer to the value for empty cells, or NULL to copy
+     *              empty cells as they are.
+     *
+     * RETURN:
+     * position of the first index out of range or "count" if all are valid.
+     *
+     */
+
+    for (size_t position = 0; position < count; position++) {
+        // prefetch a future cell and its map.
+        if (position + GATHER_PREFETCH_DISTANCE < count) {
+            size_t future = indices[position + GATHER_PREFETCH_DISTANCE];
+            if (future < size) {
+                AA_ARAYEH_PREFETCH(array + future * element_size);
+                AA_ARAYEH_PREFETCH(map + future);
+            }
+        }
+
+        size_t index = indices[position];
+        if (index >= size) {
+            return position;
+        }
+
+        const void *source = array + index * element_size;
+        if (fill_value != NULL && map[index] != AA_ARAYEH_ON) {
+            source = fill_value;
+        }
+
+        copy_element(destination + position * element_size, source, element_size);
+    }
+
+    return count;
+}
+
+#if defined(__AVX2__) && defined(__BMI2__)
+static __m256i compress_permutation(uint32_t mask)
+{
+    /*
+     * This function builds the permutation that moves the 32 bit lanes selected
+     * by the 8 bit "mask" to the front of a register, the shuffle indices are
+     * extracted from the identity permutation with pext instead of a table.
+     */
+
+    uint64_t lanes   = _pdep_u64(mask, 0x0101010101010101ULL) * 0xFF;
+    uint64_t indices = _pext_u64(0x0706050403020100ULL, lanes);
+    return _mm256_cvtepu8_epi32(_mm_cvtsi64_si128((long long) indices));
+}
+
+static __m256i store_lanes(unsigned int count)
+{
+    /*
+     * This function returns a maskstore mask that enables the first "count"
+     * 32 bit lanes.
+     */
+
+    const __m256i lane_numbers = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    return _mm256_cmpgt_epi32(_mm256_set1_epi32((int) count), lane_numbers);
+}
+#endif
+
+size_t compress_block(char *destination, const char *source, size_t length,
+                      uint64_t mask, size_t element_size)
+{
+    /*
+     * This function copies the cells of a block whose bit is set in "mask" to
+     * the beginning of "destination", keeping their order (stream compaction).
+     *
+     * "destination" may overlap "source" if it starts before it, which makes
+     * in place compaction possible, nothing is written after the last copied
+     * cell.
+     *
+     * ARGUMENTS:
+     * destination  pointer to the destination memory location.
+     * source       pointer to the first cell of the block.
+     * length       number of cells in the block, at most 64.
+     * mask         bitmask of cells to copy, cell 0 is the lowest bit.
+     * element_size size of a cell in bytes.
+     *
+     * RETURN:
+     * count        number of copied cells.
+     *
+     */
+
+    // a full block is a single move.
+    if (length == 64 && mask == UINT64_MAX) {
+        memmove(destination, source, 64 * element_size);
+        return 64;
+    }
+
+    size_t count = 0;
+
+#if defined(__AVX2__) && defined(__BMI2__)
+    // compress 8 cells of 4 bytes or 4 cells of 8 bytes per step with a lane
+    // permutation and a masked store.
+    if (element_size == 4 || element_size == 8) {
+        size_t cells_per_step = 32 / element_size;
+        size_t offset         = 0;
+
+        for (; offset + cells_per_step <= length; offset += cells_per_step) {
+            uint32_t bits = (uint32_t) (mask >> offset) & ((1U << cells_per_step) - 1);
+            if (bits == 0) {
+                continue;
+            }
+
+            // 8 byte cells are handled as pairs of 32 bit lanes.
+            uint32_t lanes = bits;
+            if (element_size == 8) {
+                lanes = (uint32_t) _pdep_u64(bits, 0x55) * 3;
+            }
+
+            __m256i block =
+                _mm256_loadu_si256((const __m256i *) (source + offset * element_size));
+            __m256i packed =
+                _mm256_permutevar8x32_epi32(block, compress_permutation(lanes));
+            unsigned int kept = count_set_bits(lanes);
+
+            _mm256_maskstore_epi32((int *) (destination + count * element_size),
+                                   store_lanes(kept), packed);
+            count += count_set_bits(bits);
+        }
+
+        // remaining cells.
+        mask = (offset < 64) ? (mask >> offset) << offset : 0;
+    }
+#endif
+
+    // copy the selected cells one by one, the cost is proportional to the
+    // number of selected cells.
+    while (mask != 0) {
+        size_t cell = count_trailing_zeros(mask);
+        mask &= mask - 1;
+
+        if (cell >= length) {
+            break;
+        }
+
+        // cells before the first hole of an in place compaction don't move.
+        if (destination + count * element_size != source + cell * element_size) {
+            copy_element(destination + count * element_size,
+                         source + cell * element_size, element_size);
+        }
+        count++;
+    }
+
+    return count;
+}
+
+size_t load_filled_cells(arayeh *self, size_t start_index, size_t end_index,
+                         char *destination)
+{
+    /*
+     * This function copies filled cells from index (inclusive) "start_index" to
+     * index (exclusive) "end_index" to "destination", keeping their order.
+     *
+     * "start_index" should be a multiple of 64, the map is read 64 cells at a
+     * time.
+     *
+     * ARGUMENTS:
+     * self         pointer to the arayeh object.
+     * start_index  starting index (inclusive).
+     * end_index    ending index (exclusive).
+     * destination  pointer to a buffer of at least "end_index - start_index" cells.
+     *
+     * RETURN:
+     * count        number of copied cells.
+     *
+     */
+
+    // shorten names for god's sake.
+    struct private_properties *private_properties = &self->_private_properties;
+
+    size_t element_size = private_properties->element_size;
+    char *array_pointer = private_properties->array.char_pointer;
+    size_t count        = 0;
+
+    for (size_t block = start_index; block < end_index; block += 64) {
+        size_t length = (end_index - block < 64) ? end_index - block : 64;
+        uint64_t mask = map_block_mask(private_properties->map, block, length);
+
+        if (mask != 0) {
+            count += compress_block(destination + count * element_size,
+                                    array_pointer + block * element_size, length, mask,
+                                    element_size);
+        }
+    }
+
+    return count;
+}
+
+size_t run_pipeline_stages(arayeh_pipeline *pipeline, void *block, size_t count)
+{
+    /*
+     * This function runs "count" elements of "block" through the stages of
+     * "pipeline" in order, a stage that keeps no element ends the run.
+     *
+     * ARGUMENTS:
+     * pipeline     pointer to the pipeline.
+     * block        pointer to the elements.
+     * count        number of elements.
+     *
+     * RETURN:
+     * count        number of elements left at the beginning of "block".
+     *
+     */
+
+    for (size_t stage = 0; stage < pipeline->stage_count && count != 0; stage++) {
+        arayeh_stage *current = &pipeline->stages[stage];
+        count                 = current->function(block, count, current->context);
+    }
+
+    return count;
+}
+
+/* Walks filled cells of "map" from index (inclusive) "start_index" to index
+ * (exclusive) "end_index" in order of index and runs the statement "..." with
+ * "index" set to each of them. the map is read 64 cells at a time, blocks
+ * without a filled cell are skipped and full blocks are walked without checking
+ * the map. the statement is expanded in place, so callbacks are called directly.
+ */
+
+#define AA_WALK_FILLED_CELLS(map, start_index, end_index, index, ...)                   \
+    for (size_t block = (start_index); block < (end_index); block += 64) {              \
+        size_t length = ((end_index) - block < 64) ? (end_index) - block : 64;          \
+        uint64_t mask = map_block_mask((map), block, length);                           \
+                                                                                        \
+        if (length == 64 && mask == UINT64_MAX) {                                       \
+            /* full block. */                                                           \
+            for (size_t index = block; index < block + 64; index++) {                   \
+                __VA_ARGS__;                                                            \
+            }                                                                           \
+        } else {                                                                        \
+            for (; mask != 0; mask &= mask - 1) {                                       \
+                size_t index = block + count_trailing_zeros(mask);                      \
+                __VA_ARGS__;                                                            \
+            }                                                                           \
+        }                                                                               \
     }
 
-    // update public next property.
-    self->next = private_properties->next;
+void visit_cells(arayeh *self, size_t start_index, size_t end_index,
+                 arayeh_visitor visitor, void *context)
+{
+    /*
+     * This function calls "visitor" for filled cells from index (inclusive)
+     * "start_index" to index (exclusive) "end_index", in order of index.
+     *
+     * the map is read 64 cells at a time, blocks without a filled cell are
+     * skipped and full blocks are walked without checking the map.
+     *
+     * ARGUMENTS:
+     * self         pointer to the arayeh object.
+     * start_index  starting index (inclusive), a multiple of 64.
+     * end_index    ending index (exclusive).
+     * visitor      function to call.
+     * context      pointer passed to every call of "visitor".
+     *
+     * RETURN:
+     * no return, it's void dude.
+     *
+     */
+
+    // shorten names for god's sake.
+    struct private_properties *private_properties = &self->_private_properties;
+
+    size_t element_size = private_properties->element_size;
+    char *array_pointer = private_properties->array.char_pointer;
+
+    AA_WALK_FILLED_CELLS(private_properties->map, start_index, end_index, index,
+                         visitor(index, array_pointer + index * element_size, context));
+}
+
+void transform_cells(arayeh *self, size_t start_index, size_t end_index,
+                     arayeh_transformer transformer, void *context)
+{
+    /*
+     * This function calls "transformer" for filled cells from index (inclusive)
+     * "start_index" to index (exclusive) "end_index", in order of index.
+     *
+     * the map is read 64 cells at a time, blocks without a filled cell are
+     * skipped and full blocks are walked without checking the map.
+     *
+     * ARGUMENTS:
+     * self         pointer to the arayeh object.
+     * start_index  starting index (inclusive), a multiple of 64.
+     * end_index    ending index (exclusive).
+     * transformer  function to call.
+     * context      pointer passed to every call of "transformer".
+     *
+     * RETURN:
+     * no return, it's void dude.
+     *
+     */
+
+    // shorten names for god's sake.
+    struct private_properties *private_properties = &self->_private_properties;
+
+    size_t element_size = private_properties->element_size;
+    char *array_pointer = private_properties->array.char_pointer;
+
+    AA_WALK_FILLED_CELLS(private_properties->map, start_index, end_index, index,
+                         transformer(index, array_pointer + index * element_size,
+                                     context));
+}
+
+void map_cells(arayeh *self, size_t start_index, size_t end_index,
+               arayeh_mapper mapper, arayeh *result, void *context)
+{
+    /*
+     * This function calls "mapper" for filled cells from index (inclusive)
+     * "start_index" to index (exclusive) "end_index", in order of index.
+     *
+     * the map is read 64 cells at a time, blocks without a filled cell are
+     * skipped and full blocks are walked without checking the map.
+     *
+     * ARGUMENTS:
+     * self         pointer to the arayeh object.
+     * start_index  starting index (inclusive), a multiple of 64.
+     * end_index    ending index (exclusive).
+     * mapper       function to call.
+     * result       pointer to an arayeh with the same size.
+     * context      pointer passed to every call of "mapper".
+     *
+     * RETURN:
+     * no return, it's void dude.
+     *
+     */
+
+    // shorten names for god's sake.
+    struct private_properties *private_properties = &self->_private_properties;
+
+    size_t element_size = private_properties->element_size;
+    char *array_pointer = private_properties->array.char_pointer;
+
+    size_t result_size   = result->_private_properties.element_size;
+    char *result_pointer = result->_private_properties.array.char_pointer;
+
+    AA_WALK_FILLED_CELLS(private_properties->map, start_index, end_index, index,
+                         mapper(index, array_pointer + index * element_size,
+                                result_pointer + index * result_size, context));
 }
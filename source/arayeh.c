@@ -40,17 +40,18 @@
 #include "../include/fatal.h"
 #include "../include/functions.h"
 
-arayeh *Arayeh(size_t type, size_t initial_size)
+static arayeh *create_arayeh(size_t type, size_t element_size, size_t alignment,
+                             size_t initial_size)
 {
     /*
-     * This function will create an arayeh of type "type"
-     * (one the supported types defined in configuration.h)
-     * and size of "initial_size" if it's possible
-     * (you have enough memory and right to allocate that memory).
+     * This function will create an arayeh of type "type" with elements of
+     * "element_size" bytes aligned to "alignment" bytes.
      *
      * ARGUMENTS:
-     * initial_size  size of arayeh.
      * type          type of arayeh elements.
+     * element_size  size of an arayeh element in bytes.
+     * alignment     alignment of arayeh memory in bytes.
+     * initial_size  size of arayeh.
      *
      * RETURN:
      * A pointer to the initialized arayeh.
@@ -58,15 +59,18 @@ arayeh *Arayeh(size_t type, size_t initial_size)
      * return NULL in case of error.
      */
 
-    // check arayeh type.
-    if (type < AA_ARAYEH_TYPE_CHAR || AA_ARAYEH_TYPE_DOUBLE < type) {
-        // wrong arayeh type.
-        FATAL_WRONG_TYPE("Arayeh()", AA_ARAYEH_TRUE);
-    }
-
     // initialize a pointer and allocate memory.
     arayeh *self = (arayeh *) malloc(sizeof *self);
 
+    // start without an arena, string arayehs allocate it on the first add.
+    self->_private_properties.arena.bytes = NULL;
+    self->_private_properties.arena.used  = 0;
+    self->_private_properties.arena.size  = 0;
+
+    // private methods of generic arayehs depend on the element size.
+    self->_private_properties.element_size = element_size;
+    self->_private_properties.alignment    = alignment;
+
     // shorten names for god's sake.
     struct private_methods *private_methods       = &self->_private_methods;
     struct private_properties *private_properties = &self->_private_properties;
@@ -74,8 +78,11 @@ arayeh *Arayeh(size_t type, size_t initial_size)
     // assign public methods.
     set_public_methods(self);
 
-    // assign private methods based on arayeh type.
-    set_private_methods(self, type);
+    // boolean arayehs start packed.
+    size_t storage_type = (type == AA_ARAYEH_TYPE_BOOL) ? AA_ARAYEH_STORAGE_BIT : type;
+
+    // assign private methods based on arayeh storage type.
+    set_private_methods(self, storage_type);
 
     // initialize variables for allocating memory.
     char *map_pointer = NULL;
@@ -133,10 +140,18 @@ arayeh *Arayeh(size_t type, size_t initial_size)
     self->next               = 0;
     self->used               = 0;
     self->size               = initial_size;
-    private_properties->type = type;
-    private_properties->next = 0;
-    private_properties->used = 0;
-    private_properties->size = initial_size;
+    private_properties->type         = type;
+    private_properties->storage_type = storage_type;
+    private_properties->next         = 0;
+    private_properties->used         = 0;
+    private_properties->size         = initial_size;
+
+    // start without a hash index.
+    private_properties->hash_index = NULL;
+
+    // start with a closed gap.
+    private_properties->gap_start = 0;
+    private_properties->gap_end   = 0;
 
     // create arayeh default setting holder.
     arayeh_settings *default_settings =
@@ -146,6 +161,9 @@ arayeh *Arayeh(size_t type, size_t initial_size)
     default_settings->debug_messages = AA_ARAYEH_OFF;
     default_settings->extend_size    = AA_ARAYEH_ON;
     default_settings->method_size    = NULL;
+    default_settings->hash_index     = AA_ARAYEH_OFF;
+    default_settings->gap_buffer     = AA_ARAYEH_OFF;
+    default_settings->parallel       = AA_ARAYEH_OFF;
 
     // assign setting pointer to the arayeh private properties.
     private_properties->settings = default_settings;
@@ -164,5 +182,73 @@ arayeh *Arayeh(size_t type, size_t initial_size)
     // assign setting pointer to the arayeh private properties.
     private_properties->settings->method_size = method_size;
 
+    // resolve default settings.
+    resolve_policy(self);
+
     return self;
 }
+
+arayeh *Arayeh(size_t type, size_t initial_size)
+{
+    /*
+     * This function will create an arayeh of type "type"
+     * (one the supported types defined in configuration.h)
+     * and size of "initial_size" if it's possible
+     * (you have enough memory and right to allocate that memory).
+     *
+     * ARGUMENTS:
+     * initial_size  size of arayeh.
+     * type          type of arayeh elements.
+     *
+     * RETURN:
+     * A pointer to the initialized arayeh.
+     * or
+     * return NULL in case of error.
+     */
+
+    // check arayeh type, generic arayehs are created by ArayehGeneric().
+    if (type < AA_ARAYEH_TYPE_CHAR || AA_ARAYEH_TYPE_BOOL < type ||
+        type == AA_ARAYEH_TYPE_GENERIC) {
+        // wrong arayeh type.
+        FATAL_WRONG_TYPE("Arayeh()", AA_ARAYEH_TRUE);
+    }
+
+    size_t element_size = type_size(type);
+
+    return create_arayeh(type, element_size, element_size, initial_size);
+}
+
+arayeh *ArayehGeneric(size_t element_size, size_t alignment, size_t initial_size)
+{
+    /*
+     * This function will create an arayeh of type AA_ARAYEH_TYPE_GENERIC, its
+     * elements are "element_size" bytes, e.g. a struct, and arayeh memory is
+     * aligned to "alignment" bytes.
+     *
+     * ARGUMENTS:
+     * element_size  size of an arayeh element in bytes, e.g. sizeof(struct x).
+     * alignment     alignment of arayeh memory, e.g. _Alignof(struct x), a power
+     *               of 2 that divides "element_size", or 0 for the default
+     *               alignment of malloc().
+     * initial_size  size of arayeh.
+     *
+     * RETURN:
+     * A pointer to the initialized arayeh.
+     * or
+     * return NULL in case of error.
+     */
+
+    // default alignment.
+    if (alignment == 0) {
+        alignment = 1;
+    }
+
+    // check element type.
+    if (element_size == 0 || (alignment & (alignment - 1)) != 0 ||
+        element_size % alignment != 0) {
+        // wrong arayeh type.
+        FATAL_WRONG_TYPE("ArayehGeneric()", AA_ARAYEH_TRUE);
+    }
+
+    return create_arayeh(AA_ARAYEH_TYPE_GENERIC, element_size, alignment, initial_size);
+}
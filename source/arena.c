@@ -0,0 +1,370 @@
+/** source/arena.c
+ *
+ * This file is a part of:
+ * Azadeh Afzar - Arayehsaz (AA-A).
+ *
+ * Copyright (C) 2020 - 2021 Azadeh Afzar.
+ * Copyright (C) 2020 - 2021 Mohammad Mahdi Baghbani Pourvahid.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgement in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+
+#include "../include/arena.h"
+
+#include "../include/algorithms.h"
+#include "../include/fatal.h"
+
+#include <string.h>
+
+/* String arayehs keep their bytes in one arena, strings are appended at its
+ * end and cells hold their offset, so a string arayeh costs two allocations
+ * (cells and arena) however many strings it holds. bytes of deleted and
+ * overwritten strings are only dropped by arena_compact.
+ */
+
+int arena_reserve(arayeh *self, size_t bytes)
+{
+    /*
+     * This function makes room for "bytes" more bytes in the arena of arayeh,
+     * the arena grows at least by half of its size, so appending strings one by
+     * one reallocates it a logarithmic number of times.
+     *
+     * ARGUMENTS:
+     * self         pointer to the arayeh object.
+     * bytes        number of bytes to be appended.
+     *
+     * RETURN:
+     * state        a code that indicates successful operation
+     *              or an error code defined in arayeh.h .
+     *
+     */
+
+    // shorten names for god's sake.
+    struct arayeh_arena *arena = &self->_private_properties.arena;
+
+    // set debug flag.
+    int debug = self->_private_properties.policy.debug;
+
+    // enough room.
+    if (bytes <= arena->size - arena->used) {
+        return AA_ARAYEH_SUCCESS;
+    }
+
+    // check for size_t overflow.
+    if (bytes > SIZE_MAX - arena->used) {
+        WARN_T_OVERFLOW("arena_reserve()", debug);
+        return AA_ARAYEH_OVERFLOW;
+    }
+
+    size_t needed   = arena->used + bytes;
+    size_t new_size = arena->size + arena->size / 2;
+
+    if (new_size < needed || new_size < arena->size) {
+        new_size = needed;
+    }
+
+    char *new_bytes = (char *) realloc(arena->bytes, new_size);
+    if (new_bytes == NULL) {
+        WARN_REALLOC("arena_reserve()", debug);
+        return AA_ARAYEH_REALLOC_DENIED;
+    }
+
+    arena->bytes = new_bytes;
+    arena->size  = new_size;
+
+    // return success code.
+    return AA_ARAYEH_SUCCESS;
+}
+
+static int in_arena(const arayeh_string *string, uintptr_t base, size_t used)
+{
+    /*
+     * This function returns AA_ARAYEH_TRUE if the bytes of "string" are in the
+     * first "used" bytes of the arena at "base", e.g. a string from get method.
+     */
+
+    uintptr_t bytes = (uintptr_t) string->bytes;
+
+    return base != 0 && bytes >= base && bytes - base <= used &&
+           string->length <= used - (bytes - base);
+}
+
+size_t arena_new_bytes(arayeh *self, const arayeh_string *strings, size_t count)
+{
+    /*
+     * This function returns the number of bytes "count" strings need in the
+     * arena, strings that are already in the arena share their bytes.
+     *
+     * ARGUMENTS:
+     * self         pointer to the arayeh object.
+     * strings      pointer to the strings.
+     * count        number of strings.
+     *
+     * RETURN:
+     * number of bytes, SIZE_MAX if it doesn't fit in size_t.
+     *
+     */
+
+    // shorten names for god's sake.
+    struct arayeh_arena *arena = &self->_private_properties.arena;
+
+    size_t bytes = 0;
+
+    for (size_t index = 0; index < count; index++) {
+        if (in_arena(&strings[index], (uintptr_t) arena->bytes, arena->used)) {
+            continue;
+        }
+        if (strings[index].length > SIZE_MAX - bytes) {
+            return SIZE_MAX;
+        }
+        bytes += strings[index].length;
+    }
+
+    return bytes;
+}
+
+int arena_reserve_element(arayeh *self, const void *element)
+{
+    /*
+     * This function makes room for the string "element" if arayeh is a string
+     * arayeh, other arayehs have no arena.
+     *
+     * ARGUMENTS:
+     * self         pointer to the arayeh object.
+     * element      pointer to the element to be added.
+     *
+     * RETURN:
+     * state        a code that indicates successful operation
+     *              or an error code defined in arayeh.h .
+     *
+     */
+
+    if (self->_private_properties.type != AA_ARAYEH_TYPE_STRING) {
+        return AA_ARAYEH_SUCCESS;
+    }
+
+    return arena_reserve(self, arena_new_bytes(self, (const arayeh_string *) element, 1));
+}
+
+void arena_store(arayeh *self, size_t index, const arayeh_string *string,
+                 uintptr_t base, size_t used)
+{
+    /*
+     * This function stores "string" in the cell at "index", its bytes are
+     * appended to the arena unless they were in the arena before room was made
+     * for them, then the cell shares them. "base" and "used" are the arena
+     * before arena_reserve, the arena may have moved since then.
+     *
+     * ARGUMENTS:
+     * self         pointer to the arayeh object.
+     * index        index of the cell.
+     * string       pointer to the string.
+     * base         address of arena bytes before the reservation.
+     * used         number of arena bytes written before the reservation.
+     *
+     * RETURN:
+     * no return, it's void dude.
+     *
+     */
+
+    // shorten names for god's sake.
+    struct arayeh_arena *arena = &self->_private_properties.arena;
+    arayeh_string_cell *cell   = &self->_private_properties.array.string_pointer[index];
+
+    cell->length = string->length;
+
+    // share bytes that are already in the arena.
+    if (in_arena(string, base, used)) {
+        cell->offset = (size_t) ((uintptr_t) string->bytes - base);
+        return;
+    }
+
+    if (string->length != 0) {
+        memcpy(arena->bytes + arena->used, string->bytes, string->length);
+    }
+    cell->offset = arena->used;
+    arena->used += string->length;
+}
+
+static int compare_offsets(const void *first, const void *second)
+{
+    /*
+     * This function orders pointers to string cells by their offset, it's the
+     * comparison function of qsort.
+     *
+     * ARGUMENTS:
+     * first        pointer to the first cell pointer.
+     * second       pointer to the second cell pointer.
+     *
+     * RETURN:
+     * -1, 0 or 1 if offset of first is less, equal or greater than second.
+     *
+     */
+
+    size_t first_offset  = (*(arayeh_string_cell *const *) first)->offset;
+    size_t second_offset = (*(arayeh_string_cell *const *) second)->offset;
+
+    return (first_offset > second_offset) - (first_offset < second_offset);
+}
+
+int arena_compact(arayeh *self)
+{
+    /*
+     * This function copies the bytes of filled cells into a new arena in order of
+     * their offset and frees the old one. overlapping bytes are copied once and
+     * cells that shared them keep sharing, so the new arena is never larger than
+     * the bytes used in the old one.
+     *
+     * ARGUMENTS:
+     * self         pointer to the arayeh object.
+     *
+     * RETURN:
+     * state        a code that indicates successful operation
+     *              or an error code defined in arayeh.h .
+     *
+     */
+
+    // shorten names for god's sake.
+    struct private_properties *private_properties = &self->_private_properties;
+    struct arayeh_arena *arena                    = &private_properties->arena;
+
+    // set debug flag.
+    int debug = private_properties->policy.debug;
+
+    size_t size               = private_properties->size;
+    arayeh_string_cell *cells = private_properties->array.string_pointer;
+
+    arayeh_string_cell **order = NULL;
+    if (private_properties->used != 0) {
+        order = (arayeh_string_cell **) malloc(private_properties->used * sizeof(*order));
+        if (order == NULL) {
+            WARN_MALLOC("arena_compact()", debug);
+            return AA_ARAYEH_REALLOC_DENIED;
+        }
+    }
+
+    // filled cells that have bytes, in order of their offset.
+    size_t count = 0;
+    for (size_t block = 0; block < size; block += 64) {
+        size_t length = (size - block < 64) ? size - block : 64;
+        uint64_t mask = map_block_mask(private_properties->map, block, length);
+
+        while (mask != 0) {
+            arayeh_string_cell *cell = &cells[block + count_trailing_zeros(mask)];
+            mask &= mask - 1;
+
+            if (cell->length == 0) {
+                cell->offset = 0;
+            } else {
+                order[count++] = cell;
+            }
+        }
+    }
+    if (count > 1) {
+        qsort(order, count, sizeof(*order), compare_offsets);
+    }
+
+    // bytes of filled cells, overlapping bytes counted once.
+    size_t live = 0;
+    size_t end  = 0;
+    for (size_t index = 0; index < count; index++) {
+        size_t start = order[index]->offset;
+        size_t stop  = start + order[index]->length;
+
+        if (stop > end) {
+            live += stop - (start > end ? start : end);
+            end = stop;
+        }
+    }
+
+    char *new_bytes = NULL;
+    if (live != 0) {
+        new_bytes = (char *) malloc(live);
+        if (new_bytes == NULL) {
+            free(order);
+            WARN_MALLOC("arena_compact()", debug);
+            return AA_ARAYEH_REALLOC_DENIED;
+        }
+    }
+
+    // copy each run of overlapping strings once and move their offsets into it.
+    size_t used      = 0;
+    size_t run_start = 0;
+    size_t run_end   = 0;
+    size_t run_used  = 0;
+    for (size_t index = 0; index < count; index++) {
+        arayeh_string_cell *cell = order[index];
+        size_t start             = cell->offset;
+        size_t stop              = start + cell->length;
+
+        if (index == 0 || start >= run_end) {
+            run_start = start;
+            run_end   = start;
+            run_used  = used;
+        }
+        if (stop > run_end) {
+            memcpy(new_bytes + used, arena->bytes + run_end, stop - run_end);
+            used += stop - run_end;
+            run_end = stop;
+        }
+        cell->offset = run_used + (start - run_start);
+    }
+
+    free(order);
+    free(arena->bytes);
+    arena->bytes = new_bytes;
+    arena->used  = used;
+    arena->size  = live;
+
+    // return success code.
+    return AA_ARAYEH_SUCCESS;
+}
+
+void arena_free(arayeh *self)
+{
+    /*
+     * This function frees the arena of arayeh.
+     *
+     * ARGUMENTS:
+     * self         pointer to the arayeh object.
+     *
+     * RETURN:
+     * no return, it's void dude.
+     *
+     */
+
+    // shorten names for god's sake.
+    struct arayeh_arena *arena = &self->_private_properties.arena;
+
+    free(arena->bytes);
+    arena->bytes = NULL;
+    arena->used  = 0;
+    arena->size  = 0;
+}
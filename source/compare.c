@@ -0,0 +1,238 @@
+/** source/compare.c
+ *
+ * This file is a part of:
+ * Azadeh Afzar - Arayehsaz (AA-A).
+ *
+ * Copyright (C) 2020 - 2021 Azadeh Afzar.
+ * Copyright (C) 2020 - 2021 Mohammad Mahdi Baghbani Pourvahid.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgement in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+
+#include "../include/compare.h"
+
+#include "../include/convert.h"
+
+#if defined(__SSE2__)
+#    include <immintrin.h>
+#endif
+
+/* A comparison is done in two branch free steps: a loop per type and operation
+ * writes one byte per cell (0 or 1), simple enough for compilers to vectorize,
+ * then the bytes are packed into a bitmask with a movemask instruction.
+ *
+ * half precision cells are compared as floats, NaN never satisfies a comparison.
+ */
+
+#define AA_COMPARE_CELLS(name, type)                                                    \
+    static void compare_##name(unsigned char *hits, const void *cells, size_t length,   \
+                               int operation, const void *value, const void *upper)     \
+    {                                                                                   \
+        const type *values = (const type *) cells;                                      \
+        type low           = *((const type *) value);                                   \
+                                                                                        \
+        switch (operation) {                                                            \
+        case AA_ARAYEH_LESS:                                                            \
+            for (size_t index = 0; index < length; index++) {                           \
+                hits[index] = (unsigned char) (values[index] < low);                    \
+            }                                                                           \
+            break;                                                                      \
+        case AA_ARAYEH_LESS_EQUAL:                                                      \
+            for (size_t index = 0; index < length; index++) {                           \
+                hits[index] = (unsigned char) (values[index] <= low);                   \
+            }                                                                           \
+            break;                                                                      \
+        case AA_ARAYEH_EQUAL:                                                           \
+            for (size_t index = 0; index < length; index++) {                           \
+                hits[index] = (unsigned char) (values[index] == low);                   \
+            }                                                                           \
+            break;                                                                      \
+        case AA_ARAYEH_GREATER_EQUAL:                                                   \
+            for (size_t index = 0; index < length; index++) {                           \
+                hits[index] = (unsigned char) (values[index] >= low);                   \
+            }                                                                           \
+            break;                                                                      \
+        case AA_ARAYEH_GREATER:                                                         \
+            for (size_t index = 0; index < length; index++) {                           \
+                hits[index] = (unsigned char) (values[index] > low);                    \
+            }                                                                           \
+            break;                                                                      \
+        default: {                                                                      \
+            type high = *((const type *) upper);                                        \
+            for (size_t index = 0; index < length; index++) {                           \
+                hits[index] =                                                           \
+                    (unsigned char) ((values[index] >= low) & (values[index] <= high)); \
+            }                                                                           \
+        }                                                                               \
+        }                                                                               \
+    }
+
+AA_COMPARE_CELLS(char, char)
+AA_COMPARE_CELLS(short_int, short int)
+AA_COMPARE_CELLS(int, int)
+AA_COMPARE_CELLS(long_int, long int)
+AA_COMPARE_CELLS(float, float)
+AA_COMPARE_CELLS(double, double)
+AA_COMPARE_CELLS(int8, int8_t)
+AA_COMPARE_CELLS(int16, int16_t)
+AA_COMPARE_CELLS(int32, int32_t)
+AA_COMPARE_CELLS(int64, int64_t)
+AA_COMPARE_CELLS(uint8, uint8_t)
+AA_COMPARE_CELLS(uint16, uint16_t)
+AA_COMPARE_CELLS(uint32, uint32_t)
+AA_COMPARE_CELLS(uint64, uint64_t)
+
+static uint64_t pack_hits(const unsigned char *hits, size_t length)
+{
+    /*
+     * This function packs "length" (at most 64) bytes of 0 or 1 into a bitmask.
+     */
+
+    uint64_t mask = 0;
+    size_t offset = 0;
+
+    // move bit 0 of every byte to its sign bit, which movemask collects.
+#if defined(__AVX2__)
+    for (; offset + 32 <= length; offset += 32) {
+        __m256i bytes = _mm256_loadu_si256((const __m256i *) (hits + offset));
+        uint32_t bits = (uint32_t) _mm256_movemask_epi8(_mm256_slli_epi16(bytes, 7));
+        mask |= (uint64_t) bits << offset;
+    }
+#endif
+#if defined(__SSE2__)
+    for (; offset + 16 <= length; offset += 16) {
+        __m128i bytes = _mm_loadu_si128((const __m128i *) (hits + offset));
+        uint32_t bits = (uint32_t) _mm_movemask_epi8(_mm_slli_epi16(bytes, 7));
+        mask |= (uint64_t) bits << offset;
+    }
+#endif
+
+    for (; offset < length; offset++) {
+        mask |= (uint64_t) hits[offset] << offset;
+    }
+
+    return mask;
+}
+
+int is_compare_operation(int operation)
+{
+    /*
+     * This function returns AA_ARAYEH_TRUE if "operation" is an operation of
+     * compare method.
+     *
+     * ARGUMENTS:
+     * operation    AA_ARAYEH_LESS, LESS_EQUAL, EQUAL, GREATER_EQUAL, GREATER
+     *              or BETWEEN.
+     *
+     * RETURN:
+     * AA_ARAYEH_TRUE or AA_ARAYEH_FALSE.
+     *
+     */
+
+    return operation >= AA_ARAYEH_LESS && operation <= AA_ARAYEH_BETWEEN;
+}
+
+uint64_t compare_block(const void *cells, size_t type, size_t length, int operation,
+                       const void *value, const void *upper)
+{
+    /*
+     * This function compares "length" (at most 64) cells with "value" and
+     * returns a bitmask of the cells that satisfy "operation".
+     *
+     * ARGUMENTS:
+     * cells        pointer to the first cell of the block.
+     * type         numeric type of cells.
+     * length       number of cells in the block, at most 64.
+     * operation    an operation of compare method.
+     * value        pointer to an element of "type", lower bound of between.
+     * upper        pointer to an element of "type", upper bound of between,
+     *              not used by other operations.
+     *
+     * RETURN:
+     * mask         bitmask of cells that satisfy the comparison.
+     *
+     */
+
+    unsigned char hits[64];
+
+    switch (type) {
+    case AA_ARAYEH_TYPE_CHAR:
+        compare_char(hits, cells, length, operation, value, upper);
+        break;
+    case AA_ARAYEH_TYPE_SINT:
+        compare_short_int(hits, cells, length, operation, value, upper);
+        break;
+    case AA_ARAYEH_TYPE_INT:
+        compare_int(hits, cells, length, operation, value, upper);
+        break;
+    case AA_ARAYEH_TYPE_LINT:
+        compare_long_int(hits, cells, length, operation, value, upper);
+        break;
+    case AA_ARAYEH_TYPE_FLOAT:
+        compare_float(hits, cells, length, operation, value, upper);
+        break;
+    case AA_ARAYEH_TYPE_DOUBLE:
+        compare_double(hits, cells, length, operation, value, upper);
+        break;
+    case AA_ARAYEH_TYPE_INT8:
+        compare_int8(hits, cells, length, operation, value, upper);
+        break;
+    case AA_ARAYEH_TYPE_INT16:
+        compare_int16(hits, cells, length, operation, value, upper);
+        break;
+    case AA_ARAYEH_TYPE_INT32:
+        compare_int32(hits, cells, length, operation, value, upper);
+        break;
+    case AA_ARAYEH_TYPE_INT64:
+        compare_int64(hits, cells, length, operation, value, upper);
+        break;
+    case AA_ARAYEH_TYPE_UINT8:
+        compare_uint8(hits, cells, length, operation, value, upper);
+        break;
+    case AA_ARAYEH_TYPE_UINT16:
+        compare_uint16(hits, cells, length, operation, value, upper);
+        break;
+    case AA_ARAYEH_TYPE_UINT32:
+        compare_uint32(hits, cells, length, operation, value, upper);
+        break;
+    case AA_ARAYEH_TYPE_UINT64:
+        compare_uint64(hits, cells, length, operation, value, upper);
+        break;
+    default: {
+        // half precision cells are widened, their elements are already floats.
+        float floats[64];
+        convert_values(floats, AA_ARAYEH_TYPE_FLOAT, cells, type, length,
+                       AA_ARAYEH_CONVERT_WRAP);
+        compare_float(hits, floats, length, operation, value, upper);
+    }
+    }
+
+    return pack_hits(hits, length);
+}
@@ -0,0 +1,1447 @@
+/** source/convert.c
+ *
+ * This file is a part of:
+ * Azadeh Afzar - Arayehsaz (AA-A).
+ *
+ * Copyright (C) 2020 - 2021 Azadeh Afzar.
+ * Copyright (C) 2020 - 2021 Mohammad Mahdi Baghbani Pourvahid.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgement in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "../include/convert.h"
+
+#include "../include/algorithms.h"
+#include "../include/arayeh_typed.h"
+#include "../include/functions.h"
+#include "../include/hash.h"
+#include "../include/types.h"
+
+#include <float.h>
+#include <limits.h>
+#include <math.h>
+#include <string.h>
+
+#if defined(__SSE2__)
+#    include <immintrin.h>
+#endif
+
+/* Integers are converted through their two's complement bits in an uint64_t,
+ * values of signed types are sign extended, so a value keeps its meaning in
+ * every type it fits in and out of range values are truncated.
+ */
+
+static uint64_t load_integer(const void *cell, size_t size, int is_signed)
+{
+    /*
+     * This function loads an integer of "size" bytes as an uint64_t.
+     */
+
+    switch (size) {
+    case 1: {
+        uint8_t value;
+        memcpy(&value, cell, 1);
+        return is_signed ? (uint64_t) (int64_t) (int8_t) value : value;
+    }
+    case 2: {
+        uint16_t value;
+        memcpy(&value, cell, 2);
+        return is_signed ? (uint64_t) (int64_t) (int16_t) value : value;
+    }
+    case 4: {
+        uint32_t value;
+        memcpy(&value, cell, 4);
+        return is_signed ? (uint64_t) (int64_t) (int32_t) value : value;
+    }
+    default: {
+        uint64_t value;
+        memcpy(&value, cell, 8);
+        return value;
+    }
+    }
+}
+
+static void store_integer(void *cell, size_t size, uint64_t value)
+{
+    /*
+     * This function stores the low "size" bytes of "value".
+     */
+
+    switch (size) {
+    case 1: {
+        uint8_t narrow = (uint8_t) value;
+        memcpy(cell, &narrow, 1);
+        break;
+    }
+    case 2: {
+        uint16_t narrow = (uint16_t) value;
+        memcpy(cell, &narrow, 2);
+        break;
+    }
+    case 4: {
+        uint32_t narrow = (uint32_t) value;
+        memcpy(cell, &narrow, 4);
+        break;
+    }
+    default:
+        memcpy(cell, &value, 8);
+    }
+}
+
+int is_integer_type(size_t type)
+{
+    /*
+     * This function returns AA_ARAYEH_TRUE if "type" is an integer arayeh type.
+     *
+     * ARGUMENTS:
+     * type         type of arayeh elements.
+     *
+     * RETURN:
+     * AA_ARAYEH_TRUE or AA_ARAYEH_FALSE.
+     *
+     */
+
+    switch (type) {
+    case AA_ARAYEH_TYPE_CHAR:
+    case AA_ARAYEH_TYPE_SINT:
+    case AA_ARAYEH_TYPE_INT:
+    case AA_ARAYEH_TYPE_LINT:
+    case AA_ARAYEH_TYPE_INT8:
+    case AA_ARAYEH_TYPE_INT16:
+    case AA_ARAYEH_TYPE_INT32:
+    case AA_ARAYEH_TYPE_INT64:
+    case AA_ARAYEH_TYPE_UINT8:
+    case AA_ARAYEH_TYPE_UINT16:
+    case AA_ARAYEH_TYPE_UINT32:
+    case AA_ARAYEH_TYPE_UINT64:
+        return AA_ARAYEH_TRUE;
+    default:
+        return AA_ARAYEH_FALSE;
+    }
+}
+
+int is_numeric_type(size_t type)
+{
+    /*
+     * This function returns AA_ARAYEH_TRUE if "type" is a numeric arayeh type,
+     * every type except generic arayehs.
+     *
+     * ARGUMENTS:
+     * type         type of arayeh elements.
+     *
+     * RETURN:
+     * AA_ARAYEH_TRUE or AA_ARAYEH_FALSE.
+     *
+     */
+
+    return is_integer_type(type) || is_half_type(type) || type == AA_ARAYEH_TYPE_FLOAT ||
+           type == AA_ARAYEH_TYPE_DOUBLE;
+}
+
+int is_half_type(size_t type)
+{
+    /*
+     * This function returns AA_ARAYEH_TRUE if "type" is a half precision arayeh
+     * type, float16 or bfloat16.
+     *
+     * ARGUMENTS:
+     * type         type of arayeh elements.
+     *
+     * RETURN:
+     * AA_ARAYEH_TRUE or AA_ARAYEH_FALSE.
+     *
+     */
+
+    return type == AA_ARAYEH_TYPE_FLOAT16 || type == AA_ARAYEH_TYPE_BFLOAT16;
+}
+
+int is_signed_type(size_t type)
+{
+    /*
+     * This function returns AA_ARAYEH_TRUE if "type" is a signed arayeh type,
+     * char is signed if the compiler makes it signed.
+     *
+     * ARGUMENTS:
+     * type         type of arayeh elements.
+     *
+     * RETURN:
+     * AA_ARAYEH_TRUE or AA_ARAYEH_FALSE.
+     *
+     */
+
+    switch (type) {
+    case AA_ARAYEH_TYPE_CHAR:
+        return CHAR_MIN < 0 ? AA_ARAYEH_TRUE : AA_ARAYEH_FALSE;
+    case AA_ARAYEH_TYPE_UINT8:
+    case AA_ARAYEH_TYPE_UINT16:
+    case AA_ARAYEH_TYPE_UINT32:
+    case AA_ARAYEH_TYPE_UINT64:
+    case AA_ARAYEH_TYPE_GENERIC:
+        return AA_ARAYEH_FALSE;
+    default:
+        return AA_ARAYEH_TRUE;
+    }
+}
+
+int integer_fits(const void *element, size_t type, size_t target_type)
+{
+    /*
+     * This function returns AA_ARAYEH_TRUE if the integer "element" of "type" can
+     * be stored in "target_type" without changing its value.
+     *
+     * ARGUMENTS:
+     * element      pointer to the integer.
+     * type         integer type of element.
+     * target_type  integer type to store element in.
+     *
+     * RETURN:
+     * AA_ARAYEH_TRUE or AA_ARAYEH_FALSE.
+     *
+     */
+
+    size_t target_bits = 8 * type_size(target_type);
+    int target_signed  = is_signed_type(target_type);
+    uint64_t value     = load_integer(element, type_size(type), is_signed_type(type));
+
+    // negative values fit only in signed types.
+    if (is_signed_type(type) && (int64_t) value < 0) {
+        if (target_signed == AA_ARAYEH_FALSE) {
+            return AA_ARAYEH_FALSE;
+        }
+
+        return target_bits == 64 ||
+               (int64_t) value >= -((int64_t) 1 << (target_bits - 1));
+    }
+
+    uint64_t max = UINT64_MAX >> (64 - target_bits + (target_signed ? 1 : 0));
+
+    return value <= max;
+}
+
+void convert_integers(void *destination, size_t destination_type, const void *source,
+                      size_t source_type, size_t count)
+{
+    /*
+     * This function converts "count" integers of "source_type" into
+     * "destination_type", values that don't fit are truncated.
+     *
+     * source and destination may be the same memory, narrowing conversions go
+     * forward and widening conversions go backward, so every integer is read
+     * before it's overwritten.
+     *
+     * ARGUMENTS:
+     * destination      pointer to the converted integers.
+     * destination_type integer type of converted integers.
+     * source           pointer to the integers.
+     * source_type      integer type of integers.
+     * count            number of integers.
+     *
+     * RETURN:
+     * no return, it's void dude.
+     *
+     */
+
+    char *destination_pointer = (char *) destination;
+    const char *source_pointer = (const char *) source;
+
+    size_t destination_size = type_size(destination_type);
+    size_t source_size      = type_size(source_type);
+    int is_signed           = is_signed_type(source_type);
+
+    if (destination_size <= source_size) {
+        for (size_t index = 0; index < count; index++) {
+            const char *cell = source_pointer + index * source_size;
+            uint64_t value   = load_integer(cell, source_size, is_signed);
+
+            store_integer(destination_pointer + index * destination_size,
+                          destination_size, value);
+        }
+    } else {
+        for (size_t index = count; index-- > 0;) {
+            const char *cell = source_pointer + index * source_size;
+            uint64_t value   = load_integer(cell, source_size, is_signed);
+
+            store_integer(destination_pointer + index * destination_size,
+                          destination_size, value);
+        }
+    }
+}
+
+size_t narrowest_type(arayeh *self)
+{
+    /*
+     * This function returns the narrowest fixed-width integer type that holds all
+     * filled cells of an integer arayeh, unsigned types are preferred if there is
+     * no negative value.
+     *
+     * ARGUMENTS:
+     * self         pointer to the arayeh object.
+     *
+     * RETURN:
+     * one of the fixed-width integer types.
+     *
+     */
+
+    // shorten names for god's sake.
+    struct private_properties *private_properties = &self->_private_properties;
+
+    static const size_t signed_types[]   = {AA_ARAYEH_TYPE_INT8, AA_ARAYEH_TYPE_INT16,
+                                            AA_ARAYEH_TYPE_INT32, AA_ARAYEH_TYPE_INT64};
+    static const size_t unsigned_types[] = {AA_ARAYEH_TYPE_UINT8, AA_ARAYEH_TYPE_UINT16,
+                                            AA_ARAYEH_TYPE_UINT32, AA_ARAYEH_TYPE_UINT64};
+
+    size_t element_size = private_properties->element_size;
+    size_t size         = private_properties->size;
+    int is_signed       = is_signed_type(private_properties->storage_type);
+    char *array_pointer = private_properties->array.char_pointer;
+
+    // smallest negative value and biggest non negative value.
+    int64_t min  = 0;
+    uint64_t max = 0;
+
+    for (size_t block = 0; block < size; block += 64) {
+        size_t length = (size - block < 64) ? size - block : 64;
+        uint64_t mask = map_block_mask(private_properties->map, block, length);
+
+        while (mask != 0) {
+            size_t index = block + count_trailing_zeros(mask);
+            mask &= mask - 1;
+
+            char *cell     = array_pointer + index * element_size;
+            uint64_t value = load_integer(cell, element_size, is_signed);
+
+            if (is_signed && (int64_t) value < 0) {
+                min = ((int64_t) value < min) ? (int64_t) value : min;
+            } else {
+                max = (value > max) ? value : max;
+            }
+        }
+    }
+
+    for (size_t width = 0; width < 3; width++) {
+        size_t bits = (size_t) 8 << width;
+
+        if (min == 0 && max <= UINT64_MAX >> (64 - bits)) {
+            return unsigned_types[width];
+        }
+        if (min >= -((int64_t) 1 << (bits - 1)) && max <= UINT64_MAX >> (65 - bits)) {
+            return signed_types[width];
+        }
+    }
+
+    return (min == 0) ? unsigned_types[3] : signed_types[3];
+}
+
+/* Values of any numeric type are converted in blocks of CONVERT_BLOCK cells,
+ * a block is loaded into a stack buffer of uint64_t integers or doubles and
+ * stored from there into the new type, so both loops work on one type and
+ * compilers vectorize them. the hot pairs int32 -> double and float -> double
+ * have SSE2/AVX kernels.
+ *
+ * the block is read completely before it's stored, so source and destination
+ * may be the same memory if blocks are converted forward when narrowing and
+ * backward when widening.
+ */
+
+// number of cells converted at once, a block of arayeh map.
+#define CONVERT_BLOCK 64
+
+// kinds of loaded values.
+#define KIND_SIGNED   0
+#define KIND_UNSIGNED 1
+#define KIND_REAL     2
+
+// a loaded block, integers as their two's complement bits.
+typedef union {
+    uint64_t integers[CONVERT_BLOCK];
+    double reals[CONVERT_BLOCK];
+} wide_block;
+
+#define AA_LOAD_INTEGERS(name, type)                                                    \
+    static void load_integers_##name(wide_block *wide, const void *cells, size_t length) \
+    {                                                                                   \
+        const type *values = (const type *) cells;                                      \
+        for (size_t index = 0; index < length; index++) {                               \
+            wide->integers[index] = (uint64_t) values[index];                           \
+        }                                                                               \
+    }
+
+#define AA_LOAD_REALS(name, type)                                                       \
+    static void load_reals_##name(wide_block *wide, const void *cells, size_t length)    \
+    {                                                                                   \
+        const type *values = (const type *) cells;                                      \
+        for (size_t index = 0; index < length; index++) {                               \
+            wide->reals[index] = (double) values[index];                                \
+        }                                                                               \
+    }
+
+AA_LOAD_INTEGERS(char, char)
+AA_LOAD_INTEGERS(short_int, short int)
+AA_LOAD_INTEGERS(int, int)
+AA_LOAD_INTEGERS(long_int, long int)
+AA_LOAD_INTEGERS(int8, int8_t)
+AA_LOAD_INTEGERS(int16, int16_t)
+AA_LOAD_INTEGERS(int32, int32_t)
+AA_LOAD_INTEGERS(int64, int64_t)
+AA_LOAD_INTEGERS(uint8, uint8_t)
+AA_LOAD_INTEGERS(uint16, uint16_t)
+AA_LOAD_INTEGERS(uint32, uint32_t)
+AA_LOAD_INTEGERS(uint64, uint64_t)
+
+AA_LOAD_REALS(char, char)
+AA_LOAD_REALS(short_int, short int)
+AA_LOAD_REALS(int8, int8_t)
+AA_LOAD_REALS(int16, int16_t)
+AA_LOAD_REALS(uint8, uint8_t)
+AA_LOAD_REALS(uint16, uint16_t)
+AA_LOAD_REALS(uint32, uint32_t)
+AA_LOAD_REALS(double, double)
+
+static void load_reals_int32(wide_block *wide, const void *cells, size_t length)
+{
+    const int32_t *values = (const int32_t *) cells;
+    size_t index          = 0;
+
+#if defined(__AVX__)
+    for (; index + 4 <= length; index += 4) {
+        __m128i block = _mm_loadu_si128((const __m128i *) (values + index));
+        _mm256_storeu_pd(wide->reals + index, _mm256_cvtepi32_pd(block));
+    }
+#endif
+#if defined(__SSE2__)
+    for (; index + 2 <= length; index += 2) {
+        __m128i block = _mm_loadl_epi64((const __m128i *) (values + index));
+        _mm_storeu_pd(wide->reals + index, _mm_cvtepi32_pd(block));
+    }
+#endif
+
+    for (; index < length; index++) {
+        wide->reals[index] = (double) values[index];
+    }
+}
+
+static void load_reals_float(wide_block *wide, const void *cells, size_t length)
+{
+    const float *values = (const float *) cells;
+    size_t index        = 0;
+
+#if defined(__AVX__)
+    for (; index + 4 <= length; index += 4) {
+        __m128 block = _mm_loadu_ps(values + index);
+        _mm256_storeu_pd(wide->reals + index, _mm256_cvtps_pd(block));
+    }
+#endif
+#if defined(__SSE2__)
+    for (; index + 2 <= length; index += 2) {
+        __m128i bits = _mm_loadl_epi64((const __m128i *) (values + index));
+        __m128 block = _mm_castsi128_ps(bits);
+        _mm_storeu_pd(wide->reals + index, _mm_cvtps_pd(block));
+    }
+#endif
+
+    for (; index < length; index++) {
+        wide->reals[index] = (double) values[index];
+    }
+}
+
+static int load_block(wide_block *wide, const void *cells, size_t type, size_t length,
+                      int as_reals)
+{
+    /*
+     * This function loads "length" cells of "type" into "wide" and returns the
+     * kind of loaded values, if "as_reals" is true integers of up to 32 bits
+     * are loaded as doubles, they are exact in a double.
+     */
+
+    switch (type) {
+    case AA_ARAYEH_TYPE_FLOAT:
+        load_reals_float(wide, cells, length);
+        return KIND_REAL;
+    case AA_ARAYEH_TYPE_DOUBLE:
+        load_reals_double(wide, cells, length);
+        return KIND_REAL;
+    default:
+        break;
+    }
+
+    if (as_reals) {
+        switch (type) {
+        case AA_ARAYEH_TYPE_CHAR:
+            load_reals_char(wide, cells, length);
+            return KIND_REAL;
+        case AA_ARAYEH_TYPE_SINT:
+            load_reals_short_int(wide, cells, length);
+            return KIND_REAL;
+        case AA_ARAYEH_TYPE_INT8:
+            load_reals_int8(wide, cells, length);
+            return KIND_REAL;
+        case AA_ARAYEH_TYPE_INT16:
+            load_reals_int16(wide, cells, length);
+            return KIND_REAL;
+        case AA_ARAYEH_TYPE_UINT8:
+            load_reals_uint8(wide, cells, length);
+            return KIND_REAL;
+        case AA_ARAYEH_TYPE_UINT16:
+            load_reals_uint16(wide, cells, length);
+            return KIND_REAL;
+        case AA_ARAYEH_TYPE_UINT32:
+            load_reals_uint32(wide, cells, length);
+            return KIND_REAL;
+        case AA_ARAYEH_TYPE_INT32:
+            load_reals_int32(wide, cells, length);
+            return KIND_REAL;
+        case AA_ARAYEH_TYPE_INT:
+            if (sizeof(int) == sizeof(int32_t)) {
+                load_reals_int32(wide, cells, length);
+                return KIND_REAL;
+            }
+            break;
+        default:
+            break;
+        }
+    }
+
+    switch (type) {
+    case AA_ARAYEH_TYPE_CHAR:
+        load_integers_char(wide, cells, length);
+        break;
+    case AA_ARAYEH_TYPE_SINT:
+        load_integers_short_int(wide, cells, length);
+        break;
+    case AA_ARAYEH_TYPE_INT:
+        load_integers_int(wide, cells, length);
+        break;
+    case AA_ARAYEH_TYPE_LINT:
+        load_integers_long_int(wide, cells, length);
+        break;
+    case AA_ARAYEH_TYPE_INT8:
+        load_integers_int8(wide, cells, length);
+        break;
+    case AA_ARAYEH_TYPE_INT16:
+        load_integers_int16(wide, cells, length);
+        break;
+    case AA_ARAYEH_TYPE_INT32:
+        load_integers_int32(wide, cells, length);
+        break;
+    case AA_ARAYEH_TYPE_INT64:
+        load_integers_int64(wide, cells, length);
+        break;
+    case AA_ARAYEH_TYPE_UINT8:
+        load_integers_uint8(wide, cells, length);
+        break;
+    case AA_ARAYEH_TYPE_UINT16:
+        load_integers_uint16(wide, cells, length);
+        break;
+    case AA_ARAYEH_TYPE_UINT32:
+        load_integers_uint32(wide, cells, length);
+        break;
+    default:
+        load_integers_uint64(wide, cells, length);
+        break;
+    }
+
+    return is_signed_type(type) ? KIND_SIGNED : KIND_UNSIGNED;
+}
+
+static void round_block(wide_block *wide, size_t length, int mode)
+{
+    /*
+     * This function rounds loaded doubles to integers by the rounding mode.
+     *
+     * doubles from 2^52 up are integers, smaller magnitudes are rounded to the
+     * nearest integer (ties to even) by adding and subtracting 2^52, unlike
+     * calls to nearbyint() and trunc() the loop is vectorized.
+     */
+
+    const double integral = 4503599627370496.0;
+    int truncate          = (mode & AA_ARAYEH_ROUND_NEAREST) == 0;
+
+    for (size_t index = 0; index < length; index++) {
+        double real      = wide->reals[index];
+        double magnitude = fabs(real);
+        double rounded   = (magnitude + integral) - integral;
+
+        if (truncate && rounded > magnitude) {
+            rounded -= 1.0;
+        }
+
+        wide->reals[index] = (magnitude < integral) ? copysign(rounded, real) : real;
+    }
+}
+
+/* Store functions write a loaded block into cells and return a mask of the
+ * values that don't fit in the cell type, out of range values are clamped to
+ * the range of the type (NaN becomes 0) or, if "wrap" is true, integers keep
+ * their low bits and doubles become infinity in a float.
+ */
+
+#define AA_STORE_INTEGERS(name, type, low, high)                                        \
+    static uint64_t store_##name(void *cells, const wide_block *wide, int kind,          \
+                                 size_t length, int wrap)                               \
+    {                                                                                   \
+        type *values      = (type *) cells;                                             \
+        uint64_t overflow = 0;                                                          \
+                                                                                        \
+        if (kind == KIND_REAL) {                                                        \
+            for (size_t index = 0; index < length; index++) {                           \
+                double real = wide->reals[index];                                       \
+                int below   = !(real >= (double) (low));                                \
+                int above   = real >= (double) (high) + 1.0;                            \
+                                                                                        \
+                overflow |= (uint64_t) (below | above) << index;                        \
+                values[index] = below   ? ((real != real) ? 0 : (low))                  \
+                                : above ? (high)                                        \
+                                        : (type) real;                                  \
+            }                                                                           \
+        } else {                                                                        \
+            for (size_t index = 0; index < length; index++) {                           \
+                uint64_t bits = wide->integers[index];                                  \
+                int negative  = kind == KIND_SIGNED && (int64_t) bits < 0;              \
+                int below     = negative && (int64_t) bits < (int64_t) (low);           \
+                int above     = !negative && bits > (uint64_t) (high);                  \
+                                                                                        \
+                overflow |= (uint64_t) (below | above) << index;                        \
+                values[index] = (wrap || !(below | above)) ? (type) bits                \
+                                : below                    ? (low)                      \
+                                                           : (high);                    \
+            }                                                                           \
+        }                                                                               \
+                                                                                        \
+        return overflow;                                                                \
+    }
+
+AA_STORE_INTEGERS(char, char, CHAR_MIN, CHAR_MAX)
+AA_STORE_INTEGERS(short_int, short int, SHRT_MIN, SHRT_MAX)
+AA_STORE_INTEGERS(int, int, INT_MIN, INT_MAX)
+AA_STORE_INTEGERS(long_int, long int, LONG_MIN, LONG_MAX)
+AA_STORE_INTEGERS(int8, int8_t, INT8_MIN, INT8_MAX)
+AA_STORE_INTEGERS(int16, int16_t, INT16_MIN, INT16_MAX)
+AA_STORE_INTEGERS(int32, int32_t, INT32_MIN, INT32_MAX)
+AA_STORE_INTEGERS(int64, int64_t, INT64_MIN, INT64_MAX)
+AA_STORE_INTEGERS(uint8, uint8_t, 0, UINT8_MAX)
+AA_STORE_INTEGERS(uint16, uint16_t, 0, UINT16_MAX)
+AA_STORE_INTEGERS(uint32, uint32_t, 0, UINT32_MAX)
+AA_STORE_INTEGERS(uint64, uint64_t, 0, UINT64_MAX)
+
+static uint64_t store_float(void *cells, const wide_block *wide, int kind, size_t length,
+                            int wrap)
+{
+    float *values     = (float *) cells;
+    uint64_t overflow = 0;
+
+    if (kind == KIND_SIGNED) {
+        for (size_t index = 0; index < length; index++) {
+            values[index] = (float) (int64_t) wide->integers[index];
+        }
+    } else if (kind == KIND_UNSIGNED) {
+        for (size_t index = 0; index < length; index++) {
+            values[index] = (float) wide->integers[index];
+        }
+    } else {
+        for (size_t index = 0; index < length; index++) {
+            double real = wide->reals[index];
+            int below   = real < -FLT_MAX && real != -INFINITY;
+            int above   = real > FLT_MAX && real != INFINITY;
+
+            overflow |= (uint64_t) (below | above) << index;
+            values[index] = (wrap || !(below | above)) ? (float) real
+                            : below                    ? -FLT_MAX
+                                                       : FLT_MAX;
+        }
+    }
+
+    return overflow;
+}
+
+static uint64_t store_double(void *cells, const wide_block *wide, int kind, size_t length,
+                             int wrap)
+{
+    double *values = (double *) cells;
+
+    if (kind == KIND_SIGNED) {
+        for (size_t index = 0; index < length; index++) {
+            values[index] = (double) (int64_t) wide->integers[index];
+        }
+    } else if (kind == KIND_UNSIGNED) {
+        for (size_t index = 0; index < length; index++) {
+            values[index] = (double) wide->integers[index];
+        }
+    } else {
+        memcpy(values, wide->reals, length * sizeof(double));
+    }
+
+    return 0;
+}
+
+/* Half precision cells are converted to and from floats, F16C converts 8 float16
+ * values per instruction and bfloat16 is rounded by integer arithmetic on SSE2
+ * registers. halves are unpacked from the back and packed from the front, so a
+ * block may be converted in place.
+ */
+
+static void halves_to_floats(float *floats, const uint16_t *halves, size_t type,
+                             size_t length)
+{
+    size_t index = length;
+
+    if (type == AA_ARAYEH_TYPE_FLOAT16) {
+#if defined(__F16C__) && defined(__AVX__)
+        for (; index >= 8; index -= 8) {
+            __m128i block = _mm_loadu_si128((const __m128i *) (halves + index - 8));
+            _mm256_storeu_ps(floats + index - 8, _mm256_cvtph_ps(block));
+        }
+#endif
+        while (index-- > 0) {
+            floats[index] = arayeh_float16_to_float(halves[index]);
+        }
+        return;
+    }
+
+#if defined(__SSE2__)
+    // bfloat16 is the upper half of a float.
+    const __m128i zero = _mm_setzero_si128();
+    for (; index >= 8; index -= 8) {
+        __m128i block = _mm_loadu_si128((const __m128i *) (halves + index - 8));
+        __m128i low   = _mm_unpacklo_epi16(zero, block);
+        __m128i high  = _mm_unpackhi_epi16(zero, block);
+        _mm_storeu_ps(floats + index - 8, _mm_castsi128_ps(low));
+        _mm_storeu_ps(floats + index - 4, _mm_castsi128_ps(high));
+    }
+#endif
+    while (index-- > 0) {
+        floats[index] = arayeh_bfloat16_to_float(halves[index]);
+    }
+}
+
+static uint64_t floats_to_halves(uint16_t *halves, size_t type, const float *floats,
+                                 size_t length, int wrap)
+{
+    /*
+     * finite floats that round to infinity overflow, they are clamped to the
+     * biggest finite half or, if "wrap" is true, stay infinity.
+     */
+
+    int is_float16    = type == AA_ARAYEH_TYPE_FLOAT16;
+    uint16_t infinity = is_float16 ? 0x7C00 : 0x7F80;
+    uint16_t largest  = is_float16 ? 0x7BFF : 0x7F7F;
+    uint64_t overflow = 0;
+    size_t index      = 0;
+
+#if defined(__F16C__) && defined(__AVX__)
+    // magnitudes from 65520 up round to infinity.
+    const __m256 limit = _mm256_set1_ps(65520.0f);
+    const __m256 max   = _mm256_set1_ps(FLT_MAX);
+    const __m256 sign  = _mm256_set1_ps(-0.0f);
+    for (; is_float16 && index + 8 <= length; index += 8) {
+        __m256 block     = _mm256_loadu_ps(floats + index);
+        __m256 magnitude = _mm256_andnot_ps(sign, block);
+        __m256 outside   = _mm256_and_ps(_mm256_cmp_ps(magnitude, limit, _CMP_GE_OQ),
+                                         _mm256_cmp_ps(magnitude, max, _CMP_LE_OQ));
+        if (_mm256_movemask_ps(outside) != 0) {
+            break;
+        }
+        __m128i packed = _mm256_cvtps_ph(block, _MM_FROUND_TO_NEAREST_INT);
+        _mm_storeu_si128((__m128i *) (halves + index), packed);
+    }
+#endif
+#if defined(__SSE2__)
+    const __m128i round     = _mm_set1_epi32(0x7FFF);
+    const __m128i one       = _mm_set1_epi32(1);
+    const __m128i quiet     = _mm_set1_epi32(0x40);
+    const __m128i exponent  = _mm_set1_epi32(0x7F80);
+    const __m128i magnitude = _mm_set1_epi32(0x7FFFFFFF);
+    const __m128i inf_bits  = _mm_set1_epi32(0x7F800000);
+    for (; !is_float16 && index + 8 <= length; index += 8) {
+        __m128i result[2];
+        int outside = 0;
+
+        for (int part = 0; part < 2; part++) {
+            __m128 block    = _mm_loadu_ps(floats + index + 4 * part);
+            __m128i bits    = _mm_castps_si128(block);
+            __m128i odd     = _mm_and_si128(_mm_srli_epi32(bits, 16), one);
+            __m128i rounded = _mm_add_epi32(bits, _mm_add_epi32(round, odd));
+            __m128i upper   = _mm_srai_epi32(rounded, 16);
+            __m128i nan     = _mm_castps_si128(_mm_cmpunord_ps(block, block));
+            __m128i kept    = _mm_or_si128(_mm_srai_epi32(bits, 16), quiet);
+            __m128i finite  = _mm_cmplt_epi32(_mm_and_si128(bits, magnitude), inf_bits);
+            __m128i to_inf  = _mm_cmpeq_epi32(_mm_and_si128(upper, exponent), exponent);
+
+            outside |= _mm_movemask_epi8(_mm_and_si128(finite, to_inf));
+            result[part] = _mm_or_si128(_mm_and_si128(nan, kept),
+                                        _mm_andnot_si128(nan, upper));
+        }
+        if (outside != 0) {
+            break;
+        }
+        __m128i packed = _mm_packs_epi32(result[0], result[1]);
+        _mm_storeu_si128((__m128i *) (halves + index), packed);
+    }
+#endif
+
+    for (; index < length; index++) {
+        float value   = floats[index];
+        uint16_t half = is_float16 ? arayeh_float_to_float16(value)
+                                   : arayeh_float_to_bfloat16(value);
+
+        if ((half & 0x7FFF) == infinity && value >= -FLT_MAX && value <= FLT_MAX) {
+            overflow |= (uint64_t) 1 << index;
+            half = wrap ? half : (uint16_t) ((half & 0x8000) | largest);
+        }
+        halves[index] = half;
+    }
+
+    return overflow;
+}
+
+static uint64_t convert_block(void *destination, size_t destination_type,
+                              const void *source, size_t source_type, size_t length,
+                              int mode)
+{
+    /*
+     * This function converts a block of up to CONVERT_BLOCK cells and returns
+     * the mask of values that don't fit in "destination_type".
+     */
+
+    wide_block wide;
+    float reals[CONVERT_BLOCK];
+
+    // halves go through floats.
+    if (is_half_type(source_type) && destination_type == AA_ARAYEH_TYPE_FLOAT) {
+        halves_to_floats((float *) destination, (const uint16_t *) source, source_type,
+                         length);
+        return 0;
+    }
+    if (is_half_type(source_type)) {
+        halves_to_floats(reals, (const uint16_t *) source, source_type, length);
+        source      = reals;
+        source_type = AA_ARAYEH_TYPE_FLOAT;
+    }
+    if (is_half_type(destination_type)) {
+        int wrap_halves   = (mode & AA_ARAYEH_CONVERT_WRAP) != 0;
+        uint64_t overflow = 0;
+
+        if (source_type != AA_ARAYEH_TYPE_FLOAT) {
+            overflow = convert_block(reals, AA_ARAYEH_TYPE_FLOAT, source, source_type,
+                                     length, mode);
+            source   = reals;
+        }
+
+        return overflow | floats_to_halves((uint16_t *) destination, destination_type,
+                                           (const float *) source, length, wrap_halves);
+    }
+
+    int as_reals = destination_type == AA_ARAYEH_TYPE_FLOAT ||
+                   destination_type == AA_ARAYEH_TYPE_DOUBLE;
+    int kind     = load_block(&wide, source, source_type, length, as_reals);
+    int wrap     = (mode & AA_ARAYEH_CONVERT_WRAP) != 0;
+
+    if (kind == KIND_REAL && as_reals == AA_ARAYEH_FALSE) {
+        round_block(&wide, length, mode);
+    }
+
+    switch (destination_type) {
+    case AA_ARAYEH_TYPE_CHAR:
+        return store_char(destination, &wide, kind, length, wrap);
+    case AA_ARAYEH_TYPE_SINT:
+        return store_short_int(destination, &wide, kind, length, wrap);
+    case AA_ARAYEH_TYPE_INT:
+        return store_int(destination, &wide, kind, length, wrap);
+    case AA_ARAYEH_TYPE_LINT:
+        return store_long_int(destination, &wide, kind, length, wrap);
+    case AA_ARAYEH_TYPE_FLOAT:
+        return store_float(destination, &wide, kind, length, wrap);
+    case AA_ARAYEH_TYPE_DOUBLE:
+        return store_double(destination, &wide, kind, length, wrap);
+    case AA_ARAYEH_TYPE_INT8:
+        return store_int8(destination, &wide, kind, length, wrap);
+    case AA_ARAYEH_TYPE_INT16:
+        return store_int16(destination, &wide, kind, length, wrap);
+    case AA_ARAYEH_TYPE_INT32:
+        return store_int32(destination, &wide, kind, length, wrap);
+    case AA_ARAYEH_TYPE_INT64:
+        return store_int64(destination, &wide, kind, length, wrap);
+    case AA_ARAYEH_TYPE_UINT8:
+        return store_uint8(destination, &wide, kind, length, wrap);
+    case AA_ARAYEH_TYPE_UINT16:
+        return store_uint16(destination, &wide, kind, length, wrap);
+    case AA_ARAYEH_TYPE_UINT32:
+        return store_uint32(destination, &wide, kind, length, wrap);
+    default:
+        return store_uint64(destination, &wide, kind, length, wrap);
+    }
+}
+
+void convert_values(void *destination, size_t destination_type, const void *source,
+                    size_t source_type, size_t count, int mode)
+{
+    /*
+     * This function converts "count" values of "source_type" into
+     * "destination_type", out of range values are handled by "mode".
+     *
+     * source and destination may be the same memory.
+     *
+     * ARGUMENTS:
+     * destination      pointer to the converted values.
+     * destination_type numeric type of converted values.
+     * source           pointer to the values.
+     * source_type      numeric type of values.
+     * count            number of values.
+     * mode             AA_ARAYEH_CONVERT_* mode or'ed with AA_ARAYEH_ROUND_* mode.
+     *
+     * RETURN:
+     * no return, it's void dude.
+     *
+     */
+
+    char *destination_pointer = (char *) destination;
+    const char *source_pointer = (const char *) source;
+
+    size_t destination_size = type_size(destination_type);
+    size_t source_size      = type_size(source_type);
+
+    if (destination_type == source_type) {
+        memmove(destination, source, count * source_size);
+        return;
+    }
+
+    if (destination_size <= source_size) {
+        for (size_t block = 0; block < count; block += CONVERT_BLOCK) {
+            size_t length = (count - block < CONVERT_BLOCK) ? count - block
+                                                            : CONVERT_BLOCK;
+
+            convert_block(destination_pointer + block * destination_size,
+                          destination_type, source_pointer + block * source_size,
+                          source_type, length, mode);
+        }
+    } else {
+        for (size_t end = count; end > 0;) {
+            size_t block = (end - 1) / CONVERT_BLOCK * CONVERT_BLOCK;
+
+            convert_block(destination_pointer + block * destination_size,
+                          destination_type, source_pointer + block * source_size,
+                          source_type, end - block, mode);
+            end = block;
+        }
+    }
+}
+
+static int type_holds(size_t type, size_t source_type)
+{
+    /*
+     * This function returns AA_ARAYEH_TRUE if every value of "source_type" fits in
+     * "type", e.g. any integer in a float or int16 in int32.
+     */
+
+    if (type == AA_ARAYEH_TYPE_DOUBLE || type == source_type) {
+        return AA_ARAYEH_TRUE;
+    }
+    if (type == AA_ARAYEH_TYPE_FLOAT || type == AA_ARAYEH_TYPE_BFLOAT16) {
+        return is_integer_type(source_type) || is_half_type(source_type);
+    }
+    if (type == AA_ARAYEH_TYPE_FLOAT16) {
+        // 16 bit signed integers, but 65535 is bigger than the biggest float16.
+        return is_integer_type(source_type) &&
+               (type_size(source_type) == 1 ||
+                (type_size(source_type) == 2 && is_signed_type(source_type)));
+    }
+    if (is_integer_type(type) == AA_ARAYEH_FALSE ||
+        is_integer_type(source_type) == AA_ARAYEH_FALSE) {
+        return AA_ARAYEH_FALSE;
+    }
+
+    // signed values need a signed type, unsigned values need a bit less of it.
+    size_t bits        = 8 * type_size(type);
+    size_t source_bits = 8 * type_size(source_type);
+
+    if (is_signed_type(source_type)) {
+        return is_signed_type(type) && bits >= source_bits;
+    }
+
+    return is_signed_type(type) ? bits > source_bits : bits >= source_bits;
+}
+
+int convert_overflows(arayeh *self, size_t type, int mode)
+{
+    /*
+     * This function returns AA_ARAYEH_TRUE if a filled cell of arayeh doesn't fit
+     * in "type" after rounding by "mode".
+     *
+     * ARGUMENTS:
+     * self         pointer to the arayeh object.
+     * type         numeric type to convert cells into.
+     * mode         AA_ARAYEH_CONVERT_* mode or'ed with AA_ARAYEH_ROUND_* mode.
+     *
+     * RETURN:
+     * AA_ARAYEH_TRUE or AA_ARAYEH_FALSE.
+     *
+     */
+
+    // shorten names for god's sake.
+    struct private_properties *private_properties = &self->_private_properties;
+
+    size_t cell_type    = private_properties->storage_type;
+    size_t element_size = private_properties->element_size;
+    size_t size         = private_properties->size;
+    char *array_pointer = private_properties->array.char_pointer;
+
+    // converted cells are thrown away.
+    uint64_t scratch[CONVERT_BLOCK];
+
+    // every value of cell type fits in "type".
+    if (type_holds(type, cell_type) == AA_ARAYEH_TRUE) {
+        return AA_ARAYEH_FALSE;
+    }
+
+    for (size_t block = 0; block < size; block += CONVERT_BLOCK) {
+        size_t length = (size - block < CONVERT_BLOCK) ? size - block : CONVERT_BLOCK;
+        uint64_t mask = map_block_mask(private_properties->map, block, length);
+
+        if (mask == 0) {
+            continue;
+        }
+
+        char *cells       = array_pointer + block * element_size;
+
+        uint64_t overflow = convert_block(scratch, type, cells, cell_type, length, mode);
+
+        if ((overflow & mask) != 0) {
+            return AA_ARAYEH_TRUE;
+        }
+    }
+
+    return AA_ARAYEH_FALSE;
+}
+
+// Private methods of narrowed arayehs, their cells are stored in a narrower
+// integer type than arayeh type and elements are converted on the fly.
+
+static void add_narrowed(arayeh *self, size_t index, void *element)
+{
+    struct private_properties *private_properties = &self->_private_properties;
+
+    convert_integers(private_properties->array.char_pointer +
+                         index * private_properties->element_size,
+                     private_properties->storage_type, element, private_properties->type,
+                     1);
+}
+
+static void get_narrowed(arayeh *self, size_t index, void *element)
+{
+    struct private_properties *private_properties = &self->_private_properties;
+
+    convert_integers(element, private_properties->type,
+                     private_properties->array.char_pointer +
+                         index * private_properties->element_size,
+                     private_properties->storage_type, 1);
+}
+
+static uint64_t match_narrowed(arayeh *self, size_t index, size_t length, void *element)
+{
+    struct private_properties *private_properties = &self->_private_properties;
+
+    size_t type         = private_properties->type;
+    size_t storage_type = private_properties->storage_type;
+
+    // values that don't fit in the cells are not in the arayeh.
+    if (integer_fits(element, type, storage_type) == AA_ARAYEH_FALSE) {
+        return 0;
+    }
+
+    // element converted into the cell type.
+    union {
+        char char_type;
+        short int short_int_type;
+        int int_type;
+        int64_t int64_type;
+    } needle;
+
+    convert_integers(&needle, storage_type, element, type, 1);
+
+    // cells are compared as the integer of their size.
+    size_t element_size = private_properties->element_size;
+
+    if (element_size == sizeof(char)) {
+        return _match_type_char(self, index, length, &needle);
+    } else if (element_size == sizeof(short int)) {
+        return _match_type_short_int(self, index, length, &needle);
+    } else if (element_size == sizeof(int)) {
+        return _match_type_int(self, index, length, &needle);
+    } else if (element_size == sizeof(int64_t)) {
+        return _match_type_int64(self, index, length, &needle);
+    }
+
+    return _match_type_generic(self, index, length, &needle);
+}
+
+void set_storage_methods(arayeh *self)
+{
+    /*
+     * This function assigns private functions of arayeh for its storage type,
+     * narrowed arayehs convert elements from and into arayeh type and have no
+     * hash keys, packed boolean arayehs have their own private functions.
+     *
+     * ARGUMENTS:
+     * self         pointer to the arayeh object.
+     *
+     * RETURN:
+     * no return, it's void dude.
+     *
+     */
+
+    // shorten names for god's sake.
+    struct private_methods *private_methods       = &self->_private_methods;
+    struct private_properties *private_properties = &self->_private_properties;
+
+    // keep the growth factor of user.
+    size_t (*growth_factor)(arayeh *) = private_methods->growth_factor;
+
+    set_private_methods(self, private_properties->storage_type);
+
+    private_methods->growth_factor = growth_factor;
+
+    if (private_properties->storage_type != private_properties->type &&
+        private_properties->storage_type != AA_ARAYEH_STORAGE_BIT) {
+        private_methods->add_to_arayeh   = add_narrowed;
+        private_methods->get_from_arayeh = get_narrowed;
+        private_methods->match_block     = match_narrowed;
+        private_methods->hash_key        = NULL;
+    }
+}
+
+static int convert_bits(arayeh *self, size_t storage_type)
+{
+    /*
+     * This function packs the cells of a boolean arayeh into words of bits
+     * (AA_ARAYEH_STORAGE_BIT) or unpacks them into chars (AA_ARAYEH_TYPE_BOOL) in
+     * place, memory grows before and shrinks after the conversion.
+     *
+     * ARGUMENTS:
+     * self         pointer to the arayeh object.
+     * storage_type AA_ARAYEH_STORAGE_BIT or AA_ARAYEH_TYPE_BOOL.
+     *
+     * RETURN:
+     * state        a code that indicates successful operation
+     *              or an error code defined in arayeh.h .
+     *
+     */
+
+    // shorten names for god's sake.
+    struct private_methods *private_methods       = &self->_private_methods;
+    struct private_properties *private_properties = &self->_private_properties;
+
+    size_t old_type  = private_properties->storage_type;
+    size_t size      = private_properties->size;
+    size_t words     = AA_ARAYEH_MASK_SIZE(size);
+    size_t old_bytes = (old_type == AA_ARAYEH_STORAGE_BIT) ? words * 8 : size;
+    size_t new_bytes = (storage_type == AA_ARAYEH_STORAGE_BIT) ? words * 8 : size;
+
+    arayeh_types array_pointer;
+
+    // private methods of the new type allocate memory for it.
+    private_properties->storage_type = storage_type;
+    set_storage_methods(self);
+
+    if (new_bytes > old_bytes) {
+        int state = private_methods->init_arayeh(self, &array_pointer, size);
+        if (state == AA_ARAYEH_SUCCESS) {
+            state = private_methods->realloc_arayeh(self, &array_pointer, size);
+        }
+
+        if (state != AA_ARAYEH_SUCCESS) {
+            // arayeh is unchanged.
+            private_properties->storage_type = old_type;
+            set_storage_methods(self);
+            return AA_ARAYEH_REALLOC_DENIED;
+        }
+
+        private_methods->set_memory_pointer(self, &array_pointer);
+    }
+
+    uint64_t *bits = private_properties->array.bool_pointer;
+    char *cells    = private_properties->array.char_pointer;
+
+    if (storage_type == AA_ARAYEH_STORAGE_BIT) {
+        // word i is built from cells 64 * i to 64 * i + 63, none of them is before it.
+        for (size_t word = 0; word < words; word++) {
+            size_t length  = (size - word * 64 < 64) ? size - word * 64 : 64;
+            char *block    = cells + word * 64;
+            uint64_t value = 0;
+            size_t offset  = 0;
+
+#if defined(__SSE2__)
+            const __m128i zero = _mm_setzero_si128();
+            for (; offset + 16 <= length; offset += 16) {
+                __m128i chars = _mm_loadu_si128((const __m128i *) (block + offset));
+                uint32_t zeros =
+                    (uint32_t) _mm_movemask_epi8(_mm_cmpeq_epi8(chars, zero));
+                value |= (uint64_t) (~zeros & 0xFFFF) << offset;
+            }
+#endif
+            for (; offset < length; offset++) {
+                value |= (uint64_t) (block[offset] != 0) << offset;
+            }
+
+            bits[word] = value;
+        }
+    } else {
+        // cells of word i are after it, so words are unpacked from the last one.
+        for (size_t word = words; word-- > 0;) {
+            size_t length  = (size - word * 64 < 64) ? size - word * 64 : 64;
+            uint64_t value = bits[word];
+
+            for (size_t offset = length; offset-- > 0;) {
+                cells[word * 64 + offset] = (char) ((value >> offset) & 1);
+            }
+        }
+    }
+
+    // shrink memory, cells are kept in the bigger memory if it fails.
+    if (new_bytes < old_bytes) {
+        int state = private_methods->realloc_arayeh(self, &array_pointer, size);
+        if (state == AA_ARAYEH_SUCCESS) {
+            private_methods->set_memory_pointer(self, &array_pointer);
+        }
+    }
+
+    // return success code.
+    return AA_ARAYEH_SUCCESS;
+}
+
+int convert_storage(arayeh *self, size_t storage_type, int mode)
+{
+    /*
+     * This function re-stores the cells of arayeh in the numeric "storage_type",
+     * values that don't fit in the new type are handled by "mode".
+     *
+     * cells are converted in place, memory grows before a widening conversion
+     * and shrinks after a narrowing conversion.
+     *
+     * ARGUMENTS:
+     * self         pointer to the arayeh object.
+     * storage_type numeric type of cells.
+     * mode         AA_ARAYEH_CONVERT_* mode or'ed with AA_ARAYEH_ROUND_* mode.
+     *
+     * RETURN:
+     * state        a code that indicates successful operation
+     *              or an error code defined in arayeh.h .
+     *
+     */
+
+    // shorten names for god's sake.
+    struct private_methods *private_methods       = &self->_private_methods;
+    struct private_properties *private_properties = &self->_private_properties;
+
+    size_t old_type = private_properties->storage_type;
+
+    if (old_type == storage_type) {
+        return AA_ARAYEH_SUCCESS;
+    }
+
+    // boolean cells are packed or unpacked, not converted.
+    if (old_type == AA_ARAYEH_STORAGE_BIT || storage_type == AA_ARAYEH_STORAGE_BIT) {
+        return convert_bits(self, storage_type);
+    }
+
+    size_t old_size = private_properties->element_size;
+    size_t new_size = type_size(storage_type);
+
+    arayeh_types array_pointer;
+
+    // private methods of the new type allocate memory for it.
+    private_properties->storage_type = storage_type;
+    private_properties->element_size = new_size;
+    set_storage_methods(self);
+
+    // realloc() of zero bytes may free the memory, an empty arayeh keeps it.
+    if (new_size > old_size && private_properties->size > 0) {
+        size_t size = private_properties->size;
+
+        // check for size_t overflow before growing memory.
+        int state = private_methods->init_arayeh(self, &array_pointer, size);
+        if (state == AA_ARAYEH_SUCCESS) {
+            state = private_methods->realloc_arayeh(self, &array_pointer, size);
+        }
+
+        if (state != AA_ARAYEH_SUCCESS) {
+            // arayeh is unchanged.
+            private_properties->storage_type = old_type;
+            private_properties->element_size = old_size;
+            set_storage_methods(self);
+            return AA_ARAYEH_REALLOC_DENIED;
+        }
+
+        private_methods->set_memory_pointer(self, &array_pointer);
+    }
+
+    char *cells = private_properties->array.char_pointer;
+    convert_values(cells, storage_type, cells, old_type, private_properties->size, mode);
+
+    // shrink memory, cells are kept in the bigger memory if it fails.
+    if (new_size < old_size && private_properties->size > 0 &&
+        private_methods->realloc_arayeh(self, &array_pointer, private_properties->size) ==
+            AA_ARAYEH_SUCCESS) {
+        private_methods->set_memory_pointer(self, &array_pointer);
+    }
+
+    // hash keys depend on the cells.
+    hash_index_free(self);
+
+    // return success code.
+    return AA_ARAYEH_SUCCESS;
+}
+
+int widen_storage(arayeh *self)
+{
+    /*
+     * This function re-stores the cells of a narrowed arayeh in arayeh type, so
+     * methods can work on its memory directly, packed booleans are unpacked.
+     *
+     * ARGUMENTS:
+     * self         pointer to the arayeh object.
+     *
+     * RETURN:
+     * state        a code that indicates successful operation
+     *              or an error code defined in arayeh.h .
+     *
+     */
+
+    return convert_storage(self, self->_private_properties.type, AA_ARAYEH_CONVERT_WRAP);
+}
+
+int widen_to_fit(arayeh *self, const void *element)
+{
+    /*
+     * This function widens a narrowed arayeh if "element" of arayeh type doesn't
+     * fit in its cells.
+     *
+     * ARGUMENTS:
+     * self         pointer to the arayeh object.
+     * element      pointer to an element of arayeh type.
+     *
+     * RETURN:
+     * state        a code that indicates successful operation
+     *              or an error code defined in arayeh.h .
+     *
+     */
+
+    // shorten names for god's sake.
+    struct private_properties *private_properties = &self->_private_properties;
+
+    size_t type         = private_properties->type;
+    size_t storage_type = private_properties->storage_type;
+
+    // every boolean fits in a bit.
+    if (storage_type == type || storage_type == AA_ARAYEH_STORAGE_BIT ||
+        integer_fits(element, type, storage_type)) {
+        return AA_ARAYEH_SUCCESS;
+    }
+
+    return widen_storage(self);
+}
+
+size_t wide_cell_size(arayeh *self)
+{
+    /*
+     * This function returns the size of a cell of arayeh in bytes once it's
+     * stored in arayeh type, whatever its storage type is.
+     *
+     * ARGUMENTS:
+     * self         pointer to the arayeh object.
+     *
+     * RETURN:
+     * size of one cell.
+     *
+     */
+
+    // shorten names for god's sake.
+    struct private_properties *private_properties = &self->_private_properties;
+
+    if (private_properties->storage_type == private_properties->type) {
+        return private_properties->element_size;
+    }
+
+    return type_size(private_properties->type);
+}
+
+void read_cells(arayeh *self, void *destination, size_t start_index, size_t count)
+{
+    /*
+     * This function copies "count" cells from "start_index" into "destination"
+     * as cells of arayeh type, cells of a narrowed arayeh are converted in
+     * blocks and packed boolean cells are unpacked 64 at a time while they're
+     * copied, so arayeh keeps its storage.
+     *
+     * ARGUMENTS:
+     * self         pointer to the arayeh object.
+     * destination  pointer to at least "count" cells of arayeh type.
+     * start_index  index of the first cell.
+     * count        number of cells to copy.
+     *
+     * RETURN:
+     * no return, it's void dude.
+     *
+     */
+
+    // shorten names for god's sake.
+    struct private_properties *private_properties = &self->_private_properties;
+
+    size_t type         = private_properties->type;
+    size_t storage_type = private_properties->storage_type;
+    size_t element_size = private_properties->element_size;
+    char *cells         = private_properties->array.char_pointer;
+
+    if (count == 0) {
+        return;
+    }
+
+    // packed boolean cells, one char of 0 or 1 per cell.
+    if (storage_type == AA_ARAYEH_STORAGE_BIT) {
+        const uint64_t *words = private_properties->array.bool_pointer;
+        char *chars           = (char *) destination;
+
+        for (size_t block = 0; block < count; block += 64) {
+            size_t length = (count - block < 64) ? count - block : 64;
+            uint64_t bits = read_bits(words, start_index + block, length);
+
+            for (size_t offset = 0; offset < length; offset++) {
+                chars[block + offset] = (char) ((bits >> offset) & 1);
+            }
+        }
+        return;
+    }
+
+    cells += start_index * element_size;
+
+    if (storage_type == type) {
+        memcpy(destination, cells, count * element_size);
+        return;
+    }
+
+    convert_values(destination, type, cells, storage_type, count, AA_ARAYEH_CONVERT_WRAP);
+}
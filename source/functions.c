@@ -38,6 +38,7 @@
 #include "../include/functions.h"
 
 #include "../include/algorithms.h"
+#include "../include/convert.h"
 #include "../include/fatal.h"
 #include "../include/methods.h"
 #include "../include/types.h"
@@ -73,6 +74,324 @@ int auto_extend_memory(arayeh *self)
     return state;
 }
 
+int auto_extend_memory_to(arayeh *self, size_t min_size)
+{
+    /*
+     * This function extends arayeh size once, so it can hold at least "min_size"
+     * cells. the extension is the bigger one of the growth factor and the missing
+     * cells, so bulk operations keep the amortized growth of arayeh.add method.
+     *
+     * ARGUMENTS:
+     * self             pointer to the arayeh object.
+     * min_size         minimum arayeh size needed.
+     *
+     * RETURN:
+     * state        a code that indicates successful operation
+     *              or an error code defined in configuration.h .
+     *
+     */
+
+    // shorten names for god's sake.
+    struct private_methods *private_methods       = &self->_private_methods;
+    struct private_properties *private_properties = &self->_private_properties;
+
+    // arayeh is big enough.
+    if (min_size <= private_properties->size) {
+        return AA_ARAYEH_SUCCESS;
+    }
+
+    // calculate the extension memory size using growth factor function.
+    size_t extension_size = private_methods->growth_factor(self);
+    size_t missing_size   = min_size - private_properties->size;
+
+    // extend arayeh size.
+    return self->extend_size(self, extension_size > missing_size ? extension_size
+                                                                 : missing_size);
+}
+
+int open_writer(arayeh *self, arayeh_writer *writer, size_t count)
+{
+    /*
+     * This function reserves "count" empty cells after the last filled cell and
+     * prepares "writer" for them, for any type of arayeh. methods that fill the
+     * cells themselves (add_strings, append_bytes) use it directly.
+     *
+     * ARGUMENTS:
+     * self         pointer to the arayeh object.
+     * writer       pointer to the writer to be prepared.
+     * count        number of cells to reserve.
+     *
+     * RETURN:
+     * state        a code that indicates successful operation
+     *              or an error code defined in arayeh.h .
+     *
+     */
+
+    // shorten names for god's sake.
+    struct private_properties *private_properties = &self->_private_properties;
+
+    // shorten setting names.
+    struct arayeh_policy *policy = &private_properties->policy;
+
+    // set debug flag.
+    int debug = policy->debug;
+
+    // gap buffer mode, put cells at their logical index.
+    close_gap(self);
+
+    // narrowed arayeh, cells must be of arayeh type.
+    if (widen_storage(self) != AA_ARAYEH_SUCCESS) {
+        return AA_ARAYEH_REALLOC_DENIED;
+    }
+
+    // track error state in the function.
+    int state;
+
+    // cells after the last filled cell are empty.
+    size_t start_index = find_top_index(self);
+
+    // check for size_t overflow.
+    if (count > SIZE_MAX - start_index) {
+        WARN_T_OVERFLOW("open_writer()", debug);
+        return AA_ARAYEH_OVERFLOW;
+    }
+
+    // check if arayeh is big enough.
+    if (private_properties->size < start_index + count) {
+        // extend arayeh size only if settings allow it.
+        if (policy->extend_add == AA_ARAYEH_FALSE) {
+            // write to stderr and return error code.
+            WARN_WRONG_INDEX(
+                "open_writer(), not enough space left in the arayeh.",
+                debug);
+            return AA_ARAYEH_NOT_ENOUGH_SPACE;
+        }
+
+        // extend arayeh size once.
+        state = auto_extend_memory_to(self, start_index + count);
+
+        // check for unsuccessful size extension.
+        if (state != AA_ARAYEH_SUCCESS) {
+            return state;
+        }
+    }
+
+    size_t element_size = private_properties->element_size;
+    char *array_pointer = private_properties->array.char_pointer;
+
+    writer->begin        = array_pointer + start_index * element_size;
+    writer->cursor       = writer->begin;
+    writer->end          = writer->begin + count * element_size;
+    writer->start_index  = start_index;
+    writer->element_size = element_size;
+
+    // return success code.
+    return AA_ARAYEH_SUCCESS;
+}
+
+static int resolve_extend(char method_size)
+{
+    /*
+     * This function resolves a method specific size extension setting.
+     *
+     * ARGUMENTS:
+     * method_size  AA_ARAYEH_ON or AA_ARAYEH_OFF.
+     *
+     * RETURN:
+     * AA_ARAYEH_TRUE if the method may extend arayeh size, AA_ARAYEH_FALSE if not.
+     *
+     */
+
+    switch (method_size) {
+    case AA_ARAYEH_ON:
+        return AA_ARAYEH_TRUE;
+    case AA_ARAYEH_OFF:
+        return AA_ARAYEH_FALSE;
+    default:
+        FATAL_WRONG_SETTINGS(
+            "resolve_policy() function, method size value is not correct.",
+            AA_ARAYEH_TRUE);
+    }
+}
+
+void resolve_policy(arayeh *self)
+{
+    /*
+     * This function resolves arayeh settings into the policy of methods, it's
+     * called whenever settings change, so wrong settings are detected here
+     * and not in the middle of a method call.
+     *
+     * ARGUMENTS:
+     * self         pointer to the arayeh object.
+     *
+     * RETURN:
+     * no return, it's void dude.
+     *
+     */
+
+    // shorten names for god's sake.
+    arayeh_settings *settings         = self->_private_properties.settings;
+    arayeh_size_settings *method_size = settings->method_size;
+    struct arayeh_policy *policy      = &self->_private_properties.policy;
+
+    // set debug flag.
+    policy->debug =
+        settings->debug_messages == AA_ARAYEH_ON ? AA_ARAYEH_TRUE : AA_ARAYEH_FALSE;
+
+    switch (settings->extend_size) {
+    case AA_ARAYEH_ON:
+    case AA_ARAYEH_OFF:
+        policy->extend_add = resolve_extend(settings->extend_size);
+
+        policy->extend_insert       = policy->extend_add;
+        policy->extend_fill         = policy->extend_add;
+        policy->extend_merge_arayeh = policy->extend_add;
+        policy->extend_merge_array  = policy->extend_add;
+        break;
+    // if manual is enabled, every method has its own extend size rule.
+    case AA_ARAYEH_MANUAL:
+        policy->extend_add          = resolve_extend(method_size->extend_add);
+        policy->extend_insert       = resolve_extend(method_size->extend_insert);
+        policy->extend_fill         = resolve_extend(method_size->extend_fill);
+        policy->extend_merge_arayeh = resolve_extend(method_size->extend_merge_arayeh);
+        policy->extend_merge_array  = resolve_extend(method_size->extend_merge_array);
+        break;
+    default:
+        FATAL_WRONG_SETTINGS(
+            "resolve_policy() function, extend_size value is not correct.",
+            AA_ARAYEH_TRUE);
+    }
+}
+
+arayeh *create_arayeh_like(arayeh *self, size_t initial_size)
+{
+    /*
+     * This function creates an empty arayeh with the element type of "self".
+     *
+     * ARGUMENTS:
+     * self         pointer to the arayeh object.
+     * initial_size size of the new arayeh.
+     *
+     * RETURN:
+     * A pointer to the initialized arayeh.
+     * or
+     * return NULL in case of error.
+     *
+     */
+
+    // shorten names for god's sake.
+    struct private_properties *private_properties = &self->_private_properties;
+
+    if (private_properties->type == AA_ARAYEH_TYPE_GENERIC) {
+        return ArayehGeneric(private_properties->element_size,
+                             private_properties->alignment, initial_size);
+    }
+
+    return Arayeh(private_properties->type, initial_size);
+}
+
+size_t type_size(size_t type)
+{
+    /*
+     * This function returns the size of an element of arayeh type in bytes.
+     *
+     * ARGUMENTS:
+     * type         type of arayeh elements.
+     *
+     * RETURN:
+     * size of one element.
+     *
+     */
+
+    switch (type) {
+    case AA_ARAYEH_TYPE_CHAR:
+        return sizeof(char);
+    case AA_ARAYEH_TYPE_SINT:
+        return sizeof(short int);
+    case AA_ARAYEH_TYPE_INT:
+        return sizeof(int);
+    case AA_ARAYEH_TYPE_LINT:
+        return sizeof(long int);
+    case AA_ARAYEH_TYPE_FLOAT:
+        return sizeof(float);
+    case AA_ARAYEH_TYPE_DOUBLE:
+        return sizeof(double);
+    case AA_ARAYEH_TYPE_INT8:
+    case AA_ARAYEH_TYPE_UINT8:
+        return sizeof(uint8_t);
+    case AA_ARAYEH_TYPE_INT16:
+    case AA_ARAYEH_TYPE_UINT16:
+        return sizeof(uint16_t);
+    case AA_ARAYEH_TYPE_INT32:
+    case AA_ARAYEH_TYPE_UINT32:
+        return sizeof(uint32_t);
+    case AA_ARAYEH_TYPE_INT64:
+    case AA_ARAYEH_TYPE_UINT64:
+        return sizeof(uint64_t);
+    case AA_ARAYEH_TYPE_FLOAT16:
+    case AA_ARAYEH_TYPE_BFLOAT16:
+        return sizeof(uint16_t);
+    case AA_ARAYEH_TYPE_STRING:
+        return sizeof(arayeh_string_cell);
+    case AA_ARAYEH_TYPE_BOOL:
+        return sizeof(char);
+    default:
+        FATAL_WRONG_TYPE("type_size", AA_ARAYEH_TRUE);
+    }
+}
+
+size_t element_value_size(arayeh *self)
+{
+    /*
+     * This function returns the size of the elements that methods take and
+     * return in bytes, cells of half precision and string arayehs hold
+     * something else than their elements.
+     *
+     * ARGUMENTS:
+     * self         pointer to the arayeh object.
+     *
+     * RETURN:
+     * size of one element.
+     *
+     */
+
+    switch (self->_private_properties.type) {
+    case AA_ARAYEH_TYPE_FLOAT16:
+    case AA_ARAYEH_TYPE_BFLOAT16:
+        return sizeof(float);
+    case AA_ARAYEH_TYPE_STRING:
+        return sizeof(arayeh_string);
+    default:
+        return self->_private_properties.element_size;
+    }
+}
+
+int cells_are_elements(arayeh *self)
+{
+    /*
+     * This function returns AA_ARAYEH_TRUE if arayeh cells hold its elements as
+     * they are, so C arrays of elements can be copied into the cells. boolean
+     * elements are normalized to 0 or 1, so they're never copied.
+     *
+     * ARGUMENTS:
+     * self         pointer to the arayeh object.
+     *
+     * RETURN:
+     * AA_ARAYEH_TRUE or AA_ARAYEH_FALSE.
+     *
+     */
+
+    switch (self->_private_properties.type) {
+    case AA_ARAYEH_TYPE_FLOAT16:
+    case AA_ARAYEH_TYPE_BFLOAT16:
+    case AA_ARAYEH_TYPE_STRING:
+    case AA_ARAYEH_TYPE_BOOL:
+        return AA_ARAYEH_FALSE;
+    default:
+        return AA_ARAYEH_TRUE;
+    }
+}
+
 void set_public_methods(arayeh *self)
 {
     /*
@@ -86,19 +405,133 @@ void set_public_methods(arayeh *self)
      *
      */
 
-    self->resize_memory     = _resize_memory;
-    self->extend_size       = _extend_size;
-    self->free_arayeh       = _free_memory;
-    self->duplicate         = _duplicate_arayeh;
-    self->add               = _add_to_arayeh;
-    self->insert            = _insert_to_arayeh;
-    self->fill              = _fill_arayeh;
-    self->merge_arayeh      = _merge_from_arayeh;
-    self->merge_array       = _merge_from_array;
-    self->get               = _get_from_arayeh;
-    self->set_settings      = _set_settings;
-    self->set_size_settings = _set_size_settings;
-    self->set_growth_factor = _set_growth_factor;
+    self->resize_memory      = _resize_memory;
+    self->extend_size        = _extend_size;
+    self->free_arayeh        = _free_memory;
+    self->duplicate          = _duplicate_arayeh;
+    self->add                = _add_to_arayeh;
+    self->insert             = _insert_to_arayeh;
+    self->fill               = _fill_arayeh;
+    self->merge_arayeh       = _merge_from_arayeh;
+    self->merge_array        = _merge_from_array;
+    self->get                = _get_from_arayeh;
+    self->insert_shift       = _insert_shift_to_arayeh;
+    self->insert_range_shift = _insert_range_shift_to_arayeh;
+    self->delete_item        = _delete_item_from_arayeh;
+    self->delete_slice       = _delete_slice_from_arayeh;
+    self->pop                = _pop_from_arayeh;
+    self->get_range          = _get_range_from_arayeh;
+    self->get_indices        = _get_indices_from_arayeh;
+    self->view               = _view_arayeh;
+    self->iter_begin         = _iter_begin_arayeh;
+    self->iter_next          = _iter_next_arayeh;
+    self->pipeline_reduce    = _pipeline_reduce_arayeh;
+    self->pipeline_collect   = _pipeline_collect_arayeh;
+    self->writer_open        = _writer_open_arayeh;
+    self->writer_close       = _writer_close_arayeh;
+    self->for_each           = _for_each_arayeh;
+    self->transform          = _transform_arayeh;
+    self->map_to             = _map_to_arayeh;
+    self->contains           = _contains_in_arayeh;
+    self->find               = _find_in_arayeh;
+    self->count              = _count_in_arayeh;
+    self->find_all           = _find_all_in_arayeh;
+    self->build_hash_index   = _build_hash_index;
+    self->drop_hash_index    = _drop_hash_index;
+    self->compact            = _compact_arayeh;
+    self->pack               = _pack_arayeh;
+    self->change_type        = _change_type_arayeh;
+    self->convert_to         = _convert_to_arayeh;
+    self->narrow             = _narrow_arayeh;
+    self->widen              = _widen_arayeh;
+    self->add_strings        = _add_strings_arayeh;
+    self->compact_arena      = _compact_arena_arayeh;
+    self->append_bytes       = _append_bytes_arayeh;
+    self->find_bytes         = _find_bytes_in_arayeh;
+    self->split              = _split_arayeh;
+    self->c_string           = _c_string_arayeh;
+    self->popcount           = _popcount_arayeh;
+    self->bitwise            = _bitwise_arayeh;
+    self->compare            = _compare_arayeh;
+    self->select             = _select_arayeh;
+    self->scan               = _scan_arayeh;
+    self->scan_to            = _scan_to_arayeh;
+    self->set_settings       = _set_settings;
+    self->set_size_settings  = _set_size_settings;
+    self->set_growth_factor  = _set_growth_factor;
+}
+
+static void set_size_compare_methods(arayeh *self)
+{
+    /*
+     * This function assigns compare functions of generic and fixed-width integer
+     * arayehs, elements are compared as bytes, so elements of an integer size are
+     * compared and hashed by the functions of that integer type. other elements
+     * have no hash key.
+     *
+     * ARGUMENTS:
+     * self         pointer to the arayeh object.
+     *
+     * RETURN:
+     * no return, it's void dude.
+     *
+     */
+
+    // shorten names for god's sake.
+    struct private_methods *private_methods = &self->_private_methods;
+
+    size_t element_size = self->_private_properties.element_size;
+
+    if (element_size == sizeof(char)) {
+        private_methods->match_block = _match_type_char;
+        private_methods->hash_key    = _hash_key_type_char;
+    } else if (element_size == sizeof(short int)) {
+        private_methods->match_block = _match_type_short_int;
+        private_methods->hash_key    = _hash_key_type_short_int;
+    } else if (element_size == sizeof(int)) {
+        private_methods->match_block = _match_type_int;
+        private_methods->hash_key    = _hash_key_type_int;
+    } else if (element_size == sizeof(int64_t)) {
+        private_methods->match_block = _match_type_int64;
+        private_methods->hash_key    = _hash_key_type_int64;
+    } else {
+        private_methods->match_block = _match_type_generic;
+        private_methods->hash_key    = NULL;
+    }
+}
+
+static void set_fixed_width_methods(arayeh *self,
+                                    void (*add)(arayeh *, size_t, void *),
+                                    void (*get)(arayeh *, size_t, void *))
+{
+    /*
+     * This function assigns private functions of a fixed-width integer arayeh,
+     * memory and merges are handled by the generic functions, elements are
+     * added and read by the typed "add" and "get" functions.
+     *
+     * ARGUMENTS:
+     * self         pointer to the arayeh object.
+     * add          typed function that adds an element.
+     * get          typed function that gets an element.
+     *
+     * RETURN:
+     * no return, it's void dude.
+     *
+     */
+
+    // shorten names for god's sake.
+    struct private_methods *private_methods = &self->_private_methods;
+
+    private_methods->init_arayeh        = _init_pointer_type_generic;
+    private_methods->malloc_arayeh      = _malloc_type_generic;
+    private_methods->realloc_arayeh     = _realloc_type_generic;
+    private_methods->free_arayeh        = _free_type_generic;
+    private_methods->set_memory_pointer = _set_memory_pointer_type_generic;
+    private_methods->add_to_arayeh      = add;
+    private_methods->merge_from_arayeh  = _merge_arayeh_type_generic;
+    private_methods->merge_from_array   = _merge_array_type_generic;
+    private_methods->get_from_arayeh    = get;
+    set_size_compare_methods(self);
 }
 
 void set_private_methods(arayeh *self, size_t type)
@@ -133,6 +566,8 @@ void set_private_methods(arayeh *self, size_t type)
         private_methods->merge_from_arayeh  = _merge_arayeh_type_char;
         private_methods->merge_from_array   = _merge_array_type_char;
         private_methods->get_from_arayeh    = _get_type_char;
+        private_methods->match_block        = _match_type_char;
+        private_methods->hash_key           = _hash_key_type_char;
         break;
 
     case AA_ARAYEH_TYPE_SINT:
@@ -145,6 +580,8 @@ void set_private_methods(arayeh *self, size_t type)
         private_methods->merge_from_arayeh  = _merge_arayeh_type_short_int;
         private_methods->merge_from_array   = _merge_array_type_short_int;
         private_methods->get_from_arayeh    = _get_type_short_int;
+        private_methods->match_block        = _match_type_short_int;
+        private_methods->hash_key           = _hash_key_type_short_int;
         break;
 
     case AA_ARAYEH_TYPE_INT:
@@ -157,6 +594,8 @@ void set_private_methods(arayeh *self, size_t type)
         private_methods->merge_from_arayeh  = _merge_arayeh_type_int;
         private_methods->merge_from_array   = _merge_array_type_int;
         private_methods->get_from_arayeh    = _get_type_int;
+        private_methods->match_block        = _match_type_int;
+        private_methods->hash_key           = _hash_key_type_int;
         break;
 
     case AA_ARAYEH_TYPE_LINT:
@@ -169,6 +608,8 @@ void set_private_methods(arayeh *self, size_t type)
         private_methods->merge_from_arayeh  = _merge_arayeh_type_long_int;
         private_methods->merge_from_array   = _merge_array_type_long_int;
         private_methods->get_from_arayeh    = _get_type_long_int;
+        private_methods->match_block        = _match_type_long_int;
+        private_methods->hash_key           = _hash_key_type_long_int;
         break;
 
     case AA_ARAYEH_TYPE_FLOAT:
@@ -181,6 +622,8 @@ void set_private_methods(arayeh *self, size_t type)
         private_methods->merge_from_arayeh  = _merge_arayeh_type_float;
         private_methods->merge_from_array   = _merge_array_type_float;
         private_methods->get_from_arayeh    = _get_type_float;
+        private_methods->match_block        = _match_type_float;
+        private_methods->hash_key           = _hash_key_type_float;
         break;
 
     case AA_ARAYEH_TYPE_DOUBLE:
@@ -193,6 +636,85 @@ void set_private_methods(arayeh *self, size_t type)
         private_methods->merge_from_arayeh  = _merge_arayeh_type_double;
         private_methods->merge_from_array   = _merge_array_type_double;
         private_methods->get_from_arayeh    = _get_type_double;
+        private_methods->match_block        = _match_type_double;
+        private_methods->hash_key           = _hash_key_type_double;
+        break;
+
+    case AA_ARAYEH_TYPE_GENERIC:
+        private_methods->init_arayeh        = _init_pointer_type_generic;
+        private_methods->malloc_arayeh      = _malloc_type_generic;
+        private_methods->realloc_arayeh     = _realloc_type_generic;
+        private_methods->free_arayeh        = _free_type_generic;
+        private_methods->set_memory_pointer = _set_memory_pointer_type_generic;
+        private_methods->add_to_arayeh      = _add_type_generic;
+        private_methods->merge_from_arayeh  = _merge_arayeh_type_generic;
+        private_methods->merge_from_array   = _merge_array_type_generic;
+        private_methods->get_from_arayeh    = _get_type_generic;
+        set_size_compare_methods(self);
+        break;
+
+    case AA_ARAYEH_TYPE_INT8:
+        set_fixed_width_methods(self, _add_type_int8, _get_type_int8);
+        break;
+    case AA_ARAYEH_TYPE_INT16:
+        set_fixed_width_methods(self, _add_type_int16, _get_type_int16);
+        break;
+    case AA_ARAYEH_TYPE_INT32:
+        set_fixed_width_methods(self, _add_type_int32, _get_type_int32);
+        break;
+    case AA_ARAYEH_TYPE_INT64:
+        set_fixed_width_methods(self, _add_type_int64, _get_type_int64);
+        break;
+    case AA_ARAYEH_TYPE_UINT8:
+        set_fixed_width_methods(self, _add_type_uint8, _get_type_uint8);
+        break;
+    case AA_ARAYEH_TYPE_UINT16:
+        set_fixed_width_methods(self, _add_type_uint16, _get_type_uint16);
+        break;
+    case AA_ARAYEH_TYPE_UINT32:
+        set_fixed_width_methods(self, _add_type_uint32, _get_type_uint32);
+        break;
+    case AA_ARAYEH_TYPE_UINT64:
+        set_fixed_width_methods(self, _add_type_uint64, _get_type_uint64);
+        break;
+    case AA_ARAYEH_TYPE_FLOAT16:
+        set_fixed_width_methods(self, _add_type_float16, _get_type_float16);
+        private_methods->merge_from_arayeh = _merge_arayeh_type_element;
+        private_methods->merge_from_array  = _merge_array_type_element;
+        private_methods->match_block       = _match_type_float16;
+        private_methods->hash_key          = NULL;
+        break;
+    case AA_ARAYEH_TYPE_BFLOAT16:
+        set_fixed_width_methods(self, _add_type_bfloat16, _get_type_bfloat16);
+        private_methods->merge_from_arayeh = _merge_arayeh_type_element;
+        private_methods->merge_from_array  = _merge_array_type_element;
+        private_methods->match_block       = _match_type_bfloat16;
+        private_methods->hash_key          = NULL;
+        break;
+    case AA_ARAYEH_TYPE_STRING:
+        set_fixed_width_methods(self, _add_type_string, _get_type_string);
+        private_methods->free_arayeh       = _free_type_string;
+        private_methods->merge_from_arayeh = _merge_arayeh_type_element;
+        private_methods->merge_from_array  = _merge_array_type_element;
+        private_methods->match_block       = _match_type_string;
+        private_methods->hash_key          = NULL;
+        break;
+    case AA_ARAYEH_TYPE_BOOL:
+        set_fixed_width_methods(self, _add_type_bool, _get_type_bool);
+        private_methods->merge_from_arayeh = _merge_arayeh_type_element;
+        private_methods->merge_from_array  = _merge_array_type_element;
+        private_methods->match_block       = _match_type_bool;
+        private_methods->hash_key          = NULL;
+        break;
+    case AA_ARAYEH_STORAGE_BIT:
+        set_fixed_width_methods(self, _add_type_bit, _get_type_bit);
+        private_methods->init_arayeh       = _init_pointer_type_bit;
+        private_methods->malloc_arayeh     = _malloc_type_bit;
+        private_methods->realloc_arayeh    = _realloc_type_bit;
+        private_methods->merge_from_arayeh = _merge_arayeh_type_element;
+        private_methods->merge_from_array  = _merge_array_type_element;
+        private_methods->match_block       = _match_type_bit;
+        private_methods->hash_key          = NULL;
         break;
     default:
         FATAL_WRONG_TYPE("set_private_methods", AA_ARAYEH_TRUE);
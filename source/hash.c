@@ -0,0 +1,512 @@
+/** source/hash.c
+ *
+ * This file is a part of:
+ * Azadeh Afzar - Arayehsaz (AA-A).
+ *
+ * Copyright (C) 2020 - 2021 Azadeh Afzar.
+ * Copyright (C) 2020 - 2021 Mohammad Mahdi Baghbani Pourvahid.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgement in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "../include/hash.h"
+
+#include "../include/algorithms.h"
+#include "../include/fatal.h"
+
+// smallest number of slots in the hash table.
+#define HASH_MIN_CAPACITY 16
+
+static uint64_t hash_mix(uint64_t key)
+{
+    /*
+     * This function scrambles the bits of a key (splitmix64 finalizer), so
+     * sequential values spread over the whole table.
+     */
+
+    key ^= key >> 30;
+    key *= 0xbf58476d1ce4e5b9ULL;
+    key ^= key >> 27;
+    key *= 0x94d049bb133111ebULL;
+    key ^= key >> 31;
+    return key;
+}
+
+static struct arayeh_hash_slot *probe_slot(struct arayeh_hash_index *index, uint64_t key)
+{
+    /*
+     * This function returns the slot that holds "key" or the empty slot where
+     * "key" should be stored.
+     */
+
+    size_t mask     = index->capacity - 1;
+    size_t position = (size_t) hash_mix(key) & mask;
+
+    while (index->slots[position].count != 0 && index->slots[position].key != key) {
+        position = (position + 1) & mask;
+    }
+
+    return &index->slots[position];
+}
+
+static int grow_table(struct arayeh_hash_index *index, size_t new_capacity)
+{
+    /*
+     * This function moves the slots of the hash table into a bigger table.
+     */
+
+    struct arayeh_hash_slot *old_slots = index->slots;
+    size_t old_capacity                = index->capacity;
+
+    struct arayeh_hash_slot *new_slots =
+        (struct arayeh_hash_slot *) calloc(new_capacity, sizeof *new_slots);
+    if (new_slots == NULL) {
+        return AA_ARAYEH_FAILURE;
+    }
+
+    index->slots    = new_slots;
+    index->capacity = new_capacity;
+
+    // chains don't depend on the table, only slots are moved.
+    for (size_t position = 0; position < old_capacity; position++) {
+        if (old_slots[position].count != 0) {
+            *probe_slot(index, old_slots[position].key) = old_slots[position];
+        }
+    }
+
+    free(old_slots);
+    return AA_ARAYEH_SUCCESS;
+}
+
+static int cell_key(arayeh *self, size_t index, uint64_t *key)
+{
+    /*
+     * This function returns the hash key of the value in cell "index".
+     */
+
+    // shorten names for god's sake.
+    struct private_properties *private_properties = &self->_private_properties;
+
+    char *cell =
+        private_properties->array.char_pointer + index * private_properties->element_size;
+
+    return self->_private_methods.hash_key(cell, key);
+}
+
+static int link_cell(arayeh *self, size_t index)
+{
+    /*
+     * This function links cell "index" into the chain of its value.
+     */
+
+    // shorten names for god's sake.
+    struct arayeh_hash_index *hash_index = self->_private_properties.hash_index;
+
+    uint64_t key;
+
+    // values without key (NaN) are never searched.
+    if (cell_key(self, index, &key) == AA_ARAYEH_FALSE) {
+        return AA_ARAYEH_SUCCESS;
+    }
+
+    // keep the table at most half full.
+    if ((hash_index->filled + 1) * 2 > hash_index->capacity) {
+        if (grow_table(hash_index, hash_index->capacity * 2) != AA_ARAYEH_SUCCESS) {
+            return AA_ARAYEH_FAILURE;
+        }
+    }
+
+    struct arayeh_hash_slot *slot = probe_slot(hash_index, key);
+    size_t *chain_next            = hash_index->chain_next;
+    size_t *chain_prev            = hash_index->chain_prev;
+
+    // first cell of a new value.
+    if (slot->count == 0) {
+        slot->key         = key;
+        slot->head        = index;
+        slot->tail        = index;
+        slot->count       = 1;
+        chain_next[index] = AA_ARAYEH_HASH_NONE;
+        chain_prev[index] = AA_ARAYEH_HASH_NONE;
+        hash_index->filled++;
+        return AA_ARAYEH_SUCCESS;
+    }
+
+    slot->count++;
+
+    // cells are mostly added at the end of the arayeh, so append is the fast path.
+    if (slot->tail < index) {
+        chain_next[slot->tail] = index;
+        chain_prev[index]      = slot->tail;
+        chain_next[index]      = AA_ARAYEH_HASH_NONE;
+        slot->tail             = index;
+        return AA_ARAYEH_SUCCESS;
+    }
+
+    // walk backward from the tail to the first cell that must follow "index".
+    size_t cursor = slot->tail;
+    while (chain_prev[cursor] != AA_ARAYEH_HASH_NONE && index < chain_prev[cursor]) {
+        cursor = chain_prev[cursor];
+    }
+
+    // link "index" right before cursor.
+    chain_next[index] = cursor;
+    chain_prev[index] = chain_prev[cursor];
+    if (chain_prev[cursor] == AA_ARAYEH_HASH_NONE) {
+        slot->head = index;
+    } else {
+        chain_next[chain_prev[cursor]] = index;
+    }
+    chain_prev[cursor] = index;
+
+    return AA_ARAYEH_SUCCESS;
+}
+
+int hash_index_build(arayeh *self)
+{
+    /*
+     * This function builds the hash index of arayeh values.
+     *
+     * an existing index is rebuilt from scratch.
+     *
+     * ARGUMENTS:
+     * self         pointer to the arayeh object.
+     *
+     * RETURN:
+     * state        a code that indicates successful operation
+     *              or an error code defined in arayeh.h .
+     *
+     */
+
+    // shorten names for god's sake.
+    struct private_properties *private_properties = &self->_private_properties;
+
+    // shorten setting names.
+    char debug_messages = private_properties->settings->debug_messages;
+
+    // set debug flag.
+    int debug = debug_messages == AA_ARAYEH_ON ? AA_ARAYEH_TRUE : AA_ARAYEH_FALSE;
+
+    // free old index.
+    hash_index_free(self);
+
+    // elements without hash keys can't be indexed.
+    if (self->_private_methods.hash_key == NULL) {
+        WARN_WRONG_TYPE("hash_index_build(), elements of arayeh have no hash key.",
+                        debug);
+        return AA_ARAYEH_WRONG_TYPE;
+    }
+
+    size_t size = private_properties->size;
+
+    // start with a table big enough for distinct values.
+    size_t capacity = HASH_MIN_CAPACITY;
+    while (capacity < private_properties->used * 2) {
+        capacity *= 2;
+    }
+
+    struct arayeh_hash_index *hash_index =
+        (struct arayeh_hash_index *) malloc(sizeof *hash_index);
+    if (hash_index == NULL) {
+        WARN_MALLOC("hash_index_build()", debug);
+        return AA_ARAYEH_FAILURE;
+    }
+
+    // chain arrays have at least one cell, so they can be reallocated later.
+    size_t chain_size      = size > 0 ? size : 1;
+    hash_index->slots =
+        (struct arayeh_hash_slot *) calloc(capacity, sizeof *hash_index->slots);
+    hash_index->capacity   = capacity;
+    hash_index->filled     = 0;
+    hash_index->chain_next = (size_t *) malloc(sizeof(size_t) * chain_size);
+    hash_index->chain_prev = (size_t *) malloc(sizeof(size_t) * chain_size);
+    hash_index->chain_size = size;
+
+    private_properties->hash_index = hash_index;
+
+    if (hash_index->slots == NULL || hash_index->chain_next == NULL ||
+        hash_index->chain_prev == NULL) {
+        hash_index_free(self);
+        WARN_MALLOC("hash_index_build()", debug);
+        return AA_ARAYEH_FAILURE;
+    }
+
+    // link filled cells in increasing order, every link is an append.
+    for (size_t block = 0; block < size; block += 64) {
+        size_t length = (size - block < 64) ? size - block : 64;
+        uint64_t mask = map_block_mask(private_properties->map, block, length);
+
+        while (mask != 0) {
+            size_t index = block + count_trailing_zeros(mask);
+            mask &= mask - 1;
+
+            if (link_cell(self, index) != AA_ARAYEH_SUCCESS) {
+                hash_index_free(self);
+                WARN_MALLOC("hash_index_build()", debug);
+                return AA_ARAYEH_FAILURE;
+            }
+        }
+    }
+
+    return AA_ARAYEH_SUCCESS;
+}
+
+void hash_index_free(arayeh *self)
+{
+    /*
+     * This function frees the hash index of arayeh values.
+     *
+     * ARGUMENTS:
+     * self         pointer to the arayeh object.
+     *
+     * RETURN:
+     * no return, it's void dude.
+     *
+     */
+
+    // shorten names for god's sake.
+    struct arayeh_hash_index *hash_index = self->_private_properties.hash_index;
+
+    if (hash_index == NULL) {
+        return;
+    }
+
+    free(hash_index->slots);
+    free(hash_index->chain_next);
+    free(hash_index->chain_prev);
+    free(hash_index);
+
+    self->_private_properties.hash_index = NULL;
+}
+
+int hash_index_ready(arayeh *self)
+{
+    /*
+     * This function returns AA_ARAYEH_TRUE if the arayeh has a usable hash index.
+     *
+     * if there is no index and "hash_index" setting is ON, the index is built
+     * here, so the first search pays for building it (lazy index).
+     *
+     * ARGUMENTS:
+     * self         pointer to the arayeh object.
+     *
+     * RETURN:
+     * AA_ARAYEH_TRUE if the index can be used, otherwise AA_ARAYEH_FALSE.
+     *
+     */
+
+    // shorten names for god's sake.
+    struct private_properties *private_properties = &self->_private_properties;
+
+    if (private_properties->hash_index != NULL) {
+        return AA_ARAYEH_TRUE;
+    }
+
+    if (private_properties->settings->hash_index != AA_ARAYEH_ON ||
+        self->_private_methods.hash_key == NULL) {
+        return AA_ARAYEH_FALSE;
+    }
+
+    return hash_index_build(self) == AA_ARAYEH_SUCCESS ? AA_ARAYEH_TRUE
+                                                       : AA_ARAYEH_FALSE;
+}
+
+void hash_index_resize(arayeh *self, size_t new_size)
+{
+    /*
+     * This function adjusts the hash index to the new size of the arayeh.
+     *
+     * growing the arayeh grows the chain arrays, shrinking it drops the index
+     * because the removed values are not available anymore, a dropped index is
+     * rebuilt on the next search if "hash_index" setting is ON.
+     *
+     * ARGUMENTS:
+     * self         pointer to the arayeh object.
+     * new_size     new size of the arayeh.
+     *
+     * RETURN:
+     * no return, it's void dude.
+     *
+     */
+
+    // shorten names for god's sake.
+    struct arayeh_hash_index *hash_index = self->_private_properties.hash_index;
+
+    if (hash_index == NULL || new_size == hash_index->chain_size) {
+        return;
+    }
+
+    if (new_size < hash_index->chain_size) {
+        hash_index_free(self);
+        return;
+    }
+
+    size_t *chain_next =
+        (size_t *) realloc(hash_index->chain_next, sizeof(size_t) * new_size);
+    if (chain_next != NULL) {
+        hash_index->chain_next = chain_next;
+    }
+
+    size_t *chain_prev =
+        (size_t *) realloc(hash_index->chain_prev, sizeof(size_t) * new_size);
+    if (chain_prev != NULL) {
+        hash_index->chain_prev = chain_prev;
+    }
+
+    if (chain_next == NULL || chain_prev == NULL) {
+        hash_index_free(self);
+        return;
+    }
+
+    hash_index->chain_size = new_size;
+}
+
+void hash_index_insert(arayeh *self, size_t index)
+{
+    /*
+     * This function adds a filled cell to the hash index.
+     *
+     * if memory runs out the index is dropped, searches still work by
+     * scanning the arayeh.
+     *
+     * ARGUMENTS:
+     * self         pointer to the arayeh object.
+     * index        index of the filled cell.
+     *
+     * RETURN:
+     * no return, it's void dude.
+     *
+     */
+
+    if (self->_private_properties.hash_index == NULL) {
+        return;
+    }
+
+    if (link_cell(self, index) != AA_ARAYEH_SUCCESS) {
+        hash_index_free(self);
+    }
+}
+
+void hash_index_remove(arayeh *self, size_t index)
+{
+    /*
+     * This function removes a filled cell from the hash index.
+     *
+     * the cell value is used to find its chain, so it must be called
+     * before the cell is overwritten or emptied.
+     *
+     * ARGUMENTS:
+     * self         pointer to the arayeh object.
+     * index        index of the filled cell.
+     *
+     * RETURN:
+     * no return, it's void dude.
+     *
+     */
+
+    // shorten names for god's sake.
+    struct arayeh_hash_index *hash_index = self->_private_properties.hash_index;
+
+    uint64_t key;
+
+    if (hash_index == NULL || cell_key(self, index, &key) == AA_ARAYEH_FALSE) {
+        return;
+    }
+
+    struct arayeh_hash_slot *slot = probe_slot(hash_index, key);
+    if (slot->count == 0) {
+        return;
+    }
+
+    size_t *chain_next = hash_index->chain_next;
+    size_t *chain_prev = hash_index->chain_prev;
+
+    // unlink the cell.
+    if (chain_prev[index] == AA_ARAYEH_HASH_NONE) {
+        slot->head = chain_next[index];
+    } else {
+        chain_next[chain_prev[index]] = chain_next[index];
+    }
+    if (chain_next[index] == AA_ARAYEH_HASH_NONE) {
+        slot->tail = chain_prev[index];
+    } else {
+        chain_prev[chain_next[index]] = chain_prev[index];
+    }
+
+    slot->count--;
+    if (slot->count != 0) {
+        return;
+    }
+
+    // the value is gone, empty its slot and shift back the following slots of
+    // the probe sequence, so no tombstone is needed.
+    size_t mask     = hash_index->capacity - 1;
+    size_t hole     = (size_t) (slot - hash_index->slots);
+    size_t position = (hole + 1) & mask;
+
+    while (hash_index->slots[position].count != 0) {
+        size_t home = (size_t) hash_mix(hash_index->slots[position].key) & mask;
+
+        // move the slot if its home is not between the hole and its position.
+        if (((position - home) & mask) >= ((position - hole) & mask)) {
+            hash_index->slots[hole] = hash_index->slots[position];
+            hole                    = position;
+        }
+
+        position = (position + 1) & mask;
+    }
+
+    hash_index->slots[hole].count = 0;
+    hash_index->filled--;
+}
+
+struct arayeh_hash_slot *hash_index_lookup(arayeh *self, void *element)
+{
+    /*
+     * This function returns the slot of an element.
+     *
+     * ARGUMENTS:
+     * self         pointer to the arayeh object.
+     * element      pointer to a variable to be searched for.
+     *
+     * RETURN:
+     * pointer to the slot or NULL if element isn't in the arayeh.
+     *
+     */
+
+    uint64_t key;
+
+    if (self->_private_methods.hash_key(element, &key) == AA_ARAYEH_FALSE) {
+        return NULL;
+    }
+
+    struct arayeh_hash_slot *slot = probe_slot(self->_private_properties.hash_index, key);
+
+    return slot->count == 0 ? NULL : slot;
+}
@@ -38,8 +38,21 @@
 #include "../include/methods.h"
 
 #include "../include/algorithms.h"
+#include "../include/arena.h"
+#include "../include/compare.h"
+#include "../include/convert.h"
 #include "../include/fatal.h"
 #include "../include/functions.h"
+#include "../include/hash.h"
+#include "../include/scan.h"
+#include "../include/text.h"
+#include "../include/types.h"
+
+#include <string.h>
+
+#ifdef _OPENMP
+#    include <omp.h>
+#endif
 
 int _resize_memory(arayeh *self, size_t new_size)
 {
@@ -56,6 +69,9 @@ int _resize_memory(arayeh *self, size_t new_size)
      *
      */
 
+    // gap buffer mode, put cells at their logical index.
+    close_gap(self);
+
     // shorten names for god's sake.
     struct private_methods *private_methods       = &self->_private_methods;
     struct private_properties *private_properties = &self->_private_properties;
@@ -107,6 +123,9 @@ int _resize_memory(arayeh *self, size_t new_size)
     private_properties->size = new_size;
     self->size               = new_size;
 
+    // keep hash index in sync with the new size.
+    hash_index_resize(self, new_size);
+
     // return success code.
     return AA_ARAYEH_SUCCESS;
 }
@@ -203,6 +222,9 @@ int _free_memory(arayeh **self)
     // free the arayeh's internal array pointer.
     private_methods->free_arayeh(*self);
 
+    // free hash index.
+    hash_index_free(*self);
+
     // free map array pointer and nullify the pointer.
     free(private_properties->map);
     private_properties->map = NULL;
@@ -254,7 +276,7 @@ arayeh *_duplicate_arayeh(arayeh *self)
     int state;
 
     // create new arayeh with "self" properties.
-    arayeh *duplicate = Arayeh(private_properties->type, private_properties->size);
+    arayeh *duplicate = create_arayeh_like(self, private_properties->size);
 
     // check errors.
     if (duplicate == NULL) {
@@ -302,66 +324,47 @@ int _add_to_arayeh(arayeh *self, void *element)
      *              or an error code defined in arayeh.h .
      */
 
+    // gap buffer mode, put cells at their logical index.
+    close_gap(self);
+
+    // narrowed arayeh, widen it if element doesn't fit in its cells.
+    if (widen_to_fit(self, element) != AA_ARAYEH_SUCCESS) {
+        return AA_ARAYEH_REALLOC_DENIED;
+    }
+
+    // string arayeh, make room for the bytes of element in the arena.
+    if (arena_reserve_element(self, element) != AA_ARAYEH_SUCCESS) {
+        return AA_ARAYEH_REALLOC_DENIED;
+    }
+
     // shorten names for god's sake.
     struct private_methods *private_methods       = &self->_private_methods;
     struct private_properties *private_properties = &self->_private_properties;
 
     // shorten setting names.
-    char debug_messages = private_properties->settings->debug_messages;
-    char extend_size    = private_properties->settings->extend_size;
-    char extend_add     = private_properties->settings->method_size->extend_add;
+    struct arayeh_policy *policy = &private_properties->policy;
 
     // set debug flag.
-    int debug = debug_messages == AA_ARAYEH_ON ? AA_ARAYEH_TRUE : AA_ARAYEH_FALSE;
+    int debug = policy->debug;
 
     // track error state in the function.
     int state;
 
     // check if arayeh is full.
     if (private_properties->used == private_properties->size) {
-        // decide to extend arayeh size based on arayeh settings.
-        switch (extend_size) {
-        case AA_ARAYEH_ON:
-            // extend arayeh size.
-            state = auto_extend_memory(self);
-            // stop function and return error value if extending arayeh size failed.
-            if (state != AA_ARAYEH_SUCCESS) {
-                return state;
-            }
-            break;
-        case AA_ARAYEH_OFF:
+        // extend arayeh size only if settings allow it.
+        if (policy->extend_add == AA_ARAYEH_FALSE) {
             // write to stderr and return error code.
             WARN_WRONG_INDEX(
                 "_add_to_arayeh() method, not enough space left in the arayeh.", debug);
             return AA_ARAYEH_NOT_ENOUGH_SPACE;
-        // if manual is enabled, check against the correct extend size rule.
-        case AA_ARAYEH_MANUAL:
-            switch (extend_add) {
-            case AA_ARAYEH_ON:
-                // extend arayeh size.
-                state = auto_extend_memory(self);
-                // stop function and return error value if extending arayeh size
-                // failed.
-                if (state != AA_ARAYEH_SUCCESS) {
-                    return state;
-                }
-                break;
-            case AA_ARAYEH_OFF:
-                // write to stderr and return error code.
-                WARN_WRONG_INDEX(
-                    "_add_to_arayeh() method, not enough space left in the arayeh.",
-                    debug);
-                return AA_ARAYEH_NOT_ENOUGH_SPACE;
-            default:
-                FATAL_WRONG_SETTINGS("_add_to_arayeh() method, extend_add "
-                                     "value is not correct.",
-                                     AA_ARAYEH_TRUE);
-            }
-            break;
-        default:
-            FATAL_WRONG_SETTINGS(
-                "_add_to_arayeh() method, extend_size value is not correct.",
-                AA_ARAYEH_TRUE);
+        }
+
+        // extend arayeh size.
+        state = auto_extend_memory(self);
+        // stop function and return error value if extending arayeh size failed.
+        if (state != AA_ARAYEH_SUCCESS) {
+            return state;
         }
     }
 
@@ -371,6 +374,9 @@ int _add_to_arayeh(arayeh *self, void *element)
     // update "map".
     private_properties->map[private_properties->next] = AA_ARAYEH_ON;
 
+    // index the new element.
+    hash_index_insert(self, private_properties->next);
+
     // update both public and private "used" counter.
     private_properties->used++;
     self->used = private_properties->used;
@@ -406,17 +412,28 @@ int _insert_to_arayeh(arayeh *self, size_t index, void *element)
      *
      */
 
+    // gap buffer mode, put cells at their logical index.
+    close_gap(self);
+
+    // narrowed arayeh, widen it if element doesn't fit in its cells.
+    if (widen_to_fit(self, element) != AA_ARAYEH_SUCCESS) {
+        return AA_ARAYEH_REALLOC_DENIED;
+    }
+
+    // string arayeh, make room for the bytes of element in the arena.
+    if (arena_reserve_element(self, element) != AA_ARAYEH_SUCCESS) {
+        return AA_ARAYEH_REALLOC_DENIED;
+    }
+
     // shorten names for god's sake.
     struct private_methods *private_methods       = &self->_private_methods;
     struct private_properties *private_properties = &self->_private_properties;
 
     // shorten setting names.
-    char debug_messages = private_properties->settings->debug_messages;
-    char extend_size    = private_properties->settings->extend_size;
-    char extend_insert  = private_properties->settings->method_size->extend_insert;
+    struct arayeh_policy *policy = &private_properties->policy;
 
     // set debug flag.
-    int debug = debug_messages == AA_ARAYEH_ON ? AA_ARAYEH_TRUE : AA_ARAYEH_FALSE;
+    int debug = policy->debug;
 
     // track error state in the function.
     int state = AA_ARAYEH_SUCCESS;
@@ -426,51 +443,21 @@ int _insert_to_arayeh(arayeh *self, size_t index, void *element)
         // calculate memory growth size needed.
         size_t growth_size = index - private_properties->size + 1;
 
-        // decide to extend arayeh size based on arayeh settings.
-        switch (extend_size) {
-        case AA_ARAYEH_ON:
-            // extend arayeh size.
-            state = self->extend_size(self, growth_size);
-
-            // check for unsuccessful size extension.
-            if (state != AA_ARAYEH_SUCCESS) {
-                return state;
-            }
-            break;
-        case AA_ARAYEH_OFF:
+        // extend arayeh size only if settings allow it.
+        if (policy->extend_insert == AA_ARAYEH_FALSE) {
             // write to stderr and return error code.
             WARN_WRONG_INDEX("_insert_to_arayeh() method, index is equal or bigger "
                              "than arayeh size!",
                              debug);
             return AA_ARAYEH_NOT_ENOUGH_SPACE;
-            // if manual is enabled, check against the correct extend size rule.
-        case AA_ARAYEH_MANUAL:
-            switch (extend_insert) {
-            case AA_ARAYEH_ON:
-                // extend arayeh size.
-                state = self->extend_size(self, growth_size);
-
-                // check for unsuccessful size extension.
-                if (state != AA_ARAYEH_SUCCESS) {
-                    return state;
-                }
-                break;
-            case AA_ARAYEH_OFF:
-                // write to stderr and return error code.
-                WARN_WRONG_INDEX("_insert_to_arayeh() method, index is equal or bigger "
-                                 "than arayeh size!",
-                                 debug);
-                return AA_ARAYEH_NOT_ENOUGH_SPACE;
-            default:
-                FATAL_WRONG_SETTINGS("_insert_to_arayeh() method, extend_insert "
-                                     "value is not correct.",
-                                     AA_ARAYEH_TRUE);
-            }
-            break;
-        default:
-            FATAL_WRONG_SETTINGS(
-                "_insert_to_arayeh() method, extend_size value is not correct.",
-                AA_ARAYEH_TRUE);
+        }
+
+        // extend arayeh size.
+        state = self->extend_size(self, growth_size);
+
+        // check for unsuccessful size extension.
+        if (state != AA_ARAYEH_SUCCESS) {
+            return state;
         }
     }
 
@@ -487,6 +474,11 @@ int _insert_to_arayeh(arayeh *self, size_t index, void *element)
         // or not, if it had, then "used" and map will stay same, but
         // if it was uninitialized, update map and "used" counter.
 
+        // remove the overwritten element from hash index.
+        if (private_properties->map[index] == AA_ARAYEH_ON) {
+            hash_index_remove(self, index);
+        }
+
         // assign element.
         private_methods->add_to_arayeh(self, index, element);
 
@@ -500,6 +492,9 @@ int _insert_to_arayeh(arayeh *self, size_t index, void *element)
             private_properties->used++;
             self->used = private_properties->used;
         }
+
+        // index the new element.
+        hash_index_insert(self, index);
     }
 
     // return error state code.
@@ -533,16 +528,17 @@ int _fill_arayeh(arayeh *self, size_t start_index, size_t step, size_t end_index
      *
      */
 
+    // gap buffer mode, put cells at their logical index.
+    close_gap(self);
+
     // shorten names for god's sake.
     struct private_properties *private_properties = &self->_private_properties;
 
     // shorten setting names.
-    char debug_messages = private_properties->settings->debug_messages;
-    char extend_size    = private_properties->settings->extend_size;
-    char extend_fill    = private_properties->settings->method_size->extend_fill;
+    struct arayeh_policy *policy = &private_properties->policy;
 
     // set debug flag.
-    int debug = debug_messages == AA_ARAYEH_ON ? AA_ARAYEH_TRUE : AA_ARAYEH_FALSE;
+    int debug = policy->debug;
 
     // track error state in the function.
     int state = AA_ARAYEH_SUCCESS;
@@ -569,52 +565,52 @@ int _fill_arayeh(arayeh *self, size_t start_index, size_t step, size_t end_index
         // calculate memory growth size needed.
         size_t growthSize = end_index - private_properties->size;
 
-        // decide to extend arayeh size based on arayeh settings.
-        switch (extend_size) {
-        case AA_ARAYEH_ON:
-            // extend arayeh size.
-            state = self->extend_size(self, growthSize);
-
-            // check for unsuccessful size extension.
-            if (state != AA_ARAYEH_SUCCESS) {
-                return state;
-            }
-            break;
-        case AA_ARAYEH_OFF:
+        // extend arayeh size only if settings allow it.
+        if (policy->extend_fill == AA_ARAYEH_FALSE) {
             // write to stderr and return error code.
             WARN_WRONG_INDEX("_fill_arayeh() method, start_index or end_index is "
                              "greater than arayeh size!",
                              debug);
             return AA_ARAYEH_NOT_ENOUGH_SPACE;
-            // if manual is enabled, check against the correct extend size rule.
-        case AA_ARAYEH_MANUAL:
-            switch (extend_fill) {
-            case AA_ARAYEH_ON:
-                // extend arayeh size.
-                state = self->extend_size(self, growthSize);
-
-                // check for unsuccessful size extension.
-                if (state != AA_ARAYEH_SUCCESS) {
-                    return state;
-                }
-                break;
-            case AA_ARAYEH_OFF:
-                // write to stderr and return error code.
-                WARN_WRONG_INDEX("_fill_arayeh() method, start_index or end_index is "
-                                 "greater than arayeh size!",
-                                 debug);
-                return AA_ARAYEH_NOT_ENOUGH_SPACE;
-            default:
-                FATAL_WRONG_SETTINGS("_fill_arayeh() method, extend_fill "
-                                     "value is not correct.",
-                                     AA_ARAYEH_TRUE);
-            }
-            break;
-        default:
-            FATAL_WRONG_SETTINGS(
-                "_fill_arayeh() method, extend_size value is not correct.",
-                AA_ARAYEH_TRUE);
         }
+
+        // extend arayeh size.
+        state = self->extend_size(self, growthSize);
+
+        // check for unsuccessful size extension.
+        if (state != AA_ARAYEH_SUCCESS) {
+            return state;
+        }
+    }
+
+    // packed boolean cells are filled 64 at a time.
+    if (private_properties->storage_type == AA_ARAYEH_STORAGE_BIT && step == 1) {
+        char *map       = private_properties->map;
+        uint64_t *words = private_properties->array.bool_pointer;
+        uint64_t bits   = (*(char *) element != 0) ? UINT64_MAX : 0;
+        size_t filled   = count_filled_cells(map, start_index, end_index);
+
+        for (size_t index = start_index; index < end_index;) {
+            size_t length = 64 - index % 64;
+            length        = (length < end_index - index) ? length : end_index - index;
+            write_bits(words, index, bits, length);
+            index += length;
+        }
+        memset(map + start_index, AA_ARAYEH_ON, end_index - start_index);
+
+        // update both public and private "used" counter.
+        private_properties->used += end_index - start_index - filled;
+        self->used = private_properties->used;
+
+        // update "next" pointer if it was inside filled cells.
+        size_t next = private_properties->next;
+        if (next >= start_index && next < end_index) {
+            private_properties->next = end_index;
+            update_next_index(self);
+        }
+
+        // return success code.
+        return AA_ARAYEH_SUCCESS;
     }
 
     // fill the arayeh using a sequence of insert method.
@@ -653,19 +649,20 @@ int _merge_from_arayeh(arayeh *self, size_t start_index, size_t step, arayeh *so
      *
      */
 
+    // gap buffer mode, put cells at their logical index.
+    close_gap(self);
+    close_gap(source);
+
     // shorten names for god's sake.
     struct private_methods *self_private_methods         = &self->_private_methods;
     struct private_properties *self_private_properties   = &self->_private_properties;
     struct private_properties *source_private_properties = &source->_private_properties;
 
     // shorten setting names.
-    char debug_messages = self_private_properties->settings->debug_messages;
-    char extend_size    = self_private_properties->settings->extend_size;
-    char extend_merge_arayeh =
-        self_private_properties->settings->method_size->extend_merge_arayeh;
+    struct arayeh_policy *policy = &self_private_properties->policy;
 
     // set debug flag.
-    int debug = debug_messages == AA_ARAYEH_ON ? AA_ARAYEH_TRUE : AA_ARAYEH_FALSE;
+    int debug = policy->debug;
 
     // track error state in the function.
     int state = AA_ARAYEH_SUCCESS;
@@ -711,55 +708,33 @@ int _merge_from_arayeh(arayeh *self, size_t start_index, size_t step, arayeh *so
         // calculate memory growth size needed.
         size_t growthSize = endIndex - self_private_properties->size;
 
-        // decide to extend arayeh size based on arayeh settings.
-        switch (extend_size) {
-        case AA_ARAYEH_ON:
-            // extend arayeh size.
-            state = self->extend_size(self, growthSize);
-
-            // check for unsuccessful size extension.
-            if (state != AA_ARAYEH_SUCCESS) {
-                return state;
-            }
-            break;
-        case AA_ARAYEH_OFF:
+        // extend arayeh size only if settings allow it.
+        if (policy->extend_merge_arayeh == AA_ARAYEH_FALSE) {
             // write to stderr and return error code.
             WARN_WRONG_INDEX("_merge_from_arayeh() method, low memory space to merge!",
                              debug);
             return AA_ARAYEH_NOT_ENOUGH_SPACE;
-            // if manual is enabled, check against the correct extend size rule.
-        case AA_ARAYEH_MANUAL:
-            switch (extend_merge_arayeh) {
-            case AA_ARAYEH_ON:
-                // extend arayeh size.
-                state = self->extend_size(self, growthSize);
-
-                // check for unsuccessful size extension.
-                if (state != AA_ARAYEH_SUCCESS) {
-                    return state;
-                }
-                break;
-            case AA_ARAYEH_OFF:
-                // write to stderr and return error code.
-                WARN_WRONG_INDEX("_merge_from_arayeh() method, low memory space to merge",
-                                 debug);
-                return AA_ARAYEH_NOT_ENOUGH_SPACE;
-            default:
-                FATAL_WRONG_SETTINGS("_merge_from_arayeh() method, extend_merge_arayeh "
-                                     "value is not correct.",
-                                     AA_ARAYEH_TRUE);
-            }
-            break;
-        default:
-            FATAL_WRONG_SETTINGS(
-                "_merge_from_arayeh() method, extend_size value is not correct.",
-                AA_ARAYEH_TRUE);
+        }
+
+        // extend arayeh size.
+        state = self->extend_size(self, growthSize);
+
+        // check for unsuccessful size extension.
+        if (state != AA_ARAYEH_SUCCESS) {
+            return state;
         }
     }
 
     // insert source arayeh elements into self arayeh.
     // updating arayeh parameters is delegated to "insert" method.
-    state = self_private_methods->merge_from_arayeh(self, start_index, step, source);
+    // cells of narrowed or packed arayehs are read and written element by
+    // element, so both arayehs keep their storage.
+    if (self_private_properties->storage_type != self_private_properties->type ||
+        source_private_properties->storage_type != source_private_properties->type) {
+        state = _merge_arayeh_type_element(self, start_index, step, source);
+    } else {
+        state = self_private_methods->merge_from_arayeh(self, start_index, step, source);
+    }
 
     // update next index pointer.
     update_next_index(self);
@@ -796,18 +771,23 @@ int _merge_from_array(arayeh *self, size_t start_index, size_t step, size_t arra
      *
      */
 
+    // gap buffer mode, put cells at their logical index.
+    close_gap(self);
+
+    // narrowed arayeh, cells must be of arayeh type.
+    if (widen_storage(self) != AA_ARAYEH_SUCCESS) {
+        return AA_ARAYEH_REALLOC_DENIED;
+    }
+
     // shorten names for god's sake.
     struct private_methods *private_methods       = &self->_private_methods;
     struct private_properties *private_properties = &self->_private_properties;
 
     // shorten setting names.
-    char debug_messages = private_properties->settings->debug_messages;
-    char extend_size    = private_properties->settings->extend_size;
-    char extend_merge_array =
-        private_properties->settings->method_size->extend_merge_array;
+    struct arayeh_policy *policy = &private_properties->policy;
 
     // set debug flag.
-    int debug = debug_messages == AA_ARAYEH_ON ? AA_ARAYEH_TRUE : AA_ARAYEH_FALSE;
+    int debug = policy->debug;
 
     // track error state in the function.
     int state = AA_ARAYEH_SUCCESS;
@@ -845,49 +825,20 @@ int _merge_from_array(arayeh *self, size_t start_index, size_t step, size_t arra
         // calculate memory growth size needed.
         size_t growthSize = end_index - private_properties->size;
 
-        // decide to extend arayeh size based on arayeh settings.
-        switch (extend_size) {
-        case AA_ARAYEH_ON:
-            // extend arayeh size.
-            state = self->extend_size(self, growthSize);
-
-            // check for unsuccessful size extension.
-            if (state != AA_ARAYEH_SUCCESS) {
-                return state;
-            }
-            break;
-        case AA_ARAYEH_OFF:
+        // extend arayeh size only if settings allow it.
+        if (policy->extend_merge_array == AA_ARAYEH_FALSE) {
             // write to stderr and return error code.
             WARN_WRONG_INDEX("_merge_from_array() method, low memory space to merge!",
                              debug);
             return AA_ARAYEH_NOT_ENOUGH_SPACE;
-            // if manual is enabled, check against the correct extend size rule.
-        case AA_ARAYEH_MANUAL:
-            switch (extend_merge_array) {
-            case AA_ARAYEH_ON:
-                // extend arayeh size.
-                state = self->extend_size(self, growthSize);
-
-                // check for unsuccessful size extension.
-                if (state != AA_ARAYEH_SUCCESS) {
-                    return state;
-                }
-                break;
-            case AA_ARAYEH_OFF:
-                // write to stderr and return error code.
-                WARN_WRONG_INDEX("_merge_from_array() method, low memory space to merge",
-                                 debug);
-                return AA_ARAYEH_NOT_ENOUGH_SPACE;
-            default:
-                FATAL_WRONG_SETTINGS("_merge_from_array() method, extend_merge_array "
-                                     "value is not correct.",
-                                     AA_ARAYEH_TRUE);
-            }
-            break;
-        default:
-            FATAL_WRONG_SETTINGS(
-                "_merge_from_array() method, extend_size value is not correct.",
-                AA_ARAYEH_TRUE);
+        }
+
+        // extend arayeh size.
+        state = self->extend_size(self, growthSize);
+
+        // check for unsuccessful size extension.
+        if (state != AA_ARAYEH_SUCCESS) {
+            return state;
         }
     }
 
@@ -905,6 +856,8 @@ int _get_from_arayeh(arayeh *self, size_t index, void *destination)
      * This function copies data in "index" cell of the arayeh to the "destination"
      * memory location.
      *
+     * in gap buffer mode "index" is the logical index, the gap isn't moved.
+     *
      * ARGUMENTS:
      * self         pointer to the arayeh object.
      * index        index of the element to be copied.
@@ -928,6 +881,11 @@ int _get_from_arayeh(arayeh *self, size_t index, void *destination)
         return AA_ARAYEH_WRONG_INDEX;
     }
 
+    // skip the gap of gap buffer mode.
+    if (private_properties->gap_start != private_properties->gap_end) {
+        index = gap_physical_index(self, index);
+    }
+
     // copy data to destination memory location.
     private_methods->get_from_arayeh(self, index, destination);
 
@@ -935,51 +893,2756 @@ int _get_from_arayeh(arayeh *self, size_t index, void *destination)
     return AA_ARAYEH_SUCCESS;
 }
 
-void _set_settings(arayeh *self, arayeh_settings *new_settings)
+int _insert_shift_to_arayeh(arayeh *self, size_t index, void *element)
 {
     /*
-     * This function will override arayeh default settings with new one.
+     * This function inserts "element" at "index", the cells from "index" up to
+     * the last filled cell move one cell forward.
      *
      * ARGUMENTS:
-     * self              pointer to the arayeh object.
-     * new_settings      new setting to apply to arayeh.
+     * self         pointer to the arayeh object.
+     * index        index of the desired arayeh cell to insert the element.
+     * element      pointer to a variable to be inserted into the arayeh.
      *
      * RETURN:
-     * no return, it's void dude.
+     * state        a code that indicates successful operation
+     *              or an error code defined in arayeh.h .
+     *
+     */
+
+    return self->insert_range_shift(self, index, 1, element);
+}
+
+int _insert_range_shift_to_arayeh(arayeh *self, size_t index, size_t count,
+                                  void *array)
+{
+    /*
+     * This function inserts "count" elements of C array "array" at "index", the
+     * cells from "index" up to the last filled cell move "count" cells forward.
+     *
+     * the tail is moved with a single memmove of data and map, and the arayeh
+     * grows at most once through the growth factor function, so inserting a
+     * batch costs one move instead of "count" moves.
+     *
+     * in gap buffer mode the elements are written into the gap after moving it
+     * to "index", only the cells between the old and new edit point move. when
+     * the gap is too small, the tail is moved to the end of arayeh instead of
+     * "count" cells forward, which opens a new gap after the inserted cells.
+     *
+     * shifting changes the index of cells, so the hash index is dropped.
+     * elements of half precision and string arayehs are converted into their
+     * cells one by one, the bytes of strings are reserved at once.
+     *
+     * ARGUMENTS:
+     * self         pointer to the arayeh object.
+     * index        index of the first inserted cell.
+     * count        number of elements in "array".
+     * array        pointer to a C array with the same type as arayeh.
+     *
+     * RETURN:
+     * state        a code that indicates successful operation
+     *              or an error code defined in arayeh.h .
      *
      */
 
     // shorten names for god's sake.
-    arayeh_settings *settings = self->_private_properties.settings;
+    struct private_properties *private_properties = &self->_private_properties;
 
-    // override new settings.
-    settings->debug_messages = new_settings->debug_messages;
-    settings->extend_size    = new_settings->extend_size;
+    // narrowed arayeh, cells must be of arayeh type, packed booleans move as bits.
+    if (private_properties->storage_type != AA_ARAYEH_STORAGE_BIT &&
+        widen_storage(self) != AA_ARAYEH_SUCCESS) {
+        return AA_ARAYEH_REALLOC_DENIED;
+    }
+
+    // shorten setting names.
+    char gap_buffer = private_properties->settings->gap_buffer;
+    struct arayeh_policy *policy = &private_properties->policy;
+
+    // set debug flag.
+    int debug = policy->debug;
+
+    // track error state in the function.
+    int state;
+
+    size_t element_size = private_properties->element_size;
+    size_t gap_length   = private_properties->gap_end - private_properties->gap_start;
+
+    // nothing to insert.
+    if (count == 0) {
+        return AA_ARAYEH_SUCCESS;
+    }
+
+    // string arayeh, make room for the bytes of elements in the arena.
+    const arayeh_string *strings = (const arayeh_string *) array;
+    uintptr_t arena_base         = (uintptr_t) private_properties->arena.bytes;
+    size_t arena_used            = private_properties->arena.used;
+    if (private_properties->type == AA_ARAYEH_TYPE_STRING) {
+        state = arena_reserve(self, arena_new_bytes(self, strings, count));
+        if (state != AA_ARAYEH_SUCCESS) {
+            return state;
+        }
+    }
+
+    if (count <= gap_length && index <= private_properties->size - gap_length) {
+        // gap buffer mode, the gap is big enough, move it to "index".
+        hash_index_free(self);
+        move_gap(self, index);
+        private_properties->gap_start += count;
+    } else {
+        // cells must be at their logical index.
+        close_gap(self);
+
+        // cells from "index" up to "top" move forward.
+        size_t top    = find_top_index(self);
+        size_t tail   = (top > index) ? top - index : 0;
+        size_t bottom = (top > index) ? top : index;
+
+        // check for size_t overflow.
+        if (count > SIZE_MAX - bottom) {
+            WARN_T_OVERFLOW("_insert_range_shift_to_arayeh()", debug);
+            return AA_ARAYEH_OVERFLOW;
+        }
+
+        // check if arayeh is big enough.
+        if (private_properties->size < bottom + count) {
+            // extend arayeh size only if settings allow it.
+            if (policy->extend_insert == AA_ARAYEH_FALSE) {
+                // write to stderr and return error code.
+                WARN_WRONG_INDEX("_insert_range_shift_to_arayeh() method, not "
+                                 "enough space left in the arayeh.",
+                                 debug);
+                return AA_ARAYEH_NOT_ENOUGH_SPACE;
+            }
+
+            // extend arayeh size once.
+            state = auto_extend_memory_to(self, bottom + count);
+
+            // check for unsuccessful size extension.
+            if (state != AA_ARAYEH_SUCCESS) {
+                return state;
+            }
+        }
+
+        // shifting changes the index of cells, drop the hash index.
+        hash_index_free(self);
+
+        if (gap_buffer == AA_ARAYEH_ON && tail != 0) {
+            // move the tail to the end of arayeh, the empty cells between the
+            // inserted cells and the tail become the gap.
+            size_t gap_start = index + count;
+            size_t gap_end   = gap_start + private_properties->size - top - count;
+            move_cells(self, gap_end, index, tail);
+
+            // empty the cells that weren't overwritten.
+            if (top > gap_start) {
+                memset(private_properties->map + gap_start, AA_ARAYEH_OFF,
+                       (top < gap_end ? top : gap_end) - gap_start);
+            }
+
+            private_properties->gap_start = gap_start;
+            private_properties->gap_end   = gap_end;
+        } else {
+            // move the tail forward.
+            move_cells(self, index + count, index, tail);
+        }
+    }
+
+    // copy the new elements and fill their map.
+    if (cells_are_elements(self)) {
+        memcpy(private_properties->array.char_pointer + index * element_size, array,
+               count * element_size);
+    } else if (private_properties->type == AA_ARAYEH_TYPE_STRING) {
+        for (size_t offset = 0; offset < count; offset++) {
+            arena_store(self, index + offset, &strings[offset], arena_base, arena_used);
+        }
+    } else {
+        size_t value_size = element_value_size(self);
+        for (size_t offset = 0; offset < count; offset++) {
+            self->_private_methods.add_to_arayeh(self, index + offset,
+                                                 (char *) array + offset * value_size);
+        }
+    }
+    memset(private_properties->map + index, AA_ARAYEH_ON, count);
+
+    // update both public and private "used" counter.
+    private_properties->used += count;
+    self->used = private_properties->used;
+
+    // cells before "next" are filled, so the first empty cell moves with the tail.
+    if (index <= private_properties->next) {
+        private_properties->next += count;
+        self->next = private_properties->next;
+    }
+
+    // return success code.
+    return AA_ARAYEH_SUCCESS;
 }
 
-void _set_size_settings(arayeh *self, arayeh_size_settings *new_settings)
+int _delete_item_from_arayeh(arayeh *self, size_t index, char shift)
 {
     /*
-     * This function will override arayeh default extend size settings with new one.
+     * This function empties the cell at "index".
+     *
+     * if "shift" is AA_ARAYEH_ON, the cells after "index" move one cell backward,
+     * so the arayeh keeps its order without a hole.
      *
      * ARGUMENTS:
-     * self              pointer to the arayeh object.
-     * new_settings      new setting to apply to arayeh.
+     * self         pointer to the arayeh object.
+     * index        index of the cell to be emptied.
+     * shift        AA_ARAYEH_ON to close the gap, AA_ARAYEH_OFF to leave it empty.
      *
      * RETURN:
-     * no return, it's void dude.
+     * state        a code that indicates successful operation
+     *              or an error code defined in arayeh.h .
      *
      */
 
     // shorten names for god's sake.
-    arayeh_size_settings *settings = self->_private_properties.settings->method_size;
+    struct private_properties *private_properties = &self->_private_properties;
 
-    // override new settings.
-    settings->extend_add          = new_settings->extend_add;
-    settings->extend_insert       = new_settings->extend_insert;
-    settings->extend_fill         = new_settings->extend_fill;
-    settings->extend_merge_arayeh = new_settings->extend_merge_arayeh;
-    settings->extend_merge_array  = new_settings->extend_merge_array;
+    // shorten setting names.
+    char debug_messages = private_properties->settings->debug_messages;
+
+    // set debug flag.
+    int debug = debug_messages == AA_ARAYEH_ON ? AA_ARAYEH_TRUE : AA_ARAYEH_FALSE;
+
+    // check arayeh bounds.
+    if (index >= private_properties->size) {
+        WARN_WRONG_INDEX("_delete_item_from_arayeh() method, index out of range!", debug);
+        return AA_ARAYEH_WRONG_INDEX;
+    }
+
+    return self->delete_slice(self, index, 1, index + 1, shift);
+}
+
+int _delete_slice_from_arayeh(arayeh *self, size_t start_index, size_t step,
+                              size_t end_index, char shift)
+{
+    /*
+     * This function empties cells from index (inclusive) "start_index" to index
+     * (exclusive) "end_index" with step size "step".
+     *
+     * "used" is decreased by the number of filled cells in the slice, which are
+     * counted 64 cells at a time from the map, and "next" is moved back to
+     * "start_index" if needed, so the arayeh is never rescanned.
+     *
+     * if "shift" is AA_ARAYEH_ON, the cells that are not deleted move backward
+     * to close the gaps, each of them is moved once with memmove. shifting moves
+     * cells, so the hash index is dropped.
+     *
+     * in gap buffer mode a shifting delete with step 1 moves the gap to
+     * "end_index" and grows it backward over the deleted cells, so only the
+     * cells between the old and new edit point move.
+     *
+     * ARGUMENTS:
+     * self          pointer to the arayeh object.
+     * start_index   starting index (inclusive).
+     * step          step size.
+     * end_index     ending index (exclusive).
+     * shift         AA_ARAYEH_ON to close the gaps, AA_ARAYEH_OFF to leave them.
+     *
+     * RETURN:
+     * state        a code that indicates successful operation
+     *              or an error code defined in arayeh.h .
+     *
+     */
+
+    // shorten names for god's sake.
+    struct private_properties *private_properties = &self->_private_properties;
+
+    // shorten setting names.
+    char debug_messages = private_properties->settings->debug_messages;
+
+    // set debug flag.
+    int debug = debug_messages == AA_ARAYEH_ON ? AA_ARAYEH_TRUE : AA_ARAYEH_FALSE;
+
+    char *map         = private_properties->map;
+    size_t removed    = 0;
+    size_t gap_length = private_properties->gap_end - private_properties->gap_start;
+
+    // check if starting index being greater than the ending index.
+    if (end_index < start_index) {
+        WARN_WRONG_INDEX("_delete_slice_from_arayeh() method, start_index index is "
+                         "greater than end_index index!",
+                         debug);
+        return AA_ARAYEH_WRONG_INDEX;
+    }
+
+    // check step size.
+    if (step <= 0) {
+        WARN_WRONG_STEP(
+            "_delete_slice_from_arayeh() method, step should be bigger or equal to 1!",
+            debug);
+        return AA_ARAYEH_WRONG_STEP;
+    }
+
+    // check arayeh bounds.
+    if (private_properties->size < end_index) {
+        WARN_WRONG_INDEX("_delete_slice_from_arayeh() method, end_index is greater "
+                         "than arayeh size!",
+                         debug);
+        return AA_ARAYEH_WRONG_INDEX;
+    }
+
+    // nothing to delete.
+    if (start_index == end_index) {
+        return AA_ARAYEH_SUCCESS;
+    }
+
+    // gap buffer mode, delete the cells just before the gap.
+    if (private_properties->settings->gap_buffer == AA_ARAYEH_ON &&
+        shift == AA_ARAYEH_ON && step == 1 &&
+        end_index <= private_properties->size - gap_length) {
+        hash_index_free(self);
+        move_gap(self, end_index);
+
+        removed = count_filled_cells(map, start_index, end_index);
+        memset(map + start_index, AA_ARAYEH_OFF, end_index - start_index);
+        private_properties->gap_start = start_index;
+
+        // update both public and private "used" counter.
+        private_properties->used -= removed;
+        self->used = private_properties->used;
+
+        // cells after the slice moved "end_index - start_index" cells backward.
+        size_t next    = private_properties->next;
+        size_t gap_end = private_properties->gap_end;
+        if (next >= end_index) {
+            next -= end_index - start_index;
+        } else if (next >= start_index) {
+            next = start_index +
+                   find_empty_cell(map, gap_end, private_properties->size) - gap_end;
+        }
+
+        // update both public and private next property.
+        private_properties->next = next;
+        self->next               = next;
+
+        // return success code.
+        return AA_ARAYEH_SUCCESS;
+    }
+
+    // cells must be at their logical index.
+    close_gap(self);
+
+    // shifting changes the index of cells, drop the hash index.
+    if (shift == AA_ARAYEH_ON) {
+        hash_index_free(self);
+    }
+
+    if (step == 1) {
+        // count filled cells in bulk.
+        removed = count_filled_cells(map, start_index, end_index);
+
+        // remove deleted cells from hash index.
+        if (private_properties->hash_index != NULL) {
+            for (size_t block = start_index; block < end_index; block += 64) {
+                size_t length = (end_index - block < 64) ? end_index - block : 64;
+                uint64_t mask = map_block_mask(map, block, length);
+                for (; mask != 0; mask &= mask - 1) {
+                    hash_index_remove(self, block + count_trailing_zeros(mask));
+                }
+            }
+        }
+
+        size_t tail = 0;
+        if (shift == AA_ARAYEH_ON) {
+            // move the cells after the slice to its beginning.
+            size_t top = find_top_index(self);
+            tail       = (top > end_index) ? top - end_index : 0;
+            move_cells(self, start_index, end_index, tail);
+        }
+
+        // empty the slice (or the cells left behind by the move).
+        memset(map + start_index + tail, AA_ARAYEH_OFF, end_index - start_index);
+    } else if (shift != AA_ARAYEH_ON) {
+        for (size_t index = start_index; index < end_index;
+             index = (step > end_index - index) ? end_index : index + step) {
+            if (map[index] == AA_ARAYEH_ON) {
+                hash_index_remove(self, index);
+                map[index] = AA_ARAYEH_OFF;
+                removed++;
+            }
+        }
+    } else {
+        size_t top         = find_top_index(self);
+        size_t write_index = start_index;
+
+        // move the runs of cells between deleted cells backward.
+        for (size_t index = start_index; index < end_index;
+             index = (step > end_index - index) ? end_index : index + step) {
+            if (map[index] == AA_ARAYEH_ON) {
+                removed++;
+            }
+
+            size_t run_end = (step > end_index - index) ? end_index : index + step;
+            move_cells(self, write_index, index + 1, run_end - index - 1);
+            write_index += run_end - index - 1;
+        }
+
+        // move the cells after the slice.
+        if (top > end_index) {
+            move_cells(self, write_index, end_index, top - end_index);
+            write_index += top - end_index;
+        }
+
+        // empty the cells left behind.
+        size_t old_end = (top > end_index) ? top : end_index;
+        memset(map + write_index, AA_ARAYEH_OFF, old_end - write_index);
+    }
+
+    // update both public and private "used" counter.
+    private_properties->used -= removed;
+    self->used = private_properties->used;
+
+    // the first deleted cell is empty now, unless shifting filled it again.
+    if (start_index <= private_properties->next) {
+        private_properties->next = start_index;
+        self->next               = start_index;
+        if (shift == AA_ARAYEH_ON) {
+            update_next_index(self);
+        }
+    }
+
+    // return success code.
+    return AA_ARAYEH_SUCCESS;
+}
+
+int _pop_from_arayeh(arayeh *self, void *destination)
+{
+    /*
+     * This function copies the last filled cell to "destination" and empties it.
+     *
+     * ARGUMENTS:
+     * self         pointer to the arayeh object.
+     * destination  pointer to the destination memory location, or NULL.
+     *
+     * RETURN:
+     * state        a code that indicates successful operation
+     *              or an error code defined in arayeh.h .
+     *
+     */
+
+    // gap buffer mode, put cells at their logical index.
+    close_gap(self);
+
+    // shorten names for god's sake.
+    struct private_methods *private_methods       = &self->_private_methods;
+    struct private_properties *private_properties = &self->_private_properties;
+
+    // shorten setting names.
+    char debug_messages = private_properties->settings->debug_messages;
+
+    // set debug flag.
+    int debug = debug_messages == AA_ARAYEH_ON ? AA_ARAYEH_TRUE : AA_ARAYEH_FALSE;
+
+    size_t top = find_top_index(self);
+
+    // check for empty arayeh.
+    if (top == 0) {
+        WARN_WRONG_INDEX("_pop_from_arayeh() method, arayeh is empty!", debug);
+        return AA_ARAYEH_EMPTY;
+    }
+
+    // copy data to destination memory location.
+    if (destination != NULL) {
+        private_methods->get_from_arayeh(self, top - 1, destination);
+    }
+
+    return self->delete_slice(self, top - 1, 1, top, AA_ARAYEH_OFF);
+}
+
+int _get_range_from_arayeh(arayeh *self, size_t start_index, size_t count,
+                           void *destination, void *fill_value)
+{
+    /*
+     * This function copies "count" cells starting from "start_index" into the C
+     * array "destination" with a single memcpy.
+     *
+     * if "fill_value" isn't NULL, empty cells are replaced by it, the map is
+     * checked in blocks of 64 cells so fully filled blocks cost nothing extra.
+     *
+     * ARGUMENTS:
+     * self         pointer to the arayeh object.
+     * start_index  index of the first cell.
+     * count        number of cells to copy.
+     * destination  C array of arayeh type, at least "count" elements long.
+     * fill_value   pointer to a variable that replaces empty cells, or NULL.
+     *
+     * RETURN:
+     * state        a code that indicates successful operation
+     *              or an error code defined in arayeh.h .
+     *
+     */
+
+    // gap buffer mode, put cells at their logical index.
+    close_gap(self);
+
+    // shorten names for god's sake.
+    struct private_properties *private_properties = &self->_private_properties;
+
+    // shorten setting names.
+    char debug_messages = private_properties->settings->debug_messages;
+
+    // set debug flag.
+    int debug = debug_messages == AA_ARAYEH_ON ? AA_ARAYEH_TRUE : AA_ARAYEH_FALSE;
+
+    size_t size         = private_properties->size;
+    size_t element_size = wide_cell_size(self);
+
+    // check arayeh bounds, written this way to avoid size_t overflow.
+    if (start_index > size || count > size - start_index) {
+        WARN_WRONG_INDEX("_get_range_from_arayeh() method, range out of arayeh!", debug);
+        return AA_ARAYEH_WRONG_INDEX;
+    }
+
+    // copy cells.
+    read_cells(self, destination, start_index, count);
+
+    if (fill_value == NULL) {
+        return AA_ARAYEH_SUCCESS;
+    }
+
+    // replace empty cells.
+    for (size_t block = 0; block < count; block += 64) {
+        size_t length = (count - block < 64) ? count - block : 64;
+        uint64_t full = (length == 64) ? UINT64_MAX : ((uint64_t) 1 << length) - 1;
+        uint64_t mask =
+            ~map_block_mask(private_properties->map, start_index + block, length);
+
+        for (mask &= full; mask != 0; mask &= mask - 1) {
+            size_t position = block + count_trailing_zeros(mask);
+            copy_element((char *) destination + position * element_size, fill_value,
+                         element_size);
+        }
+    }
+
+    // return success code.
+    return AA_ARAYEH_SUCCESS;
+}
+
+int _get_indices_from_arayeh(arayeh *self, size_t *indices, size_t count,
+                             void *destination, void *fill_value)
+{
+    /*
+     * This function copies the cells at "indices" into the C array "destination",
+     * destination[i] receives the cell at indices[i].
+     *
+     * if "fill_value" isn't NULL, empty cells are replaced by it. if an index
+     * is out of range, the cells before it are copied and an error is returned.
+     *
+     * ARGUMENTS:
+     * self         pointer to the arayeh object.
+     * indices      C array of indices to copy.
+     * count        number of indices.
+     * destination  C array of arayeh type, at least "count" elements long.
+     * fill_value   pointer to a variable that replaces empty cells, or NULL.
+     *
+     * RETURN:
+     * state        a code that indicates successful operation
+     *              or an error code defined in arayeh.h .
+     *
+     */
+
+    // gap buffer mode, put cells at their logical index.
+    close_gap(self);
+
+    // shorten names for god's sake.
+    struct private_properties *private_properties = &self->_private_properties;
+
+    // shorten setting names.
+    char debug_messages = private_properties->settings->debug_messages;
+
+    // set debug flag.
+    int debug = debug_messages == AA_ARAYEH_ON ? AA_ARAYEH_TRUE : AA_ARAYEH_FALSE;
+
+    // copy cells.
+    size_t copied = 0;
+    if (private_properties->storage_type == private_properties->type) {
+        char *array_pointer = private_properties->array.char_pointer;
+        copied = gather_cells((char *) destination, array_pointer,
+                              private_properties->map, private_properties->size, indices,
+                              count, private_properties->element_size, fill_value);
+    } else {
+        // narrowed and packed cells are converted one by one.
+        size_t element_size = wide_cell_size(self);
+
+        for (; copied < count && indices[copied] < private_properties->size; copied++) {
+            size_t index = indices[copied];
+            char *cell   = (char *) destination + copied * element_size;
+
+            if (fill_value != NULL && private_properties->map[index] != AA_ARAYEH_ON) {
+                copy_element(cell, fill_value, element_size);
+            } else {
+                read_cells(self, cell, index, 1);
+            }
+        }
+    }
+
+    // check arayeh bounds.
+    if (copied != count) {
+        WARN_WRONG_INDEX("_get_indices_from_arayeh() method, index out of range!", debug);
+        return AA_ARAYEH_WRONG_INDEX;
+    }
+
+    // return success code.
+    return AA_ARAYEH_SUCCESS;
+}
+
+int _view_arayeh(arayeh *self, arayeh_view *view)
+{
+    /*
+     * This function fills "view" with pointers to the arayeh memory and map,
+     * so elements can be read in place (by hot loops or by external libraries)
+     * without copying them one by one.
+     *
+     * the view is read only and it's valid until the next call that changes
+     * the arayeh, because such a call may reallocate or move the memory. a
+     * narrowed arayeh is widened and a packed bool arayeh is unpacked for good,
+     * call narrow method to store it narrow again.
+     *
+     * ARGUMENTS:
+     * self         pointer to the arayeh object.
+     * view         pointer to the view to be filled.
+     *
+     * RETURN:
+     * state        a code that indicates successful operation
+     *              or an error code defined in arayeh.h .
+     *
+     */
+
+    // gap buffer mode, put cells at their logical index.
+    close_gap(self);
+
+    // narrowed arayeh, cells must be of arayeh type.
+    if (widen_storage(self) != AA_ARAYEH_SUCCESS) {
+        return AA_ARAYEH_REALLOC_DENIED;
+    }
+
+    // shorten names for god's sake.
+    struct private_properties *private_properties = &self->_private_properties;
+
+    view->type         = private_properties->type;
+    view->size         = private_properties->size;
+    view->used         = private_properties->used;
+    view->element_size = private_properties->element_size;
+    view->array        = private_properties->array;
+    view->map          = private_properties->map;
+    view->arena        = private_properties->arena.bytes;
+
+    // return success code.
+    return AA_ARAYEH_SUCCESS;
+}
+
+int _iter_begin_arayeh(arayeh *self, arayeh_iterator *iterator)
+{
+    /*
+     * This function prepares "iterator" for visiting filled cells of arayeh in
+     * order of their index, the first call to iter_next moves it to the first
+     * filled cell. like view method, it widens and unpacks cells for good.
+     *
+     * ARGUMENTS:
+     * self         pointer to the arayeh object.
+     * iterator     pointer to the iterator to be prepared.
+     *
+     * RETURN:
+     * state        a code that indicates successful operation
+     *              or an error code defined in arayeh.h .
+     *
+     */
+
+    // gap buffer mode, put cells at their logical index.
+    close_gap(self);
+
+    // narrowed arayeh, cells must be of arayeh type.
+    if (widen_storage(self) != AA_ARAYEH_SUCCESS) {
+        return AA_ARAYEH_REALLOC_DENIED;
+    }
+
+    iterator->index        = 0;
+    iterator->element      = NULL;
+    iterator->_block_index = 0;
+    iterator->_block_mask  = 0;
+
+    // return success code.
+    return AA_ARAYEH_SUCCESS;
+}
+
+int _iter_next_arayeh(arayeh *self, arayeh_iterator *iterator)
+{
+    /*
+     * This function moves "iterator" to the next filled cell.
+     *
+     * the map is converted to a bitmask 64 cells at a time, empty blocks are
+     * skipped as a whole and filled cells of a block are visited by counting
+     * trailing zeros, so sparse arayehs are walked without checking every cell.
+     *
+     * ARGUMENTS:
+     * self         pointer to the arayeh object.
+     * iterator     pointer to an iterator prepared by iter_begin.
+     *
+     * RETURN:
+     * AA_ARAYEH_TRUE if iterator moved to a filled cell, AA_ARAYEH_FALSE if
+     * there is no filled cell left.
+     *
+     */
+
+    // shorten names for god's sake.
+    struct private_properties *private_properties = &self->_private_properties;
+
+    size_t size = private_properties->size;
+
+    // find the next block with a filled cell.
+    while (iterator->_block_mask == 0) {
+        if (iterator->_block_index >= size) {
+            return AA_ARAYEH_FALSE;
+        }
+
+        size_t block  = iterator->_block_index;
+        size_t length = (size - block < 64) ? size - block : 64;
+
+        iterator->_block_mask  = map_block_mask(private_properties->map, block, length);
+        iterator->_block_index = block + length;
+    }
+
+    // visit the lowest filled cell of the block, blocks start at multiples of 64.
+    size_t block = (iterator->_block_index - 1) & ~(size_t) 63;
+    size_t index = block + count_trailing_zeros(iterator->_block_mask);
+    iterator->_block_mask &= iterator->_block_mask - 1;
+
+    iterator->index   = index;
+    iterator->element = private_properties->array.char_pointer +
+                        index * private_properties->element_size;
+
+    return AA_ARAYEH_TRUE;
+}
+
+int _pipeline_reduce_arayeh(arayeh *self, arayeh_pipeline *pipeline,
+                            arayeh_reducer reducer, void *accumulator)
+{
+    /*
+     * This function runs filled cells through the stages of "pipeline" and
+     * folds what is left into "accumulator" with "reducer".
+     *
+     * cells are processed in blocks of AA_ARAYEH_PIPELINE_BLOCK cells, each
+     * block is copied once into a small buffer and goes through every stage and
+     * the reducer while it's in cache, no intermediate arayeh is created.
+     *
+     * ARGUMENTS:
+     * self         pointer to the arayeh object.
+     * pipeline     pointer to the pipeline.
+     * reducer      function that folds blocks into "accumulator".
+     * accumulator  pointer to the initialized result of reduction.
+     *
+     * RETURN:
+     * state        a code that indicates successful operation
+     *              or an error code defined in arayeh.h .
+     *
+     */
+
+    // gap buffer mode, put cells at their logical index.
+    close_gap(self);
+
+    // narrowed arayeh, cells must be of arayeh type.
+    if (widen_storage(self) != AA_ARAYEH_SUCCESS) {
+        return AA_ARAYEH_REALLOC_DENIED;
+    }
+
+    // shorten names for god's sake.
+    struct private_properties *private_properties = &self->_private_properties;
+
+    // shorten setting names.
+    char debug_messages = private_properties->settings->debug_messages;
+
+    // set debug flag.
+    int debug = debug_messages == AA_ARAYEH_ON ? AA_ARAYEH_TRUE : AA_ARAYEH_FALSE;
+
+    size_t size         = private_properties->size;
+    size_t type         = private_properties->type;
+    size_t element_size = private_properties->element_size;
+
+    // half precision cells run through the pipeline as floats.
+    int as_floats = is_half_type(type);
+    if (as_floats) {
+        element_size = sizeof(float);
+    }
+
+    // buffer of one block.
+    char *block = (char *) malloc(AA_ARAYEH_PIPELINE_BLOCK * element_size);
+    if (block == NULL) {
+        WARN_MALLOC("_pipeline_reduce_arayeh()", debug);
+        return AA_ARAYEH_FAILURE;
+    }
+
+    for (size_t start_index = 0; start_index < size;
+         start_index += AA_ARAYEH_PIPELINE_BLOCK) {
+        size_t end_index = (size - start_index < AA_ARAYEH_PIPELINE_BLOCK)
+                               ? size
+                               : start_index + AA_ARAYEH_PIPELINE_BLOCK;
+
+        size_t count = load_filled_cells(self, start_index, end_index, block);
+        if (as_floats) {
+            convert_values(block, AA_ARAYEH_TYPE_FLOAT, block, type, count,
+                           AA_ARAYEH_CONVERT_WRAP);
+        }
+        count = run_pipeline_stages(pipeline, block, count);
+
+        if (count != 0) {
+            reducer(block, count, accumulator);
+        }
+    }
+
+    free(block);
+
+    // return success code.
+    return AA_ARAYEH_SUCCESS;
+}
+
+arayeh *_pipeline_collect_arayeh(arayeh *self, arayeh_pipeline *pipeline)
+{
+    /*
+     * This function runs filled cells through the stages of "pipeline" and
+     * returns what is left in a new arayeh, elements keep their order.
+     *
+     * blocks of AA_ARAYEH_PIPELINE_BLOCK cells are copied straight to their
+     * place in the new arayeh and go through every stage there, so there is
+     * no intermediate buffer. half precision blocks go through the stages as
+     * floats in a buffer and are converted back into the new arayeh.
+     *
+     * ARGUMENTS:
+     * self         pointer to the arayeh object.
+     * pipeline     pointer to the pipeline.
+     *
+     * RETURN:
+     * A pointer to the new arayeh.
+     * or
+     * return NULL in case of error.
+     *
+     */
+
+    // gap buffer mode, put cells at their logical index.
+    close_gap(self);
+
+    // narrowed arayeh, cells must be of arayeh type.
+    if (widen_storage(self) != AA_ARAYEH_SUCCESS) {
+        return NULL;
+    }
+
+    // shorten names for god's sake.
+    struct private_properties *private_properties = &self->_private_properties;
+
+    // shorten setting names.
+    char debug_messages = private_properties->settings->debug_messages;
+
+    // set debug flag.
+    int debug = debug_messages == AA_ARAYEH_ON ? AA_ARAYEH_TRUE : AA_ARAYEH_FALSE;
+
+    size_t size         = private_properties->size;
+    size_t element_size = private_properties->element_size;
+
+    // string cells point into the arena of arayeh, not of the new one.
+    if (private_properties->type == AA_ARAYEH_TYPE_STRING) {
+        WARN_WRONG_TYPE("_pipeline_collect_arayeh() method, string arayeh.", debug);
+        return NULL;
+    }
+
+    // stages never add elements, so "used" cells are enough, at least one cell
+    // is allocated, malloc() of zero bytes may return NULL.
+    size_t used    = private_properties->used;
+    arayeh *result = create_arayeh_like(self, used > 0 ? used : 1);
+
+    // check errors.
+    if (result == NULL) {
+        WARN_INIT_FAIL("_pipeline_collect_arayeh() method, can not create new arayeh.",
+                       debug);
+        return NULL;
+    }
+
+    // apply self settings to new arayeh.
+    result->set_settings(result, private_properties->settings);
+    result->set_size_settings(result, private_properties->settings->method_size);
+
+    // blocks are written directly, boolean cells must be unpacked.
+    if (widen_storage(result) != AA_ARAYEH_SUCCESS) {
+        result->free_arayeh(&result);
+        return NULL;
+    }
+
+    struct private_properties *result_properties = &result->_private_properties;
+    char *result_pointer                         = result_properties->array.char_pointer;
+    size_t written                               = 0;
+
+    // float buffer of one block for half precision cells.
+    size_t type  = private_properties->type;
+    char *floats = NULL;
+    if (is_half_type(type)) {
+        floats = (char *) malloc(AA_ARAYEH_PIPELINE_BLOCK * sizeof(float));
+        if (floats == NULL) {
+            WARN_MALLOC("_pipeline_collect_arayeh()", debug);
+            result->free_arayeh(&result);
+            return NULL;
+        }
+    }
+
+    for (size_t start_index = 0; start_index < size;
+         start_index += AA_ARAYEH_PIPELINE_BLOCK) {
+        size_t end_index = (size - start_index < AA_ARAYEH_PIPELINE_BLOCK)
+                               ? size
+                               : start_index + AA_ARAYEH_PIPELINE_BLOCK;
+
+        char *block = result_pointer + written * element_size;
+
+        if (floats == NULL) {
+            size_t count = load_filled_cells(self, start_index, end_index, block);
+            written += run_pipeline_stages(pipeline, block, count);
+            continue;
+        }
+
+        size_t count = load_filled_cells(self, start_index, end_index, floats);
+        convert_values(floats, AA_ARAYEH_TYPE_FLOAT, floats, type, count,
+                       AA_ARAYEH_CONVERT_WRAP);
+        count = run_pipeline_stages(pipeline, floats, count);
+        convert_values(block, type, floats, AA_ARAYEH_TYPE_FLOAT, count,
+                       AA_ARAYEH_CONVERT_WRAP);
+        written += count;
+    }
+
+    free(floats);
+
+    // update new arayeh map and counters.
+    memset(result_properties->map, AA_ARAYEH_ON, written);
+    result_properties->used = written;
+    result_properties->next = written;
+    result->used            = written;
+    result->next            = written;
+
+    // hand unused memory back.
+    if (written != 0 && written < result_properties->size) {
+        result->resize_memory(result, written);
+    }
+
+    return result;
+}
+
+int _writer_open_arayeh(arayeh *self, arayeh_writer *writer, size_t count)
+{
+    /*
+     * This function reserves "count" empty cells after the last filled cell and
+     * prepares "writer" for them.
+     *
+     * settings are checked and arayeh grows at most once here, so the push
+     * functions of arayeh_typed.h only store the value and move the cursor.
+     *
+     * ARGUMENTS:
+     * self         pointer to the arayeh object.
+     * writer       pointer to the writer to be prepared.
+     * count        number of cells to reserve.
+     *
+     * RETURN:
+     * state        a code that indicates successful operation
+     *              or an error code defined in arayeh.h .
+     *
+     */
+
+    // shorten names for god's sake.
+    struct private_properties *private_properties = &self->_private_properties;
+
+    // set debug flag.
+    int debug = private_properties->policy.debug;
+
+    // pushed bytes are stored as they are, boolean cells must be 0 or 1 and
+    // string cells must point into the arena.
+    if (private_properties->type == AA_ARAYEH_TYPE_BOOL ||
+        private_properties->type == AA_ARAYEH_TYPE_STRING) {
+        WARN_WRONG_TYPE("_writer_open_arayeh() method, bool or string arayeh.", debug);
+        return AA_ARAYEH_WRONG_TYPE;
+    }
+
+    return open_writer(self, writer, count);
+}
+
+int _writer_close_arayeh(arayeh *self, arayeh_writer *writer)
+{
+    /*
+     * This function marks the cells written by "writer" as filled and updates
+     * "used" and "next" once for all of them.
+     *
+     * ARGUMENTS:
+     * self         pointer to the arayeh object.
+     * writer       pointer to a writer prepared by writer_open.
+     *
+     * RETURN:
+     * state        a code that indicates successful operation
+     *              or an error code defined in arayeh.h .
+     *
+     */
+
+    // shorten names for god's sake.
+    struct private_properties *private_properties = &self->_private_properties;
+
+    // number of written cells, never more than the reserved cells.
+    char *cursor       = (writer->cursor < writer->end) ? writer->cursor : writer->end;
+    size_t count       = (size_t) (cursor - writer->begin) / writer->element_size;
+    size_t start_index = writer->start_index;
+
+    // fill the map in bulk.
+    memset(private_properties->map + start_index, AA_ARAYEH_ON, count);
+
+    // index the new elements.
+    if (private_properties->hash_index != NULL) {
+        for (size_t index = start_index; index < start_index + count; index++) {
+            hash_index_insert(self, index);
+        }
+    }
+
+    // update both public and private "used" counter.
+    private_properties->used += count;
+    self->used = private_properties->used;
+
+    // update "next" pointer if it was inside written cells.
+    if (private_properties->next >= start_index &&
+        private_properties->next < start_index + count) {
+        private_properties->next = start_index + count;
+        update_next_index(self);
+    }
+
+    // the writer can't be used anymore.
+    writer->cursor = writer->begin;
+    writer->end    = writer->begin;
+
+    // return success code.
+    return AA_ARAYEH_SUCCESS;
+}
+
+int _for_each_arayeh(arayeh *self, arayeh_visitor visitor, void *context)
+{
+    /*
+     * This function calls "visitor" with the index and a pointer to every filled
+     * cell, in order of index.
+     *
+     * cells are split into blocks of AA_ARAYEH_PARALLEL_BLOCK cells, if the
+     * library is built with OpenMP and "parallel" setting is on, blocks are
+     * given to several threads, so "visitor" must be thread safe.
+     *
+     * ARGUMENTS:
+     * self         pointer to the arayeh object.
+     * visitor      function to call.
+     * context      pointer passed to every call of "visitor".
+     *
+     * RETURN:
+     * state        a code that indicates successful operation
+     *              or an error code defined in arayeh.h .
+     *
+     */
+
+    // gap buffer mode, put cells at their logical index.
+    close_gap(self);
+
+    // narrowed arayeh, cells must be of arayeh type.
+    if (widen_storage(self) != AA_ARAYEH_SUCCESS) {
+        return AA_ARAYEH_REALLOC_DENIED;
+    }
+
+    // shorten names for god's sake.
+    struct private_properties *private_properties = &self->_private_properties;
+
+    size_t size  = private_properties->size;
+    int parallel = private_properties->settings->parallel == AA_ARAYEH_ON;
+
+#ifdef _OPENMP
+#    pragma omp parallel for schedule(dynamic) if (parallel)
+#endif
+    for (size_t block = 0; block < size; block += AA_ARAYEH_PARALLEL_BLOCK) {
+        size_t end_index = (size - block < AA_ARAYEH_PARALLEL_BLOCK)
+                               ? size
+                               : block + AA_ARAYEH_PARALLEL_BLOCK;
+        visit_cells(self, block, end_index, visitor, context);
+    }
+
+    // return success code.
+    return AA_ARAYEH_SUCCESS;
+}
+
+int _transform_arayeh(arayeh *self, arayeh_transformer transformer, void *context)
+{
+    /*
+     * This function calls "transformer" with the index and a pointer to every
+     * filled cell, so it can change the cell in place.
+     *
+     * cells are split into blocks of AA_ARAYEH_PARALLEL_BLOCK cells, if the
+     * library is built with OpenMP and "parallel" setting is on, blocks are
+     * given to several threads, so "transformer" must be thread safe.
+     *
+     * ARGUMENTS:
+     * self         pointer to the arayeh object.
+     * transformer  function to call.
+     * context      pointer passed to every call of "transformer".
+     *
+     * RETURN:
+     * state        a code that indicates successful operation
+     *              or an error code defined in arayeh.h .
+     *
+     */
+
+    // gap buffer mode, put cells at their logical index.
+    close_gap(self);
+
+    // narrowed arayeh, cells must be of arayeh type.
+    if (widen_storage(self) != AA_ARAYEH_SUCCESS) {
+        return AA_ARAYEH_REALLOC_DENIED;
+    }
+
+    // shorten names for god's sake.
+    struct private_properties *private_properties = &self->_private_properties;
+
+    // cells are changed, values in the hash index would be stale.
+    hash_index_free(self);
+
+    size_t size  = private_properties->size;
+    int parallel = private_properties->settings->parallel == AA_ARAYEH_ON;
+
+#ifdef _OPENMP
+#    pragma omp parallel for schedule(dynamic) if (parallel)
+#endif
+    for (size_t block = 0; block < size; block += AA_ARAYEH_PARALLEL_BLOCK) {
+        size_t end_index = (size - block < AA_ARAYEH_PARALLEL_BLOCK)
+                               ? size
+                               : block + AA_ARAYEH_PARALLEL_BLOCK;
+        transform_cells(self, block, end_index, transformer, context);
+    }
+
+    // return success code.
+    return AA_ARAYEH_SUCCESS;
+}
+
+arayeh *_map_to_arayeh(arayeh *self, size_t type, arayeh_mapper mapper, void *context)
+{
+    /*
+     * This function creates a new arayeh of "type" with the same size and map,
+     * every filled cell of it is written by "mapper" from the cell with the same
+     * index in arayeh.
+     *
+     * cells are split into blocks of AA_ARAYEH_PARALLEL_BLOCK cells, if the
+     * library is built with OpenMP and "parallel" setting is on, blocks are
+     * given to several threads, so "mapper" must be thread safe.
+     *
+     * ARGUMENTS:
+     * self         pointer to the arayeh object.
+     * type         type of the new arayeh.
+     * mapper       function to call.
+     * context      pointer passed to every call of "mapper".
+     *
+     * RETURN:
+     * A pointer to the new arayeh.
+     * or
+     * return NULL in case of error.
+     *
+     */
+
+    // shorten names for god's sake.
+    struct private_properties *private_properties = &self->_private_properties;
+
+    // shorten setting names.
+    char debug_messages = private_properties->settings->debug_messages;
+
+    // set debug flag.
+    int debug = debug_messages == AA_ARAYEH_ON ? AA_ARAYEH_TRUE : AA_ARAYEH_FALSE;
+
+    // mappers write cells, string cells must point into an arena and generic
+    // cells need the element size of arayeh.
+    if (type == AA_ARAYEH_TYPE_STRING ||
+        (type != private_properties->type && type != AA_ARAYEH_TYPE_BOOL &&
+         is_numeric_type(type) == AA_ARAYEH_FALSE)) {
+        WARN_WRONG_TYPE("_map_to_arayeh() method, wrong type of new arayeh.", debug);
+        return NULL;
+    }
+
+    // gap buffer mode, put cells at their logical index.
+    close_gap(self);
+
+    // narrowed arayeh, cells must be of arayeh type.
+    if (widen_storage(self) != AA_ARAYEH_SUCCESS) {
+        return NULL;
+    }
+
+    // create new arayeh with the same size.
+    arayeh *result = (type == private_properties->type)
+                         ? create_arayeh_like(self, private_properties->size)
+                         : Arayeh(type, private_properties->size);
+
+    // check errors.
+    if (result == NULL) {
+        WARN_INIT_FAIL("_map_to_arayeh() method, can not create new arayeh.", debug);
+        return NULL;
+    }
+
+    // apply self settings to new arayeh.
+    result->set_settings(result, private_properties->settings);
+    result->set_size_settings(result, private_properties->settings->method_size);
+
+    // mappers write cells directly, boolean cells must be unpacked.
+    if (widen_storage(result) != AA_ARAYEH_SUCCESS) {
+        result->free_arayeh(&result);
+        return NULL;
+    }
+
+    // new arayeh has the same filled cells.
+    struct private_properties *result_properties = &result->_private_properties;
+    memcpy(result_properties->map, private_properties->map, private_properties->size);
+    result_properties->used = private_properties->used;
+    result_properties->next = private_properties->next;
+    result->used            = private_properties->used;
+    result->next            = private_properties->next;
+
+    size_t size  = private_properties->size;
+    int parallel = private_properties->settings->parallel == AA_ARAYEH_ON;
+
+#ifdef _OPENMP
+#    pragma omp parallel for schedule(dynamic) if (parallel)
+#endif
+    for (size_t block = 0; block < size; block += AA_ARAYEH_PARALLEL_BLOCK) {
+        size_t end_index = (size - block < AA_ARAYEH_PARALLEL_BLOCK)
+                               ? size
+                               : block + AA_ARAYEH_PARALLEL_BLOCK;
+        map_cells(self, block, end_index, mapper, result, context);
+    }
+
+    // packing stores boolean cells as 0 or 1, whatever mappers wrote.
+    if (type == AA_ARAYEH_TYPE_BOOL) {
+        result->narrow(result);
+    }
+
+    return result;
+}
+
+int _contains_in_arayeh(arayeh *self, void *element)
+{
+    /*
+     * This function checks if an "element" exists in the filled cells of the arayeh.
+     *
+     * float and double arayehs compare elements with the == operator, so
+     * NaN is never found and 0.0 and -0.0 are found for each other.
+     *
+     * ARGUMENTS:
+     * self         pointer to the arayeh object.
+     * element      pointer to a variable to be searched for.
+     *
+     * RETURN:
+     * AA_ARAYEH_TRUE if element exists in the arayeh, otherwise AA_ARAYEH_FALSE.
+     *
+     */
+
+    // gap buffer mode, put cells at their logical index.
+    close_gap(self);
+
+    // index of the element, not needed here.
+    size_t index;
+
+    return (self->find(self, element, &index) == AA_ARAYEH_SUCCESS) ? AA_ARAYEH_TRUE
+                                                                     : AA_ARAYEH_FALSE;
+}
+
+int _find_in_arayeh(arayeh *self, void *element, size_t *index)
+{
+    /*
+     * This function finds the first filled cell that holds "element".
+     *
+     * the arayeh is scanned in blocks of 64 cells, each block is converted into a
+     * bitmask of filled cells and blocks without any filled cell are skipped
+     * without comparing their values.
+     *
+     * ARGUMENTS:
+     * self         pointer to the arayeh object.
+     * element      pointer to a variable to be searched for.
+     * index        pointer to the location that receives the found index.
+     *
+     * RETURN:
+     * state        AA_ARAYEH_SUCCESS if element is found,
+     *              otherwise AA_ARAYEH_NOT_FOUND.
+     *
+     */
+
+    // gap buffer mode, put cells at their logical index.
+    close_gap(self);
+
+    // shorten names for god's sake.
+    struct private_methods *private_methods       = &self->_private_methods;
+    struct private_properties *private_properties = &self->_private_properties;
+
+    size_t size = private_properties->size;
+
+    // the head of the chain is the first cell holding element.
+    if (hash_index_ready(self) == AA_ARAYEH_TRUE) {
+        struct arayeh_hash_slot *slot = hash_index_lookup(self, element);
+        if (slot == NULL) {
+            return AA_ARAYEH_NOT_FOUND;
+        }
+        *index = slot->head;
+        return AA_ARAYEH_SUCCESS;
+    }
+
+    for (size_t block = 0; block < size; block += 64) {
+        // number of cells in this block.
+        size_t length = (size - block < 64) ? size - block : 64;
+
+        // skip blocks without any filled cell.
+        uint64_t mask = map_block_mask(private_properties->map, block, length);
+        if (mask == 0) {
+            continue;
+        }
+
+        // keep filled cells that are equal to element.
+        mask &= private_methods->match_block(self, block, length, element);
+        if (mask != 0) {
+            *index = block + count_trailing_zeros(mask);
+            return AA_ARAYEH_SUCCESS;
+        }
+    }
+
+    // element doesn't exist.
+    return AA_ARAYEH_NOT_FOUND;
+}
+
+size_t _count_in_arayeh(arayeh *self, void *element)
+{
+    /*
+     * This function counts the filled cells that hold "element".
+     *
+     * ARGUMENTS:
+     * self         pointer to the arayeh object.
+     * element      pointer to a variable to be counted.
+     *
+     * RETURN:
+     * count        number of filled cells equal to element.
+     *
+     */
+
+    // gap buffer mode, put cells at their logical index.
+    close_gap(self);
+
+    return self->find_all(self, element, NULL);
+}
+
+size_t _find_all_in_arayeh(arayeh *self, void *element, uint64_t *bitmap)
+{
+    /*
+     * This function marks every filled cell that holds "element" in a bitmap.
+     *
+     * bit (i % 64) of bitmap[i / 64] is set if cell i is filled and equal to
+     * element, otherwise it is cleared.
+     *
+     * ARGUMENTS:
+     * self         pointer to the arayeh object.
+     * element      pointer to a variable to be searched for.
+     * bitmap       array of AA_ARAYEH_MASK_SIZE(size) words that receives the
+     *              matches, pass NULL to only count the matches.
+     *
+     * RETURN:
+     * count        number of filled cells equal to element.
+     *
+     */
+
+    // gap buffer mode, put cells at their logical index.
+    close_gap(self);
+
+    // shorten names for god's sake.
+    struct private_methods *private_methods       = &self->_private_methods;
+    struct private_properties *private_properties = &self->_private_properties;
+
+    size_t size  = private_properties->size;
+    size_t count = 0;
+
+    // walk the chain of element instead of scanning the arayeh.
+    if (hash_index_ready(self) == AA_ARAYEH_TRUE) {
+        struct arayeh_hash_slot *slot = hash_index_lookup(self, element);
+        if (slot == NULL) {
+            count = 0;
+        } else {
+            count = slot->count;
+        }
+
+        if (bitmap != NULL) {
+            for (size_t word = 0; word < AA_ARAYEH_MASK_SIZE(size); word++) {
+                bitmap[word] = 0;
+            }
+            size_t *chain_next = private_properties->hash_index->chain_next;
+            for (size_t index = (slot != NULL) ? slot->head : AA_ARAYEH_HASH_NONE;
+                 index != AA_ARAYEH_HASH_NONE; index = chain_next[index]) {
+                bitmap[index / 64] |= (uint64_t) 1 << (index % 64);
+            }
+        }
+
+        return count;
+    }
+
+    for (size_t block = 0; block < size; block += 64) {
+        // number of cells in this block.
+        size_t length = (size - block < 64) ? size - block : 64;
+
+        // compare values only in blocks with filled cells.
+        uint64_t mask = map_block_mask(private_properties->map, block, length);
+        if (mask != 0) {
+            mask &= private_methods->match_block(self, block, length, element);
+        }
+
+        // save and count matches.
+        if (bitmap != NULL) {
+            bitmap[block / 64] = mask;
+        }
+        count += count_set_bits(mask);
+    }
+
+    return count;
+}
+
+int _build_hash_index(arayeh *self)
+{
+    /*
+     * This function builds a hash index of arayeh values.
+     *
+     * the index maps every value to the sorted chain of cells holding it and is
+     * kept up to date by every method that changes the arayeh, so contains,
+     * find_all and count run in expected O(1) time (find_all in O(matches)).
+     * set "hash_index" setting to ON to build the index on the first search
+     * instead.
+     *
+     * ARGUMENTS:
+     * self         pointer to the arayeh object.
+     *
+     * RETURN:
+     * state        a code that indicates successful operation
+     *              or an error code defined in arayeh.h .
+     *
+     */
+
+    // gap buffer mode, put cells at their logical index.
+    close_gap(self);
+
+    // narrowed arayeh, cells must be of arayeh type.
+    if (widen_storage(self) != AA_ARAYEH_SUCCESS) {
+        return AA_ARAYEH_REALLOC_DENIED;
+    }
+
+    return hash_index_build(self);
+}
+
+void _drop_hash_index(arayeh *self)
+{
+    /*
+     * This function frees the hash index of arayeh values.
+     *
+     * ARGUMENTS:
+     * self         pointer to the arayeh object.
+     *
+     * RETURN:
+     * no return, it's void dude.
+     *
+     */
+
+    hash_index_free(self);
+}
+
+int _compact_arayeh(arayeh *self)
+{
+    /*
+     * This function moves all filled cells to the beginning of the arayeh,
+     * keeping their order.
+     *
+     * after compaction cells 0 to "used" - 1 are filled and the rest are empty,
+     * "next" points to "used". the hash index is dropped because cells moved,
+     * it is rebuilt on the next search if "hash_index" setting is ON.
+     *
+     * ARGUMENTS:
+     * self         pointer to the arayeh object.
+     *
+     * RETURN:
+     * state        a code that indicates successful operation
+     *              or an error code defined in arayeh.h .
+     *
+     */
+
+    // gap buffer mode, put cells at their logical index.
+    close_gap(self);
+
+    // shorten names for god's sake.
+    struct private_properties *private_properties = &self->_private_properties;
+
+    size_t size         = private_properties->size;
+    size_t element_size = private_properties->element_size;
+    char *array_pointer = private_properties->array.char_pointer;
+    uint64_t *words     = private_properties->array.bool_pointer;
+    size_t write_index  = 0;
+
+    for (size_t block = 0; block < size; block += 64) {
+        size_t length = (size - block < 64) ? size - block : 64;
+        uint64_t mask = map_block_mask(private_properties->map, block, length);
+
+        // cells before the first hole are already in place.
+        if (write_index == block && length == 64 && mask == UINT64_MAX) {
+            write_index += 64;
+            continue;
+        }
+
+        // packed boolean cells of a block are one word.
+        if (private_properties->storage_type == AA_ARAYEH_STORAGE_BIT) {
+            size_t count = count_set_bits(mask);
+            write_bits(words, write_index, extract_bits(words[block / 64], mask), count);
+            write_index += count;
+            continue;
+        }
+
+        write_index += compress_block(array_pointer + write_index * element_size,
+                                      array_pointer + block * element_size, length, mask,
+                                      element_size);
+    }
+
+    // compacted cells are filled and the rest are empty.
+    memset(private_properties->map, AA_ARAYEH_ON, write_index);
+    memset(private_properties->map + write_index, AA_ARAYEH_OFF, size - write_index);
+
+    // update arayeh parameters.
+    private_properties->used = write_index;
+    private_properties->next = write_index;
+    self->used               = write_index;
+    self->next               = write_index;
+
+    // cells moved, old index is useless.
+    hash_index_free(self);
+
+    // return success code.
+    return AA_ARAYEH_SUCCESS;
+}
+
+size_t _pack_arayeh(arayeh *self, void *destination, size_t *indices)
+{
+    /*
+     * This function copies all filled cells into a C array, keeping their order.
+     *
+     * ARGUMENTS:
+     * self         pointer to the arayeh object.
+     * destination  C array of arayeh type, at least "used" elements long.
+     * indices      C array, at least "used" elements long, that receives the
+     *              arayeh index of every copied element, or NULL.
+     *
+     * RETURN:
+     * count        number of copied elements.
+     *
+     */
+
+    // gap buffer mode, put cells at their logical index.
+    close_gap(self);
+
+    // shorten names for god's sake.
+    struct private_properties *private_properties = &self->_private_properties;
+
+    size_t size         = private_properties->size;
+    size_t element_size = wide_cell_size(self);
+    char *array_pointer = private_properties->array.char_pointer;
+    int is_narrowed     = private_properties->storage_type != private_properties->type;
+    size_t count        = 0;
+
+    // a block of narrowed or packed cells converted into arayeh type.
+    uint64_t wide_cells[64];
+
+    for (size_t block = 0; block < size; block += 64) {
+        size_t length = (size - block < 64) ? size - block : 64;
+        uint64_t mask = map_block_mask(private_properties->map, block, length);
+
+        if (mask == 0) {
+            continue;
+        }
+
+        // save original indices of the copied cells.
+        if (indices != NULL) {
+            size_t position = count;
+            for (uint64_t bits = mask; bits != 0; bits &= bits - 1) {
+                indices[position++] = block + count_trailing_zeros(bits);
+            }
+        }
+
+        char *cells = (char *) wide_cells;
+        if (is_narrowed) {
+            read_cells(self, wide_cells, block, length);
+        } else {
+            cells = array_pointer + block * element_size;
+        }
+
+        count += compress_block((char *) destination + count * element_size, cells,
+                                length, mask, element_size);
+    }
+
+    return count;
+}
+
+int _change_type_arayeh(arayeh *self, size_t type, int mode)
+{
+    /*
+     * This function converts the elements of arayeh into "type" in place, arayeh
+     * keeps its size, map and indices and get returns elements of the new type.
+     *
+     * cells are converted in blocks by vectorized kernels, memory grows before a
+     * widening conversion and shrinks after a narrowing one. values that don't
+     * fit in the new type are handled by "mode", in strict mode conversion fails
+     * and arayeh is unchanged.
+     *
+     * ARGUMENTS:
+     * self         pointer to the arayeh object.
+     * type         new type of arayeh elements, any type except generic, string
+     *              and bool.
+     * mode         one of AA_ARAYEH_CONVERT_* or'ed with one of AA_ARAYEH_ROUND_*.
+     *
+     * RETURN:
+     * state        a code that indicates successful operation
+     *              or an error code defined in arayeh.h .
+     *
+     */
+
+    // gap buffer mode, put cells at their logical index.
+    close_gap(self);
+
+    // shorten names for god's sake.
+    struct private_properties *private_properties = &self->_private_properties;
+
+    // set debug flag.
+    int debug = private_properties->policy.debug;
+
+    // track error state in the function.
+    int state;
+
+    if (is_numeric_type(private_properties->type) == AA_ARAYEH_FALSE ||
+        is_numeric_type(type) == AA_ARAYEH_FALSE) {
+        WARN_WRONG_TYPE("_change_type_arayeh() method, not a numeric arayeh.", debug);
+        return AA_ARAYEH_WRONG_TYPE;
+    }
+
+    // strict mode, check every filled cell before changing anything.
+    if ((mode & (AA_ARAYEH_CONVERT_SATURATE | AA_ARAYEH_CONVERT_WRAP)) == 0 &&
+        convert_overflows(self, type, mode) == AA_ARAYEH_TRUE) {
+        WARN_VALUE_OVERFLOW("_change_type_arayeh() method.", debug);
+        return AA_ARAYEH_OVERFLOW;
+    }
+
+    // cells of a narrowed arayeh are converted from their storage type.
+    state = convert_storage(self, type, mode);
+    if (state != AA_ARAYEH_SUCCESS) {
+        WARN_REALLOC("_change_type_arayeh() method.", debug);
+        return state;
+    }
+
+    // cells are stored in the new type.
+    private_properties->type      = type;
+    private_properties->alignment = private_properties->element_size;
+    self->type                    = type;
+    set_storage_methods(self);
+
+    // return success code.
+    return AA_ARAYEH_SUCCESS;
+}
+
+arayeh *_convert_to_arayeh(arayeh *self, size_t type, int mode)
+{
+    /*
+     * This function creates a new arayeh of "type" with the same size and map,
+     * every filled cell of it holds the converted cell with the same index in
+     * arayeh.
+     *
+     * cells are converted in blocks by vectorized kernels, if the library is
+     * built with OpenMP and "parallel" setting is on, blocks of
+     * AA_ARAYEH_PARALLEL_BLOCK cells are given to several threads. values that
+     * don't fit in the new type are handled by "mode", in strict mode no arayeh
+     * is created.
+     *
+     * ARGUMENTS:
+     * self         pointer to the arayeh object.
+     * type         type of the new arayeh, any type except generic, string and
+     *              bool.
+     * mode         one of AA_ARAYEH_CONVERT_* or'ed with one of AA_ARAYEH_ROUND_*.
+     *
+     * RETURN:
+     * A pointer to the new arayeh.
+     * or
+     * return NULL in case of error.
+     *
+     */
+
+    // gap buffer mode, put cells at their logical index.
+    close_gap(self);
+
+    // shorten names for god's sake.
+    struct private_properties *private_properties = &self->_private_properties;
+
+    // set debug flag.
+    int debug = private_properties->policy.debug;
+
+    if (is_numeric_type(private_properties->type) == AA_ARAYEH_FALSE ||
+        is_numeric_type(type) == AA_ARAYEH_FALSE) {
+        WARN_WRONG_TYPE("_convert_to_arayeh() method, not a numeric arayeh.", debug);
+        return NULL;
+    }
+
+    // strict mode, check every filled cell before creating the new arayeh.
+    if ((mode & (AA_ARAYEH_CONVERT_SATURATE | AA_ARAYEH_CONVERT_WRAP)) == 0 &&
+        convert_overflows(self, type, mode) == AA_ARAYEH_TRUE) {
+        WARN_VALUE_OVERFLOW("_convert_to_arayeh() method.", debug);
+        return NULL;
+    }
+
+    // create new arayeh with the same size.
+    arayeh *result = Arayeh(type, private_properties->size);
+
+    // check errors.
+    if (result == NULL) {
+        WARN_INIT_FAIL("_convert_to_arayeh() method, can not create new arayeh.", debug);
+        return NULL;
+    }
+
+    // apply self settings to new arayeh.
+    result->set_settings(result, private_properties->settings);
+    result->set_size_settings(result, private_properties->settings->method_size);
+
+    // new arayeh has the same filled cells.
+    struct private_properties *result_properties = &result->_private_properties;
+    memcpy(result_properties->map, private_properties->map, private_properties->size);
+    result_properties->used = private_properties->used;
+    result_properties->next = private_properties->next;
+    result->used            = private_properties->used;
+    result->next            = private_properties->next;
+
+    // cells of a narrowed arayeh are converted from their storage type.
+    size_t source_type   = private_properties->storage_type;
+    size_t source_size   = private_properties->element_size;
+    size_t result_size   = result_properties->element_size;
+    char *source_pointer = private_properties->array.char_pointer;
+    char *result_pointer = result_properties->array.char_pointer;
+
+    size_t size  = private_properties->size;
+    int parallel = private_properties->settings->parallel == AA_ARAYEH_ON;
+
+#ifdef _OPENMP
+#    pragma omp parallel for schedule(static) if (parallel)
+#endif
+    for (size_t block = 0; block < size; block += AA_ARAYEH_PARALLEL_BLOCK) {
+        size_t length = (size - block < AA_ARAYEH_PARALLEL_BLOCK)
+                            ? size - block
+                            : AA_ARAYEH_PARALLEL_BLOCK;
+
+        convert_values(result_pointer + block * result_size, type,
+                       source_pointer + block * source_size, source_type, length, mode);
+    }
+
+    return result;
+}
+
+int _narrow_arayeh(arayeh *self)
+{
+    /*
+     * This function re-stores an integer arayeh in the narrowest fixed-width
+     * integer type that holds its filled cells, e.g. an int arayeh of values in
+     * 0..200 uses one byte per cell.
+     *
+     * arayeh keeps its type, elements are converted on add and get and search
+     * methods convert the searched element, methods that copy cells (get_range,
+     * pack, compare, ...) convert them while copying. adding a value that
+     * doesn't fit, or calling a method that hands out arayeh memory (view,
+     * iterators, for_each, ...) widens the arayeh back to its type. boolean
+     * arayehs are packed 64 cells to a word.
+     *
+     * ARGUMENTS:
+     * self         pointer to the arayeh object.
+     *
+     * RETURN:
+     * state        a code that indicates successful operation
+     *              or an error code defined in arayeh.h .
+     *
+     */
+
+    // gap buffer mode, put cells at their logical index.
+    close_gap(self);
+
+    // shorten names for god's sake.
+    struct private_properties *private_properties = &self->_private_properties;
+
+    // set debug flag.
+    int debug = private_properties->policy.debug;
+
+    // boolean cells are packed into bits.
+    if (private_properties->type == AA_ARAYEH_TYPE_BOOL) {
+        return convert_storage(self, AA_ARAYEH_STORAGE_BIT, AA_ARAYEH_CONVERT_WRAP);
+    }
+
+    if (is_integer_type(private_properties->type) == AA_ARAYEH_FALSE) {
+        WARN_WRONG_TYPE("_narrow_arayeh() method, only integer arayehs are narrowed.",
+                        debug);
+        return AA_ARAYEH_WRONG_TYPE;
+    }
+
+    size_t storage_type = narrowest_type(self);
+
+    // cells are already as narrow as they can be.
+    if (type_size(storage_type) >= private_properties->element_size) {
+        return AA_ARAYEH_SUCCESS;
+    }
+
+    return convert_storage(self, storage_type, AA_ARAYEH_CONVERT_WRAP);
+}
+
+int _widen_arayeh(arayeh *self)
+{
+    /*
+     * This function re-stores the cells of a narrowed arayeh in arayeh type.
+     *
+     * ARGUMENTS:
+     * self         pointer to the arayeh object.
+     *
+     * RETURN:
+     * state        a code that indicates successful operation
+     *              or an error code defined in arayeh.h .
+     *
+     */
+
+    // gap buffer mode, put cells at their logical index.
+    close_gap(self);
+
+    // track error state in the function.
+    int state = widen_storage(self);
+
+    if (state != AA_ARAYEH_SUCCESS) {
+        WARN_REALLOC("_widen_arayeh() method.", self->_private_properties.policy.debug);
+    }
+
+    return state;
+}
+
+int _add_strings_arayeh(arayeh *self, const char *bytes, const size_t *offsets,
+                        size_t count)
+{
+    /*
+     * This function appends "count" strings to a string arayeh after its last
+     * filled cell, string i is the bytes of "bytes" from offset "offsets[i]"
+     * (inclusive) to "offsets[i + 1]" (exclusive), so "offsets" holds
+     * "count" + 1 offsets that never decrease.
+     *
+     * the arena and the cells grow at most once, the bytes of all strings are
+     * copied with a single memcpy and cells are written by a writer, so adding
+     * millions of strings costs no allocation per string.
+     *
+     * ARGUMENTS:
+     * self         pointer to the arayeh object.
+     * bytes        pointer to the bytes of strings.
+     * offsets      pointer to "count" + 1 offsets into "bytes".
+     * count        number of strings.
+     *
+     * RETURN:
+     * state        a code that indicates successful operation
+     *              or an error code defined in arayeh.h .
+     *
+     */
+
+    // shorten names for god's sake.
+    struct private_properties *private_properties = &self->_private_properties;
+    struct arayeh_arena *arena                    = &private_properties->arena;
+
+    // set debug flag.
+    int debug = private_properties->policy.debug;
+
+    // track error state in the function.
+    int state;
+
+    if (private_properties->type != AA_ARAYEH_TYPE_STRING) {
+        WARN_WRONG_TYPE("_add_strings_arayeh() method, not a string arayeh.", debug);
+        return AA_ARAYEH_WRONG_TYPE;
+    }
+
+    // nothing to add.
+    if (count == 0) {
+        return AA_ARAYEH_SUCCESS;
+    }
+
+    // check offsets before changing anything.
+    for (size_t index = 0; index < count; index++) {
+        if (offsets[index + 1] < offsets[index]) {
+            WARN_WRONG_INDEX("_add_strings_arayeh() method, offsets decrease!", debug);
+            return AA_ARAYEH_WRONG_INDEX;
+        }
+    }
+
+    size_t first = offsets[0];
+    size_t total = offsets[count] - first;
+
+    // make room for bytes and cells.
+    state = arena_reserve(self, total);
+    if (state != AA_ARAYEH_SUCCESS) {
+        return state;
+    }
+
+    arayeh_writer writer;
+    state = open_writer(self, &writer, count);
+    if (state != AA_ARAYEH_SUCCESS) {
+        return state;
+    }
+
+    // offsets of "bytes" become offsets of the arena.
+    arayeh_string_cell *cells = (arayeh_string_cell *) writer.cursor;
+    size_t shift              = arena->used - first;
+    for (size_t index = 0; index < count; index++) {
+        cells[index].offset = offsets[index] + shift;
+        cells[index].length = offsets[index + 1] - offsets[index];
+    }
+    writer.cursor += count * sizeof(arayeh_string_cell);
+
+    if (total != 0) {
+        memcpy(arena->bytes + arena->used, bytes + first, total);
+        arena->used += total;
+    }
+
+    return self->writer_close(self, &writer);
+}
+
+int _compact_arena_arayeh(arayeh *self)
+{
+    /*
+     * This function drops the bytes of deleted and overwritten strings from the
+     * arena of a string arayeh, bytes of filled cells are copied in order of
+     * their offset into a new arena of their exact size, bytes shared by cells
+     * are copied once.
+     *
+     * ARGUMENTS:
+     * self         pointer to the arayeh object.
+     *
+     * RETURN:
+     * state        a code that indicates successful operation
+     *              or an error code defined in arayeh.h .
+     *
+     */
+
+    // shorten names for god's sake.
+    struct private_properties *private_properties = &self->_private_properties;
+
+    // set debug flag.
+    int debug = private_properties->policy.debug;
+
+    if (private_properties->type != AA_ARAYEH_TYPE_STRING) {
+        WARN_WRONG_TYPE("_compact_arena_arayeh() method, not a string arayeh.", debug);
+        return AA_ARAYEH_WRONG_TYPE;
+    }
+
+    return arena_compact(self);
+}
+
+int _append_bytes_arayeh(arayeh *self, const char *bytes, size_t count)
+{
+    /*
+     * This function appends "count" bytes to a char arayeh after its last filled
+     * cell, so a text is built at memcpy speed instead of one add per char.
+     *
+     * arayeh grows at most once and "bytes" may point into the arayeh itself,
+     * e.g. to repeat a part of the text.
+     *
+     * ARGUMENTS:
+     * self         pointer to the arayeh object.
+     * bytes        pointer to the bytes to be appended.
+     * count        number of bytes.
+     *
+     * RETURN:
+     * state        a code that indicates successful operation
+     *              or an error code defined in arayeh.h .
+     *
+     */
+
+    // shorten names for god's sake.
+    struct private_properties *private_properties = &self->_private_properties;
+
+    // set debug flag.
+    int debug = private_properties->policy.debug;
+
+    // track error state in the function.
+    int state;
+
+    if (private_properties->type != AA_ARAYEH_TYPE_CHAR) {
+        WARN_WRONG_TYPE("_append_bytes_arayeh() method, not a char arayeh.", debug);
+        return AA_ARAYEH_WRONG_TYPE;
+    }
+
+    // nothing to append.
+    if (count == 0) {
+        return AA_ARAYEH_SUCCESS;
+    }
+
+    // bytes of arayeh itself move if arayeh grows, remember their index.
+    uintptr_t base   = (uintptr_t) private_properties->array.char_pointer;
+    uintptr_t source = (uintptr_t) bytes;
+    size_t size      = private_properties->size;
+    int is_inside    = (base != 0 && source >= base && source - base < size)
+                           ? AA_ARAYEH_TRUE
+                           : AA_ARAYEH_FALSE;
+
+    arayeh_writer writer;
+    state = open_writer(self, &writer, count);
+    if (state != AA_ARAYEH_SUCCESS) {
+        return state;
+    }
+
+    if (is_inside == AA_ARAYEH_TRUE) {
+        bytes = private_properties->array.char_pointer + (source - base);
+    }
+
+    // source and destination overlap only if bytes are after the last filled cell.
+    memmove(writer.cursor, bytes, count);
+    writer.cursor += count;
+
+    return self->writer_close(self, &writer);
+}
+
+int _find_bytes_in_arayeh(arayeh *self, size_t start_index, const char *needle,
+                          size_t length, size_t *index)
+{
+    /*
+     * This function finds the first occurrence of "length" bytes of "needle" in
+     * the text of a char arayeh from index "start_index" (inclusive), the text is
+     * the cells before its last filled cell, see text.c for the SIMD kernel.
+     *
+     * ARGUMENTS:
+     * self         pointer to the arayeh object.
+     * start_index  index of the first cell to be searched.
+     * needle       pointer to the bytes being searched for.
+     * length       number of bytes of needle, an empty needle is found at
+     *              "start_index".
+     * index        pointer to the location that receives the found index.
+     *
+     * RETURN:
+     * state        AA_ARAYEH_SUCCESS if needle is found, AA_ARAYEH_NOT_FOUND if
+     *              not, otherwise an error code defined in arayeh.h .
+     *
+     */
+
+    // shorten names for god's sake.
+    struct private_properties *private_properties = &self->_private_properties;
+
+    // set debug flag.
+    int debug = private_properties->policy.debug;
+
+    if (private_properties->type != AA_ARAYEH_TYPE_CHAR) {
+        WARN_WRONG_TYPE("_find_bytes_in_arayeh() method, not a char arayeh.", debug);
+        return AA_ARAYEH_WRONG_TYPE;
+    }
+
+    size_t text_size;
+    if (text_length(self, &text_size) != AA_ARAYEH_SUCCESS) {
+        WARN_WRONG_INDEX("_find_bytes_in_arayeh() method, text has empty cells!", debug);
+        return AA_ARAYEH_WRONG_INDEX;
+    }
+
+    // nothing left to search.
+    if (start_index > text_size) {
+        return AA_ARAYEH_NOT_FOUND;
+    }
+
+    if (length == 0) {
+        *index = start_index;
+        return AA_ARAYEH_SUCCESS;
+    }
+
+    size_t remaining = text_size - start_index;
+    size_t position  = text_find(private_properties->array.char_pointer + start_index,
+                                 remaining, needle, length);
+
+    if (position == remaining) {
+        return AA_ARAYEH_NOT_FOUND;
+    }
+
+    *index = start_index + position;
+
+    // return success code.
+    return AA_ARAYEH_SUCCESS;
+}
+
+size_t _split_arayeh(arayeh *self, char delimiter, arayeh_range *ranges,
+                     size_t capacity)
+{
+    /*
+     * This function splits the text of a char arayeh on "delimiter", n
+     * delimiters make n + 1 fields, so an empty text is one empty field.
+     *
+     * fields are index ranges of arayeh, nothing is copied. if there are more
+     * fields than "capacity", the first "capacity" ones are written and the
+     * return value tells how much room all of them need.
+     *
+     * ARGUMENTS:
+     * self         pointer to the arayeh object.
+     * delimiter    char that separates fields.
+     * ranges       pointer to room for "capacity" fields, can be NULL if it's 0.
+     * capacity     number of fields that fit in ranges.
+     *
+     * RETURN:
+     * fields       number of fields, zero on failure.
+     *
+     */
+
+    // shorten names for god's sake.
+    struct private_properties *private_properties = &self->_private_properties;
+
+    // set debug flag.
+    int debug = private_properties->policy.debug;
+
+    if (private_properties->type != AA_ARAYEH_TYPE_CHAR) {
+        WARN_WRONG_TYPE("_split_arayeh() method, not a char arayeh.", debug);
+        return 0;
+    }
+
+    size_t text_size;
+    if (text_length(self, &text_size) != AA_ARAYEH_SUCCESS) {
+        WARN_WRONG_INDEX("_split_arayeh() method, text has empty cells!", debug);
+        return 0;
+    }
+
+    return text_split(private_properties->array.char_pointer, text_size, delimiter,
+                      ranges, capacity);
+}
+
+const char *_c_string_arayeh(arayeh *self, size_t *length)
+{
+    /*
+     * This function returns the text of a char arayeh as a NUL terminated string,
+     * the NUL is written to the empty cell after the last filled cell, so the
+     * text isn't copied and arayeh grows by one cell only if it's full.
+     *
+     * the string is valid until the next call that changes the arayeh, the text
+     * can hold NUL chars of its own, "length" tells where it really ends.
+     *
+     * ARGUMENTS:
+     * self         pointer to the arayeh object.
+     * length       pointer to the location that receives the length of the text,
+     *              can be NULL.
+     *
+     * RETURN:
+     * string       pointer to the text or NULL on failure.
+     *
+     */
+
+    // shorten names for god's sake.
+    struct private_properties *private_properties = &self->_private_properties;
+
+    // set debug flag.
+    int debug = private_properties->policy.debug;
+
+    if (private_properties->type != AA_ARAYEH_TYPE_CHAR) {
+        WARN_WRONG_TYPE("_c_string_arayeh() method, not a char arayeh.", debug);
+        return NULL;
+    }
+
+    size_t text_size;
+    if (text_length(self, &text_size) != AA_ARAYEH_SUCCESS) {
+        WARN_WRONG_INDEX("_c_string_arayeh() method, text has empty cells!", debug);
+        return NULL;
+    }
+
+    // make room for the terminator.
+    if (private_properties->size == text_size) {
+        // extend arayeh size only if settings allow it.
+        if (private_properties->policy.extend_add == AA_ARAYEH_FALSE) {
+            WARN_WRONG_INDEX(
+                "_c_string_arayeh() method, not enough space left in the arayeh.",
+                debug);
+            return NULL;
+        }
+
+        if (auto_extend_memory_to(self, text_size + 1) != AA_ARAYEH_SUCCESS) {
+            return NULL;
+        }
+    }
+
+    // the cell stays empty, only its memory holds the terminator.
+    private_properties->array.char_pointer[text_size] = '\0';
+
+    if (length != NULL) {
+        *length = text_size;
+    }
+
+    return private_properties->array.char_pointer;
+}
+
+size_t _popcount_arayeh(arayeh *self)
+{
+    /*
+     * This function returns the number of filled cells of a boolean arayeh that
+     * are true, cells are packed first if they aren't, then every word of 64
+     * cells is masked by its filled cells and counted by a popcount.
+     *
+     * ARGUMENTS:
+     * self         pointer to the arayeh object.
+     *
+     * RETURN:
+     * count        number of true cells, zero on failure.
+     *
+     */
+
+    // gap buffer mode, put cells at their logical index.
+    close_gap(self);
+
+    // shorten names for god's sake.
+    struct private_properties *private_properties = &self->_private_properties;
+
+    // set debug flag.
+    int debug = private_properties->policy.debug;
+
+    if (private_properties->type != AA_ARAYEH_TYPE_BOOL) {
+        WARN_WRONG_TYPE("_popcount_arayeh() method, not a boolean arayeh.", debug);
+        return 0;
+    }
+
+    if (convert_storage(self, AA_ARAYEH_STORAGE_BIT, AA_ARAYEH_CONVERT_WRAP) !=
+        AA_ARAYEH_SUCCESS) {
+        WARN_REALLOC("_popcount_arayeh() method.", debug);
+        return 0;
+    }
+
+    size_t size     = private_properties->size;
+    uint64_t *words = private_properties->array.bool_pointer;
+    size_t count    = 0;
+
+    for (size_t block = 0; block < size; block += 64) {
+        size_t length = (size - block < 64) ? size - block : 64;
+        uint64_t mask = map_block_mask(private_properties->map, block, length);
+
+        count += count_set_bits(words[block / 64] & mask);
+    }
+
+    return count;
+}
+
+int _bitwise_arayeh(arayeh *self, int operation, arayeh *other)
+{
+    /*
+     * This function replaces every filled cell of a boolean arayeh by the result
+     * of "operation", AA_ARAYEH_AND, AA_ARAYEH_OR and AA_ARAYEH_XOR combine it
+     * with the cell of the same index of "other" and AA_ARAYEH_NOT negates it.
+     *
+     * empty cells of "other" and cells after its end are false, empty cells of
+     * "self" stay empty. cells of both arayehs are packed first if they aren't,
+     * then 64 cells are computed at a time.
+     *
+     * ARGUMENTS:
+     * self         pointer to the arayeh object.
+     * operation    one of AA_ARAYEH_AND, AA_ARAYEH_OR, AA_ARAYEH_XOR, AA_ARAYEH_NOT.
+     * other        pointer to a boolean arayeh, can be NULL for AA_ARAYEH_NOT.
+     *
+     * RETURN:
+     * state        a code that indicates successful operation
+     *              or an error code defined in arayeh.h .
+     *
+     */
+
+    // shorten names for god's sake.
+    struct private_properties *private_properties = &self->_private_properties;
+
+    // set debug flag.
+    int debug = private_properties->policy.debug;
+
+    if (operation < AA_ARAYEH_AND || AA_ARAYEH_NOT < operation) {
+        WARN("failed in _bitwise_arayeh() method, unknown operation.", debug);
+        return AA_ARAYEH_FAILURE;
+    }
+
+    // NOT has no operand.
+    if (operation == AA_ARAYEH_NOT) {
+        other = NULL;
+    }
+
+    if (private_properties->type != AA_ARAYEH_TYPE_BOOL ||
+        (operation != AA_ARAYEH_NOT &&
+         (other == NULL || other->_private_properties.type != AA_ARAYEH_TYPE_BOOL))) {
+        WARN_WRONG_TYPE("_bitwise_arayeh() method, not a boolean arayeh.", debug);
+        return AA_ARAYEH_WRONG_TYPE;
+    }
+
+    // gap buffer mode, put cells at their logical index.
+    close_gap(self);
+    if (other != NULL) {
+        close_gap(other);
+    }
+
+    // cells must be packed.
+    if (convert_storage(self, AA_ARAYEH_STORAGE_BIT, AA_ARAYEH_CONVERT_WRAP) !=
+            AA_ARAYEH_SUCCESS ||
+        (other != NULL &&
+         convert_storage(other, AA_ARAYEH_STORAGE_BIT, AA_ARAYEH_CONVERT_WRAP) !=
+             AA_ARAYEH_SUCCESS)) {
+        WARN_REALLOC("_bitwise_arayeh() method.", debug);
+        return AA_ARAYEH_REALLOC_DENIED;
+    }
+
+    size_t size     = private_properties->size;
+    uint64_t *words = private_properties->array.bool_pointer;
+
+    // filled cells of "other", empty ones are false.
+    struct private_properties *other_properties =
+        (other == NULL) ? NULL : &other->_private_properties;
+    size_t other_size = (other == NULL) ? 0 : other_properties->size;
+
+    for (size_t block = 0; block < size; block += 64) {
+        size_t length = (size - block < 64) ? size - block : 64;
+        uint64_t mask = map_block_mask(private_properties->map, block, length);
+
+        if (mask == 0) {
+            continue;
+        }
+
+        uint64_t operand = 0;
+        if (block < other_size) {
+            size_t other_length = (other_size - block < 64) ? other_size - block : 64;
+            operand = other_properties->array.bool_pointer[block / 64] &
+                      map_block_mask(other_properties->map, block, other_length);
+        }
+
+        uint64_t value  = words[block / 64];
+        uint64_t result = 0;
+
+        switch (operation) {
+        case AA_ARAYEH_AND:
+            result = value & operand;
+            break;
+        case AA_ARAYEH_OR:
+            result = value | operand;
+            break;
+        case AA_ARAYEH_XOR:
+            result = value ^ operand;
+            break;
+        default:
+            result = ~value;
+            break;
+        }
+
+        // bits of empty cells are left alone.
+        words[block / 64] = (value & ~mask) | (result & mask);
+    }
+
+    // return success code.
+    return AA_ARAYEH_SUCCESS;
+}
+
+size_t _compare_arayeh(arayeh *self, int operation, void *value, void *upper,
+                       uint64_t *bitmap)
+{
+    /*
+     * This function marks every filled cell of a numeric arayeh that satisfies
+     * "operation" in a bitmap, AA_ARAYEH_LESS, LESS_EQUAL, EQUAL, GREATER_EQUAL
+     * and GREATER compare cells with "value", AA_ARAYEH_BETWEEN checks that
+     * "value" <= cell <= "upper".
+     *
+     * bit (i % 64) of bitmap[i / 64] is set if cell i is filled and satisfies the
+     * comparison, otherwise it is cleared. 64 cells are compared at a time
+     * without a branch per cell, see compare_block().
+     *
+     * ARGUMENTS:
+     * self         pointer to the arayeh object.
+     * operation    one of compare operations defined in arayeh.h .
+     * value        pointer to a variable of arayeh type.
+     * upper        pointer to a variable of arayeh type, upper bound of
+     *              AA_ARAYEH_BETWEEN, can be NULL for other operations.
+     * bitmap       array of AA_ARAYEH_MASK_SIZE(size) words that receives the
+     *              result, pass NULL to only count the cells.
+     *
+     * RETURN:
+     * count        number of filled cells that satisfy the comparison,
+     *              zero on failure.
+     *
+     */
+
+    // shorten names for god's sake.
+    struct private_properties *private_properties = &self->_private_properties;
+
+    // set debug flag.
+    int debug = private_properties->policy.debug;
+
+    if (is_compare_operation(operation) == AA_ARAYEH_FALSE || value == NULL ||
+        (operation == AA_ARAYEH_BETWEEN && upper == NULL)) {
+        WARN("failed in _compare_arayeh() method, unknown operation or no value.",
+             debug);
+        return 0;
+    }
+
+    size_t type = private_properties->type;
+    if (is_numeric_type(type) == AA_ARAYEH_FALSE) {
+        WARN_WRONG_TYPE("_compare_arayeh() method, not a numeric arayeh.", debug);
+        return 0;
+    }
+
+    // gap buffer mode, put cells at their logical index.
+    close_gap(self);
+
+    size_t size         = private_properties->size;
+    size_t element_size = private_properties->element_size;
+    char *array_pointer = private_properties->array.char_pointer;
+    int is_narrowed     = private_properties->storage_type != type;
+    size_t count        = 0;
+
+    // a block of narrowed cells converted into arayeh type.
+    uint64_t wide_cells[64];
+
+    for (size_t block = 0; block < size; block += 64) {
+        size_t length = (size - block < 64) ? size - block : 64;
+
+        // compare values only in blocks with filled cells.
+        uint64_t mask = map_block_mask(private_properties->map, block, length);
+        if (mask != 0) {
+            char *cells = array_pointer + block * element_size;
+            if (is_narrowed) {
+                read_cells(self, wide_cells, block, length);
+                cells = (char *) wide_cells;
+            }
+
+            mask &= compare_block(cells, type, length, operation, value, upper);
+        }
+
+        // save and count results.
+        if (bitmap != NULL) {
+            bitmap[block / 64] = mask;
+        }
+        count += count_set_bits(mask);
+    }
+
+    return count;
+}
+
+arayeh *_select_arayeh(arayeh *self, const uint64_t *bitmap)
+{
+    /*
+     * This function copies every filled cell whose bit is set in "bitmap" into a
+     * new arayeh of the same type, keeping their order, e.g. the cells marked
+     * by compare or find_all methods.
+     *
+     * cells of a block of 64 are copied by a stream compaction without a branch
+     * per cell, see compress_block().
+     *
+     * ARGUMENTS:
+     * self         pointer to the arayeh object.
+     * bitmap       array of AA_ARAYEH_MASK_SIZE(size) words, bit (i % 64) of
+     *              bitmap[i / 64] selects cell i.
+     *
+     * RETURN:
+     * A pointer to the new arayeh.
+     * or
+     * return NULL in case of error.
+     *
+     */
+
+    // shorten names for god's sake.
+    struct private_properties *private_properties = &self->_private_properties;
+
+    // set debug flag.
+    int debug = private_properties->policy.debug;
+
+    // string cells point into the arena of arayeh, not of the new one.
+    if (private_properties->type == AA_ARAYEH_TYPE_STRING) {
+        WARN_WRONG_TYPE("_select_arayeh() method, string arayeh.", debug);
+        return NULL;
+    }
+
+    // gap buffer mode, put cells at their logical index.
+    close_gap(self);
+
+    // narrowed arayeh, cells must be of arayeh type.
+    if (widen_storage(self) != AA_ARAYEH_SUCCESS) {
+        return NULL;
+    }
+
+    size_t size         = private_properties->size;
+    size_t element_size = private_properties->element_size;
+    char *array_pointer = private_properties->array.char_pointer;
+    size_t count        = 0;
+
+    // count selected cells to create an arayeh of the right size.
+    for (size_t block = 0; block < size; block += 64) {
+        size_t length = (size - block < 64) ? size - block : 64;
+        count += count_set_bits(bitmap[block / 64] &
+                                map_block_mask(private_properties->map, block, length));
+    }
+
+    // at least one cell is allocated, malloc() of zero bytes may return NULL.
+    arayeh *result = create_arayeh_like(self, count > 0 ? count : 1);
+
+    // check errors.
+    if (result == NULL) {
+        WARN_INIT_FAIL("_select_arayeh() method, can not create new arayeh.", debug);
+        return NULL;
+    }
+
+    // apply self settings to new arayeh.
+    result->set_settings(result, private_properties->settings);
+    result->set_size_settings(result, private_properties->settings->method_size);
+
+    // cells are copied directly, boolean cells must be unpacked.
+    if (widen_storage(result) != AA_ARAYEH_SUCCESS) {
+        result->free_arayeh(&result);
+        return NULL;
+    }
+
+    struct private_properties *result_properties = &result->_private_properties;
+    char *result_pointer                         = result_properties->array.char_pointer;
+    size_t written                               = 0;
+
+    for (size_t block = 0; block < size && written < count; block += 64) {
+        size_t length = (size - block < 64) ? size - block : 64;
+        uint64_t mask =
+            bitmap[block / 64] & map_block_mask(private_properties->map, block, length);
+
+        if (mask != 0) {
+            written += compress_block(result_pointer + written * element_size,
+                                      array_pointer + block * element_size, length,
+                                      mask, element_size);
+        }
+    }
+
+    // update new arayeh map and counters.
+    memset(result_properties->map, AA_ARAYEH_ON, written);
+    result_properties->used = written;
+    result_properties->next = written;
+    result->used            = written;
+    result->next            = written;
+
+    // selected boolean cells are packed again.
+    if (private_properties->type == AA_ARAYEH_TYPE_BOOL) {
+        result->narrow(result);
+    }
+
+    return result;
+}
+
+int _scan_arayeh(arayeh *self, int operation, int mode)
+{
+    /*
+     * This function replaces every filled cell of a numeric arayeh by the
+     * running AA_ARAYEH_SUM, AA_ARAYEH_MIN or AA_ARAYEH_MAX of the filled cells
+     * up to it (prefix sum), AA_ARAYEH_INCLUSIVE includes the cell itself and
+     * AA_ARAYEH_EXCLUSIVE doesn't, so its first filled cell becomes 0 for sums,
+     * the largest value of arayeh type for min and the smallest for max.
+     *
+     * empty cells are skipped and stay empty, integer sums wrap around and min
+     * and max ignore NaN cells.
+     *
+     * if the library is built with OpenMP, "parallel" setting is on and there
+     * are several threads, blocks of AA_ARAYEH_PARALLEL_BLOCK cells are scanned
+     * in two passes, the first one computes the total of every block and the
+     * second one scans every block starting from the total of the blocks before
+     * it.
+     * sums of floating point cells may round differently than a sequential scan.
+     *
+     * ARGUMENTS:
+     * self         pointer to the arayeh object.
+     * operation    AA_ARAYEH_SUM, AA_ARAYEH_MIN or AA_ARAYEH_MAX.
+     * mode         AA_ARAYEH_INCLUSIVE or AA_ARAYEH_EXCLUSIVE.
+     *
+     * RETURN:
+     * state        a code that indicates successful operation
+     *              or an error code defined in arayeh.h .
+     *
+     */
+
+    // shorten names for god's sake.
+    struct private_properties *private_properties = &self->_private_properties;
+
+    // set debug flag.
+    int debug = private_properties->policy.debug;
+
+    if (is_scan_operation(operation) == AA_ARAYEH_FALSE ||
+        (mode != AA_ARAYEH_INCLUSIVE && mode != AA_ARAYEH_EXCLUSIVE)) {
+        WARN("failed in _scan_arayeh() method, unknown operation or mode.", debug);
+        return AA_ARAYEH_FAILURE;
+    }
+
+    size_t type = private_properties->type;
+    if (is_numeric_type(type) == AA_ARAYEH_FALSE) {
+        WARN_WRONG_TYPE("_scan_arayeh() method, not a numeric arayeh.", debug);
+        return AA_ARAYEH_WRONG_TYPE;
+    }
+
+    // gap buffer mode, put cells at their logical index.
+    close_gap(self);
+
+    // narrowed arayeh, running values may not fit in its cells.
+    if (widen_storage(self) != AA_ARAYEH_SUCCESS) {
+        return AA_ARAYEH_REALLOC_DENIED;
+    }
+
+    size_t size         = private_properties->size;
+    char *array_pointer = private_properties->array.char_pointer;
+    char *map           = private_properties->map;
+
+    scan_value carry;
+    scan_identity(&carry, type, operation);
+
+    size_t blocks = (size + AA_ARAYEH_PARALLEL_BLOCK - 1) / AA_ARAYEH_PARALLEL_BLOCK;
+    scan_value *totals = NULL;
+
+#ifdef _OPENMP
+    // two passes only pay off with several blocks and threads.
+    if (private_properties->settings->parallel == AA_ARAYEH_ON && blocks > 1 &&
+        omp_get_max_threads() > 1) {
+        totals = (scan_value *) malloc(blocks * sizeof(scan_value));
+    }
+#endif
+
+    // sequential scan, also used if the totals can't be allocated.
+    if (totals == NULL) {
+        scan_cells(array_pointer, map, type, 0, size, operation, mode, &carry);
+    } else {
+        // first pass, total of every block.
+#ifdef _OPENMP
+#    pragma omp parallel for schedule(static)
+#endif
+        for (size_t block = 0; block < blocks; block++) {
+            size_t start_index = block * AA_ARAYEH_PARALLEL_BLOCK;
+            size_t end_index   = (size - start_index < AA_ARAYEH_PARALLEL_BLOCK)
+                                     ? size
+                                     : start_index + AA_ARAYEH_PARALLEL_BLOCK;
+
+            scan_identity(&totals[block], type, operation);
+            scan_reduce(&totals[block], array_pointer, map, type, start_index,
+                        end_index, operation);
+        }
+
+        // turn totals into the running value before every block.
+        for (size_t block = 0; block < blocks; block++) {
+            scan_value total = totals[block];
+            totals[block]    = carry;
+            scan_combine(&carry, &total, type, operation);
+        }
+
+        // second pass, scan every block from its running value.
+#ifdef _OPENMP
+#    pragma omp parallel for schedule(static)
+#endif
+        for (size_t block = 0; block < blocks; block++) {
+            size_t start_index = block * AA_ARAYEH_PARALLEL_BLOCK;
+            size_t end_index   = (size - start_index < AA_ARAYEH_PARALLEL_BLOCK)
+                                     ? size
+                                     : start_index + AA_ARAYEH_PARALLEL_BLOCK;
+
+            scan_cells(array_pointer, map, type, start_index, end_index, operation,
+                       mode, &totals[block]);
+        }
+
+        free(totals);
+    }
+
+    // values changed, old index is useless.
+    hash_index_free(self);
+
+    // return success code.
+    return AA_ARAYEH_SUCCESS;
+}
+
+arayeh *_scan_to_arayeh(arayeh *self, int operation, int mode)
+{
+    /*
+     * This function creates a copy of arayeh and replaces its filled cells by
+     * their running AA_ARAYEH_SUM, AA_ARAYEH_MIN or AA_ARAYEH_MAX, see scan
+     * method, "self" doesn't change.
+     *
+     * ARGUMENTS:
+     * self         pointer to the arayeh object.
+     * operation    AA_ARAYEH_SUM, AA_ARAYEH_MIN or AA_ARAYEH_MAX.
+     * mode         AA_ARAYEH_INCLUSIVE or AA_ARAYEH_EXCLUSIVE.
+     *
+     * RETURN:
+     * A pointer to the new arayeh.
+     * or
+     * return NULL in case of error.
+     *
+     */
+
+    // shorten names for god's sake.
+    struct private_properties *private_properties = &self->_private_properties;
+
+    // set debug flag.
+    int debug = private_properties->policy.debug;
+
+    // check arguments before copying.
+    if (is_scan_operation(operation) == AA_ARAYEH_FALSE ||
+        (mode != AA_ARAYEH_INCLUSIVE && mode != AA_ARAYEH_EXCLUSIVE)) {
+        WARN("failed in _scan_to_arayeh() method, unknown operation or mode.", debug);
+        return NULL;
+    }
+
+    if (is_numeric_type(private_properties->type) == AA_ARAYEH_FALSE) {
+        WARN_WRONG_TYPE("_scan_to_arayeh() method, not a numeric arayeh.", debug);
+        return NULL;
+    }
+
+    arayeh *result = self->duplicate(self);
+
+    // check errors.
+    if (result == NULL) {
+        return NULL;
+    }
+
+    if (result->scan(result, operation, mode) != AA_ARAYEH_SUCCESS) {
+        result->free_arayeh(&result);
+        return NULL;
+    }
+
+    return result;
+}
+
+void _set_settings(arayeh *self, arayeh_settings *new_settings)
+{
+    /*
+     * This function will override arayeh default settings with new one.
+     *
+     * ARGUMENTS:
+     * self              pointer to the arayeh object.
+     * new_settings      new setting to apply to arayeh.
+     *
+     * RETURN:
+     * no return, it's void dude.
+     *
+     */
+
+    // shorten names for god's sake.
+    arayeh_settings *settings = self->_private_properties.settings;
+
+    // override new settings.
+    settings->debug_messages = new_settings->debug_messages;
+    settings->extend_size    = new_settings->extend_size;
+    settings->hash_index     = new_settings->hash_index;
+    settings->gap_buffer     = new_settings->gap_buffer;
+    settings->parallel       = new_settings->parallel;
+
+    // resolve new settings once.
+    resolve_policy(self);
+
+    // leaving gap buffer mode, cells must be in their logical place.
+    if (settings->gap_buffer != AA_ARAYEH_ON) {
+        close_gap(self);
+    }
+}
+
+void _set_size_settings(arayeh *self, arayeh_size_settings *new_settings)
+{
+    /*
+     * This function will override arayeh default extend size settings with new one.
+     *
+     * ARGUMENTS:
+     * self              pointer to the arayeh object.
+     * new_settings      new setting to apply to arayeh.
+     *
+     * RETURN:
+     * no return, it's void dude.
+     *
+     */
+
+    // shorten names for god's sake.
+    arayeh_size_settings *settings = self->_private_properties.settings->method_size;
+
+    // override new settings.
+    settings->extend_add          = new_settings->extend_add;
+    settings->extend_insert       = new_settings->extend_insert;
+    settings->extend_fill         = new_settings->extend_fill;
+    settings->extend_merge_arayeh = new_settings->extend_merge_arayeh;
+    settings->extend_merge_array  = new_settings->extend_merge_array;
+
+    // resolve new settings once.
+    resolve_policy(self);
 }
 
 void _set_growth_factor(arayeh *self, size_t (*growth_factor)(arayeh *))
@@ -0,0 +1,504 @@
+/** source/scan.c
+ *
+ * This file is a part of:
+ * Azadeh Afzar - Arayehsaz (AA-A).
+ *
+ * Copyright (C) 2020 - 2021 Azadeh Afzar.
+ * Copyright (C) 2020 - 2021 Mohammad Mahdi Baghbani Pourvahid.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgement in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+
+#include "../include/scan.h"
+
+#include "../include/algorithms.h"
+#include "../include/convert.h"
+#include "../include/functions.h"
+
+#include <limits.h>
+#include <math.h>
+
+#if defined(__SSE2__)
+#    include <immintrin.h>
+#endif
+
+/* Scans walk the filled cells of a block of 64 with a running value, empty cells
+ * are skipped and keep their content. a full block is a plain loop, otherwise
+ * filled cells are visited through the bits of the map mask.
+ *
+ * integer sums wrap around like unsigned integers, min and max ignore NaN cells.
+ * half precision cells are scanned as floats and rounded back to their type.
+ */
+
+// kernels of a type, see AA_SCAN_TYPE.
+typedef struct {
+    void (*scan)(void *cells, uint64_t mask, size_t length, int operation,
+                 int exclusive, scan_value *carry);
+    void (*reduce)(const void *cells, uint64_t mask, size_t length, int operation,
+                   scan_value *total);
+    void (*identity)(scan_value *value, int operation);
+    void (*combine)(scan_value *total, const scan_value *value, int operation);
+} scan_kernels;
+
+// runs "step" on the filled cells of a block, "index" is the cell of a step.
+#define AA_SCAN_FILLED_CELLS(mask, length, step)                                        \
+    if ((length) == 64 && (mask) == UINT64_MAX) {                                       \
+        for (size_t index = 0; index < 64; index++) {                                   \
+            step;                                                                       \
+        }                                                                               \
+    } else {                                                                            \
+        for (uint64_t bits = (mask); bits != 0; bits &= bits - 1) {                     \
+            size_t index = count_trailing_zeros(bits);                                  \
+            step;                                                                       \
+        }                                                                               \
+    }
+
+// sums are computed in "unsigned_type" so integers wrap around.
+#define AA_SCAN_TYPE(name, type, unsigned_type, member, lowest, highest)                \
+    static void scan_##name(void *cells, uint64_t mask, size_t length, int operation,   \
+                            int exclusive, scan_value *carry)                           \
+    {                                                                                   \
+        type *values = (type *) cells;                                                  \
+        type total   = carry->member;                                                   \
+                                                                                        \
+        switch (operation) {                                                            \
+        case AA_ARAYEH_SUM:                                                             \
+            AA_SCAN_FILLED_CELLS(mask, length, {                                        \
+                type next = (type) ((unsigned_type) total +                             \
+                                    (unsigned_type) values[index]);                     \
+                values[index] = exclusive ? total : next;                               \
+                total         = next;                                                   \
+            })                                                                          \
+            break;                                                                      \
+        case AA_ARAYEH_MIN:                                                             \
+            AA_SCAN_FILLED_CELLS(mask, length, {                                        \
+                type next     = (values[index] < total) ? values[index] : total;        \
+                values[index] = exclusive ? total : next;                               \
+                total         = next;                                                   \
+            })                                                                          \
+            break;                                                                      \
+        default:                                                                        \
+            AA_SCAN_FILLED_CELLS(mask, length, {                                        \
+                type next     = (values[index] > total) ? values[index] : total;        \
+                values[index] = exclusive ? total : next;                               \
+                total         = next;                                                   \
+            })                                                                          \
+        }                                                                               \
+                                                                                        \
+        carry->member = total;                                                          \
+    }                                                                                   \
+                                                                                        \
+    static void reduce_##name(const void *cells, uint64_t mask, size_t length,          \
+                              int operation, scan_value *total)                         \
+    {                                                                                   \
+        const type *values = (const type *) cells;                                      \
+        type result        = total->member;                                             \
+                                                                                        \
+        switch (operation) {                                                            \
+        case AA_ARAYEH_SUM:                                                             \
+            AA_SCAN_FILLED_CELLS(mask, length, {                                        \
+                result = (type) ((unsigned_type) result +                               \
+                                 (unsigned_type) values[index]);                        \
+            })                                                                          \
+            break;                                                                      \
+        case AA_ARAYEH_MIN:                                                             \
+            AA_SCAN_FILLED_CELLS(mask, length, {                                        \
+                result = (values[index] < result) ? values[index] : result;             \
+            })                                                                          \
+            break;                                                                      \
+        default:                                                                        \
+            AA_SCAN_FILLED_CELLS(mask, length, {                                        \
+                result = (values[index] > result) ? values[index] : result;             \
+            })                                                                          \
+        }                                                                               \
+                                                                                        \
+        total->member = result;                                                         \
+    }                                                                                   \
+                                                                                        \
+    static void identity_##name(scan_value *value, int operation)                       \
+    {                                                                                   \
+        value->member = (operation == AA_ARAYEH_SUM)   ? (type) 0                       \
+                        : (operation == AA_ARAYEH_MIN) ? (highest)                      \
+                                                       : (lowest);                      \
+    }                                                                                   \
+                                                                                        \
+    static void combine_##name(scan_value *total, const scan_value *value,              \
+                               int operation)                                           \
+    {                                                                                   \
+        reduce_##name(&value->member, 1, 1, operation, total);                          \
+    }                                                                                   \
+                                                                                        \
+    static const scan_kernels kernels_##name = {scan_##name, reduce_##name,             \
+                                                identity_##name, combine_##name};
+
+AA_SCAN_TYPE(char, char, unsigned char, char_value, CHAR_MIN, CHAR_MAX)
+AA_SCAN_TYPE(short_int, short int, unsigned short int, short_int_value, SHRT_MIN,
+             SHRT_MAX)
+AA_SCAN_TYPE(int, int, unsigned int, int_value, INT_MIN, INT_MAX)
+AA_SCAN_TYPE(long_int, long int, unsigned long int, long_int_value, LONG_MIN, LONG_MAX)
+AA_SCAN_TYPE(float, float, float, float_value, -INFINITY, INFINITY)
+AA_SCAN_TYPE(double, double, double, double_value, -INFINITY, INFINITY)
+AA_SCAN_TYPE(int8, int8_t, uint8_t, int8_value, INT8_MIN, INT8_MAX)
+AA_SCAN_TYPE(int16, int16_t, uint16_t, int16_value, INT16_MIN, INT16_MAX)
+AA_SCAN_TYPE(int32, int32_t, uint32_t, int32_value, INT32_MIN, INT32_MAX)
+AA_SCAN_TYPE(int64, int64_t, uint64_t, int64_value, INT64_MIN, INT64_MAX)
+AA_SCAN_TYPE(uint8, uint8_t, uint8_t, uint8_value, 0, UINT8_MAX)
+AA_SCAN_TYPE(uint16, uint16_t, uint16_t, uint16_value, 0, UINT16_MAX)
+AA_SCAN_TYPE(uint32, uint32_t, uint32_t, uint32_value, 0, UINT32_MAX)
+AA_SCAN_TYPE(uint64, uint64_t, uint64_t, uint64_value, 0, UINT64_MAX)
+
+#undef AA_SCAN_TYPE
+#undef AA_SCAN_FILLED_CELLS
+
+static const scan_kernels *kernels_of(size_t type)
+{
+    /*
+     * This function returns the kernels of "type", half precision types use
+     * the float kernels.
+     */
+
+    switch (type) {
+    case AA_ARAYEH_TYPE_CHAR:
+        return &kernels_char;
+    case AA_ARAYEH_TYPE_SINT:
+        return &kernels_short_int;
+    case AA_ARAYEH_TYPE_INT:
+        return &kernels_int;
+    case AA_ARAYEH_TYPE_LINT:
+        return &kernels_long_int;
+    case AA_ARAYEH_TYPE_DOUBLE:
+        return &kernels_double;
+    case AA_ARAYEH_TYPE_INT8:
+        return &kernels_int8;
+    case AA_ARAYEH_TYPE_INT16:
+        return &kernels_int16;
+    case AA_ARAYEH_TYPE_INT32:
+        return &kernels_int32;
+    case AA_ARAYEH_TYPE_INT64:
+        return &kernels_int64;
+    case AA_ARAYEH_TYPE_UINT8:
+        return &kernels_uint8;
+    case AA_ARAYEH_TYPE_UINT16:
+        return &kernels_uint16;
+    case AA_ARAYEH_TYPE_UINT32:
+        return &kernels_uint32;
+    case AA_ARAYEH_TYPE_UINT64:
+        return &kernels_uint64;
+    default:
+        return &kernels_float;
+    }
+}
+
+/* Vector kernels scan 4 cells of a full block in a register: the cells are added
+ * to (or min'ed with) themselves shifted by one and then by two lanes, which
+ * leaves the running value of the 4 cells in the register, then the carry of the
+ * previous cells is applied and the last lane is the new carry. they cover the
+ * sums of 32 and 64 bit integers, which are exact in any order, and min and max
+ * of floats, whose NaN cells are replaced by the identity first.
+ */
+
+#if defined(__SSE2__)
+static void scan_vector_int32(int32_t *values, int exclusive, int32_t *carry)
+{
+    __m128i total = _mm_set1_epi32(*carry);
+
+    for (size_t offset = 0; offset < 64; offset += 4) {
+        __m128i cells  = _mm_loadu_si128((const __m128i *) (values + offset));
+        __m128i prefix = _mm_add_epi32(cells, _mm_slli_si128(cells, 4));
+        prefix         = _mm_add_epi32(prefix, _mm_slli_si128(prefix, 8));
+
+        __m128i shifted = exclusive ? _mm_slli_si128(prefix, 4) : prefix;
+        _mm_storeu_si128((__m128i *) (values + offset), _mm_add_epi32(shifted, total));
+
+        total = _mm_shuffle_epi32(_mm_add_epi32(prefix, total), _MM_SHUFFLE(3, 3, 3, 3));
+    }
+
+    *carry = _mm_cvtsi128_si32(total);
+}
+
+static void scan_vector_int64(int64_t *values, int exclusive, int64_t *carry)
+{
+    __m128i total = _mm_set1_epi64x((long long) *carry);
+
+    for (size_t offset = 0; offset < 64; offset += 2) {
+        __m128i cells  = _mm_loadu_si128((const __m128i *) (values + offset));
+        __m128i prefix = _mm_add_epi64(cells, _mm_slli_si128(cells, 8));
+
+        __m128i shifted = exclusive ? _mm_slli_si128(prefix, 8) : prefix;
+        _mm_storeu_si128((__m128i *) (values + offset), _mm_add_epi64(shifted, total));
+
+        total = _mm_shuffle_epi32(_mm_add_epi64(prefix, total), _MM_SHUFFLE(3, 2, 3, 2));
+    }
+
+    _mm_storel_epi64((__m128i *) carry, total);
+}
+
+static void scan_vector_float(float *values, int operation, int exclusive,
+                              float *carry)
+{
+    // identities fill the lanes that are shifted in and replace NaN cells.
+    int minimum       = operation == AA_ARAYEH_MIN;
+    float identity    = minimum ? INFINITY : -INFINITY;
+    __m128 identities = _mm_set1_ps(identity);
+    __m128 one_lane   = _mm_setr_ps(identity, 0.0f, 0.0f, 0.0f);
+    __m128 two_lanes  = _mm_setr_ps(identity, identity, 0.0f, 0.0f);
+    __m128 total      = _mm_set1_ps(*carry);
+
+    for (size_t offset = 0; offset < 64; offset += 4) {
+        __m128 cells = _mm_loadu_ps(values + offset);
+        __m128 nan   = _mm_cmpunord_ps(cells, cells);
+        cells        = _mm_or_ps(_mm_andnot_ps(nan, cells), _mm_and_ps(nan, identities));
+
+        __m128i bits   = _mm_castps_si128(cells);
+        __m128 shifted = _mm_or_ps(_mm_castsi128_ps(_mm_slli_si128(bits, 4)), one_lane);
+        __m128 prefix  = minimum ? _mm_min_ps(cells, shifted)
+                                 : _mm_max_ps(cells, shifted);
+
+        bits    = _mm_castps_si128(prefix);
+        shifted = _mm_or_ps(_mm_castsi128_ps(_mm_slli_si128(bits, 8)), two_lanes);
+        prefix  = minimum ? _mm_min_ps(prefix, shifted) : _mm_max_ps(prefix, shifted);
+
+        __m128 result = prefix;
+        if (exclusive) {
+            bits   = _mm_castps_si128(prefix);
+            result = _mm_or_ps(_mm_castsi128_ps(_mm_slli_si128(bits, 4)), one_lane);
+        }
+        result = minimum ? _mm_min_ps(result, total) : _mm_max_ps(result, total);
+        _mm_storeu_ps(values + offset, result);
+
+        __m128 last = _mm_shuffle_ps(prefix, prefix, _MM_SHUFFLE(3, 3, 3, 3));
+        total       = minimum ? _mm_min_ps(last, total) : _mm_max_ps(last, total);
+    }
+
+    *carry = _mm_cvtss_f32(total);
+}
+#endif
+
+static int scan_vector(void *cells, size_t type, int operation, int exclusive,
+                       scan_value *carry)
+{
+    /*
+     * This function scans a full block of 64 cells with a vector kernel and
+     * returns AA_ARAYEH_TRUE, or returns AA_ARAYEH_FALSE if "type" and
+     * "operation" have none.
+     */
+
+#if defined(__SSE2__)
+    size_t size = type_size(type);
+
+    if (operation == AA_ARAYEH_SUM && is_integer_type(type) && size == 4) {
+        int32_t total = (int32_t) carry->uint32_value;
+        scan_vector_int32((int32_t *) cells, exclusive, &total);
+        carry->uint32_value = (uint32_t) total;
+        return AA_ARAYEH_TRUE;
+    }
+
+    if (operation == AA_ARAYEH_SUM && is_integer_type(type) && size == 8) {
+        int64_t total = (int64_t) carry->uint64_value;
+        scan_vector_int64((int64_t *) cells, exclusive, &total);
+        carry->uint64_value = (uint64_t) total;
+        return AA_ARAYEH_TRUE;
+    }
+
+    if (operation != AA_ARAYEH_SUM && type == AA_ARAYEH_TYPE_FLOAT) {
+        scan_vector_float((float *) cells, operation, exclusive, &carry->float_value);
+        return AA_ARAYEH_TRUE;
+    }
+#else
+    (void) cells;
+    (void) type;
+    (void) operation;
+    (void) exclusive;
+    (void) carry;
+#endif
+
+    return AA_ARAYEH_FALSE;
+}
+
+int is_scan_operation(int operation)
+{
+    /*
+     * This function returns AA_ARAYEH_TRUE if "operation" is an operation of scan
+     * methods.
+     *
+     * ARGUMENTS:
+     * operation    AA_ARAYEH_SUM, AA_ARAYEH_MIN or AA_ARAYEH_MAX.
+     *
+     * RETURN:
+     * AA_ARAYEH_TRUE or AA_ARAYEH_FALSE.
+     *
+     */
+
+    return operation >= AA_ARAYEH_SUM && operation <= AA_ARAYEH_MAX;
+}
+
+void scan_identity(scan_value *value, size_t type, int operation)
+{
+    /*
+     * This function sets "value" to the identity of "operation", the value that
+     * starts a scan and is the first cell of an exclusive scan.
+     *
+     * ARGUMENTS:
+     * value        pointer to the scan value.
+     * type         numeric type of arayeh.
+     * operation    AA_ARAYEH_SUM, AA_ARAYEH_MIN or AA_ARAYEH_MAX.
+     *
+     * RETURN:
+     * no return, it's void dude.
+     *
+     */
+
+    kernels_of(type)->identity(value, operation);
+}
+
+void scan_combine(scan_value *total, const scan_value *value, size_t type,
+                  int operation)
+{
+    /*
+     * This function combines "value" into "total", e.g. adds it for sums.
+     *
+     * ARGUMENTS:
+     * total        pointer to the scan value that is updated.
+     * value        pointer to the scan value to combine.
+     * type         numeric type of arayeh.
+     * operation    AA_ARAYEH_SUM, AA_ARAYEH_MIN or AA_ARAYEH_MAX.
+     *
+     * RETURN:
+     * no return, it's void dude.
+     *
+     */
+
+    kernels_of(type)->combine(total, value, operation);
+}
+
+void scan_reduce(scan_value *total, const void *cells, const char *map, size_t type,
+                 size_t start_index, size_t end_index, int operation)
+{
+    /*
+     * This function combines the filled cells of a range into "total", the
+     * first pass of a parallel scan.
+     *
+     * ARGUMENTS:
+     * total        pointer to the scan value that is updated.
+     * cells        pointer to arayeh memory.
+     * map          pointer to arayeh map.
+     * type         numeric type of arayeh.
+     * start_index  starting index (inclusive).
+     * end_index    ending index (exclusive).
+     * operation    AA_ARAYEH_SUM, AA_ARAYEH_MIN or AA_ARAYEH_MAX.
+     *
+     * RETURN:
+     * no return, it's void dude.
+     *
+     */
+
+    const scan_kernels *kernels = kernels_of(type);
+    const char *array_pointer   = (const char *) cells;
+    size_t element_size         = type_size(type);
+
+    for (size_t block = start_index; block < end_index; block += 64) {
+        size_t length = (end_index - block < 64) ? end_index - block : 64;
+        uint64_t mask = map_block_mask(map, block, length);
+
+        if (mask == 0) {
+            continue;
+        }
+
+        if (is_half_type(type)) {
+            float floats[64];
+            convert_values(floats, AA_ARAYEH_TYPE_FLOAT,
+                           array_pointer + block * element_size, type, length,
+                           AA_ARAYEH_CONVERT_WRAP);
+            kernels->reduce(floats, mask, length, operation, total);
+            continue;
+        }
+
+        kernels->reduce(array_pointer + block * element_size, mask, length, operation,
+                        total);
+    }
+}
+
+void scan_cells(void *cells, const char *map, size_t type, size_t start_index,
+                size_t end_index, int operation, int mode, scan_value *carry)
+{
+    /*
+     * This function replaces every filled cell of a range by the running
+     * "operation" of the filled cells up to it, AA_ARAYEH_INCLUSIVE includes the
+     * cell itself and AA_ARAYEH_EXCLUSIVE doesn't, so the first filled cell
+     * becomes "carry".
+     *
+     * ARGUMENTS:
+     * cells        pointer to arayeh memory.
+     * map          pointer to arayeh map.
+     * type         numeric type of arayeh.
+     * start_index  starting index (inclusive).
+     * end_index    ending index (exclusive).
+     * operation    AA_ARAYEH_SUM, AA_ARAYEH_MIN or AA_ARAYEH_MAX.
+     * mode         AA_ARAYEH_INCLUSIVE or AA_ARAYEH_EXCLUSIVE.
+     * carry        pointer to the running value of the cells before the range,
+     *              it receives the running value of the range.
+     *
+     * RETURN:
+     * no return, it's void dude.
+     *
+     */
+
+    const scan_kernels *kernels = kernels_of(type);
+    char *array_pointer         = (char *) cells;
+    size_t element_size         = type_size(type);
+    int exclusive               = mode == AA_ARAYEH_EXCLUSIVE;
+
+    for (size_t block = start_index; block < end_index; block += 64) {
+        size_t length = (end_index - block < 64) ? end_index - block : 64;
+        uint64_t mask = map_block_mask(map, block, length);
+        char *values  = array_pointer + block * element_size;
+
+        if (mask == 0) {
+            continue;
+        }
+
+        if (is_half_type(type)) {
+            float floats[64];
+            convert_values(floats, AA_ARAYEH_TYPE_FLOAT, values, type, length,
+                           AA_ARAYEH_CONVERT_WRAP);
+            kernels->scan(floats, mask, length, operation, exclusive, carry);
+            convert_values(values, type, floats, AA_ARAYEH_TYPE_FLOAT, length,
+                           AA_ARAYEH_CONVERT_WRAP);
+            continue;
+        }
+
+        if (length == 64 && mask == UINT64_MAX &&
+            scan_vector(values, type, operation, exclusive, carry) == AA_ARAYEH_TRUE) {
+            continue;
+        }
+
+        kernels->scan(values, mask, length, operation, exclusive, carry);
+    }
+}
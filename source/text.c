@@ -0,0 +1,294 @@
+/** source/text.c
+ *
+ * This file is a part of:
+ * Azadeh Afzar - Arayehsaz (AA-A).
+ *
+ * Copyright (C) 2020 - 2021 Azadeh Afzar.
+ * Copyright (C) 2020 - 2021 Mohammad Mahdi Baghbani Pourvahid.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgement in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+
+#include "../include/text.h"
+
+#include "../include/algorithms.h"
+
+#include <string.h>
+
+#if defined(__SSE2__)
+#    include <immintrin.h>
+#endif
+
+/* Char arayehs double as text buffers, their text is the cells from index 0 to
+ * the last filled cell. the kernels below compare 16 or 32 bytes at a time and
+ * turn the result into a bitmask, so a search or split touches every byte once
+ * and only branches on matches.
+ */
+
+int text_length(arayeh *self, size_t *length)
+{
+    /*
+     * This function sets "length" to the length of the text of a char arayeh,
+     * which is one past the index of its last filled cell.
+     *
+     * text is read straight from arayeh memory, so none of the cells before
+     * the last filled cell may be empty.
+     *
+     * ARGUMENTS:
+     * self         pointer to the arayeh object.
+     * length       pointer to the location that receives the length.
+     *
+     * RETURN:
+     * state        AA_ARAYEH_SUCCESS if the text has no empty cell,
+     *              otherwise AA_ARAYEH_WRONG_INDEX.
+     *
+     */
+
+    // gap buffer mode, put cells at their logical index.
+    close_gap(self);
+
+    size_t top = find_top_index(self);
+
+    // filled cells are all below "top", so no empty cell is below it.
+    if (self->_private_properties.used != top) {
+        return AA_ARAYEH_WRONG_INDEX;
+    }
+
+    *length = top;
+
+    // return success code.
+    return AA_ARAYEH_SUCCESS;
+}
+
+static int is_match(const char *text, const char *needle, size_t needle_length)
+{
+    /*
+     * This function compares the inner bytes of a candidate whose first and last
+     * bytes are already equal to the ones of "needle".
+     *
+     * ARGUMENTS:
+     * text             pointer to the candidate.
+     * needle           pointer to the bytes being searched for.
+     * needle_length    number of bytes of needle, at least 2.
+     *
+     * RETURN:
+     * AA_ARAYEH_TRUE if the candidate is equal to needle, otherwise AA_ARAYEH_FALSE.
+     *
+     */
+
+    return (memcmp(text + 1, needle + 1, needle_length - 2) == 0) ? AA_ARAYEH_TRUE
+                                                                   : AA_ARAYEH_FALSE;
+}
+
+size_t text_find(const char *text, size_t length, const char *needle,
+                 size_t needle_length)
+{
+    /*
+     * This function returns the position of the first occurrence of
+     * "needle_length" bytes of "needle" in "length" bytes of "text".
+     *
+     * a single byte is found by memchr, longer needles compare the first and the
+     * last byte of needle with 16 or 32 candidates at once and only candidates
+     * that match both are compared in full.
+     *
+     * ARGUMENTS:
+     * text             pointer to the bytes to be searched.
+     * length           number of bytes of text.
+     * needle           pointer to the bytes being searched for.
+     * needle_length    number of bytes of needle.
+     *
+     * RETURN:
+     * position         position of needle in text, "length" if it isn't found.
+     *
+     */
+
+    // an empty needle is everywhere.
+    if (needle_length == 0) {
+        return 0;
+    }
+
+    // needle doesn't fit.
+    if (needle_length > length) {
+        return length;
+    }
+
+    if (needle_length == 1) {
+        const char *found = (const char *) memchr(text, needle[0], length);
+        return (found == NULL) ? length : (size_t) (found - text);
+    }
+
+    // candidates start before "end" and the last byte of them is "last" after it.
+    size_t last     = needle_length - 1;
+    size_t end      = length - last;
+    size_t position = 0;
+
+#if defined(__AVX2__)
+    const __m256i first_256 = _mm256_set1_epi8(needle[0]);
+    const __m256i last_256  = _mm256_set1_epi8(needle[last]);
+    for (; position + 32 <= end; position += 32) {
+        __m256i heads = _mm256_loadu_si256((const __m256i *) (text + position));
+        __m256i tails = _mm256_loadu_si256((const __m256i *) (text + position + last));
+        uint32_t mask = (uint32_t) _mm256_movemask_epi8(_mm256_and_si256(
+            _mm256_cmpeq_epi8(heads, first_256), _mm256_cmpeq_epi8(tails, last_256)));
+
+        while (mask != 0) {
+            size_t candidate = position + count_trailing_zeros(mask);
+            if (is_match(text + candidate, needle, needle_length) == AA_ARAYEH_TRUE) {
+                return candidate;
+            }
+            mask &= mask - 1;
+        }
+    }
+#endif
+#if defined(__SSE2__)
+    const __m128i first_128 = _mm_set1_epi8(needle[0]);
+    const __m128i last_128  = _mm_set1_epi8(needle[last]);
+    for (; position + 16 <= end; position += 16) {
+        __m128i heads = _mm_loadu_si128((const __m128i *) (text + position));
+        __m128i tails = _mm_loadu_si128((const __m128i *) (text + position + last));
+        uint32_t mask = (uint32_t) _mm_movemask_epi8(_mm_and_si128(
+            _mm_cmpeq_epi8(heads, first_128), _mm_cmpeq_epi8(tails, last_128)));
+
+        while (mask != 0) {
+            size_t candidate = position + count_trailing_zeros(mask);
+            if (is_match(text + candidate, needle, needle_length) == AA_ARAYEH_TRUE) {
+                return candidate;
+            }
+            mask &= mask - 1;
+        }
+    }
+#endif
+
+    // remaining candidates, jump between first bytes.
+    while (position < end) {
+        const char *found =
+            (const char *) memchr(text + position, needle[0], end - position);
+        if (found == NULL) {
+            break;
+        }
+
+        position = (size_t) (found - text);
+        if (text[position + last] == needle[last] &&
+            is_match(text + position, needle, needle_length) == AA_ARAYEH_TRUE) {
+            return position;
+        }
+        position++;
+    }
+
+    // needle doesn't exist.
+    return length;
+}
+
+size_t text_split(const char *text, size_t length, char delimiter, arayeh_range *ranges,
+                  size_t capacity)
+{
+    /*
+     * This function splits "length" bytes of "text" on "delimiter", field i is
+     * the bytes between delimiter i - 1 and delimiter i, so n delimiters make
+     * n + 1 fields and empty fields are kept.
+     *
+     * delimiters are found 16 or 32 bytes at a time as a bitmask, fields after
+     * the first "capacity" ones are counted but not written.
+     *
+     * ARGUMENTS:
+     * text         pointer to the bytes to be split.
+     * length       number of bytes of text.
+     * delimiter    byte that separates fields.
+     * ranges       pointer to room for "capacity" fields, can be NULL if it's 0.
+     * capacity     number of fields that fit in ranges.
+     *
+     * RETURN:
+     * fields       number of fields in text.
+     *
+     */
+
+    size_t fields   = 0;
+    size_t start    = 0;
+    size_t position = 0;
+
+#if defined(__AVX2__)
+    const __m256i delimiter_256 = _mm256_set1_epi8(delimiter);
+    for (; position + 32 <= length; position += 32) {
+        __m256i block = _mm256_loadu_si256((const __m256i *) (text + position));
+        uint32_t mask =
+            (uint32_t) _mm256_movemask_epi8(_mm256_cmpeq_epi8(block, delimiter_256));
+
+        while (mask != 0) {
+            size_t end = position + count_trailing_zeros(mask);
+            if (fields < capacity) {
+                ranges[fields].start = start;
+                ranges[fields].end   = end;
+            }
+            fields++;
+            start = end + 1;
+            mask &= mask - 1;
+        }
+    }
+#endif
+#if defined(__SSE2__)
+    const __m128i delimiter_128 = _mm_set1_epi8(delimiter);
+    for (; position + 16 <= length; position += 16) {
+        __m128i block = _mm_loadu_si128((const __m128i *) (text + position));
+        uint32_t mask =
+            (uint32_t) _mm_movemask_epi8(_mm_cmpeq_epi8(block, delimiter_128));
+
+        while (mask != 0) {
+            size_t end = position + count_trailing_zeros(mask);
+            if (fields < capacity) {
+                ranges[fields].start = start;
+                ranges[fields].end   = end;
+            }
+            fields++;
+            start = end + 1;
+            mask &= mask - 1;
+        }
+    }
+#endif
+
+    // remaining bytes.
+    for (; position < length; position++) {
+        if (text[position] == delimiter) {
+            if (fields < capacity) {
+                ranges[fields].start = start;
+                ranges[fields].end   = position;
+            }
+            fields++;
+            start = position + 1;
+        }
+    }
+
+    // the last field ends with the text.
+    if (fields < capacity) {
+        ranges[fields].start = start;
+        ranges[fields].end   = length;
+    }
+
+    return fields + 1;
+}
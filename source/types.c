@@ -37,6 +37,18 @@
 
 #include "../include/types.h"
 
+#include "../include/algorithms.h"
+#include "../include/arayeh_typed.h"
+#include "../include/arena.h"
+#include "../include/functions.h"
+
+#include <stddef.h>
+#include <string.h>
+
+#if defined(__SSE2__)
+#    include <immintrin.h>
+#endif
+
 /* Overflow happens when the arayeh initial size is bigger than the
  * max allowed size (defined as MAX_SIZE in size_type) divided by the
  * length of desired data type.
@@ -100,6 +112,14 @@ int _init_pointer_type_double(arayeh *self, arayeh_types *array, size_t initial_
                : AA_ARAYEH_SUCCESS;
 }
 
+int _init_pointer_type_generic(arayeh *self, arayeh_types *array, size_t initial_size)
+{
+    array->char_pointer = NULL;
+    return (initial_size > (size_t) SIZE_MAX / self->_private_properties.element_size)
+               ? AA_ARAYEH_FAILURE
+               : AA_ARAYEH_SUCCESS;
+}
+
 // Allocate memory for arayeh.
 
 int _malloc_type_char(arayeh *self, arayeh_types *array, size_t initial_size)
@@ -141,6 +161,35 @@ int _malloc_type_double(arayeh *self, arayeh_types *array, size_t initial_size)
     return (array->double_pointer == NULL) ? AA_ARAYEH_FAILURE : AA_ARAYEH_SUCCESS;
 }
 
+/* Memory of generic arayehs with an alignment bigger than the alignment of
+ * malloc() comes from aligned_alloc(), its size must be a multiple of the
+ * alignment and it can't be resized by realloc(), so it's copied.
+ */
+
+static char *malloc_aligned(size_t alignment, size_t size)
+{
+    if (alignment <= _Alignof(max_align_t)) {
+        return (char *) malloc(size);
+    }
+
+    // round size up to a multiple of alignment, at least one alignment.
+    if (size > SIZE_MAX - alignment) {
+        return NULL;
+    }
+    size = (size / alignment + 1) * alignment;
+
+    return (char *) aligned_alloc(alignment, size);
+}
+
+int _malloc_type_generic(arayeh *self, arayeh_types *array, size_t initial_size)
+{
+    struct private_properties *private_properties = &self->_private_properties;
+
+    array->char_pointer = malloc_aligned(private_properties->alignment,
+                                         private_properties->element_size * initial_size);
+    return (array->char_pointer == NULL) ? AA_ARAYEH_FAILURE : AA_ARAYEH_SUCCESS;
+}
+
 // Re-allocate memory for arayeh.
 
 int _realloc_type_char(arayeh *self, arayeh_types *array, size_t new_size)
@@ -189,6 +238,35 @@ int _realloc_type_double(arayeh *self, arayeh_types *array, size_t new_size)
     return (array->double_pointer == NULL) ? AA_ARAYEH_FAILURE : AA_ARAYEH_SUCCESS;
 }
 
+int _realloc_type_generic(arayeh *self, arayeh_types *array, size_t new_size)
+{
+    struct private_properties *private_properties = &self->_private_properties;
+
+    size_t element_size = private_properties->element_size;
+
+    if (private_properties->alignment <= _Alignof(max_align_t)) {
+        array->char_pointer = (char *) realloc(private_properties->array.char_pointer,
+                                               element_size * new_size);
+        return (array->char_pointer == NULL) ? AA_ARAYEH_FAILURE : AA_ARAYEH_SUCCESS;
+    }
+
+    array->char_pointer =
+        malloc_aligned(private_properties->alignment, element_size * new_size);
+    if (array->char_pointer == NULL) {
+        return AA_ARAYEH_FAILURE;
+    }
+
+    size_t old_size = private_properties->size;
+    size_t kept     = old_size < new_size ? old_size : new_size;
+    if (kept != 0) {
+        memcpy(array->char_pointer, private_properties->array.char_pointer,
+               element_size * kept);
+    }
+    free(private_properties->array.char_pointer);
+
+    return AA_ARAYEH_SUCCESS;
+}
+
 // Free arayeh memory.
 
 void _free_type_char(arayeh *self)
@@ -227,6 +305,12 @@ void _free_type_double(arayeh *self)
     self->_private_properties.array.double_pointer = NULL;
 }
 
+void _free_type_generic(arayeh *self)
+{
+    free(self->_private_properties.array.char_pointer);
+    self->_private_properties.array.char_pointer = NULL;
+}
+
 // Assign the initialized pointer of an array to the arayeh structs pointer.
 
 void _set_memory_pointer_type_char(arayeh *self, arayeh_types *array)
@@ -259,6 +343,11 @@ void _set_memory_pointer_type_double(arayeh *self, arayeh_types *array)
     self->_private_properties.array.double_pointer = array->double_pointer;
 }
 
+void _set_memory_pointer_type_generic(arayeh *self, arayeh_types *array)
+{
+    self->_private_properties.array.char_pointer = array->char_pointer;
+}
+
 // Add an element of a specific type to the arayeh.
 
 void _add_type_char(arayeh *self, size_t index, void *element)
@@ -291,6 +380,13 @@ void _add_type_double(arayeh *self, size_t index, void *element)
     self->_private_properties.array.double_pointer[index] = *((double *) element);
 }
 
+void _add_type_generic(arayeh *self, size_t index, void *element)
+{
+    size_t element_size = self->_private_properties.element_size;
+    copy_element(self->_private_properties.array.char_pointer + index * element_size,
+                 element, element_size);
+}
+
 // Merge an arayeh of a specific type into another arayeh.
 
 int _merge_arayeh_type_char(arayeh *self, size_t start_index, size_t step, arayeh *source)
@@ -591,6 +687,47 @@ int _merge_arayeh_type_double(arayeh *self, size_t start_index, size_t step,
     return state;
 }
 
+int _merge_arayeh_type_generic(arayeh *self, size_t start_index, size_t step,
+                               arayeh *source)
+{
+    // shorten names for god's sake.
+    struct private_properties *src_private_properties = &source->_private_properties;
+
+    // track error state in the function.
+    int state = AA_ARAYEH_SUCCESS;
+
+    // pointers.
+    char *array_pointer = src_private_properties->array.char_pointer;
+    size_t element_size = src_private_properties->element_size;
+
+    // elements of both arayehs must have the same size.
+    if (self->_private_properties.element_size != element_size) {
+        return AA_ARAYEH_WRONG_TYPE;
+    }
+
+    for (size_t array_index = 0, arayeh_index = 0;
+         array_index < src_private_properties->size; array_index++, arayeh_index += step) {
+
+        // do not insert element if its empty.
+        if (src_private_properties->map[array_index] == AA_ARAYEH_OFF) {
+            // go to next loop cycle.
+            continue;
+        }
+
+        // insert element into arayeh.
+        state = self->insert(self, start_index + arayeh_index,
+                             array_pointer + array_index * element_size);
+
+        // in case of any error abort process and return error code.
+        if (state != AA_ARAYEH_SUCCESS) {
+            break;
+        }
+    }
+
+    // return error state code.
+    return state;
+}
+
 // Merge a C standard array of a specific type into the arayeh.
 
 int _merge_array_type_char(arayeh *self, size_t start_index, size_t step,
@@ -797,6 +934,32 @@ int _merge_array_type_double(arayeh *self, size_t start_index, size_t step,
     return state;
 }
 
+int _merge_array_type_generic(arayeh *self, size_t start_index, size_t step,
+                              size_t array_size, void *array)
+{
+    // track error state in the function.
+    int state = AA_ARAYEH_SUCCESS;
+
+    // pointers.
+    char *array_pointer = (char *) array;
+    size_t element_size = self->_private_properties.element_size;
+
+    for (size_t array_index = 0, arayeh_index = 0; array_index < array_size;
+         array_index++, arayeh_index += step) {
+
+        state = self->insert(self, start_index + arayeh_index,
+                             array_pointer + array_index * element_size);
+
+        // in case of any error abort process and return error code.
+        if (state != AA_ARAYEH_SUCCESS) {
+            break;
+        }
+    }
+
+    // return error state code.
+    return state;
+}
+
 // Get an element from arayeh.
 
 void _get_type_char(arayeh *self, size_t index, void *element)
@@ -834,3 +997,632 @@ void _get_type_double(arayeh *self, size_t index, void *element)
     double *ptr = (double *) element;
     *ptr        = self->_private_properties.array.double_pointer[index];
 }
+
+void _get_type_generic(arayeh *self, size_t index, void *element)
+{
+    size_t element_size = self->_private_properties.element_size;
+    copy_element(element,
+                 self->_private_properties.array.char_pointer + index * element_size,
+                 element_size);
+}
+
+// Compare a block of arayeh cells with an element.
+
+/* The match functions compare up to 64 cells with one element and return the
+ * result as a bitmask, so callers can combine it with the map bitmask and scan
+ * the result with count_trailing_zeros() or count_set_bits().
+ *
+ * vector paths compare a full register of cells and extract one bit per cell
+ * with a movemask instruction, the scalar loop handles the remaining cells and
+ * the targets without SSE2.
+ *
+ * float and double are compared with ==, so NaN never matches and 0.0 matches -0.0.
+ */
+
+uint64_t _match_type_char(arayeh *self, size_t index, size_t length, void *element)
+{
+    char *array_pointer = self->_private_properties.array.char_pointer + index;
+    char value          = *((char *) element);
+    uint64_t mask       = 0;
+    size_t offset       = 0;
+
+#if defined(__AVX2__)
+    const __m256i needle_256 = _mm256_set1_epi8(value);
+    for (; offset + 32 <= length; offset += 32) {
+        __m256i block = _mm256_loadu_si256((const __m256i *) (array_pointer + offset));
+        uint32_t bits =
+            (uint32_t) _mm256_movemask_epi8(_mm256_cmpeq_epi8(block, needle_256));
+        mask |= (uint64_t) bits << offset;
+    }
+#endif
+#if defined(__SSE2__)
+    const __m128i needle_128 = _mm_set1_epi8(value);
+    for (; offset + 16 <= length; offset += 16) {
+        __m128i block = _mm_loadu_si128((const __m128i *) (array_pointer + offset));
+        uint32_t bits = (uint32_t) _mm_movemask_epi8(_mm_cmpeq_epi8(block, needle_128));
+        mask |= (uint64_t) bits << offset;
+    }
+#endif
+
+    for (; offset < length; offset++) {
+        mask |= (uint64_t) (array_pointer[offset] == value) << offset;
+    }
+
+    return mask;
+}
+
+uint64_t _match_type_short_int(arayeh *self, size_t index, size_t length,
+                               void *element)
+{
+    short int *array_pointer = self->_private_properties.array.short_int_pointer + index;
+    short int value          = *((short int *) element);
+    uint64_t mask            = 0;
+    size_t offset            = 0;
+
+#if defined(__SSE2__)
+    // compare 16 cells in two registers and pack the results into bytes.
+    const __m128i needle = _mm_set1_epi16(value);
+    for (; offset + 16 <= length; offset += 16) {
+        __m128i low  = _mm_loadu_si128((const __m128i *) (array_pointer + offset));
+        __m128i high = _mm_loadu_si128((const __m128i *) (array_pointer + offset + 8));
+        __m128i packed =
+            _mm_packs_epi16(_mm_cmpeq_epi16(low, needle), _mm_cmpeq_epi16(high, needle));
+        uint32_t bits = (uint32_t) _mm_movemask_epi8(packed);
+        mask |= (uint64_t) bits << offset;
+    }
+#endif
+
+    for (; offset < length; offset++) {
+        mask |= (uint64_t) (array_pointer[offset] == value) << offset;
+    }
+
+    return mask;
+}
+
+uint64_t _match_type_int(arayeh *self, size_t index, size_t length, void *element)
+{
+    int *array_pointer = self->_private_properties.array.int_pointer + index;
+    int value          = *((int *) element);
+    uint64_t mask      = 0;
+    size_t offset      = 0;
+
+#if defined(__AVX2__)
+    const __m256i needle_256 = _mm256_set1_epi32(value);
+    for (; offset + 8 <= length; offset += 8) {
+        __m256i block = _mm256_loadu_si256((const __m256i *) (array_pointer + offset));
+        __m256i equal = _mm256_cmpeq_epi32(block, needle_256);
+        uint32_t bits = (uint32_t) _mm256_movemask_ps(_mm256_castsi256_ps(equal));
+        mask |= (uint64_t) bits << offset;
+    }
+#endif
+#if defined(__SSE2__)
+    const __m128i needle_128 = _mm_set1_epi32(value);
+    for (; offset + 4 <= length; offset += 4) {
+        __m128i block = _mm_loadu_si128((const __m128i *) (array_pointer + offset));
+        __m128i equal = _mm_cmpeq_epi32(block, needle_128);
+        uint32_t bits = (uint32_t) _mm_movemask_ps(_mm_castsi128_ps(equal));
+        mask |= (uint64_t) bits << offset;
+    }
+#endif
+
+    for (; offset < length; offset++) {
+        mask |= (uint64_t) (array_pointer[offset] == value) << offset;
+    }
+
+    return mask;
+}
+
+uint64_t _match_type_long_int(arayeh *self, size_t index, size_t length,
+                              void *element)
+{
+    long int *array_pointer = self->_private_properties.array.long_int_pointer + index;
+    long int value          = *((long int *) element);
+    uint64_t mask           = 0;
+    size_t offset           = 0;
+
+#if defined(__SSE2__) && LONG_MAX == 9223372036854775807L
+    // SSE2 has no 64 bit compare, two 32 bit halves are equal only if
+    // both of them are equal, so swap the halves and combine the results.
+    const __m128i needle = _mm_set1_epi64x((long long) value);
+    for (; offset + 2 <= length; offset += 2) {
+        __m128i block   = _mm_loadu_si128((const __m128i *) (array_pointer + offset));
+        __m128i halves  = _mm_cmpeq_epi32(block, needle);
+        __m128i swapped = _mm_shuffle_epi32(halves, _MM_SHUFFLE(2, 3, 0, 1));
+        __m128i equal   = _mm_and_si128(halves, swapped);
+        uint32_t bits   = (uint32_t) _mm_movemask_pd(_mm_castsi128_pd(equal));
+        mask |= (uint64_t) bits << offset;
+    }
+#endif
+
+    for (; offset < length; offset++) {
+        mask |= (uint64_t) (array_pointer[offset] == value) << offset;
+    }
+
+    return mask;
+}
+
+uint64_t _match_type_int64(arayeh *self, size_t index, size_t length, void *element)
+{
+    int64_t *array_pointer = self->_private_properties.array.int64_pointer + index;
+    int64_t value          = *((int64_t *) element);
+    uint64_t mask          = 0;
+    size_t offset          = 0;
+
+#if defined(__SSE2__)
+    // same as the long int version, for targets where long int has 32 bits.
+    const __m128i needle = _mm_set1_epi64x((long long) value);
+    for (; offset + 2 <= length; offset += 2) {
+        __m128i block   = _mm_loadu_si128((const __m128i *) (array_pointer + offset));
+        __m128i halves  = _mm_cmpeq_epi32(block, needle);
+        __m128i swapped = _mm_shuffle_epi32(halves, _MM_SHUFFLE(2, 3, 0, 1));
+        __m128i equal   = _mm_and_si128(halves, swapped);
+        uint32_t bits   = (uint32_t) _mm_movemask_pd(_mm_castsi128_pd(equal));
+        mask |= (uint64_t) bits << offset;
+    }
+#endif
+
+    for (; offset < length; offset++) {
+        mask |= (uint64_t) (array_pointer[offset] == value) << offset;
+    }
+
+    return mask;
+}
+
+uint64_t _match_type_float(arayeh *self, size_t index, size_t length, void *element)
+{
+    float *array_pointer = self->_private_properties.array.float_pointer + index;
+    float value          = *((float *) element);
+    uint64_t mask        = 0;
+    size_t offset        = 0;
+
+#if defined(__AVX__)
+    const __m256 needle_256 = _mm256_set1_ps(value);
+    for (; offset + 8 <= length; offset += 8) {
+        __m256 block  = _mm256_loadu_ps(array_pointer + offset);
+        uint32_t bits = (uint32_t) _mm256_movemask_ps(
+            _mm256_cmp_ps(block, needle_256, _CMP_EQ_OQ));
+        mask |= (uint64_t) bits << offset;
+    }
+#endif
+#if defined(__SSE2__)
+    const __m128 needle_128 = _mm_set1_ps(value);
+    for (; offset + 4 <= length; offset += 4) {
+        __m128 block  = _mm_loadu_ps(array_pointer + offset);
+        uint32_t bits = (uint32_t) _mm_movemask_ps(_mm_cmpeq_ps(block, needle_128));
+        mask |= (uint64_t) bits << offset;
+    }
+#endif
+
+    for (; offset < length; offset++) {
+        mask |= (uint64_t) (array_pointer[offset] == value) << offset;
+    }
+
+    return mask;
+}
+
+uint64_t _match_type_double(arayeh *self, size_t index, size_t length, void *element)
+{
+    double *array_pointer = self->_private_properties.array.double_pointer + index;
+    double value          = *((double *) element);
+    uint64_t mask         = 0;
+    size_t offset         = 0;
+
+#if defined(__AVX__)
+    const __m256d needle_256 = _mm256_set1_pd(value);
+    for (; offset + 4 <= length; offset += 4) {
+        __m256d block = _mm256_loadu_pd(array_pointer + offset);
+        uint32_t bits = (uint32_t) _mm256_movemask_pd(
+            _mm256_cmp_pd(block, needle_256, _CMP_EQ_OQ));
+        mask |= (uint64_t) bits << offset;
+    }
+#endif
+#if defined(__SSE2__)
+    const __m128d needle_128 = _mm_set1_pd(value);
+    for (; offset + 2 <= length; offset += 2) {
+        __m128d block = _mm_loadu_pd(array_pointer + offset);
+        uint32_t bits = (uint32_t) _mm_movemask_pd(_mm_cmpeq_pd(block, needle_128));
+        mask |= (uint64_t) bits << offset;
+    }
+#endif
+
+    for (; offset < length; offset++) {
+        mask |= (uint64_t) (array_pointer[offset] == value) << offset;
+    }
+
+    return mask;
+}
+
+/* Generic elements are compared as bytes, elements of 1, 2, 4 and 8 bytes use
+ * the integer match functions of the same size (see set_private_methods), the
+ * rest is compared here.
+ */
+
+uint64_t _match_type_generic(arayeh *self, size_t index, size_t length, void *element)
+{
+    size_t element_size = self->_private_properties.element_size;
+    char *array_pointer = self->_private_properties.array.char_pointer;
+    uint64_t mask       = 0;
+    size_t offset       = 0;
+
+    array_pointer += index * element_size;
+
+    if (element_size == 16) {
+#if defined(__SSE2__)
+        const __m128i needle = _mm_loadu_si128((const __m128i *) element);
+        for (; offset < length; offset++) {
+            __m128i cell =
+                _mm_loadu_si128((const __m128i *) (array_pointer + offset * 16));
+            uint32_t bits = (uint32_t) _mm_movemask_epi8(_mm_cmpeq_epi8(cell, needle));
+            mask |= (uint64_t) (bits == 0xFFFF) << offset;
+        }
+#else
+        uint64_t needle[2], cell[2];
+        memcpy(needle, element, 16);
+        for (; offset < length; offset++) {
+            memcpy(cell, array_pointer + offset * 16, 16);
+            mask |= (uint64_t) (cell[0] == needle[0] && cell[1] == needle[1]) << offset;
+        }
+#endif
+        return mask;
+    }
+
+    for (; offset < length; offset++) {
+        mask |= (uint64_t) (memcmp(array_pointer + offset * element_size, element,
+                                   element_size) == 0)
+                << offset;
+    }
+
+    return mask;
+}
+
+// Convert an element into a hash index key.
+
+/* Keys of integer types are their values, so two keys are equal only if the
+ * elements are equal. floating point keys are the bit patterns of the values,
+ * except that -0.0 uses the key of 0.0 and NaN has no key, which gives the
+ * hash index the same equality rules as the match functions.
+ */
+
+int _hash_key_type_char(void *element, uint64_t *key)
+{
+    *key = (uint64_t) *((char *) element);
+    return AA_ARAYEH_TRUE;
+}
+
+int _hash_key_type_short_int(void *element, uint64_t *key)
+{
+    *key = (uint64_t) *((short int *) element);
+    return AA_ARAYEH_TRUE;
+}
+
+int _hash_key_type_int(void *element, uint64_t *key)
+{
+    *key = (uint64_t) *((int *) element);
+    return AA_ARAYEH_TRUE;
+}
+
+int _hash_key_type_long_int(void *element, uint64_t *key)
+{
+    *key = (uint64_t) *((long int *) element);
+    return AA_ARAYEH_TRUE;
+}
+
+int _hash_key_type_int64(void *element, uint64_t *key)
+{
+    *key = (uint64_t) *((int64_t *) element);
+    return AA_ARAYEH_TRUE;
+}
+
+int _hash_key_type_float(void *element, uint64_t *key)
+{
+    float value = *((float *) element);
+    uint32_t bits;
+
+    // NaN is not equal to anything.
+    if (value != value) {
+        return AA_ARAYEH_FALSE;
+    }
+
+    // 0.0 and -0.0 are equal.
+    if (value == 0) {
+        value = 0;
+    }
+
+    memcpy(&bits, &value, sizeof bits);
+    *key = bits;
+    return AA_ARAYEH_TRUE;
+}
+
+int _hash_key_type_double(void *element, uint64_t *key)
+{
+    double value = *((double *) element);
+
+    // NaN is not equal to anything.
+    if (value != value) {
+        return AA_ARAYEH_FALSE;
+    }
+
+    // 0.0 and -0.0 are equal.
+    if (value == 0) {
+        value = 0;
+    }
+
+    memcpy(key, &value, sizeof *key);
+    return AA_ARAYEH_TRUE;
+}
+
+// Add and get elements of fixed-width integer types.
+
+/* Fixed-width integer arayehs use the generic functions for memory and merges,
+ * the match and hash key functions of their size (see set_private_methods) and
+ * the typed add and get functions below.
+ */
+
+#define AA_ARAYEH_FIXED_WIDTH_TYPE(name, type, member)                             \
+    void _add_type_##name(arayeh *self, size_t index, void *element)               \
+    {                                                                              \
+        self->_private_properties.array.member[index] = *((type *) element);       \
+    }                                                                              \
+                                                                                   \
+    void _get_type_##name(arayeh *self, size_t index, void *element)               \
+    {                                                                              \
+        type *ptr = (type *) element;                                              \
+        *ptr      = self->_private_properties.array.member[index];                 \
+    }
+
+AA_ARAYEH_FIXED_WIDTH_TYPE(int8, int8_t, int8_pointer)
+AA_ARAYEH_FIXED_WIDTH_TYPE(int16, int16_t, int16_pointer)
+AA_ARAYEH_FIXED_WIDTH_TYPE(int32, int32_t, int32_pointer)
+AA_ARAYEH_FIXED_WIDTH_TYPE(int64, int64_t, int64_pointer)
+AA_ARAYEH_FIXED_WIDTH_TYPE(uint8, uint8_t, uint8_pointer)
+AA_ARAYEH_FIXED_WIDTH_TYPE(uint16, uint16_t, uint16_pointer)
+AA_ARAYEH_FIXED_WIDTH_TYPE(uint32, uint32_t, uint32_pointer)
+AA_ARAYEH_FIXED_WIDTH_TYPE(uint64, uint64_t, uint64_pointer)
+
+#undef AA_ARAYEH_FIXED_WIDTH_TYPE
+
+// Add, get and compare elements of half precision types.
+
+/* Half precision arayehs keep 16 bit cells, elements are floats and converted on
+ * add and get. cells are compared by their bits, a float that has no exact half
+ * never matches, NaN never matches and 0.0 matches -0.0 like floats do.
+ */
+
+#define AA_ARAYEH_HALF_TYPE(name, member)                                          \
+    void _add_type_##name(arayeh *self, size_t index, void *element)               \
+    {                                                                              \
+        self->_private_properties.array.member[index] =                            \
+            arayeh_float_to_##name(*((float *) element));                          \
+    }                                                                              \
+                                                                                   \
+    void _get_type_##name(arayeh *self, size_t index, void *element)               \
+    {                                                                              \
+        uint16_t half = self->_private_properties.array.member[index];             \
+        float *ptr    = (float *) element;                                         \
+        *ptr          = arayeh_##name##_to_float(half);                            \
+    }                                                                              \
+                                                                                   \
+    uint64_t _match_type_##name(arayeh *self, size_t index, size_t length,         \
+                                void *element)                                     \
+    {                                                                              \
+        float value   = *((float *) element);                                      \
+        uint16_t half = arayeh_float_to_##name(value);                             \
+        uint64_t mask;                                                             \
+                                                                                   \
+        if (value != value || arayeh_##name##_to_float(half) != value) {           \
+            return 0;                                                              \
+        }                                                                          \
+                                                                                   \
+        mask = _match_type_short_int(self, index, length, &half);                  \
+        if (value == 0) {                                                          \
+            half ^= 0x8000;                                                        \
+            mask |= _match_type_short_int(self, index, length, &half);             \
+        }                                                                          \
+                                                                                   \
+        return mask;                                                               \
+    }
+
+AA_ARAYEH_HALF_TYPE(float16, float16_pointer)
+AA_ARAYEH_HALF_TYPE(bfloat16, bfloat16_pointer)
+
+#undef AA_ARAYEH_HALF_TYPE
+
+// Add, get and compare elements of string type.
+
+/* String arayehs use the generic functions for cell memory, cells hold the
+ * offset of their bytes in the arena (see arena.c), elements are arayeh_string
+ * views of the bytes.
+ */
+
+void _free_type_string(arayeh *self)
+{
+    _free_type_generic(self);
+    arena_free(self);
+}
+
+void _add_type_string(arayeh *self, size_t index, void *element)
+{
+    struct arayeh_arena *arena = &self->_private_properties.arena;
+
+    arena_store(self, index, (const arayeh_string *) element, (uintptr_t) arena->bytes,
+                arena->used);
+}
+
+void _get_type_string(arayeh *self, size_t index, void *element)
+{
+    arayeh_string_cell cell = self->_private_properties.array.string_pointer[index];
+    char *bytes             = self->_private_properties.arena.bytes;
+    arayeh_string *ptr      = (arayeh_string *) element;
+
+    ptr->bytes  = (bytes == NULL) ? "" : bytes + cell.offset;
+    ptr->length = cell.length;
+}
+
+uint64_t _match_type_string(arayeh *self, size_t index, size_t length, void *element)
+{
+    arayeh_string_cell *cells = self->_private_properties.array.string_pointer + index;
+    const char *bytes         = self->_private_properties.arena.bytes;
+    arayeh_string *value      = (arayeh_string *) element;
+    uint64_t mask             = 0;
+
+    // compare lengths first, bytes only for strings of the same length.
+    for (size_t offset = 0; offset < length; offset++) {
+        if (cells[offset].length == value->length &&
+            (value->length == 0 ||
+             memcmp(bytes + cells[offset].offset, value->bytes, value->length) == 0)) {
+            mask |= (uint64_t) 1 << offset;
+        }
+    }
+
+    return mask;
+}
+
+// Add, get and compare elements of boolean type.
+
+/* Unpacked boolean arayehs use the generic functions for memory and hold 0 or 1
+ * in a char cell. packed boolean arayehs hold 64 cells in a word, their memory
+ * is counted in words and cells are compared a word at a time.
+ */
+
+void _add_type_bool(arayeh *self, size_t index, void *element)
+{
+    self->_private_properties.array.char_pointer[index] = (*(char *) element != 0);
+}
+
+void _get_type_bool(arayeh *self, size_t index, void *element)
+{
+    *(char *) element = self->_private_properties.array.char_pointer[index];
+}
+
+uint64_t _match_type_bool(arayeh *self, size_t index, size_t length, void *element)
+{
+    // cells hold 0 or 1 only.
+    char needle = (*(char *) element != 0);
+
+    return _match_type_char(self, index, length, &needle);
+}
+
+int _init_pointer_type_bit(arayeh *self, arayeh_types *array, size_t initial_size)
+{
+    array->bool_pointer = NULL;
+    return (AA_ARAYEH_MASK_SIZE(initial_size) > (size_t) SIZE_MAX / sizeof(uint64_t))
+               ? AA_ARAYEH_FAILURE
+               : AA_ARAYEH_SUCCESS;
+}
+
+int _malloc_type_bit(arayeh *self, arayeh_types *array, size_t initial_size)
+{
+    array->bool_pointer =
+        (uint64_t *) malloc(sizeof(uint64_t) * AA_ARAYEH_MASK_SIZE(initial_size));
+    return (array->bool_pointer == NULL) ? AA_ARAYEH_FAILURE : AA_ARAYEH_SUCCESS;
+}
+
+int _realloc_type_bit(arayeh *self, arayeh_types *array, size_t new_size)
+{
+    array->bool_pointer =
+        (uint64_t *) realloc(self->_private_properties.array.bool_pointer,
+                             sizeof(uint64_t) * AA_ARAYEH_MASK_SIZE(new_size));
+    return (array->bool_pointer == NULL) ? AA_ARAYEH_FAILURE : AA_ARAYEH_SUCCESS;
+}
+
+void _add_type_bit(arayeh *self, size_t index, void *element)
+{
+    write_bit(self->_private_properties.array.bool_pointer, index,
+              *(char *) element != 0);
+}
+
+void _get_type_bit(arayeh *self, size_t index, void *element)
+{
+    uint64_t *words = self->_private_properties.array.bool_pointer;
+
+    *(char *) element = (char) read_bit(words, index);
+}
+
+uint64_t _match_type_bit(arayeh *self, size_t index, size_t length, void *element)
+{
+    uint64_t *words = self->_private_properties.array.bool_pointer;
+    uint64_t bits   = read_bits(words, index, length);
+
+    // cells equal to false are the cleared bits.
+    if (*(char *) element == 0) {
+        bits = ~bits;
+    }
+
+    return (length == 64) ? bits : bits & (((uint64_t) 1 << length) - 1);
+}
+
+// Merge elements of types whose cells are not their elements.
+
+/* Elements of half precision, string and boolean arayehs are converted on add
+ * and get, so merges go element by element through get and insert, C arrays
+ * hold elements (floats, arayeh_string views or chars), not cells. merges from
+ * or into narrowed arayehs go the same way, so they keep their storage.
+ */
+
+int _merge_arayeh_type_element(arayeh *self, size_t start_index, size_t step,
+                               arayeh *source)
+{
+    // shorten names for god's sake.
+    struct private_properties *src_private_properties = &source->_private_properties;
+
+    // track error state in the function.
+    int state = AA_ARAYEH_SUCCESS;
+
+    // an element of any of these types.
+    union {
+        int64_t integer;
+        double double_real;
+        float real;
+        arayeh_string string;
+    } element;
+
+    size_t size = src_private_properties->size;
+
+    for (size_t array_index = 0, arayeh_index = 0; array_index < size;
+         array_index++, arayeh_index += step) {
+
+        // do not insert element if its empty.
+        if (src_private_properties->map[array_index] == AA_ARAYEH_OFF) {
+            // go to next loop cycle.
+            continue;
+        }
+
+        // insert element into arayeh.
+        source->_private_methods.get_from_arayeh(source, array_index, &element);
+        state = self->insert(self, start_index + arayeh_index, &element);
+
+        // in case of any error abort process and return error code.
+        if (state != AA_ARAYEH_SUCCESS) {
+            break;
+        }
+    }
+
+    // return error state code.
+    return state;
+}
+
+int _merge_array_type_element(arayeh *self, size_t start_index, size_t step,
+                              size_t array_size, void *array)
+{
+    // track error state in the function.
+    int state = AA_ARAYEH_SUCCESS;
+
+    // pointers.
+    char *array_pointer = (char *) array;
+    size_t value_size   = element_value_size(self);
+
+    for (size_t array_index = 0, arayeh_index = 0; array_index < array_size;
+         array_index++, arayeh_index += step) {
+
+        state = self->insert(self, start_index + arayeh_index,
+                             array_pointer + array_index * value_size);
+
+        // in case of any error abort process and return error code.
+        if (state != AA_ARAYEH_SUCCESS) {
+            break;
+        }
+    }
+
+    // return error state code.
+    return state;
+}
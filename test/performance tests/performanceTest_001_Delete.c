@@ -0,0 +1,85 @@
+/** test/performanceTest_001_Delete.c
+ *
+ * This file is a part of:
+ * Azadeh Afzar - Arayehsaz (AA-A).
+ *
+ * Copyright (C) 2020 - 2021 Azadeh Afzar.
+ * Copyright (C) 2020 - 2021 Mohammad Mahdi Baghbani Pourvahid.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgement in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "../../include/arayeh.h"
+#include "timing.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+int main(int argc, char *argv[])
+{
+    /*
+     * Benchmark: delete 10% of the cells of an int arayeh, as one contiguous
+     * slice and as a stepped slice, with and without shifting.
+     *
+     * usage: perfTest_001_Delete [arayeh size], default size is 10^8 .
+     *
+     */
+
+    size_t arayeh_size = (argc > 1) ? (size_t) strtoull(argv[1], NULL, 10) : 100000000;
+    size_t slice_size  = arayeh_size / 10;
+
+    const char *names[4] = {"contiguous", "contiguous + shift", "step 10",
+                            "step 10 + shift"};
+    size_t steps[4]      = {1, 1, 10, 10};
+    size_t ends[4]       = {slice_size, slice_size, arayeh_size, arayeh_size};
+    char shifts[4]       = {AA_ARAYEH_OFF, AA_ARAYEH_ON, AA_ARAYEH_OFF, AA_ARAYEH_ON};
+
+    for (int test = 0; test < 4; test++) {
+        arayeh *array = Arayeh(AA_ARAYEH_TYPE_INT, arayeh_size);
+        if (array == NULL) {
+            return EXIT_FAILURE;
+        }
+
+        int element = 1;
+        array->fill(array, 0, 1, arayeh_size, &element);
+
+        struct timespec start;
+        timespec_get(&start, TIME_UTC);
+        array->delete_slice(array, 0, steps[test], ends[test], shifts[test]);
+        double seconds = elapsed(&start);
+
+        printf("%-20s deleted %zu of %zu cells in %.6f s\n", names[test],
+               arayeh_size - array->used, arayeh_size, seconds);
+
+        array->free_arayeh(&array);
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,104 @@
+/** test/performanceTest_002_GapBuffer.c
+ *
+ * This file is a part of:
+ * Azadeh Afzar - Arayehsaz (AA-A).
+ *
+ * Copyright (C) 2020 - 2021 Azadeh Afzar.
+ * Copyright (C) 2020 - 2021 Mohammad Mahdi Baghbani Pourvahid.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgement in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "../../include/arayeh.h"
+#include "timing.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+int main(int argc, char *argv[])
+{
+    /*
+     * Benchmark: type and delete characters near a slowly moving cursor in the
+     * middle of a large char arayeh, with and without gap buffer mode.
+     *
+     * usage: perfTest_002_GapBuffer [arayeh size] [edits], defaults are 10^7
+     * and 10^4 .
+     *
+     */
+
+    size_t arayeh_size = (argc > 1) ? (size_t) strtoull(argv[1], NULL, 10) : 10000000;
+    size_t edits       = (argc > 2) ? (size_t) strtoull(argv[2], NULL, 10) : 10000;
+
+    const char *names[2] = {"shift", "gap buffer"};
+    char modes[2]        = {AA_ARAYEH_OFF, AA_ARAYEH_ON};
+
+    for (int test = 0; test < 2; test++) {
+        arayeh *array = Arayeh(AA_ARAYEH_TYPE_CHAR, arayeh_size);
+        if (array == NULL) {
+            return EXIT_FAILURE;
+        }
+
+        arayeh_settings new_settings = {.debug_messages = AA_ARAYEH_OFF,
+                                        .extend_size    = AA_ARAYEH_ON,
+                                        .gap_buffer     = modes[test]};
+        array->set_settings(array, &new_settings);
+
+        char element = 'a';
+        array->fill(array, 0, 1, arayeh_size, &element);
+
+        struct timespec start;
+        timespec_get(&start, TIME_UTC);
+
+        size_t cursor = arayeh_size / 2;
+        for (size_t edit = 0; edit < edits; edit++) {
+            if (edit % 4 == 3) {
+                array->delete_item(array, cursor - 1, AA_ARAYEH_ON);
+                cursor--;
+            } else {
+                array->insert_shift(array, cursor, &element);
+                cursor++;
+            }
+
+            // move the cursor around every now and then.
+            if (edit % 1000 == 999) {
+                cursor -= 500;
+            }
+        }
+
+        double seconds = elapsed(&start);
+
+        printf("%-12s %zu edits on %zu cells in %.6f s\n", names[test], edits,
+               arayeh_size, seconds);
+
+        array->free_arayeh(&array);
+    }
+
+    return EXIT_SUCCESS;
+}
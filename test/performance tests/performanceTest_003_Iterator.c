@@ -0,0 +1,92 @@
+/** test/performanceTest_003_Iterator.c
+ *
+ * This file is a part of:
+ * Azadeh Afzar - Arayehsaz (AA-A).
+ *
+ * Copyright (C) 2020 - 2021 Azadeh Afzar.
+ * Copyright (C) 2020 - 2021 Mohammad Mahdi Baghbani Pourvahid.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgement in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "../../include/arayeh.h"
+#include "timing.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+int main(int argc, char *argv[])
+{
+    /*
+     * Benchmark: sum a 1% occupied int arayeh by checking every cell of the map
+     * and with the iterator.
+     *
+     * usage: perfTest_003_Iterator [arayeh size], default size is 10^8 .
+     *
+     */
+
+    size_t arayeh_size = (argc > 1) ? (size_t) strtoull(argv[1], NULL, 10) : 100000000;
+
+    arayeh *array = Arayeh(AA_ARAYEH_TYPE_INT, arayeh_size);
+    if (array == NULL) {
+        return EXIT_FAILURE;
+    }
+
+    // fill one cell in every hundred cells.
+    int element = 1;
+    array->fill(array, 0, 100, arayeh_size, &element);
+
+    struct timespec start;
+    long long sum = 0;
+
+    // check every cell.
+    timespec_get(&start, TIME_UTC);
+    for (size_t index = 0; index < arayeh_size; index++) {
+        if (array->_private_properties.map[index] == AA_ARAYEH_ON) {
+            array->get(array, index, &element);
+            sum += element;
+        }
+    }
+    printf("%-10s sum %lld in %.6f s\n", "get", sum, elapsed(&start));
+
+    // visit filled cells only.
+    arayeh_iterator iterator;
+    sum = 0;
+    timespec_get(&start, TIME_UTC);
+    array->iter_begin(array, &iterator);
+    while (array->iter_next(array, &iterator)) {
+        sum += *(int *) iterator.element;
+    }
+    printf("%-10s sum %lld in %.6f s\n", "iterator", sum, elapsed(&start));
+
+    array->free_arayeh(&array);
+
+    return EXIT_SUCCESS;
+}
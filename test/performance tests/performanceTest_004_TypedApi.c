@@ -0,0 +1,112 @@
+/** test/performanceTest_004_TypedApi.c
+ *
+ * This file is a part of:
+ * Azadeh Afzar - Arayehsaz (AA-A).
+ *
+ * Copyright (C) 2020 - 2021 Azadeh Afzar.
+ * Copyright (C) 2020 - 2021 Mohammad Mahdi Baghbani Pourvahid.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgement in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "../../include/arayeh_typed.h"
+#include "timing.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+int main(int argc, char *argv[])
+{
+    /*
+     * Benchmark: add and sum int elements with the methods of arayeh, with
+     * the typed API and with a writer.
+     *
+     * usage: perfTest_004_TypedApi [elements], default is 10^8 .
+     *
+     */
+
+    size_t elements = (argc > 1) ? (size_t) strtoull(argv[1], NULL, 10) : 100000000;
+
+    arayeh *method = Arayeh(AA_ARAYEH_TYPE_INT, 16);
+    arayeh *typed  = Arayeh(AA_ARAYEH_TYPE_INT, 16);
+    arayeh *writer = Arayeh(AA_ARAYEH_TYPE_INT, 16);
+    if (method == NULL || typed == NULL || writer == NULL) {
+        return EXIT_FAILURE;
+    }
+
+    struct timespec start;
+    long long sum = 0;
+
+    // methods.
+    timespec_get(&start, TIME_UTC);
+    for (size_t index = 0; index < elements; index++) {
+        int element = (int) index;
+        method->add(method, &element);
+    }
+    for (size_t index = 0; index < elements; index++) {
+        int element;
+        method->get(method, index, &element);
+        sum += element;
+    }
+    printf("%-8s sum %lld in %.6f s\n", "methods", sum, elapsed(&start));
+
+    // typed API.
+    sum = 0;
+    timespec_get(&start, TIME_UTC);
+    for (size_t index = 0; index < elements; index++) {
+        arayeh_int_add(typed, (int) index);
+    }
+    for (size_t index = 0; index < elements; index++) {
+        sum += arayeh_int_get(typed, index);
+    }
+    printf("%-8s sum %lld in %.6f s\n", "typed", sum, elapsed(&start));
+
+    // writer.
+    sum = 0;
+    timespec_get(&start, TIME_UTC);
+    arayeh_writer cells;
+    if (writer->writer_open(writer, &cells, elements) != AA_ARAYEH_SUCCESS) {
+        return EXIT_FAILURE;
+    }
+    for (size_t index = 0; index < elements; index++) {
+        arayeh_int_push(&cells, (int) index);
+    }
+    writer->writer_close(writer, &cells);
+    for (size_t index = 0; index < elements; index++) {
+        sum += arayeh_int_get(writer, index);
+    }
+    printf("%-8s sum %lld in %.6f s\n", "writer", sum, elapsed(&start));
+
+    method->free_arayeh(&method);
+    typed->free_arayeh(&typed);
+    writer->free_arayeh(&writer);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,106 @@
+/** test/performanceTest_005_Policy.c
+ *
+ * This file is a part of:
+ * Azadeh Afzar - Arayehsaz (AA-A).
+ *
+ * Copyright (C) 2020 - 2021 Azadeh Afzar.
+ * Copyright (C) 2020 - 2021 Mohammad Mahdi Baghbani Pourvahid.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgement in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "../../include/arayeh.h"
+#include "timing.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+int main(int argc, char *argv[])
+{
+    /*
+     * Benchmark: calls of methods that decide on size extension settings,
+     * adds into a full arayeh that may not grow and inserts past arayeh size
+     * with manual method size settings.
+     *
+     * usage: perfTest_005_Policy [calls], default is 10^8 .
+     *
+     */
+
+    size_t calls = (argc > 1) ? (size_t) strtoull(argv[1], NULL, 10) : 100000000;
+
+    arayeh *full   = Arayeh(AA_ARAYEH_TYPE_INT, 1);
+    arayeh *manual = Arayeh(AA_ARAYEH_TYPE_INT, 1);
+    if (full == NULL || manual == NULL) {
+        return EXIT_FAILURE;
+    }
+
+    arayeh_settings no_extend = {.debug_messages = AA_ARAYEH_OFF,
+                                 .extend_size    = AA_ARAYEH_OFF};
+    full->set_settings(full, &no_extend);
+
+    arayeh_size_settings no_insert = {.extend_add          = AA_ARAYEH_ON,
+                                      .extend_insert       = AA_ARAYEH_OFF,
+                                      .extend_fill         = AA_ARAYEH_ON,
+                                      .extend_merge_arayeh = AA_ARAYEH_ON,
+                                      .extend_merge_array  = AA_ARAYEH_ON};
+    arayeh_settings by_method = {.debug_messages = AA_ARAYEH_OFF,
+                                 .extend_size    = AA_ARAYEH_MANUAL};
+    manual->set_settings(manual, &by_method);
+    manual->set_size_settings(manual, &no_insert);
+
+    struct timespec start;
+    size_t rejected = 0;
+    int element     = 1;
+
+    // adds into a full arayeh.
+    full->add(full, &element);
+    timespec_get(&start, TIME_UTC);
+    for (size_t index = 0; index < calls; index++) {
+        rejected += full->add(full, &element) == AA_ARAYEH_NOT_ENOUGH_SPACE;
+    }
+    double seconds = elapsed(&start);
+    printf("%-8s %zu rejected in %.6f s, %.3f ns per call\n", "add", rejected, seconds,
+           seconds * 1e9 / (double) calls);
+
+    // inserts past arayeh size.
+    rejected = 0;
+    timespec_get(&start, TIME_UTC);
+    for (size_t index = 0; index < calls; index++) {
+        rejected += manual->insert(manual, 1, &element) == AA_ARAYEH_NOT_ENOUGH_SPACE;
+    }
+    seconds = elapsed(&start);
+    printf("%-8s %zu rejected in %.6f s, %.3f ns per call\n", "insert", rejected,
+           seconds, seconds * 1e9 / (double) calls);
+
+    full->free_arayeh(&full);
+    manual->free_arayeh(&manual);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,104 @@
+/** test/performanceTest_006_Convert.c
+ *
+ * This file is a part of:
+ * Azadeh Afzar - Arayehsaz (AA-A).
+ *
+ * Copyright (C) 2020 - 2021 Azadeh Afzar.
+ * Copyright (C) 2020 - 2021 Mohammad Mahdi Baghbani Pourvahid.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgement in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "../../include/arayeh.h"
+#include "timing.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+int main(int argc, char *argv[])
+{
+    /*
+     * Benchmark: converting an int arayeh into a double arayeh by get and add
+     * of every element, by convert_to method, and a double arayeh into uint8
+     * with saturation in place by change_type method.
+     *
+     * usage: perfTest_006_Convert [elements], default is 10^7 .
+     *
+     */
+
+    size_t elements = (argc > 1) ? (size_t) strtoull(argv[1], NULL, 10) : 10000000;
+
+    arayeh *ints = Arayeh(AA_ARAYEH_TYPE_INT, elements);
+    if (ints == NULL) {
+        return EXIT_FAILURE;
+    }
+
+    for (size_t index = 0; index < elements; index++) {
+        int value = (int) (index % 1000) - 500;
+        ints->add(ints, &value);
+    }
+
+    struct timespec start;
+
+    // element by element.
+    timespec_get(&start, TIME_UTC);
+    arayeh *by_element = Arayeh(AA_ARAYEH_TYPE_DOUBLE, elements);
+    for (size_t index = 0; index < elements; index++) {
+        int value;
+        ints->get(ints, index, &value);
+        double real = (double) value;
+        by_element->add(by_element, &real);
+    }
+    double seconds = elapsed(&start);
+    printf("%-12s %zu elements in %.6f s, %.3f ns per element\n", "get+add", elements,
+           seconds, seconds * 1e9 / (double) elements);
+
+    // block kernels.
+    timespec_get(&start, TIME_UTC);
+    arayeh *converted = ints->convert_to(ints, AA_ARAYEH_TYPE_DOUBLE,
+                                         AA_ARAYEH_CONVERT_STRICT);
+    seconds = elapsed(&start);
+    printf("%-12s %zu elements in %.6f s, %.3f ns per element\n", "convert_to", elements,
+           seconds, seconds * 1e9 / (double) elements);
+
+    // in place narrowing with saturation.
+    timespec_get(&start, TIME_UTC);
+    converted->change_type(converted, AA_ARAYEH_TYPE_UINT8,
+                           AA_ARAYEH_CONVERT_SATURATE | AA_ARAYEH_ROUND_NEAREST);
+    seconds = elapsed(&start);
+    printf("%-12s %zu elements in %.6f s, %.3f ns per element\n", "change_type", elements,
+           seconds, seconds * 1e9 / (double) elements);
+
+    ints->free_arayeh(&ints);
+    by_element->free_arayeh(&by_element);
+    converted->free_arayeh(&converted);
+
+    return EXIT_SUCCESS;
+}
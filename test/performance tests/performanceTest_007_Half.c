@@ -0,0 +1,117 @@
+/** test/performance tests/performanceTest_007_Half.c
+ *
+ * This file is a part of:
+ * Azadeh Afzar - Arayehsaz (AA-A).
+ *
+ * Copyright (C) 2020 - 2021 Azadeh Afzar.
+ * Copyright (C) 2020 - 2021 Mohammad Mahdi Baghbani Pourvahid.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgement in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+
+#include "../../include/arayeh.h"
+#include "timing.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+// reducer, adds float elements to the sum in "accumulator".
+static void sum(const void *block, size_t count, void *accumulator)
+{
+    const float *elements = (const float *) block;
+
+    for (size_t index = 0; index < count; index++) {
+        *(float *) accumulator += elements[index];
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    /*
+     * Benchmark: converting a float arayeh into float16 and back in place by
+     * change_type method, and summing a float arayeh and its float16 copy by
+     * pipeline_reduce method, float16 moves half of the bytes.
+     *
+     * usage: perfTest_007_Half [elements], default is 10^7 .
+     *
+     */
+
+    size_t elements = (argc > 1) ? (size_t) strtoull(argv[1], NULL, 10) : 10000000;
+
+    arayeh *floats = Arayeh(AA_ARAYEH_TYPE_FLOAT, elements);
+    if (floats == NULL) {
+        return EXIT_FAILURE;
+    }
+
+    for (size_t index = 0; index < elements; index++) {
+        float value = (float) (index % 1000) * 0.125f;
+        floats->add(floats, &value);
+    }
+
+    struct timespec start;
+    arayeh_pipeline pipeline = {NULL, 0};
+
+    // bulk conversions.
+    arayeh *halves = floats->convert_to(floats, AA_ARAYEH_TYPE_FLOAT, 0);
+    timespec_get(&start, TIME_UTC);
+    halves->change_type(halves, AA_ARAYEH_TYPE_FLOAT16, AA_ARAYEH_CONVERT_SATURATE);
+    double seconds = elapsed(&start);
+    printf("%-12s %zu elements in %.6f s, %.3f ns per element\n", "to float16", elements,
+           seconds, seconds * 1e9 / (double) elements);
+
+    arayeh *widened = halves->convert_to(halves, AA_ARAYEH_TYPE_FLOAT16, 0);
+    timespec_get(&start, TIME_UTC);
+    widened->change_type(widened, AA_ARAYEH_TYPE_FLOAT, AA_ARAYEH_CONVERT_STRICT);
+    seconds = elapsed(&start);
+    printf("%-12s %zu elements in %.6f s, %.3f ns per element\n", "to float", elements,
+           seconds, seconds * 1e9 / (double) elements);
+
+    // reductions accumulate in float.
+    float total = 0;
+    timespec_get(&start, TIME_UTC);
+    floats->pipeline_reduce(floats, &pipeline, sum, &total);
+    seconds = elapsed(&start);
+    printf("%-12s %zu elements in %.6f s, %.3f ns per element, sum %g\n", "float sum",
+           elements, seconds, seconds * 1e9 / (double) elements, (double) total);
+
+    total = 0;
+    timespec_get(&start, TIME_UTC);
+    halves->pipeline_reduce(halves, &pipeline, sum, &total);
+    seconds = elapsed(&start);
+    printf("%-12s %zu elements in %.6f s, %.3f ns per element, sum %g\n", "float16 sum",
+           elements, seconds, seconds * 1e9 / (double) elements, (double) total);
+
+    floats->free_arayeh(&floats);
+    halves->free_arayeh(&halves);
+    widened->free_arayeh(&widened);
+
+    return EXIT_SUCCESS;
+}
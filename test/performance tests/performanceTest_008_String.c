@@ -0,0 +1,108 @@
+/** test/performance tests/performanceTest_008_String.c
+ *
+ * This file is a part of:
+ * Azadeh Afzar - Arayehsaz (AA-A).
+ *
+ * Copyright (C) 2020 - 2021 Azadeh Afzar.
+ * Copyright (C) 2020 - 2021 Mohammad Mahdi Baghbani Pourvahid.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgement in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+
+#include "../../include/arayeh_typed.h"
+#include "timing.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+int main(int argc, char *argv[])
+{
+    /*
+     * Benchmark: adding short strings to a string arayeh one by one by add
+     * method and all at once by add_strings method, then compacting the arena
+     * after deleting every other string.
+     *
+     * usage: perfTest_008_String [strings], default is 10^7 .
+     *
+     */
+
+    size_t strings = (argc > 1) ? (size_t) strtoull(argv[1], NULL, 10) : 10000000;
+
+    // decimal numbers in one buffer.
+    char *bytes     = (char *) malloc(strings * 21);
+    size_t *offsets = (size_t *) malloc((strings + 1) * sizeof(size_t));
+    if (bytes == NULL || offsets == NULL) {
+        return EXIT_FAILURE;
+    }
+
+    offsets[0] = 0;
+    for (size_t index = 0; index < strings; index++) {
+        int written        = sprintf(bytes + offsets[index], "%zu", index * 7919);
+        offsets[index + 1] = offsets[index] + (size_t) written;
+    }
+
+    struct timespec start;
+
+    // one by one.
+    timespec_get(&start, TIME_UTC);
+    arayeh *by_string = Arayeh(AA_ARAYEH_TYPE_STRING, 16);
+    for (size_t index = 0; index < strings; index++) {
+        arayeh_string element = {bytes + offsets[index],
+                                 offsets[index + 1] - offsets[index]};
+        by_string->add(by_string, &element);
+    }
+    double seconds = elapsed(&start);
+    printf("%-12s %zu strings in %.6f s, %.3f ns per string\n", "add", strings, seconds,
+           seconds * 1e9 / (double) strings);
+
+    // in bulk.
+    timespec_get(&start, TIME_UTC);
+    arayeh *bulk = Arayeh(AA_ARAYEH_TYPE_STRING, 16);
+    bulk->add_strings(bulk, bytes, offsets, strings);
+    seconds = elapsed(&start);
+    printf("%-12s %zu strings in %.6f s, %.3f ns per string\n", "add_strings", strings,
+           seconds, seconds * 1e9 / (double) strings);
+
+    // compaction after deletes.
+    bulk->delete_slice(bulk, 0, 2, strings, AA_ARAYEH_OFF);
+    timespec_get(&start, TIME_UTC);
+    bulk->compact_arena(bulk);
+    seconds = elapsed(&start);
+    printf("%-12s %zu strings in %.6f s, %.3f ns per string\n", "compact", strings,
+           seconds, seconds * 1e9 / (double) strings);
+
+    by_string->free_arayeh(&by_string);
+    bulk->free_arayeh(&bulk);
+    free(bytes);
+    free(offsets);
+
+    return EXIT_SUCCESS;
+}
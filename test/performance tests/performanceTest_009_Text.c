@@ -0,0 +1,113 @@
+/** test/performance tests/performanceTest_009_Text.c
+ *
+ * This file is a part of:
+ * Azadeh Afzar - Arayehsaz (AA-A).
+ *
+ * Copyright (C) 2020 - 2021 Azadeh Afzar.
+ * Copyright (C) 2020 - 2021 Mohammad Mahdi Baghbani Pourvahid.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgement in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+
+#include "../../include/arayeh_typed.h"
+#include "timing.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+int main(int argc, char *argv[])
+{
+    /*
+     * Benchmark: building a text in a char arayeh one char at a time by add
+     * method and one line at a time by append_bytes method, then searching a
+     * word that isn't in the text and splitting the text into lines.
+     *
+     * usage: perfTest_009_Text [lines], default is 10^6 .
+     *
+     */
+
+    size_t lines = (argc > 1) ? (size_t) strtoull(argv[1], NULL, 10) : 1000000;
+
+    const char *line   = "azadeh afzar arayehsaz, a dynamic array library in c.\n";
+    size_t line_length = strlen(line);
+    size_t bytes       = lines * line_length;
+
+    struct timespec start;
+
+    // one char at a time.
+    timespec_get(&start, TIME_UTC);
+    arayeh *by_char = Arayeh(AA_ARAYEH_TYPE_CHAR, 16);
+    for (size_t index = 0; index < lines; index++) {
+        for (size_t offset = 0; offset < line_length; offset++) {
+            char letter = line[offset];
+            by_char->add(by_char, &letter);
+        }
+    }
+    double seconds = elapsed(&start);
+    printf("%-14s %zu bytes in %.6f s, %.3f ns per byte\n", "add", bytes, seconds,
+           seconds * 1e9 / (double) bytes);
+
+    // one line at a time.
+    timespec_get(&start, TIME_UTC);
+    arayeh *text = Arayeh(AA_ARAYEH_TYPE_CHAR, 16);
+    for (size_t index = 0; index < lines; index++) {
+        text->append_bytes(text, line, line_length);
+    }
+    seconds = elapsed(&start);
+    printf("%-14s %zu bytes in %.6f s, %.3f ns per byte\n", "append_bytes", bytes,
+           seconds, seconds * 1e9 / (double) bytes);
+
+    // search the whole text.
+    size_t found;
+    timespec_get(&start, TIME_UTC);
+    int state = text->find_bytes(text, 0, "arayehsaz!", 10, &found);
+    seconds   = elapsed(&start);
+    printf("%-14s %zu bytes in %.6f s, %.3f ns per byte (%s)\n", "find_bytes", bytes,
+           seconds, seconds * 1e9 / (double) bytes,
+           (state == AA_ARAYEH_NOT_FOUND) ? "not found" : "found");
+
+    // split into lines.
+    arayeh_range *ranges = (arayeh_range *) malloc((lines + 1) * sizeof(arayeh_range));
+    if (ranges == NULL) {
+        return EXIT_FAILURE;
+    }
+    timespec_get(&start, TIME_UTC);
+    size_t fields = text->split(text, '\n', ranges, lines + 1);
+    seconds       = elapsed(&start);
+    printf("%-14s %zu bytes in %.6f s, %.3f ns per byte (%zu fields)\n", "split", bytes,
+           seconds, seconds * 1e9 / (double) bytes, fields);
+
+    by_char->free_arayeh(&by_char);
+    text->free_arayeh(&text);
+    free(ranges);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,108 @@
+/** test/performance tests/performanceTest_010_Bool.c
+ *
+ * This file is a part of:
+ * Azadeh Afzar - Arayehsaz (AA-A).
+ *
+ * Copyright (C) 2020 - 2021 Azadeh Afzar.
+ * Copyright (C) 2020 - 2021 Mohammad Mahdi Baghbani Pourvahid.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgement in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+
+#include "../../include/arayeh.h"
+#include "timing.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+int main(int argc, char *argv[])
+{
+    /*
+     * Benchmark: filling flags in a char arayeh and in a packed boolean arayeh,
+     * counting the true flags with count and popcount methods, and combining
+     * two boolean arayehs with bitwise method.
+     *
+     * usage: perfTest_010_Bool [cells], default is 10^8 .
+     *
+     */
+
+    size_t cells = (argc > 1) ? (size_t) strtoull(argv[1], NULL, 10) : 100000000;
+
+    char true_value = 1;
+    struct timespec start;
+
+    arayeh *chars = Arayeh(AA_ARAYEH_TYPE_CHAR, cells);
+    arayeh *flags = Arayeh(AA_ARAYEH_TYPE_BOOL, cells);
+    arayeh *other = Arayeh(AA_ARAYEH_TYPE_BOOL, cells);
+    if (chars == NULL || flags == NULL || other == NULL) {
+        return EXIT_FAILURE;
+    }
+
+    // fill every cell.
+    timespec_get(&start, TIME_UTC);
+    chars->fill(chars, 0, 1, cells, &true_value);
+    double seconds = elapsed(&start);
+    printf("%-14s %zu cells in %.6f s, %.3f ns per cell\n", "fill char", cells, seconds,
+           seconds * 1e9 / (double) cells);
+
+    timespec_get(&start, TIME_UTC);
+    flags->fill(flags, 0, 1, cells, &true_value);
+    seconds = elapsed(&start);
+    printf("%-14s %zu cells in %.6f s, %.3f ns per cell\n", "fill bool", cells, seconds,
+           seconds * 1e9 / (double) cells);
+
+    // count true cells.
+    timespec_get(&start, TIME_UTC);
+    size_t count = chars->count(chars, &true_value);
+    seconds      = elapsed(&start);
+    printf("%-14s %zu cells in %.6f s, %.3f ns per cell (%zu)\n", "count char", cells,
+           seconds, seconds * 1e9 / (double) cells, count);
+
+    timespec_get(&start, TIME_UTC);
+    count   = flags->popcount(flags);
+    seconds = elapsed(&start);
+    printf("%-14s %zu cells in %.6f s, %.3f ns per cell (%zu)\n", "popcount", cells,
+           seconds, seconds * 1e9 / (double) cells, count);
+
+    // combine two boolean arayehs.
+    other->fill(other, 0, 2, cells, &true_value);
+    timespec_get(&start, TIME_UTC);
+    flags->bitwise(flags, AA_ARAYEH_AND, other);
+    seconds = elapsed(&start);
+    printf("%-14s %zu cells in %.6f s, %.3f ns per cell (%zu)\n", "bitwise and", cells,
+           seconds, seconds * 1e9 / (double) cells, flags->popcount(flags));
+
+    chars->free_arayeh(&chars);
+    flags->free_arayeh(&flags);
+    other->free_arayeh(&other);
+
+    return EXIT_SUCCESS;
+}
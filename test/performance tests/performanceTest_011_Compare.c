@@ -0,0 +1,110 @@
+/** test/performance tests/performanceTest_011_Compare.c
+ *
+ * This file is a part of:
+ * Azadeh Afzar - Arayehsaz (AA-A).
+ *
+ * Copyright (C) 2020 - 2021 Azadeh Afzar.
+ * Copyright (C) 2020 - 2021 Mohammad Mahdi Baghbani Pourvahid.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgement in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+
+#include "../../include/arayeh.h"
+#include "timing.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+int main(int argc, char *argv[])
+{
+    /*
+     * Benchmark: filtering the cells of an int arayeh that are between two
+     * values, by a get and a branch per cell and by compare and select methods.
+     *
+     * usage: perfTest_011_Compare [cells], default is 10^7 .
+     *
+     */
+
+    size_t cells = (argc > 1) ? (size_t) strtoull(argv[1], NULL, 10) : 10000000;
+
+    arayeh *numbers = Arayeh(AA_ARAYEH_TYPE_INT, cells);
+    uint64_t *bitmap = (uint64_t *) malloc(AA_ARAYEH_MASK_SIZE(cells) * sizeof(uint64_t));
+    if (numbers == NULL || bitmap == NULL) {
+        return EXIT_FAILURE;
+    }
+
+    // pseudo random values, a quarter of them are in the range.
+    unsigned int seed = 1;
+    for (size_t index = 0; index < cells; index++) {
+        seed      = seed * 1103515245u + 12345u;
+        int value = (int) ((seed >> 8) % 1000);
+        numbers->add(numbers, &value);
+    }
+
+    int low  = 250;
+    int high = 499;
+    struct timespec start;
+
+    // a get and a branch per cell.
+    timespec_get(&start, TIME_UTC);
+    arayeh *by_get = Arayeh(AA_ARAYEH_TYPE_INT, 16);
+    for (size_t index = 0; index < cells; index++) {
+        int value;
+        numbers->get(numbers, index, &value);
+        if (value >= low && value <= high) {
+            by_get->add(by_get, &value);
+        }
+    }
+    double seconds = elapsed(&start);
+    printf("%-14s %zu cells in %.6f s, %.3f ns per cell (%zu selected)\n",
+           "get and add", cells, seconds, seconds * 1e9 / (double) cells, by_get->used);
+
+    // compare into a bitmap.
+    timespec_get(&start, TIME_UTC);
+    size_t count = numbers->compare(numbers, AA_ARAYEH_BETWEEN, &low, &high, bitmap);
+    seconds      = elapsed(&start);
+    printf("%-14s %zu cells in %.6f s, %.3f ns per cell (%zu selected)\n", "compare",
+           cells, seconds, seconds * 1e9 / (double) cells, count);
+
+    // copy the marked cells.
+    timespec_get(&start, TIME_UTC);
+    arayeh *selected = numbers->select(numbers, bitmap);
+    seconds          = elapsed(&start);
+    printf("%-14s %zu cells in %.6f s, %.3f ns per cell (%zu selected)\n", "select",
+           cells, seconds, seconds * 1e9 / (double) cells, selected->used);
+
+    by_get->free_arayeh(&by_get);
+    selected->free_arayeh(&selected);
+    numbers->free_arayeh(&numbers);
+    free(bitmap);
+
+    return EXIT_SUCCESS;
+}
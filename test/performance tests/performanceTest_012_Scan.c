@@ -0,0 +1,107 @@
+/** test/performance tests/performanceTest_012_Scan.c
+ *
+ * This file is a part of:
+ * Azadeh Afzar - Arayehsaz (AA-A).
+ *
+ * Copyright (C) 2020 - 2021 Azadeh Afzar.
+ * Copyright (C) 2020 - 2021 Mohammad Mahdi Baghbani Pourvahid.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgement in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+
+#include "../../include/arayeh.h"
+#include "timing.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+int main(int argc, char *argv[])
+{
+    /*
+     * Benchmark: prefix sum of an int arayeh by a get and an add per cell, by
+     * scan method and by scan method with "parallel" setting on.
+     *
+     * usage: perfTest_012_Scan [cells], default is 10^7 .
+     *
+     */
+
+    size_t cells = (argc > 1) ? (size_t) strtoull(argv[1], NULL, 10) : 10000000;
+
+    arayeh *numbers = Arayeh(AA_ARAYEH_TYPE_INT, cells);
+    if (numbers == NULL) {
+        return EXIT_FAILURE;
+    }
+    for (size_t index = 0; index < cells; index++) {
+        int value = (int) (index % 100);
+        numbers->add(numbers, &value);
+    }
+
+    struct timespec start;
+
+    // a get and an add per cell.
+    timespec_get(&start, TIME_UTC);
+    arayeh *by_get = Arayeh(AA_ARAYEH_TYPE_INT, cells);
+    int total      = 0;
+    for (size_t index = 0; index < cells; index++) {
+        int value;
+        numbers->get(numbers, index, &value);
+        total += value;
+        by_get->add(by_get, &total);
+    }
+    double seconds = elapsed(&start);
+    printf("%-14s %zu cells in %.6f s, %.3f ns per cell\n", "get and add", cells,
+           seconds, seconds * 1e9 / (double) cells);
+
+    // in place scan.
+    arayeh *sequential = numbers->duplicate(numbers);
+    timespec_get(&start, TIME_UTC);
+    sequential->scan(sequential, AA_ARAYEH_SUM, AA_ARAYEH_INCLUSIVE);
+    seconds = elapsed(&start);
+    printf("%-14s %zu cells in %.6f s, %.3f ns per cell\n", "scan", cells, seconds,
+           seconds * 1e9 / (double) cells);
+
+    // two pass scan, blocks are scanned by several threads.
+    arayeh_settings settings = *numbers->_private_properties.settings;
+    settings.parallel        = AA_ARAYEH_ON;
+    numbers->set_settings(numbers, &settings);
+
+    timespec_get(&start, TIME_UTC);
+    numbers->scan(numbers, AA_ARAYEH_SUM, AA_ARAYEH_INCLUSIVE);
+    seconds = elapsed(&start);
+    printf("%-14s %zu cells in %.6f s, %.3f ns per cell\n", "scan parallel", cells,
+           seconds, seconds * 1e9 / (double) cells);
+
+    by_get->free_arayeh(&by_get);
+    sequential->free_arayeh(&sequential);
+    numbers->free_arayeh(&numbers);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,250 @@
+/** test/unitTest_013_Search.c
+ *
+ * This file is a part of:
+ * Azadeh Afzar - Arayehsaz (AA-A).
+ *
+ * Copyright (C) 2020 - 2021 Azadeh Afzar.
+ * Copyright (C) 2020 - 2021 Mohammad Mahdi Baghbani Pourvahid.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgement in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "../../include/arayeh.h"
+#include "unity.h"
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_contains(void)
+{
+    // Test that contains method only finds elements in filled cells.
+
+    // define default arayeh size.
+    size_t arayeh_size = 10;
+    int element        = 7;
+    int missing        = 8;
+
+    // create new arayeh.
+    arayeh *test_case = Arayeh(AA_ARAYEH_TYPE_INT, arayeh_size);
+
+    // fill the first half of arayeh.
+    test_case->fill(test_case, 0, 1, 5, &element);
+
+    // write element into an empty cell without updating the map,
+    // so it must be ignored.
+    test_case->_private_properties.array.int_pointer[7] = missing;
+
+    // assert element exists and missing doesn't.
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_TRUE, test_case->contains(test_case, &element));
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_FALSE, test_case->contains(test_case, &missing));
+
+    // free arayeh.
+    test_case->free_arayeh(&test_case);
+}
+
+void test_find(void)
+{
+    // Test that find method returns the first matching index in all types.
+
+    // define error state variable.
+    int state;
+
+    // define default arayeh size, big enough to use vector paths.
+    size_t arayeh_size = 1000;
+    size_t index;
+
+    // create new arayehs.
+    arayeh *type_char      = Arayeh(AA_ARAYEH_TYPE_CHAR, arayeh_size);
+    arayeh *type_short_int = Arayeh(AA_ARAYEH_TYPE_SINT, arayeh_size);
+    arayeh *type_int       = Arayeh(AA_ARAYEH_TYPE_INT, arayeh_size);
+    arayeh *type_long_int  = Arayeh(AA_ARAYEH_TYPE_LINT, arayeh_size);
+    arayeh *type_float     = Arayeh(AA_ARAYEH_TYPE_FLOAT, arayeh_size);
+    arayeh *type_double    = Arayeh(AA_ARAYEH_TYPE_DOUBLE, arayeh_size);
+
+    // define elements.
+    char char_element           = 'a';
+    short int short_int_element = 1;
+    int int_element             = 1;
+    long int long_int_element   = 1;
+    float float_element         = 1;
+    double double_element       = 1;
+
+    // fill arayehs.
+    for (size_t i = 0; i < arayeh_size; i++) {
+        type_char->add(type_char, &char_element);
+        type_short_int->add(type_short_int, &short_int_element);
+        type_int->add(type_int, &int_element);
+        type_long_int->add(type_long_int, &long_int_element);
+        type_float->add(type_float, &float_element);
+        type_double->add(type_double, &double_element);
+    }
+
+    // define needles.
+    char char_needle           = 'b';
+    short int short_int_needle = 2;
+    int int_needle             = 2;
+    long int long_int_needle   = 2;
+    float float_needle         = 2;
+    double double_needle       = 2;
+
+    // assert needles don't exist.
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_NOT_FOUND,
+                          type_char->find(type_char, &char_needle, &index));
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_NOT_FOUND,
+                          type_short_int->find(type_short_int, &short_int_needle, &index));
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_NOT_FOUND,
+                          type_int->find(type_int, &int_needle, &index));
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_NOT_FOUND,
+                          type_long_int->find(type_long_int, &long_int_needle, &index));
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_NOT_FOUND,
+                          type_float->find(type_float, &float_needle, &index));
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_NOT_FOUND,
+                          type_double->find(type_double, &double_needle, &index));
+
+    // insert needles at two places.
+    size_t positions[2] = {733, 901};
+    for (size_t i = 0; i < 2; i++) {
+        type_char->insert(type_char, positions[i], &char_needle);
+        type_short_int->insert(type_short_int, positions[i], &short_int_needle);
+        type_int->insert(type_int, positions[i], &int_needle);
+        type_long_int->insert(type_long_int, positions[i], &long_int_needle);
+        type_float->insert(type_float, positions[i], &float_needle);
+        type_double->insert(type_double, positions[i], &double_needle);
+    }
+
+    // assert first position is found.
+    state = type_char->find(type_char, &char_needle, &index);
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS, state);
+    TEST_ASSERT_EQUAL_size_t(positions[0], index);
+
+    state = type_short_int->find(type_short_int, &short_int_needle, &index);
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS, state);
+    TEST_ASSERT_EQUAL_size_t(positions[0], index);
+
+    state = type_int->find(type_int, &int_needle, &index);
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS, state);
+    TEST_ASSERT_EQUAL_size_t(positions[0], index);
+
+    state = type_long_int->find(type_long_int, &long_int_needle, &index);
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS, state);
+    TEST_ASSERT_EQUAL_size_t(positions[0], index);
+
+    state = type_float->find(type_float, &float_needle, &index);
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS, state);
+    TEST_ASSERT_EQUAL_size_t(positions[0], index);
+
+    state = type_double->find(type_double, &double_needle, &index);
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS, state);
+    TEST_ASSERT_EQUAL_size_t(positions[0], index);
+
+    // free arayehs.
+    type_char->free_arayeh(&type_char);
+    type_short_int->free_arayeh(&type_short_int);
+    type_int->free_arayeh(&type_int);
+    type_long_int->free_arayeh(&type_long_int);
+    type_float->free_arayeh(&type_float);
+    type_double->free_arayeh(&type_double);
+}
+
+void test_count_find_all(void)
+{
+    // Test that count and find_all methods agree on every match.
+
+    // define default arayeh size.
+    size_t arayeh_size = 200;
+    short int element  = 3;
+    short int other    = 4;
+
+    // create new arayeh.
+    arayeh *test_case = Arayeh(AA_ARAYEH_TYPE_SINT, arayeh_size);
+
+    // put element in every third cell and other in the rest of the first 150 cells.
+    test_case->fill(test_case, 0, 1, 150, &other);
+    test_case->fill(test_case, 0, 3, 150, &element);
+
+    // define bitmap.
+    uint64_t bitmap[AA_ARAYEH_MASK_SIZE(200)];
+
+    // assert count.
+    TEST_ASSERT_EQUAL_size_t(50, test_case->count(test_case, &element));
+    TEST_ASSERT_EQUAL_size_t(50, test_case->find_all(test_case, &element, bitmap));
+
+    // assert bitmap.
+    for (size_t index = 0; index < arayeh_size; index++) {
+        int expected = index < 150 && index % 3 == 0;
+        int bit      = (int) ((bitmap[index / 64] >> (index % 64)) & 1);
+        TEST_ASSERT_EQUAL_INT(expected, bit);
+    }
+
+    // free arayeh.
+    test_case->free_arayeh(&test_case);
+}
+
+void test_float_equality(void)
+{
+    // Test float search semantics, NaN never matches and 0.0 matches -0.0.
+
+    // define default arayeh size.
+    size_t arayeh_size = 10;
+    double zero        = 0.0;
+    double negative    = -0.0;
+    double not_number  = zero / zero;
+
+    // create new arayeh.
+    arayeh *test_case = Arayeh(AA_ARAYEH_TYPE_DOUBLE, arayeh_size);
+
+    // add elements.
+    test_case->add(test_case, &negative);
+    test_case->add(test_case, &not_number);
+
+    // assert semantics.
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_TRUE, test_case->contains(test_case, &zero));
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_FALSE, test_case->contains(test_case, &not_number));
+    TEST_ASSERT_EQUAL_size_t(1, test_case->count(test_case, &negative));
+
+    // free arayeh.
+    test_case->free_arayeh(&test_case);
+}
+
+int main(void)
+{
+    UnityBegin("unitTest_013_Search.c");
+
+    RUN_TEST(test_contains);
+    RUN_TEST(test_find);
+    RUN_TEST(test_count_find_all);
+    RUN_TEST(test_float_equality);
+
+    return UnityEnd();
+}
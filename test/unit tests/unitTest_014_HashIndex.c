@@ -0,0 +1,166 @@
+/** test/unitTest_014_HashIndex.c
+ *
+ * This file is a part of:
+ * Azadeh Afzar - Arayehsaz (AA-A).
+ *
+ * Copyright (C) 2020 - 2021 Azadeh Afzar.
+ * Copyright (C) 2020 - 2021 Mohammad Mahdi Baghbani Pourvahid.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgement in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "../../include/arayeh.h"
+#include "unity.h"
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_build_hash_index(void)
+{
+    // Test that indexed search gives the same results as scanning.
+
+    // define error state variable.
+    int state;
+
+    // define default arayeh size.
+    size_t arayeh_size = 1000;
+    size_t indexed_index;
+    size_t scanned_index;
+
+    // create new arayehs, one of them is indexed.
+    arayeh *indexed = Arayeh(AA_ARAYEH_TYPE_INT, 1);
+    arayeh *scanned = Arayeh(AA_ARAYEH_TYPE_INT, 1);
+
+    // build index before adding elements.
+    state = indexed->build_hash_index(indexed);
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS, state);
+
+    // add elements with many duplicates, the index must follow size extensions.
+    for (size_t i = 0; i < arayeh_size; i++) {
+        int element = (int) (i % 37);
+        indexed->add(indexed, &element);
+        scanned->add(scanned, &element);
+    }
+
+    // overwrite some cells, fill and merge an array to change the chains.
+    int element = 100;
+    indexed->fill(indexed, 5, 7, 300, &element);
+    scanned->fill(scanned, 5, 7, 300, &element);
+
+    int c_array[4] = {1, 100, 2, 500};
+    indexed->merge_array(indexed, 990, 3, 4, c_array);
+    scanned->merge_array(scanned, 990, 3, 4, c_array);
+
+    TEST_ASSERT_NOT_NULL(indexed->_private_properties.hash_index)
+
+    // compare search results for every value.
+    for (int value = -1; value < 510; value++) {
+        TEST_ASSERT_EQUAL_INT(scanned->contains(scanned, &value),
+                              indexed->contains(indexed, &value));
+        TEST_ASSERT_EQUAL_size_t(scanned->count(scanned, &value),
+                                 indexed->count(indexed, &value));
+        TEST_ASSERT_EQUAL_INT(scanned->find(scanned, &value, &scanned_index),
+                              indexed->find(indexed, &value, &indexed_index));
+        if (scanned->contains(scanned, &value) == AA_ARAYEH_TRUE) {
+            TEST_ASSERT_EQUAL_size_t(scanned_index, indexed_index);
+        }
+    }
+
+    // compare bitmaps.
+    size_t words = AA_ARAYEH_MASK_SIZE(indexed->size);
+    uint64_t *indexed_bitmap = (uint64_t *) malloc(sizeof(uint64_t) * words);
+    uint64_t *scanned_bitmap = (uint64_t *) malloc(sizeof(uint64_t) * words);
+
+    indexed->find_all(indexed, &element, indexed_bitmap);
+    scanned->find_all(scanned, &element, scanned_bitmap);
+    TEST_ASSERT_EQUAL_MEMORY(scanned_bitmap, indexed_bitmap, sizeof(uint64_t) * words);
+
+    // free memory.
+    free(indexed_bitmap);
+    free(scanned_bitmap);
+    indexed->free_arayeh(&indexed);
+    scanned->free_arayeh(&scanned);
+}
+
+void test_lazy_hash_index(void)
+{
+    // Test that "hash_index" setting builds the index on the first search
+    // and shrinking the arayeh drops it.
+
+    // define default arayeh size.
+    size_t arayeh_size = 100;
+    float element      = 2.5f;
+
+    // create new arayeh.
+    arayeh *test_case = Arayeh(AA_ARAYEH_TYPE_FLOAT, arayeh_size);
+
+    // define new settings.
+    arayeh_settings new_settings = {.debug_messages = AA_ARAYEH_OFF,
+                                    .extend_size    = AA_ARAYEH_ON,
+                                    .hash_index     = AA_ARAYEH_ON};
+
+    // set new settings.
+    test_case->set_settings(test_case, &new_settings);
+
+    // fill arayeh.
+    test_case->fill(test_case, 10, 10, 100, &element);
+
+    // index doesn't exist before the first search.
+    TEST_ASSERT_NULL(test_case->_private_properties.hash_index)
+    TEST_ASSERT_EQUAL_size_t(9, test_case->count(test_case, &element));
+    TEST_ASSERT_NOT_NULL(test_case->_private_properties.hash_index)
+
+    // shrinking drops the index, the next search builds it again.
+    test_case->resize_memory(test_case, 50);
+    TEST_ASSERT_NULL(test_case->_private_properties.hash_index)
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_TRUE, test_case->contains(test_case, &element));
+    TEST_ASSERT_NOT_NULL(test_case->_private_properties.hash_index)
+
+    // drop index.
+    test_case->drop_hash_index(test_case);
+    TEST_ASSERT_NULL(test_case->_private_properties.hash_index)
+
+    // free arayeh.
+    test_case->free_arayeh(&test_case);
+}
+
+int main(void)
+{
+    UnityBegin("unitTest_014_HashIndex.c");
+
+    RUN_TEST(test_build_hash_index);
+    RUN_TEST(test_lazy_hash_index);
+
+    return UnityEnd();
+}
@@ -0,0 +1,167 @@
+/** test/unitTest_015_Compact.c
+ *
+ * This file is a part of:
+ * Azadeh Afzar - Arayehsaz (AA-A).
+ *
+ * Copyright (C) 2020 - 2021 Azadeh Afzar.
+ * Copyright (C) 2020 - 2021 Mohammad Mahdi Baghbani Pourvahid.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgement in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "../../include/arayeh.h"
+#include "unity.h"
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+// decides which cells are filled in the tests, a mix of dense and sparse regions.
+static int is_filled(size_t index)
+{
+    return (index < 200) || (index % 7 == 0) || (index % 11 == 3);
+}
+
+void test_pack(void)
+{
+    // Test that pack method copies filled cells and their indexes in order.
+
+    // define default arayeh size.
+    size_t arayeh_size = 1000;
+
+    // create new arayehs.
+    arayeh *type_int    = Arayeh(AA_ARAYEH_TYPE_INT, arayeh_size);
+    arayeh *type_double = Arayeh(AA_ARAYEH_TYPE_DOUBLE, arayeh_size);
+
+    // insert elements into chosen cells.
+    for (size_t index = 0; index < arayeh_size; index++) {
+        if (is_filled(index)) {
+            int int_element       = (int) index;
+            double double_element = (double) index / 2;
+            type_int->insert(type_int, index, &int_element);
+            type_double->insert(type_double, index, &double_element);
+        }
+    }
+
+    // define C arrays.
+    size_t used          = type_int->used;
+    int *int_array       = (int *) malloc(sizeof(int) * used);
+    double *double_array = (double *) malloc(sizeof(double) * used);
+    size_t *indexes      = (size_t *) malloc(sizeof(size_t) * used);
+
+    // pack arayehs.
+    TEST_ASSERT_EQUAL_size_t(used, type_int->pack(type_int, int_array, indexes));
+    TEST_ASSERT_EQUAL_size_t(used, type_double->pack(type_double, double_array, NULL));
+
+    // assert packed elements.
+    size_t position = 0;
+    for (size_t index = 0; index < arayeh_size; index++) {
+        if (is_filled(index)) {
+            TEST_ASSERT_EQUAL_size_t(index, indexes[position]);
+            TEST_ASSERT_EQUAL_INT((int) index, int_array[position]);
+            TEST_ASSERT_TRUE((double) index / 2 == double_array[position]);
+            position++;
+        }
+    }
+
+    // free memory.
+    free(int_array);
+    free(double_array);
+    free(indexes);
+    type_int->free_arayeh(&type_int);
+    type_double->free_arayeh(&type_double);
+}
+
+void test_compact(void)
+{
+    // Test that compact method removes holes in place.
+
+    // define error state variable.
+    int state;
+
+    // define default arayeh size.
+    size_t arayeh_size = 1000;
+    char element;
+
+    // create new arayeh.
+    arayeh *test_case = Arayeh(AA_ARAYEH_TYPE_CHAR, arayeh_size);
+
+    // shorten names for god's sake.
+    struct private_properties *private_properties = &test_case->_private_properties;
+
+    // insert elements into chosen cells.
+    for (size_t index = 0; index < arayeh_size; index++) {
+        if (is_filled(index)) {
+            element = (char) (index % 100);
+            test_case->insert(test_case, index, &element);
+        }
+    }
+
+    size_t used = private_properties->used;
+
+    // compact arayeh.
+    state = test_case->compact(test_case);
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS, state);
+
+    // assert arayeh parameters.
+    TEST_ASSERT_EQUAL_size_t(used, private_properties->used);
+    TEST_ASSERT_EQUAL_size_t(used, private_properties->next);
+    TEST_ASSERT_EQUAL_size_t(arayeh_size, private_properties->size);
+
+    // assert elements and map.
+    size_t position = 0;
+    for (size_t index = 0; index < arayeh_size; index++) {
+        if (is_filled(index)) {
+            TEST_ASSERT_EQUAL_CHAR((char) (index % 100),
+                                   private_properties->array.char_pointer[position]);
+            position++;
+        }
+    }
+    for (size_t index = 0; index < arayeh_size; index++) {
+        TEST_ASSERT_EQUAL_CHAR(index < used ? AA_ARAYEH_ON : AA_ARAYEH_OFF,
+                               private_properties->map[index]);
+    }
+
+    // free arayeh.
+    test_case->free_arayeh(&test_case);
+}
+
+int main(void)
+{
+    UnityBegin("unitTest_015_Compact.c");
+
+    RUN_TEST(test_pack);
+    RUN_TEST(test_compact);
+
+    return UnityEnd();
+}
@@ -0,0 +1,106 @@
+/** test/unitTest_016_View.c
+ *
+ * This file is a part of:
+ * Azadeh Afzar - Arayehsaz (AA-A).
+ *
+ * Copyright (C) 2020 - 2021 Azadeh Afzar.
+ * Copyright (C) 2020 - 2021 Mohammad Mahdi Baghbani Pourvahid.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgement in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "../../include/arayeh.h"
+#include "unity.h"
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_view(void)
+{
+    // Test that view method exposes arayeh memory without copying.
+
+    // define error state variable.
+    int state;
+
+    // define default arayeh size.
+    size_t arayeh_size = 10;
+    arayeh_view view;
+
+    // create new arayeh.
+    arayeh *test_case = Arayeh(AA_ARAYEH_TYPE_LINT, arayeh_size);
+
+    // define a c array with size 5.
+    long int c_generic_array[5] = {1, 0, 6, 4, 7};
+
+    // merge array with step 2.
+    test_case->merge_array(test_case, 0, 2, 5, &c_generic_array);
+
+    // get view.
+    state = test_case->view(test_case, &view);
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS, state);
+
+    // assert view properties.
+    TEST_ASSERT_EQUAL_size_t(AA_ARAYEH_TYPE_LINT, view.type);
+    TEST_ASSERT_EQUAL_size_t(arayeh_size, view.size);
+    TEST_ASSERT_EQUAL_size_t(5, view.used);
+    TEST_ASSERT_EQUAL_size_t(sizeof(long int), view.element_size);
+
+    // assert view points to arayeh memory.
+    TEST_ASSERT_TRUE(view.array.long_int_pointer ==
+                     test_case->_private_properties.array.long_int_pointer);
+    TEST_ASSERT_TRUE(view.map == test_case->_private_properties.map);
+
+    // read elements through the view.
+    for (size_t index = 0; index < view.size; index++) {
+        if (index % 2 == 0) {
+            TEST_ASSERT_EQUAL_CHAR(AA_ARAYEH_ON, view.map[index]);
+            TEST_ASSERT_EQUAL_INT(c_generic_array[index / 2],
+                                  view.array.long_int_pointer[index]);
+        } else {
+            TEST_ASSERT_EQUAL_CHAR(AA_ARAYEH_OFF, view.map[index]);
+        }
+    }
+
+    // free arayeh.
+    test_case->free_arayeh(&test_case);
+}
+
+int main(void)
+{
+    UnityBegin("unitTest_016_View.c");
+
+    RUN_TEST(test_view);
+
+    return UnityEnd();
+}
@@ -0,0 +1,142 @@
+/** test/unitTest_017_GetMany.c
+ *
+ * This file is a part of:
+ * Azadeh Afzar - Arayehsaz (AA-A).
+ *
+ * Copyright (C) 2020 - 2021 Azadeh Afzar.
+ * Copyright (C) 2020 - 2021 Mohammad Mahdi Baghbani Pourvahid.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgement in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "../../include/arayeh.h"
+#include "unity.h"
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_get_range(void)
+{
+    // Test that get_range method copies a range and replaces empty cells.
+
+    // define error state variable.
+    int state;
+
+    // define default arayeh size.
+    size_t arayeh_size = 300;
+    int fill_value     = -1;
+    int destination[300];
+
+    // create new arayeh.
+    arayeh *test_case = Arayeh(AA_ARAYEH_TYPE_INT, arayeh_size);
+
+    // insert elements in every cell except multiples of 5.
+    for (size_t index = 0; index < arayeh_size; index++) {
+        if (index % 5 != 0) {
+            int element = (int) index;
+            test_case->insert(test_case, index, &element);
+        }
+    }
+
+    // copy a range that crosses several map blocks.
+    state = test_case->get_range(test_case, 10, 250, destination, &fill_value);
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS, state);
+
+    for (size_t position = 0; position < 250; position++) {
+        size_t index = 10 + position;
+        int expected = (index % 5 != 0) ? (int) index : fill_value;
+        TEST_ASSERT_EQUAL_INT(expected, destination[position]);
+    }
+
+    // assert out of range error.
+    state = test_case->get_range(test_case, 100, 201, destination, NULL);
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_WRONG_INDEX, state);
+
+    // free arayeh.
+    test_case->free_arayeh(&test_case);
+}
+
+void test_get_indices(void)
+{
+    // Test that get_indices method gathers random cells.
+
+    // define error state variable.
+    int state;
+
+    // define default arayeh size.
+    size_t arayeh_size = 100;
+    double fill_value  = 0.5;
+    double destination[50];
+    size_t indices[50];
+
+    // create new arayeh and fill its even cells.
+    arayeh *test_case = Arayeh(AA_ARAYEH_TYPE_DOUBLE, arayeh_size);
+    for (size_t index = 0; index < arayeh_size; index += 2) {
+        double element = (double) index;
+        test_case->insert(test_case, index, &element);
+    }
+
+    // scatter indices over the arayeh.
+    for (size_t position = 0; position < 50; position++) {
+        indices[position] = (position * 37) % arayeh_size;
+    }
+
+    // gather cells.
+    state = test_case->get_indices(test_case, indices, 50, destination, &fill_value);
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS, state);
+
+    for (size_t position = 0; position < 50; position++) {
+        size_t index    = indices[position];
+        double expected = (index % 2 == 0) ? (double) index : fill_value;
+        TEST_ASSERT_TRUE(expected == destination[position]);
+    }
+
+    // assert out of range error.
+    indices[10] = arayeh_size;
+    state       = test_case->get_indices(test_case, indices, 50, destination, NULL);
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_WRONG_INDEX, state);
+
+    // free arayeh.
+    test_case->free_arayeh(&test_case);
+}
+
+int main(void)
+{
+    UnityBegin("unitTest_017_GetMany.c");
+
+    RUN_TEST(test_get_range);
+    RUN_TEST(test_get_indices);
+
+    return UnityEnd();
+}
@@ -0,0 +1,236 @@
+/** test/unitTest_018_Delete.c
+ *
+ * This file is a part of:
+ * Azadeh Afzar - Arayehsaz (AA-A).
+ *
+ * Copyright (C) 2020 - 2021 Azadeh Afzar.
+ * Copyright (C) 2020 - 2021 Mohammad Mahdi Baghbani Pourvahid.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgement in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "../../include/arayeh.h"
+#include "unity.h"
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+// creates an int arayeh filled with 0 .. arayeh_size - 1 .
+static arayeh *filled_arayeh(size_t arayeh_size)
+{
+    arayeh *array = Arayeh(AA_ARAYEH_TYPE_INT, arayeh_size);
+
+    for (size_t index = 0; index < arayeh_size; index++) {
+        int element = (int) index;
+        array->add(array, &element);
+    }
+
+    return array;
+}
+
+void test_delete_item(void)
+{
+    // Test that delete_item method empties a cell and fixes used and next.
+
+    // define default arayeh size.
+    size_t arayeh_size = 100;
+
+    // create new arayeh.
+    arayeh *array = filled_arayeh(arayeh_size);
+
+    // delete without shifting.
+    int state = array->delete_item(array, 40, AA_ARAYEH_OFF);
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS, state);
+    TEST_ASSERT_EQUAL_CHAR(AA_ARAYEH_OFF, array->_private_properties.map[40]);
+    TEST_ASSERT_EQUAL_size_t(arayeh_size - 1, array->used);
+    TEST_ASSERT_EQUAL_size_t(40, array->next);
+
+    // deleting an empty cell does nothing to used.
+    state = array->delete_item(array, 40, AA_ARAYEH_OFF);
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS, state);
+    TEST_ASSERT_EQUAL_size_t(arayeh_size - 1, array->used);
+
+    // delete with shifting, the hole at 40 moves to 39 and the top becomes empty.
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS, array->delete_item(array, 10, AA_ARAYEH_ON));
+    TEST_ASSERT_EQUAL_size_t(arayeh_size - 2, array->used);
+    TEST_ASSERT_EQUAL_size_t(39, array->next);
+    TEST_ASSERT_EQUAL_INT(11, array->_private_properties.array.int_pointer[10]);
+    TEST_ASSERT_EQUAL_CHAR(AA_ARAYEH_OFF, array->_private_properties.map[39]);
+    TEST_ASSERT_EQUAL_INT(41, array->_private_properties.array.int_pointer[40]);
+    TEST_ASSERT_EQUAL_CHAR(AA_ARAYEH_OFF, array->_private_properties.map[99]);
+
+    // out of range index.
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_WRONG_INDEX,
+                          array->delete_item(array, arayeh_size, AA_ARAYEH_OFF));
+
+    // free arayeh.
+    array->free_arayeh(&array);
+}
+
+void test_delete_slice(void)
+{
+    // Test that delete_slice method empties a slice with and without shifting.
+
+    // define default arayeh size.
+    size_t arayeh_size = 1000;
+
+    // create new arayehs.
+    arayeh *plain   = filled_arayeh(arayeh_size);
+    arayeh *shifted = filled_arayeh(arayeh_size);
+    arayeh *stepped = filled_arayeh(arayeh_size);
+
+    // contiguous slice, crossing 64 cell blocks.
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS,
+                          plain->delete_slice(plain, 100, 1, 300, AA_ARAYEH_OFF));
+    TEST_ASSERT_EQUAL_size_t(arayeh_size - 200, plain->used);
+    TEST_ASSERT_EQUAL_size_t(100, plain->next);
+    for (size_t index = 0; index < arayeh_size; index++) {
+        char expected = (index >= 100 && index < 300) ? AA_ARAYEH_OFF : AA_ARAYEH_ON;
+        TEST_ASSERT_EQUAL_CHAR(expected, plain->_private_properties.map[index]);
+    }
+
+    // contiguous slice with shifting.
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS,
+                          shifted->delete_slice(shifted, 100, 1, 300, AA_ARAYEH_ON));
+    TEST_ASSERT_EQUAL_size_t(arayeh_size - 200, shifted->used);
+    TEST_ASSERT_EQUAL_size_t(arayeh_size - 200, shifted->next);
+    for (size_t index = 0; index < arayeh_size - 200; index++) {
+        int expected = (int) (index < 100 ? index : index + 200);
+        int actual   = shifted->_private_properties.array.int_pointer[index];
+        TEST_ASSERT_EQUAL_INT(expected, actual);
+    }
+    for (size_t index = arayeh_size - 200; index < arayeh_size; index++) {
+        TEST_ASSERT_EQUAL_CHAR(AA_ARAYEH_OFF, shifted->_private_properties.map[index]);
+    }
+
+    // stepped slice with shifting, deletes 10, 13, 16, ..., 49 .
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS,
+                          stepped->delete_slice(stepped, 10, 3, 50, AA_ARAYEH_ON));
+    TEST_ASSERT_EQUAL_size_t(arayeh_size - 14, stepped->used);
+    TEST_ASSERT_EQUAL_size_t(arayeh_size - 14, stepped->next);
+    size_t write_index = 0;
+    for (size_t index = 0; index < arayeh_size; index++) {
+        if (index >= 10 && index < 50 && (index - 10) % 3 == 0) {
+            continue;
+        }
+        int actual = stepped->_private_properties.array.int_pointer[write_index];
+        TEST_ASSERT_EQUAL_INT((int) index, actual);
+        write_index++;
+    }
+
+    // stepped slice without shifting.
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS,
+                          stepped->delete_slice(stepped, 0, 5, 20, AA_ARAYEH_OFF));
+    TEST_ASSERT_EQUAL_size_t(arayeh_size - 18, stepped->used);
+    TEST_ASSERT_EQUAL_size_t(0, stepped->next);
+    TEST_ASSERT_EQUAL_CHAR(AA_ARAYEH_OFF, stepped->_private_properties.map[15]);
+    TEST_ASSERT_EQUAL_CHAR(AA_ARAYEH_ON, stepped->_private_properties.map[16]);
+
+    // wrong arguments.
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_WRONG_INDEX,
+                          plain->delete_slice(plain, 10, 1, 5, AA_ARAYEH_OFF));
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_WRONG_STEP,
+                          plain->delete_slice(plain, 0, 0, 5, AA_ARAYEH_OFF));
+    TEST_ASSERT_EQUAL_INT(
+        AA_ARAYEH_WRONG_INDEX,
+        plain->delete_slice(plain, 0, 1, arayeh_size + 1, AA_ARAYEH_OFF));
+
+    // free arayehs.
+    plain->free_arayeh(&plain);
+    shifted->free_arayeh(&shifted);
+    stepped->free_arayeh(&stepped);
+}
+
+void test_delete_with_hash_index(void)
+{
+    // Test that deleted cells can't be found through the hash index.
+
+    // define default arayeh size.
+    size_t arayeh_size = 200;
+
+    // create new arayeh.
+    arayeh *array = filled_arayeh(arayeh_size);
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS, array->build_hash_index(array));
+
+    int element = 50;
+    array->delete_slice(array, 40, 2, 60, AA_ARAYEH_OFF);
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_FALSE, array->contains(array, &element));
+
+    element = 51;
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_TRUE, array->contains(array, &element));
+    TEST_ASSERT_EQUAL_size_t(1, array->count(array, &element));
+
+    // free arayeh.
+    array->free_arayeh(&array);
+}
+
+void test_pop(void)
+{
+    // Test that pop method returns the last filled cells in reverse order.
+
+    // define default arayeh size.
+    size_t arayeh_size = 10;
+
+    // create new arayeh.
+    arayeh *array = filled_arayeh(arayeh_size);
+
+    // make a hole, it must not change pop order.
+    array->delete_item(array, 3, AA_ARAYEH_OFF);
+
+    int element;
+    for (int expected = 9; expected >= 0; expected--) {
+        if (expected == 3) {
+            continue;
+        }
+        TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS, array->pop(array, &element));
+        TEST_ASSERT_EQUAL_INT(expected, element);
+    }
+
+    TEST_ASSERT_EQUAL_size_t(0, array->used);
+    TEST_ASSERT_EQUAL_size_t(0, array->next);
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_EMPTY, array->pop(array, &element));
+
+    // free arayeh.
+    array->free_arayeh(&array);
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_delete_item);
+    RUN_TEST(test_delete_slice);
+    RUN_TEST(test_delete_with_hash_index);
+    RUN_TEST(test_pop);
+    return UNITY_END();
+}
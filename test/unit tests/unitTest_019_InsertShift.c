@@ -0,0 +1,179 @@
+/** test/unitTest_019_InsertShift.c
+ *
+ * This file is a part of:
+ * Azadeh Afzar - Arayehsaz (AA-A).
+ *
+ * Copyright (C) 2020 - 2021 Azadeh Afzar.
+ * Copyright (C) 2020 - 2021 Mohammad Mahdi Baghbani Pourvahid.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgement in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "../../include/arayeh.h"
+#include "unity.h"
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_insert_shift(void)
+{
+    // Test that insert_shift method moves the tail forward and keeps order.
+
+    // define default arayeh size.
+    size_t arayeh_size = 10;
+
+    // create new arayeh.
+    arayeh *test_case = Arayeh(AA_ARAYEH_TYPE_INT, arayeh_size);
+
+    // insert 0, 2, 4, ..., 18 .
+    for (int element = 0; element < 20; element += 2) {
+        test_case->add(test_case, &element);
+    }
+
+    // insert odd numbers in their ordered position, arayeh must grow.
+    for (int element = 1; element < 20; element += 2) {
+        int state = test_case->insert_shift(test_case, (size_t) element, &element);
+        TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS, state);
+    }
+
+    TEST_ASSERT_EQUAL_size_t(20, test_case->used);
+    TEST_ASSERT_EQUAL_size_t(20, test_case->next);
+    TEST_ASSERT_TRUE(test_case->size >= 20);
+
+    for (size_t index = 0; index < 20; index++) {
+        int element;
+        test_case->get(test_case, index, &element);
+        TEST_ASSERT_EQUAL_INT((int) index, element);
+    }
+
+    // free arayeh.
+    test_case->free_arayeh(&test_case);
+}
+
+void test_insert_range_shift(void)
+{
+    // Test that insert_range_shift method inserts a batch with holes in the tail.
+
+    // define default arayeh size.
+    size_t arayeh_size = 100;
+
+    // create new arayeh.
+    arayeh *test_case = Arayeh(AA_ARAYEH_TYPE_DOUBLE, arayeh_size);
+
+    // fill cells 0 .. 49 and make a hole at 30.
+    for (size_t index = 0; index < 50; index++) {
+        double element = (double) index;
+        test_case->add(test_case, &element);
+    }
+    test_case->delete_item(test_case, 30, AA_ARAYEH_OFF);
+    TEST_ASSERT_EQUAL_size_t(30, test_case->next);
+
+    double batch[80];
+    for (size_t index = 0; index < 80; index++) {
+        batch[index] = -(double) index;
+    }
+
+    // insert the batch at 10, arayeh grows once.
+    int state = test_case->insert_range_shift(test_case, 10, 80, batch);
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS, state);
+    TEST_ASSERT_TRUE(test_case->size >= 130);
+    TEST_ASSERT_EQUAL_size_t(129, test_case->used);
+    TEST_ASSERT_EQUAL_size_t(110, test_case->next);
+
+    for (size_t index = 0; index < 130; index++) {
+        char *map = test_case->_private_properties.map;
+        if (index == 110) {
+            TEST_ASSERT_EQUAL_CHAR(AA_ARAYEH_OFF, map[index]);
+            continue;
+        }
+
+        double expected = (index < 10)    ? (double) index
+                          : (index < 90) ? -(double) (index - 10)
+                                         : (double) (index - 80);
+        double element;
+        test_case->get(test_case, index, &element);
+        TEST_ASSERT_EQUAL_CHAR(AA_ARAYEH_ON, map[index]);
+        TEST_ASSERT_TRUE(expected == element);
+    }
+
+    // inserting after the last filled cell doesn't move anything.
+    state = test_case->insert_range_shift(test_case, 140, 2, batch);
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS, state);
+    TEST_ASSERT_EQUAL_size_t(131, test_case->used);
+    TEST_ASSERT_EQUAL_CHAR(AA_ARAYEH_OFF, test_case->_private_properties.map[135]);
+
+    // free arayeh.
+    test_case->free_arayeh(&test_case);
+}
+
+void test_insert_shift_no_extend(void)
+{
+    // Test that insert_shift method respects extend size settings.
+
+    // define default arayeh size.
+    size_t arayeh_size = 4;
+
+    // create new arayeh.
+    arayeh *test_case = Arayeh(AA_ARAYEH_TYPE_CHAR, arayeh_size);
+
+    // define new settings.
+    arayeh_settings new_settings = {.debug_messages = AA_ARAYEH_OFF,
+                                    .extend_size    = AA_ARAYEH_OFF};
+
+    // set new settings.
+    test_case->set_settings(test_case, &new_settings);
+
+    char elements[4] = {'a', 'b', 'c', 'd'};
+    test_case->insert_range_shift(test_case, 0, 3, elements);
+
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS,
+                          test_case->insert_shift(test_case, 0, &elements[3]));
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_NOT_ENOUGH_SPACE,
+                          test_case->insert_shift(test_case, 0, &elements[3]));
+    TEST_ASSERT_EQUAL_size_t(4, test_case->size);
+    TEST_ASSERT_EQUAL_CHAR('d', test_case->_private_properties.array.char_pointer[0]);
+    TEST_ASSERT_EQUAL_CHAR('c', test_case->_private_properties.array.char_pointer[3]);
+
+    // free arayeh.
+    test_case->free_arayeh(&test_case);
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_insert_shift);
+    RUN_TEST(test_insert_range_shift);
+    RUN_TEST(test_insert_shift_no_extend);
+    return UNITY_END();
+}
@@ -0,0 +1,187 @@
+/** test/unitTest_020_GapBuffer.c
+ *
+ * This file is a part of:
+ * Azadeh Afzar - Arayehsaz (AA-A).
+ *
+ * Copyright (C) 2020 - 2021 Azadeh Afzar.
+ * Copyright (C) 2020 - 2021 Mohammad Mahdi Baghbani Pourvahid.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgement in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "../../include/arayeh.h"
+#include "unity.h"
+
+#include <string.h>
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+// checks that arayeh cells are the same as "expected" text.
+static void assert_text(arayeh *array, const char *expected, size_t length)
+{
+    TEST_ASSERT_EQUAL_size_t(length, array->used);
+    TEST_ASSERT_EQUAL_size_t(length, array->next);
+
+    for (size_t index = 0; index < length; index++) {
+        char element;
+        array->get(array, index, &element);
+        TEST_ASSERT_EQUAL_CHAR(expected[index], element);
+    }
+}
+
+void test_gap_buffer_edits(void)
+{
+    // Test that edits near a moving cursor give the same text as plain shifting.
+
+    // define default arayeh size.
+    size_t arayeh_size = 16;
+
+    // create new arayehs.
+    arayeh *plain = Arayeh(AA_ARAYEH_TYPE_CHAR, arayeh_size);
+    arayeh *gap   = Arayeh(AA_ARAYEH_TYPE_CHAR, arayeh_size);
+
+    // enable gap buffer mode.
+    arayeh_settings new_settings = {.debug_messages = AA_ARAYEH_OFF,
+                                    .extend_size    = AA_ARAYEH_ON,
+                                    .gap_buffer     = AA_ARAYEH_ON};
+    gap->set_settings(gap, &new_settings);
+
+    // reference text.
+    char text[4096];
+    size_t length = 0;
+
+    // cursor walks back and forth, typing and deleting.
+    size_t cursor       = 0;
+    unsigned int random = 12345;
+    for (int edit = 0; edit < 2000; edit++) {
+        random = random * 1103515245 + 12345;
+        size_t move = (random >> 16) % 7;
+        if (random & 0x100) {
+            cursor = (cursor + move > length) ? length : cursor + move;
+        } else {
+            cursor = (cursor > move) ? cursor - move : 0;
+        }
+
+        if ((random & 0x3000) != 0 || length == 0) {
+            // type one or a few characters.
+            char word[3] = {(char) ('a' + edit % 26), 'x', 'y'};
+            size_t count = 1 + (random >> 20) % 3;
+
+            plain->insert_range_shift(plain, cursor, count, word);
+            gap->insert_range_shift(gap, cursor, count, word);
+
+            memmove(text + cursor + count, text + cursor, length - cursor);
+            memcpy(text + cursor, word, count);
+            length += count;
+            cursor += count;
+        } else {
+            // delete backward from the cursor.
+            size_t count = 1 + (random >> 20) % 4;
+            count        = count > cursor ? cursor : count;
+
+            plain->delete_slice(plain, cursor - count, 1, cursor, AA_ARAYEH_ON);
+            gap->delete_slice(gap, cursor - count, 1, cursor, AA_ARAYEH_ON);
+
+            memmove(text + cursor - count, text + cursor, length - cursor);
+            length -= count;
+            cursor -= count;
+        }
+
+        TEST_ASSERT_EQUAL_size_t(plain->used, gap->used);
+        TEST_ASSERT_EQUAL_size_t(plain->next, gap->next);
+    }
+
+    assert_text(plain, text, length);
+    assert_text(gap, text, length);
+
+    // gap must be open after edits in the middle.
+    TEST_ASSERT_TRUE(gap->_private_properties.gap_start !=
+                     gap->_private_properties.gap_end);
+
+    // other methods see cells at their logical index.
+    arayeh_view view;
+    gap->view(gap, &view);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(view.array.char_pointer, text, length));
+    TEST_ASSERT_EQUAL_size_t(gap->_private_properties.gap_start,
+                             gap->_private_properties.gap_end);
+
+    // free arayehs.
+    plain->free_arayeh(&plain);
+    gap->free_arayeh(&gap);
+}
+
+void test_gap_buffer_settings(void)
+{
+    // Test that leaving gap buffer mode puts cells at their logical index.
+
+    // define default arayeh size.
+    size_t arayeh_size = 8;
+
+    // create new arayeh.
+    arayeh *test_case = Arayeh(AA_ARAYEH_TYPE_INT, arayeh_size);
+
+    // enable gap buffer mode.
+    arayeh_settings new_settings = {.debug_messages = AA_ARAYEH_OFF,
+                                    .extend_size    = AA_ARAYEH_ON,
+                                    .gap_buffer     = AA_ARAYEH_ON};
+    test_case->set_settings(test_case, &new_settings);
+
+    int elements[4] = {1, 2, 3, 4};
+    test_case->insert_range_shift(test_case, 0, 4, elements);
+    test_case->insert_range_shift(test_case, 2, 2, elements);
+    test_case->delete_item(test_case, 1, AA_ARAYEH_ON);
+
+    // 1, 1, 2, 3, 4 with a gap after the first cell.
+    new_settings.gap_buffer = AA_ARAYEH_OFF;
+    test_case->set_settings(test_case, &new_settings);
+
+    int expected[5] = {1, 1, 2, 3, 4};
+    int *actual     = test_case->_private_properties.array.int_pointer;
+    TEST_ASSERT_EQUAL_INT_ARRAY(expected, actual, 5);
+    TEST_ASSERT_EQUAL_CHAR(AA_ARAYEH_OFF, test_case->_private_properties.map[5]);
+    TEST_ASSERT_EQUAL_size_t(5, test_case->used);
+    TEST_ASSERT_EQUAL_size_t(5, test_case->next);
+
+    // free arayeh.
+    test_case->free_arayeh(&test_case);
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_gap_buffer_edits);
+    RUN_TEST(test_gap_buffer_settings);
+    return UNITY_END();
+}
@@ -0,0 +1,125 @@
+/** test/unitTest_021_Iterator.c
+ *
+ * This file is a part of:
+ * Azadeh Afzar - Arayehsaz (AA-A).
+ *
+ * Copyright (C) 2020 - 2021 Azadeh Afzar.
+ * Copyright (C) 2020 - 2021 Mohammad Mahdi Baghbani Pourvahid.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgement in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "../../include/arayeh.h"
+#include "unity.h"
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+// decides which cells are filled in the tests, a mix of dense and sparse regions.
+static int is_filled(size_t index)
+{
+    return (index < 100) || (index % 97 == 5) || (index > 990);
+}
+
+void test_iterator(void)
+{
+    // Test that iterator visits every filled cell once, in order.
+
+    // define default arayeh size, not a multiple of 64.
+    size_t arayeh_size = 1000;
+
+    // create new arayeh.
+    arayeh *test_case = Arayeh(AA_ARAYEH_TYPE_LINT, arayeh_size);
+
+    // insert elements into chosen cells.
+    for (size_t index = 0; index < arayeh_size; index++) {
+        if (is_filled(index)) {
+            long int element = (long int) index * 3;
+            test_case->insert(test_case, index, &element);
+        }
+    }
+
+    arayeh_iterator iterator;
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS, test_case->iter_begin(test_case, &iterator));
+
+    size_t expected = 0;
+    size_t visited  = 0;
+    while (test_case->iter_next(test_case, &iterator)) {
+        while (!is_filled(expected)) {
+            expected++;
+        }
+
+        TEST_ASSERT_EQUAL_size_t(expected, iterator.index);
+        TEST_ASSERT_EQUAL_INT64((long int) expected * 3, *(long int *) iterator.element);
+
+        expected++;
+        visited++;
+    }
+
+    TEST_ASSERT_EQUAL_size_t(test_case->used, visited);
+
+    // the iterator stays at the end.
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_FALSE, test_case->iter_next(test_case, &iterator));
+
+    // free arayeh.
+    test_case->free_arayeh(&test_case);
+}
+
+void test_iterator_empty(void)
+{
+    // Test that iterator of an empty arayeh ends immediately.
+
+    // create new arayehs.
+    arayeh *empty_case = Arayeh(AA_ARAYEH_TYPE_CHAR, 200);
+    arayeh *zero_case  = Arayeh(AA_ARAYEH_TYPE_CHAR, 0);
+
+    arayeh_iterator iterator;
+    empty_case->iter_begin(empty_case, &iterator);
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_FALSE, empty_case->iter_next(empty_case, &iterator));
+
+    zero_case->iter_begin(zero_case, &iterator);
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_FALSE, zero_case->iter_next(zero_case, &iterator));
+
+    // free arayehs.
+    empty_case->free_arayeh(&empty_case);
+    zero_case->free_arayeh(&zero_case);
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_iterator);
+    RUN_TEST(test_iterator_empty);
+    return UNITY_END();
+}
@@ -0,0 +1,230 @@
+/** test/unitTest_022_Pipeline.c
+ *
+ * This file is a part of:
+ * Azadeh Afzar - Arayehsaz (AA-A).
+ *
+ * Copyright (C) 2020 - 2021 Azadeh Afzar.
+ * Copyright (C) 2020 - 2021 Mohammad Mahdi Baghbani Pourvahid.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgement in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "../../include/arayeh.h"
+#include "unity.h"
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+// map stage, multiplies elements by the factor in "context".
+static size_t scale(void *block, size_t count, void *context)
+{
+    double *elements = (double *) block;
+    double factor    = *(double *) context;
+
+    for (size_t index = 0; index < count; index++) {
+        elements[index] *= factor;
+    }
+
+    return count;
+}
+
+// filter stage, keeps elements greater than the threshold in "context".
+static size_t above(void *block, size_t count, void *context)
+{
+    double *elements = (double *) block;
+    double threshold = *(double *) context;
+    size_t kept      = 0;
+
+    for (size_t index = 0; index < count; index++) {
+        if (elements[index] > threshold) {
+            elements[kept++] = elements[index];
+        }
+    }
+
+    return kept;
+}
+
+// reducer, adds elements to the sum in "accumulator".
+static void sum(const void *block, size_t count, void *accumulator)
+{
+    const double *elements = (const double *) block;
+
+    for (size_t index = 0; index < count; index++) {
+        *(double *) accumulator += elements[index];
+    }
+}
+
+// decides which cells are filled in the tests.
+static int is_filled(size_t index)
+{
+    return (index % 3 != 1) && (index < 5000 || index > 9000);
+}
+
+void test_pipeline(void)
+{
+    // Test that reduce and collect give the same result as separate passes.
+
+    // define default arayeh size, more than two pipeline blocks.
+    size_t arayeh_size = 10000;
+
+    // create new arayeh.
+    arayeh *test_case = Arayeh(AA_ARAYEH_TYPE_DOUBLE, arayeh_size);
+
+    // define new settings.
+    arayeh_settings new_settings = {.debug_messages = AA_ARAYEH_OFF,
+                                    .extend_size    = AA_ARAYEH_ON,
+                                    .hash_index     = AA_ARAYEH_ON};
+    arayeh_size_settings new_size_settings = {.extend_add          = AA_ARAYEH_ON,
+                                              .extend_insert       = AA_ARAYEH_OFF,
+                                              .extend_fill         = AA_ARAYEH_OFF,
+                                              .extend_merge_arayeh = AA_ARAYEH_ON,
+                                              .extend_merge_array  = AA_ARAYEH_OFF};
+
+    // set new settings.
+    test_case->set_settings(test_case, &new_settings);
+    test_case->set_size_settings(test_case, &new_size_settings);
+
+    // insert elements into chosen cells.
+    double expected_sum  = 0;
+    size_t expected_used = 0;
+    for (size_t index = 0; index < arayeh_size; index++) {
+        if (is_filled(index)) {
+            double element = (double) (index % 100);
+            test_case->insert(test_case, index, &element);
+            if (element * 0.5 > 20) {
+                expected_sum += element * 0.5;
+                expected_used++;
+            }
+        }
+    }
+
+    // scale by 0.5, keep elements above 20, sum.
+    double factor            = 0.5;
+    double threshold         = 20;
+    arayeh_stage stages[2]   = {{scale, &factor}, {above, &threshold}};
+    arayeh_pipeline pipeline = {stages, 2};
+
+    double actual_sum = 0;
+    int state = test_case->pipeline_reduce(test_case, &pipeline, sum, &actual_sum);
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS, state);
+    TEST_ASSERT_TRUE(expected_sum == actual_sum);
+
+    // source isn't changed by stages.
+    double element;
+    test_case->get(test_case, 99, &element);
+    TEST_ASSERT_TRUE(99 == element);
+
+    // collect the filtered elements.
+    arayeh *result = test_case->pipeline_collect(test_case, &pipeline);
+    TEST_ASSERT_NOT_NULL(result);
+    TEST_ASSERT_EQUAL_size_t(expected_used, result->used);
+    TEST_ASSERT_EQUAL_size_t(expected_used, result->size);
+
+    double collected_sum = 0;
+    for (size_t index = 0; index < result->used; index++) {
+        result->get(result, index, &element);
+        TEST_ASSERT_TRUE(element > 20);
+        collected_sum += element;
+    }
+    TEST_ASSERT_TRUE(expected_sum == collected_sum);
+
+    // collected arayeh has the settings of source.
+    arayeh_settings *settings = result->_private_properties.settings;
+    TEST_ASSERT_EQUAL_CHAR(AA_ARAYEH_ON, settings->hash_index);
+    TEST_ASSERT_EQUAL_CHAR(AA_ARAYEH_OFF, settings->method_size->extend_insert);
+    TEST_ASSERT_EQUAL_CHAR(AA_ARAYEH_OFF, settings->method_size->extend_fill);
+
+    // free arayehs.
+    test_case->free_arayeh(&test_case);
+    result->free_arayeh(&result);
+}
+
+void test_pipeline_without_stages(void)
+{
+    // Test that an empty pipeline passes every filled cell.
+
+    // define default arayeh size.
+    size_t arayeh_size = 100;
+
+    // create new arayeh.
+    arayeh *test_case = Arayeh(AA_ARAYEH_TYPE_DOUBLE, arayeh_size);
+
+    double element = 2;
+    test_case->fill(test_case, 0, 2, arayeh_size, &element);
+
+    arayeh_pipeline pipeline = {NULL, 0};
+
+    double actual_sum = 0;
+    test_case->pipeline_reduce(test_case, &pipeline, sum, &actual_sum);
+    TEST_ASSERT_TRUE(100 == actual_sum);
+
+    // free arayeh.
+    test_case->free_arayeh(&test_case);
+}
+
+void test_pipeline_empty_arayeh(void)
+{
+    // Test that collecting from an empty arayeh gives an empty arayeh.
+
+    // define default arayeh size.
+    size_t arayeh_size = 100;
+
+    // create new arayeh.
+    arayeh *test_case = Arayeh(AA_ARAYEH_TYPE_DOUBLE, arayeh_size);
+
+    arayeh_pipeline pipeline = {NULL, 0};
+
+    arayeh *result = test_case->pipeline_collect(test_case, &pipeline);
+    TEST_ASSERT_NOT_NULL(result);
+    TEST_ASSERT_EQUAL_size_t(0, result->used);
+    TEST_ASSERT_EQUAL_size_t(0, result->next);
+
+    // the result can grow.
+    double element = 3;
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS, result->add(result, &element));
+    TEST_ASSERT_EQUAL_size_t(1, result->used);
+
+    // free arayehs.
+    test_case->free_arayeh(&test_case);
+    result->free_arayeh(&result);
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_pipeline);
+    RUN_TEST(test_pipeline_without_stages);
+    RUN_TEST(test_pipeline_empty_arayeh);
+    return UNITY_END();
+}
@@ -0,0 +1,243 @@
+/** test/unitTest_023_ForEach.c
+ *
+ * This file is a part of:
+ * Azadeh Afzar - Arayehsaz (AA-A).
+ *
+ * Copyright (C) 2020 - 2021 Azadeh Afzar.
+ * Copyright (C) 2020 - 2021 Mohammad Mahdi Baghbani Pourvahid.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgement in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "../../include/arayeh.h"
+#include "unity.h"
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+// decides which cells are filled in the tests, a mix of dense and sparse regions.
+static int is_filled(size_t index)
+{
+    return (index < 70000) || (index % 13 == 2);
+}
+
+// visitor, adds indexes of filled cells whose element matches its index.
+static void check_cell(size_t index, const void *element, void *context)
+{
+    if (*(const int *) element == (int) index) {
+        *(size_t *) context += index;
+    }
+}
+
+// transformer, doubles the element.
+static void double_cell(size_t index, void *element, void *context)
+{
+    *(int *) element *= 2;
+}
+
+// mapper, writes half of the element as a double.
+static void half_cell(size_t index, const void *element, void *result, void *context)
+{
+    *(double *) result = *(const int *) element / 2.0;
+}
+
+// mapper, writes a char that is neither 0 nor 1 for odd elements.
+static void odd_cell(size_t index, const void *element, void *result, void *context)
+{
+    *(char *) result = (char) ((*(const int *) element % 2) * 15);
+}
+
+// creates an int arayeh where filled cells hold their index.
+static arayeh *create_case(size_t arayeh_size, char parallel)
+{
+    arayeh *test_case = Arayeh(AA_ARAYEH_TYPE_INT, arayeh_size);
+
+    // set parallel setting.
+    arayeh_settings new_settings = {.debug_messages = AA_ARAYEH_OFF,
+                                    .extend_size    = AA_ARAYEH_ON,
+                                    .parallel       = parallel};
+    test_case->set_settings(test_case, &new_settings);
+
+    // insert elements into chosen cells.
+    for (size_t index = 0; index < arayeh_size; index++) {
+        if (is_filled(index)) {
+            int element = (int) index;
+            test_case->insert(test_case, index, &element);
+        }
+    }
+
+    return test_case;
+}
+
+static void check_callbacks(char parallel)
+{
+    // define default arayeh size, more than one parallel block.
+    size_t arayeh_size = 200000;
+
+    // create new arayeh.
+    arayeh *test_case = create_case(arayeh_size, parallel);
+
+    size_t expected = 0;
+    for (size_t index = 0; index < arayeh_size; index++) {
+        expected += is_filled(index) ? index : 0;
+    }
+
+    // for_each visits every filled cell.
+    size_t actual = 0;
+    if (parallel == AA_ARAYEH_OFF) {
+        TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS,
+                              test_case->for_each(test_case, check_cell, &actual));
+        TEST_ASSERT_EQUAL_size_t(expected, actual);
+    }
+
+    // transform changes filled cells in place.
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS,
+                          test_case->transform(test_case, double_cell, NULL));
+
+    // map_to creates a new arayeh with another type.
+    arayeh *result = test_case->map_to(test_case, AA_ARAYEH_TYPE_DOUBLE, half_cell, NULL);
+    TEST_ASSERT_NOT_NULL(result);
+    TEST_ASSERT_EQUAL_size_t(test_case->used, result->used);
+    TEST_ASSERT_EQUAL_size_t(test_case->next, result->next);
+
+    for (size_t index = 0; index < arayeh_size; index++) {
+        char filled = is_filled(index) ? AA_ARAYEH_ON : AA_ARAYEH_OFF;
+        TEST_ASSERT_EQUAL_CHAR(filled, result->_private_properties.map[index]);
+
+        if (filled == AA_ARAYEH_ON) {
+            int element;
+            double mapped;
+            test_case->get(test_case, index, &element);
+            result->get(result, index, &mapped);
+            TEST_ASSERT_EQUAL_INT((int) index * 2, element);
+            TEST_ASSERT_TRUE((double) index == mapped);
+        }
+    }
+
+    // free arayehs.
+    test_case->free_arayeh(&test_case);
+    result->free_arayeh(&result);
+}
+
+void test_callbacks(void)
+{
+    // Test that for_each, transform and map_to visit every filled cell once.
+    check_callbacks(AA_ARAYEH_OFF);
+}
+
+void test_callbacks_parallel(void)
+{
+    // Test that transform and map_to give the same result in parallel.
+    check_callbacks(AA_ARAYEH_ON);
+}
+
+void test_map_to_settings(void)
+{
+    // Test that map_to gives the new arayeh the settings of source.
+
+    // define default arayeh size.
+    size_t arayeh_size = 100;
+
+    // create new arayeh.
+    arayeh *test_case = create_case(arayeh_size, AA_ARAYEH_OFF);
+
+    // define new settings.
+    arayeh_settings new_settings = {.debug_messages = AA_ARAYEH_OFF,
+                                    .extend_size    = AA_ARAYEH_OFF,
+                                    .hash_index     = AA_ARAYEH_ON};
+    arayeh_size_settings new_size_settings = {.extend_add          = AA_ARAYEH_OFF,
+                                              .extend_insert       = AA_ARAYEH_ON,
+                                              .extend_fill         = AA_ARAYEH_OFF,
+                                              .extend_merge_arayeh = AA_ARAYEH_ON,
+                                              .extend_merge_array  = AA_ARAYEH_OFF};
+
+    // set new settings.
+    test_case->set_settings(test_case, &new_settings);
+    test_case->set_size_settings(test_case, &new_size_settings);
+
+    arayeh *result = test_case->map_to(test_case, AA_ARAYEH_TYPE_DOUBLE, half_cell, NULL);
+    TEST_ASSERT_NOT_NULL(result);
+
+    arayeh_settings *settings = result->_private_properties.settings;
+    TEST_ASSERT_EQUAL_CHAR(AA_ARAYEH_OFF, settings->extend_size);
+    TEST_ASSERT_EQUAL_CHAR(AA_ARAYEH_ON, settings->hash_index);
+    TEST_ASSERT_EQUAL_CHAR(AA_ARAYEH_OFF, settings->method_size->extend_add);
+    TEST_ASSERT_EQUAL_CHAR(AA_ARAYEH_OFF, settings->method_size->extend_merge_array);
+
+    // free arayehs.
+    test_case->free_arayeh(&test_case);
+    result->free_arayeh(&result);
+}
+
+void test_map_to_types(void)
+{
+    // Test that map_to stores booleans as 0 or 1 and refuses wrong types.
+
+    // define default arayeh size.
+    size_t arayeh_size = 100;
+
+    // create new arayeh.
+    arayeh *test_case = create_case(arayeh_size, AA_ARAYEH_OFF);
+
+    arayeh *flags = test_case->map_to(test_case, AA_ARAYEH_TYPE_BOOL, odd_cell, NULL);
+    TEST_ASSERT_NOT_NULL(flags);
+    TEST_ASSERT_EQUAL_size_t(AA_ARAYEH_STORAGE_BIT,
+                             flags->_private_properties.storage_type);
+
+    for (size_t index = 0; index < arayeh_size; index++) {
+        char flag;
+        flags->get(flags, index, &flag);
+        TEST_ASSERT_EQUAL_CHAR((char) (index % 2), flag);
+    }
+
+    // generic, string and unknown types are refused.
+    size_t types[3] = {AA_ARAYEH_TYPE_GENERIC, AA_ARAYEH_TYPE_STRING, 99};
+    for (size_t index = 0; index < 3; index++) {
+        TEST_ASSERT_NULL(test_case->map_to(test_case, types[index], odd_cell, NULL));
+    }
+
+    // free arayehs.
+    test_case->free_arayeh(&test_case);
+    flags->free_arayeh(&flags);
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_callbacks);
+    RUN_TEST(test_callbacks_parallel);
+    RUN_TEST(test_map_to_settings);
+    RUN_TEST(test_map_to_types);
+    return UNITY_END();
+}
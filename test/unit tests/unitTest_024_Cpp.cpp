@@ -0,0 +1,244 @@
+/** test/unitTest_024_Cpp.cpp
+ *
+ * This file is a part of:
+ * Azadeh Afzar - Arayehsaz (AA-A).
+ *
+ * Copyright (C) 2020 - 2021 Azadeh Afzar.
+ * Copyright (C) 2020 - 2021 Mohammad Mahdi Baghbani Pourvahid.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgement in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "../../include/arayeh.hpp"
+#include "../../include/arayeh_typed.h"
+#include "unity.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <utility>
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_cpp_wrapper(void)
+{
+    // Test that aa::arayeh wraps the C API with the right type.
+
+    // create new arayeh.
+    aa::arayeh<double> test_case(10);
+    TEST_ASSERT_EQUAL_size_t(AA_ARAYEH_TYPE_DOUBLE, test_case.native()->type);
+    TEST_ASSERT_EQUAL_size_t(10, test_case.size());
+    TEST_ASSERT_TRUE(test_case.empty());
+
+    for (int element = 0; element < 20; element++) {
+        test_case.add(element);
+    }
+
+    TEST_ASSERT_EQUAL_size_t(20, test_case.used());
+    TEST_ASSERT_TRUE(test_case.size() >= 20);
+    TEST_ASSERT_TRUE(test_case.filled(19));
+    TEST_ASSERT_TRUE(7 == test_case[7]);
+
+    // random access iterators work with the standard library.
+    double sum = std::accumulate(test_case.begin(), test_case.begin() + 20, 0.0);
+    TEST_ASSERT_TRUE(190 == sum);
+    std::reverse(test_case.begin(), test_case.begin() + 20);
+    TEST_ASSERT_TRUE(19 == test_case.at(0));
+
+#ifdef AA_ARAYEH_HAS_SPAN
+    // span views share memory.
+    auto view = test_case.span().first(20);
+    view[1]   = -1;
+    TEST_ASSERT_TRUE(-1 == test_case[1]);
+#endif
+
+    // checked accessor.
+    bool thrown = false;
+    try {
+        test_case.at(test_case.size());
+    } catch (const std::out_of_range &) {
+        thrown = true;
+    }
+    TEST_ASSERT_TRUE(thrown);
+}
+
+void test_cpp_copy_and_move(void)
+{
+    // Test that copies duplicate the arayeh and moves steal it.
+
+    // create new arayeh.
+    aa::arayeh<int> original(4);
+    original.add(1);
+    original.add(2);
+
+    // copy.
+    aa::arayeh<int> copy(original);
+    copy[0] = 10;
+    TEST_ASSERT_EQUAL_INT(1, original[0]);
+    TEST_ASSERT_EQUAL_size_t(2, copy.used());
+
+    // move steals the buffer.
+    int *buffer = original.data();
+    aa::arayeh<int> moved(std::move(original));
+    TEST_ASSERT_EQUAL_PTR(buffer, moved.data());
+    TEST_ASSERT_NULL(original.native());
+
+    // move assignment frees the old arayeh and steals the new one.
+    copy = std::move(moved);
+    TEST_ASSERT_EQUAL_PTR(buffer, copy.data());
+    TEST_ASSERT_NULL(moved.native());
+
+    // copy assignment.
+    aa::arayeh<int> other;
+    other = copy;
+    TEST_ASSERT_EQUAL_INT(2, other[1]);
+    TEST_ASSERT_TRUE(other.data() != copy.data());
+}
+
+void test_cpp_fixed_width(void)
+{
+    // Test that fixed-width integers map to arayeh types of their size.
+
+    aa::arayeh<std::uint8_t> bytes;
+    aa::arayeh<std::int64_t> stamps;
+    aa::arayeh<std::uint16_t> words;
+
+    TEST_ASSERT_EQUAL_size_t(AA_ARAYEH_TYPE_UINT8, bytes.native()->type);
+    TEST_ASSERT_EQUAL_size_t(AA_ARAYEH_TYPE_UINT16, words.native()->type);
+    TEST_ASSERT_EQUAL_size_t(8, stamps.native()->_private_properties.element_size);
+
+    bytes.add(255);
+    stamps.add(INT64_C(1) << 40);
+    words.add(65535);
+
+    TEST_ASSERT_EQUAL_UINT8(255, bytes[0]);
+    TEST_ASSERT_TRUE((INT64_C(1) << 40) == stamps[0]);
+    TEST_ASSERT_EQUAL_UINT16(65535, words[0]);
+}
+
+void test_cpp_narrowed(void)
+{
+    // Test that accessors widen a narrowed arayeh.
+
+    // create new arayeh.
+    aa::arayeh<long> test_case(8);
+    for (long element = 0; element < 4; element++) {
+        test_case.add(element);
+    }
+
+    test_case.native()->narrow(test_case.native());
+    TEST_ASSERT_TRUE(test_case.native()->_private_properties.storage_type !=
+                     AA_ARAYEH_TYPE_LINT);
+
+    TEST_ASSERT_TRUE(2 == test_case.at(2));
+    TEST_ASSERT_EQUAL_size_t(AA_ARAYEH_TYPE_LINT,
+                             test_case.native()->_private_properties.storage_type);
+    TEST_ASSERT_TRUE(6 == std::accumulate(test_case.begin(), test_case.begin() + 4, 0L));
+
+    // const accessors widen too.
+    test_case.native()->narrow(test_case.native());
+    const aa::arayeh<long> &constant = test_case;
+    TEST_ASSERT_TRUE(3 == constant[3]);
+}
+
+void test_cpp_hash_index(void)
+{
+    // Test that writes through mutable accessors don't leave a stale index.
+
+    // create new arayeh.
+    aa::arayeh<int> test_case(4);
+
+    // define new settings.
+    arayeh_settings new_settings = {.debug_messages = AA_ARAYEH_OFF,
+                                    .extend_size    = AA_ARAYEH_ON,
+                                    .hash_index     = AA_ARAYEH_ON};
+
+    // set new settings.
+    test_case.native()->set_settings(test_case.native(), &new_settings);
+
+    int element = 5;
+    test_case.add(element);
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_TRUE,
+                          test_case.native()->contains(test_case.native(), &element));
+    TEST_ASSERT_NOT_NULL(test_case.native()->_private_properties.hash_index)
+
+    test_case[0] = 7;
+    TEST_ASSERT_NULL(test_case.native()->_private_properties.hash_index)
+
+    size_t index = 1;
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_FALSE,
+                          test_case.native()->contains(test_case.native(), &element));
+    element = 7;
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS,
+                          test_case.native()->find(test_case.native(), &element, &index));
+    TEST_ASSERT_EQUAL_size_t(0, index);
+}
+
+void test_cpp_typed_api(void)
+{
+    // Test that the typed C API is usable from C++.
+
+    // create new arayeh.
+    aa::arayeh<int> test_case(10);
+    for (int element = 0; element < 5; element++) {
+        TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS,
+                              arayeh_int_add(test_case.native(), element * 3));
+    }
+
+    TEST_ASSERT_EQUAL_INT(12, arayeh_int_get(test_case.native(), 4));
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS, arayeh_int_set(test_case.native(), 4, 7));
+    TEST_ASSERT_EQUAL_INT(7, test_case.at(4));
+    TEST_ASSERT_EQUAL_size_t(5, test_case.used());
+
+    // half precision cells round trip.
+    arayeh *half = Arayeh(AA_ARAYEH_TYPE_FLOAT16, 4);
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS, arayeh_float16_add(half, 1.5f));
+    TEST_ASSERT_EQUAL_FLOAT(1.5f, arayeh_float16_get(half, 0));
+
+    // free arayeh.
+    half->free_arayeh(&half);
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_cpp_wrapper);
+    RUN_TEST(test_cpp_copy_and_move);
+    RUN_TEST(test_cpp_fixed_width);
+    RUN_TEST(test_cpp_narrowed);
+    RUN_TEST(test_cpp_hash_index);
+    RUN_TEST(test_cpp_typed_api);
+    return UNITY_END();
+}
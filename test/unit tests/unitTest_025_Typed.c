@@ -0,0 +1,120 @@
+/** test/unitTest_025_Typed.c
+ *
+ * This file is a part of:
+ * Azadeh Afzar - Arayehsaz (AA-A).
+ *
+ * Copyright (C) 2020 - 2021 Azadeh Afzar.
+ * Copyright (C) 2020 - 2021 Mohammad Mahdi Baghbani Pourvahid.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgement in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "../../include/arayeh_typed.h"
+#include "unity.h"
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_typed_add_get(void)
+{
+    // Test that typed add and get keep arayeh bookkeeping like the methods.
+
+    // define default arayeh size.
+    size_t arayeh_size = 10;
+
+    // create new arayehs.
+    arayeh *typed  = Arayeh(AA_ARAYEH_TYPE_INT, arayeh_size);
+    arayeh *method = Arayeh(AA_ARAYEH_TYPE_INT, arayeh_size);
+
+    // make a hole, add must skip filled cells after it.
+    int element = -1;
+    typed->insert(typed, 5, &element);
+    method->insert(method, 5, &element);
+
+    for (int index = 0; index < 100; index++) {
+        TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS, arayeh_int_add(typed, index));
+        method->add(method, &index);
+
+        TEST_ASSERT_EQUAL_size_t(method->used, typed->used);
+        TEST_ASSERT_EQUAL_size_t(method->next, typed->next);
+        TEST_ASSERT_EQUAL_size_t(method->size, typed->size);
+    }
+
+    for (size_t index = 0; index < typed->used; index++) {
+        method->get(method, index, &element);
+        TEST_ASSERT_EQUAL_INT(element, arayeh_int_get(typed, index));
+        TEST_ASSERT_EQUAL_INT(element, arayeh_int_data(typed)[index]);
+    }
+
+    // free arayehs.
+    typed->free_arayeh(&typed);
+    method->free_arayeh(&method);
+}
+
+void test_typed_set(void)
+{
+    // Test that typed set fills cells and updates used and next.
+
+    // define default arayeh size.
+    size_t arayeh_size = 10;
+
+    // create new arayeh.
+    arayeh *test_case = Arayeh(AA_ARAYEH_TYPE_DOUBLE, arayeh_size);
+
+    arayeh_double_set(test_case, 3, 1.5);
+    arayeh_double_set(test_case, 3, 2.5);
+    TEST_ASSERT_EQUAL_size_t(1, test_case->used);
+    TEST_ASSERT_EQUAL_size_t(0, test_case->next);
+    TEST_ASSERT_TRUE(2.5 == arayeh_double_get(test_case, 3));
+
+    // setting "next" moves it.
+    arayeh_double_set(test_case, 0, 1);
+    TEST_ASSERT_EQUAL_size_t(1, test_case->next);
+
+    // setting out of arayeh size extends it.
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS, arayeh_double_set(test_case, 20, 4));
+    TEST_ASSERT_TRUE(test_case->size > 20);
+    TEST_ASSERT_EQUAL_size_t(3, test_case->used);
+
+    // free arayeh.
+    test_case->free_arayeh(&test_case);
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_typed_add_get);
+    RUN_TEST(test_typed_set);
+    return UNITY_END();
+}
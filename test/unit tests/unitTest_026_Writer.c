@@ -0,0 +1,192 @@
+/** test/unitTest_026_Writer.c
+ *
+ * This file is a part of:
+ * Azadeh Afzar - Arayehsaz (AA-A).
+ *
+ * Copyright (C) 2020 - 2021 Azadeh Afzar.
+ * Copyright (C) 2020 - 2021 Mohammad Mahdi Baghbani Pourvahid.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgement in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "../../include/arayeh_typed.h"
+#include "unity.h"
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_writer_push(void)
+{
+    // Test that writer reserves cells after the last filled cell and commits
+    // only the pushed cells.
+
+    // define default arayeh size.
+    size_t arayeh_size = 10;
+
+    // create new arayeh.
+    arayeh *test_case = Arayeh(AA_ARAYEH_TYPE_INT, arayeh_size);
+
+    // fill some cells with a hole at index 1.
+    int element = 7;
+    test_case->insert(test_case, 0, &element);
+    test_case->insert(test_case, 2, &element);
+
+    arayeh_writer writer;
+    int state = test_case->writer_open(test_case, &writer, 100);
+
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS, state);
+    TEST_ASSERT_EQUAL_size_t(3, writer.start_index);
+    TEST_ASSERT_TRUE(test_case->size >= 103);
+
+    for (int index = 0; index < 50; index++) {
+        arayeh_int_push(&writer, index);
+    }
+    element = 50;
+    arayeh_writer_push(&writer, &element);
+
+    state = test_case->writer_close(test_case, &writer);
+
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS, state);
+    TEST_ASSERT_EQUAL_size_t(53, test_case->used);
+    TEST_ASSERT_EQUAL_size_t(1, test_case->next);
+
+    for (int index = 0; index <= 50; index++) {
+        test_case->get(test_case, (size_t) index + 3, &element);
+        TEST_ASSERT_EQUAL_INT(index, element);
+    }
+
+    // cells after the pushed ones stay empty.
+    TEST_ASSERT_EQUAL_CHAR(AA_ARAYEH_OFF, test_case->_private_properties.map[54]);
+
+    // free arayeh.
+    test_case->free_arayeh(&test_case);
+}
+
+void test_writer_next(void)
+{
+    // Test that writer moves "next" when it fills it.
+
+    // define default arayeh size.
+    size_t arayeh_size = 10;
+
+    // create new arayeh.
+    arayeh *test_case = Arayeh(AA_ARAYEH_TYPE_DOUBLE, arayeh_size);
+
+    arayeh_writer writer;
+    test_case->writer_open(test_case, &writer, 10);
+    for (int index = 0; index < 4; index++) {
+        arayeh_double_push(&writer, index * 0.5);
+    }
+    test_case->writer_close(test_case, &writer);
+
+    TEST_ASSERT_EQUAL_size_t(4, test_case->used);
+    TEST_ASSERT_EQUAL_size_t(4, test_case->next);
+    TEST_ASSERT_EQUAL_size_t(arayeh_size, test_case->size);
+
+    // add continues after the written cells.
+    double element = 9;
+    test_case->add(test_case, &element);
+    TEST_ASSERT_TRUE(9 == arayeh_double_get(test_case, 4));
+
+    // free arayeh.
+    test_case->free_arayeh(&test_case);
+}
+
+void test_writer_extend_off(void)
+{
+    // Test that writer respects extend settings.
+
+    // define default arayeh size.
+    size_t arayeh_size = 10;
+
+    // create new arayeh.
+    arayeh *test_case = Arayeh(AA_ARAYEH_TYPE_INT, arayeh_size);
+
+    // turn off extending.
+    arayeh_settings new_settings = {.debug_messages = AA_ARAYEH_OFF,
+                                    .extend_size    = AA_ARAYEH_OFF};
+    test_case->set_settings(test_case, &new_settings);
+
+    arayeh_writer writer;
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_NOT_ENOUGH_SPACE,
+                          test_case->writer_open(test_case, &writer, 11));
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS,
+                          test_case->writer_open(test_case, &writer, 10));
+
+    // free arayeh.
+    test_case->free_arayeh(&test_case);
+}
+
+void test_writer_wrong_type(void)
+{
+    // Test that bool and string arayehs have no writer.
+
+    // define default arayeh size.
+    size_t arayeh_size = 10;
+
+    size_t types[2] = {AA_ARAYEH_TYPE_BOOL, AA_ARAYEH_TYPE_STRING};
+    for (size_t index = 0; index < 2; index++) {
+        // create new arayeh.
+        arayeh *test_case = Arayeh(types[index], arayeh_size);
+
+        arayeh_writer writer;
+        TEST_ASSERT_EQUAL_INT(AA_ARAYEH_WRONG_TYPE,
+                              test_case->writer_open(test_case, &writer, 4));
+        TEST_ASSERT_EQUAL_size_t(0, test_case->used);
+        TEST_ASSERT_EQUAL_size_t(types[index], test_case->_private_properties.type);
+
+        // free arayeh.
+        test_case->free_arayeh(&test_case);
+    }
+
+    // packed boolean cells stay packed.
+    arayeh *flags = Arayeh(AA_ARAYEH_TYPE_BOOL, arayeh_size);
+    arayeh_writer writer;
+    flags->writer_open(flags, &writer, 4);
+    TEST_ASSERT_EQUAL_size_t(AA_ARAYEH_STORAGE_BIT,
+                             flags->_private_properties.storage_type);
+
+    // free arayeh.
+    flags->free_arayeh(&flags);
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_writer_push);
+    RUN_TEST(test_writer_next);
+    RUN_TEST(test_writer_extend_off);
+    RUN_TEST(test_writer_wrong_type);
+    return UNITY_END();
+}
@@ -0,0 +1,191 @@
+/** test/unitTest_027_Generic.c
+ *
+ * This file is a part of:
+ * Azadeh Afzar - Arayehsaz (AA-A).
+ *
+ * Copyright (C) 2020 - 2021 Azadeh Afzar.
+ * Copyright (C) 2020 - 2021 Mohammad Mahdi Baghbani Pourvahid.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgement in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "../../include/arayeh.h"
+#include "unity.h"
+
+#include <stdint.h>
+#include <string.h>
+
+struct point {
+    int x;
+    int y;
+    int z;
+};
+
+struct pair {
+    double first;
+    double second;
+};
+
+struct line {
+    _Alignas(64) double values[8];
+};
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_generic_add_get(void)
+{
+    // Test that generic arayehs store structs and grow.
+
+    // define default arayeh size.
+    size_t arayeh_size = 4;
+
+    // create new arayeh.
+    arayeh *test_case =
+        ArayehGeneric(sizeof(struct point), _Alignof(struct point), arayeh_size);
+
+    TEST_ASSERT_EQUAL_size_t(AA_ARAYEH_TYPE_GENERIC, test_case->type);
+
+    for (int index = 0; index < 100; index++) {
+        struct point element = {index, -index, index * 2};
+        TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS, test_case->add(test_case, &element));
+    }
+
+    TEST_ASSERT_EQUAL_size_t(100, test_case->used);
+
+    for (int index = 0; index < 100; index++) {
+        struct point element;
+        test_case->get(test_case, (size_t) index, &element);
+        TEST_ASSERT_EQUAL_INT(index, element.x);
+        TEST_ASSERT_EQUAL_INT(-index, element.y);
+        TEST_ASSERT_EQUAL_INT(index * 2, element.z);
+    }
+
+    // search compares elements as bytes.
+    struct point needle = {42, -42, 84};
+    size_t index;
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS, test_case->find(test_case, &needle, &index));
+    TEST_ASSERT_EQUAL_size_t(42, index);
+
+    // 12 byte elements have no hash key.
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_WRONG_TYPE, test_case->build_hash_index(test_case));
+
+    // free arayeh.
+    test_case->free_arayeh(&test_case);
+}
+
+void test_generic_sizes(void)
+{
+    // Test elements of 8 and 16 bytes, which use specialized copies.
+
+    // define default arayeh size.
+    size_t arayeh_size = 10;
+
+    // create new arayehs.
+    arayeh *pairs =
+        ArayehGeneric(sizeof(struct pair), _Alignof(struct pair), arayeh_size);
+    arayeh *words = ArayehGeneric(sizeof(uint64_t), 0, arayeh_size);
+
+    for (int index = 0; index < 70; index++) {
+        struct pair element = {index, index + 0.5};
+        uint64_t word       = (uint64_t) index << 40;
+        pairs->add(pairs, &element);
+        words->add(words, &word);
+    }
+
+    struct pair pair_needle = {69, 69.5};
+    uint64_t word_needle    = (uint64_t) 33 << 40;
+    size_t index;
+
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS, pairs->find(pairs, &pair_needle, &index));
+    TEST_ASSERT_EQUAL_size_t(69, index);
+
+    // 8 byte elements can be indexed.
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS, words->build_hash_index(words));
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS, words->find(words, &word_needle, &index));
+    TEST_ASSERT_EQUAL_size_t(33, index);
+
+    // duplicates keep the element type.
+    arayeh *copy = pairs->duplicate(pairs);
+    TEST_ASSERT_EQUAL_size_t(70, copy->used);
+    struct pair element;
+    copy->get(copy, 10, &element);
+    TEST_ASSERT_TRUE(10 == element.first && 10.5 == element.second);
+
+    // free arayehs.
+    pairs->free_arayeh(&pairs);
+    words->free_arayeh(&words);
+    copy->free_arayeh(&copy);
+}
+
+void test_generic_alignment(void)
+{
+    // Test that over-aligned arayeh memory stays aligned when it grows.
+
+    // define default arayeh size.
+    size_t arayeh_size = 3;
+
+    // create new arayeh.
+    arayeh *test_case =
+        ArayehGeneric(sizeof(struct line), _Alignof(struct line), arayeh_size);
+
+    for (int index = 0; index < 50; index++) {
+        struct line element;
+        for (int value = 0; value < 8; value++) {
+            element.values[value] = index * 8 + value;
+        }
+        test_case->add(test_case, &element);
+
+        arayeh_view view;
+        test_case->view(test_case, &view);
+        uintptr_t address = (uintptr_t) view.array.char_pointer;
+        TEST_ASSERT_EQUAL_size_t(0, address % _Alignof(struct line));
+    }
+
+    struct line element;
+    test_case->get(test_case, 49, &element);
+    TEST_ASSERT_TRUE(49 * 8 + 7 == element.values[7]);
+
+    // free arayeh.
+    test_case->free_arayeh(&test_case);
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_generic_add_get);
+    RUN_TEST(test_generic_sizes);
+    RUN_TEST(test_generic_alignment);
+    return UNITY_END();
+}
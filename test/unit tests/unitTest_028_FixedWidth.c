@@ -0,0 +1,142 @@
+/** test/unitTest_028_FixedWidth.c
+ *
+ * This file is a part of:
+ * Azadeh Afzar - Arayehsaz (AA-A).
+ *
+ * Copyright (C) 2020 - 2021 Azadeh Afzar.
+ * Copyright (C) 2020 - 2021 Mohammad Mahdi Baghbani Pourvahid.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgement in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "../../include/arayeh_typed.h"
+#include "unity.h"
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_fixed_width_unsigned(void)
+{
+    // Test that unsigned types keep values that don't fit in signed types.
+
+    // define default arayeh size.
+    size_t arayeh_size = 10;
+
+    // create new arayehs.
+    arayeh *bytes = Arayeh(AA_ARAYEH_TYPE_UINT8, arayeh_size);
+    arayeh *ids   = Arayeh(AA_ARAYEH_TYPE_UINT32, arayeh_size);
+
+    TEST_ASSERT_EQUAL_size_t(1, bytes->_private_properties.element_size);
+    TEST_ASSERT_EQUAL_size_t(4, ids->_private_properties.element_size);
+
+    for (int index = 0; index < 256; index++) {
+        uint8_t byte = (uint8_t) index;
+        uint32_t id  = UINT32_MAX - (uint32_t) index;
+        bytes->add(bytes, &byte);
+        ids->add(ids, &id);
+    }
+
+    uint8_t byte;
+    uint32_t id;
+    bytes->get(bytes, 200, &byte);
+    ids->get(ids, 255, &id);
+    TEST_ASSERT_EQUAL_UINT8(200, byte);
+    TEST_ASSERT_EQUAL_UINT32(UINT32_MAX - 255, id);
+
+    // search.
+    size_t index;
+    byte = 250;
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS, bytes->find(bytes, &byte, &index));
+    TEST_ASSERT_EQUAL_size_t(250, index);
+    id = UINT32_MAX - 77;
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS, ids->find(ids, &id, &index));
+    TEST_ASSERT_EQUAL_size_t(77, index);
+
+    // typed API sums without sign bugs.
+    unsigned sum = 0;
+    for (size_t cell = 0; cell < bytes->used; cell++) {
+        sum += arayeh_uint8_get(bytes, cell);
+    }
+    TEST_ASSERT_EQUAL_UINT(255 * 256 / 2, sum);
+
+    // free arayehs.
+    bytes->free_arayeh(&bytes);
+    ids->free_arayeh(&ids);
+}
+
+void test_fixed_width_int64(void)
+{
+    // Test 64 bit values with the hash index and merges.
+
+    // define default arayeh size.
+    size_t arayeh_size = 10;
+
+    // create new arayeh.
+    arayeh *stamps = Arayeh(AA_ARAYEH_TYPE_INT64, arayeh_size);
+
+    int64_t array[100];
+    for (int index = 0; index < 100; index++) {
+        array[index] = (INT64_C(1) << 40) * index - index;
+    }
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS,
+                          stamps->merge_array(stamps, 0, 1, 100, array));
+    TEST_ASSERT_EQUAL_size_t(100, stamps->used);
+
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS, stamps->build_hash_index(stamps));
+
+    size_t index;
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS, stamps->find(stamps, &array[64], &index));
+    TEST_ASSERT_EQUAL_size_t(64, index);
+
+    // a value that differs only in the high half isn't found.
+    int64_t missing = array[64] + (INT64_C(1) << 32);
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_FALSE, stamps->contains(stamps, &missing));
+
+    // duplicates keep the type.
+    arayeh *copy = stamps->duplicate(stamps);
+    TEST_ASSERT_EQUAL_size_t(AA_ARAYEH_TYPE_INT64, copy->type);
+    TEST_ASSERT_TRUE(array[99] == arayeh_int64_get(copy, 99));
+
+    // free arayehs.
+    stamps->free_arayeh(&stamps);
+    copy->free_arayeh(&copy);
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_fixed_width_unsigned);
+    RUN_TEST(test_fixed_width_int64);
+    return UNITY_END();
+}
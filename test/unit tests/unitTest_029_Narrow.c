@@ -0,0 +1,267 @@
+/** test/unitTest_029_Narrow.c
+ *
+ * This file is a part of:
+ * Azadeh Afzar - Arayehsaz (AA-A).
+ *
+ * Copyright (C) 2020 - 2021 Azadeh Afzar.
+ * Copyright (C) 2020 - 2021 Mohammad Mahdi Baghbani Pourvahid.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgement in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "../../include/arayeh_typed.h"
+#include "unity.h"
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_narrow(void)
+{
+    // Test that narrowed arayehs keep their values and widen when needed.
+
+    // define default arayeh size.
+    size_t arayeh_size = 1000;
+
+    // create new arayeh.
+    arayeh *codes = Arayeh(AA_ARAYEH_TYPE_LINT, arayeh_size);
+
+    struct private_properties *properties = &codes->_private_properties;
+
+    for (long int value = 0; value < 900; value++) {
+        long int code = value % 200;
+        codes->add(codes, &code);
+    }
+
+    // values in 0..199 fit in one byte.
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS, codes->narrow(codes));
+    TEST_ASSERT_EQUAL_size_t(AA_ARAYEH_TYPE_LINT, codes->type);
+    TEST_ASSERT_EQUAL_size_t(AA_ARAYEH_TYPE_UINT8, properties->storage_type);
+    TEST_ASSERT_EQUAL_size_t(1, properties->element_size);
+
+    // get widens the cell, search narrows the element.
+    long int code;
+    size_t index;
+    codes->get(codes, 399, &code);
+    TEST_ASSERT_EQUAL_INT64(199, code);
+    TEST_ASSERT_EQUAL_INT64(199, arayeh_long_int_get(codes, 399));
+    code = 150;
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS, codes->find(codes, &code, &index));
+    TEST_ASSERT_EQUAL_size_t(150, index);
+    TEST_ASSERT_EQUAL_size_t(4, codes->count(codes, &code));
+    code = 150 + 256;
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_FALSE, codes->contains(codes, &code));
+
+    // values that fit keep the arayeh narrow.
+    code = 255;
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS, arayeh_long_int_add(codes, code));
+    TEST_ASSERT_EQUAL_size_t(1, properties->element_size);
+
+    // a negative value doesn't fit and widens it.
+    code = -5;
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS, codes->insert(codes, 950, &code));
+    TEST_ASSERT_EQUAL_size_t(sizeof(long int), properties->element_size);
+    TEST_ASSERT_EQUAL_INT64(255, arayeh_long_int_get(codes, 900));
+    TEST_ASSERT_EQUAL_INT64(-5, arayeh_long_int_get(codes, 950));
+    TEST_ASSERT_EQUAL_INT64(42, arayeh_long_int_get(codes, 842));
+
+    // now it needs a signed byte.
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS,
+                          codes->delete_item(codes, 900, AA_ARAYEH_OFF));
+    for (size_t cell = 0; cell < 900; cell++) {
+        if (arayeh_long_int_get(codes, cell) > 127) {
+            codes->delete_item(codes, cell, AA_ARAYEH_OFF);
+        }
+    }
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS, codes->narrow(codes));
+    TEST_ASSERT_EQUAL_size_t(AA_ARAYEH_TYPE_INT8, properties->storage_type);
+    codes->get(codes, 950, &code);
+    TEST_ASSERT_EQUAL_INT64(-5, code);
+
+    // methods that hand out memory widen it.
+    arayeh_view view;
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS, codes->view(codes, &view));
+    TEST_ASSERT_EQUAL_size_t(AA_ARAYEH_TYPE_LINT, properties->storage_type);
+    TEST_ASSERT_EQUAL_INT64(-5, view.array.long_int_pointer[950]);
+
+    // free arayeh.
+    codes->free_arayeh(&codes);
+}
+
+void test_change_type(void)
+{
+    // Test converting integer arayehs between types.
+
+    // define default arayeh size.
+    size_t arayeh_size = 100;
+
+    // create new arayeh.
+    arayeh *values = Arayeh(AA_ARAYEH_TYPE_INT, arayeh_size);
+
+    for (int value = -50; value < 50; value += 2) {
+        values->add(values, &value);
+    }
+
+    // negative values don't fit in unsigned types.
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_OVERFLOW,
+                          values->change_type(values, AA_ARAYEH_TYPE_UINT16,
+                                              AA_ARAYEH_CONVERT_STRICT));
+    TEST_ASSERT_EQUAL_size_t(AA_ARAYEH_TYPE_INT, values->type);
+
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS,
+                          values->change_type(values, AA_ARAYEH_TYPE_INT8,
+                                              AA_ARAYEH_CONVERT_STRICT));
+    TEST_ASSERT_EQUAL_size_t(AA_ARAYEH_TYPE_INT8, values->type);
+    TEST_ASSERT_EQUAL_size_t(1, values->_private_properties.element_size);
+    TEST_ASSERT_EQUAL_INT8(-50, arayeh_int8_get(values, 0));
+    TEST_ASSERT_EQUAL_INT8(48, arayeh_int8_get(values, 49));
+    TEST_ASSERT_EQUAL_size_t(50, values->used);
+
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS,
+                          values->change_type(values, AA_ARAYEH_TYPE_INT64,
+                                              AA_ARAYEH_CONVERT_STRICT));
+    TEST_ASSERT_EQUAL_INT64(-48, arayeh_int64_get(values, 1));
+
+    // the converted arayeh works like a new one.
+    int64_t big = INT64_C(1) << 40;
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS, values->add(values, &big));
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS, values->build_hash_index(values));
+    size_t index;
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS, values->find(values, &big, &index));
+    TEST_ASSERT_EQUAL_size_t(50, index);
+
+    // free arayeh.
+    values->free_arayeh(&values);
+}
+
+void test_narrow_merge(void)
+{
+    // Test that merging from or into narrowed arayehs keeps their storage.
+
+    // define default arayeh size.
+    size_t arayeh_size = 100;
+
+    // create new arayehs.
+    arayeh *narrow = Arayeh(AA_ARAYEH_TYPE_INT, arayeh_size);
+    arayeh *wide   = Arayeh(AA_ARAYEH_TYPE_INT, arayeh_size);
+
+    for (int value = 0; value < (int) arayeh_size; value++) {
+        if (value % 3 != 0) {
+            narrow->insert(narrow, (size_t) value, &value);
+        }
+    }
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS, narrow->narrow(narrow));
+
+    // source stays narrowed.
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS, wide->merge_arayeh(wide, 0, 1, narrow));
+    TEST_ASSERT_EQUAL_size_t(AA_ARAYEH_TYPE_UINT8,
+                             narrow->_private_properties.storage_type);
+    TEST_ASSERT_EQUAL_size_t(narrow->used, wide->used);
+    for (size_t index = 0; index < arayeh_size; index++) {
+        TEST_ASSERT_EQUAL_CHAR(narrow->_private_properties.map[index],
+                               wide->_private_properties.map[index]);
+        if (index % 3 != 0) {
+            TEST_ASSERT_EQUAL_INT((int) index, arayeh_int_get(wide, index));
+        }
+    }
+
+    // self stays narrowed while merged values fit.
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS, narrow->merge_arayeh(narrow, 0, 1, wide));
+    TEST_ASSERT_EQUAL_size_t(AA_ARAYEH_TYPE_UINT8,
+                             narrow->_private_properties.storage_type);
+    TEST_ASSERT_EQUAL_INT(98, arayeh_int_get(narrow, 98));
+
+    // free arayehs.
+    narrow->free_arayeh(&narrow);
+    wide->free_arayeh(&wide);
+}
+
+void test_narrow_copies(void)
+{
+    // Test that methods copying cells keep the arayeh narrowed.
+
+    // define default arayeh size.
+    size_t arayeh_size = 150;
+
+    // create new arayeh, every 5th cell is empty.
+    arayeh *codes = Arayeh(AA_ARAYEH_TYPE_INT, arayeh_size);
+    for (int value = 0; value < (int) arayeh_size; value++) {
+        if (value % 5 != 0) {
+            codes->insert(codes, (size_t) value, &value);
+        }
+    }
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS, codes->narrow(codes));
+
+    struct private_properties *properties = &codes->_private_properties;
+
+    int range[10];
+    int fill = -1;
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS,
+                          codes->get_range(codes, 100, 10, range, &fill));
+    TEST_ASSERT_EQUAL_INT(-1, range[0]);
+    TEST_ASSERT_EQUAL_INT(109, range[9]);
+
+    size_t indices[3] = {149, 5, 7};
+    int picked[3];
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS,
+                          codes->get_indices(codes, indices, 3, picked, &fill));
+    TEST_ASSERT_EQUAL_INT(149, picked[0]);
+    TEST_ASSERT_EQUAL_INT(-1, picked[1]);
+    TEST_ASSERT_EQUAL_INT(7, picked[2]);
+
+    int packed[150];
+    size_t packed_indices[150];
+    TEST_ASSERT_EQUAL_size_t(120, codes->pack(codes, packed, packed_indices));
+    TEST_ASSERT_EQUAL_INT(1, packed[0]);
+    TEST_ASSERT_EQUAL_INT(149, packed[119]);
+    TEST_ASSERT_EQUAL_size_t(149, packed_indices[119]);
+
+    int value = 100;
+    TEST_ASSERT_EQUAL_size_t(40, codes->compare(codes, AA_ARAYEH_GREATER_EQUAL, &value,
+                                                NULL, NULL));
+
+    TEST_ASSERT_EQUAL_size_t(AA_ARAYEH_TYPE_UINT8, properties->storage_type);
+
+    // free arayeh.
+    codes->free_arayeh(&codes);
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_narrow);
+    RUN_TEST(test_change_type);
+    RUN_TEST(test_narrow_merge);
+    RUN_TEST(test_narrow_copies);
+    return UNITY_END();
+}
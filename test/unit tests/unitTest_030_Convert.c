@@ -0,0 +1,224 @@
+/** test/unitTest_030_Convert.c
+ *
+ * This file is a part of:
+ * Azadeh Afzar - Arayehsaz (AA-A).
+ *
+ * Copyright (C) 2020 - 2021 Azadeh Afzar.
+ * Copyright (C) 2020 - 2021 Mohammad Mahdi Baghbani Pourvahid.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgement in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "../../include/arayeh_typed.h"
+#include "unity.h"
+
+#include <float.h>
+#include <math.h>
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_convert_to(void)
+{
+    // Test converting into a new arayeh keeps values and empty cells.
+
+    // define default arayeh size.
+    size_t arayeh_size = 1000;
+
+    // create new arayeh.
+    arayeh *ints = Arayeh(AA_ARAYEH_TYPE_INT, arayeh_size);
+
+    // fill every third cell.
+    for (int index = 0; index < 1000; index += 3) {
+        int value = index * 10 - 5000;
+        ints->insert(ints, (size_t) index, &value);
+    }
+
+    arayeh *doubles =
+        ints->convert_to(ints, AA_ARAYEH_TYPE_DOUBLE, AA_ARAYEH_CONVERT_STRICT);
+
+    TEST_ASSERT_NOT_NULL(doubles);
+    TEST_ASSERT_EQUAL_size_t(AA_ARAYEH_TYPE_DOUBLE, doubles->type);
+    TEST_ASSERT_EQUAL_size_t(ints->used, doubles->used);
+    TEST_ASSERT_EQUAL_size_t(ints->size, doubles->size);
+
+    for (size_t index = 0; index < 1000; index++) {
+        char filled = doubles->_private_properties.map[index];
+
+        if (index % 3 == 0) {
+            TEST_ASSERT_EQUAL_CHAR(AA_ARAYEH_ON, filled);
+            TEST_ASSERT_TRUE(arayeh_double_get(doubles, index) ==
+                             (double) index * 10 - 5000);
+        } else {
+            TEST_ASSERT_EQUAL_CHAR(AA_ARAYEH_OFF, filled);
+        }
+    }
+
+    // narrowed arayehs are converted from their cells.
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS, ints->narrow(ints));
+    arayeh *longs = ints->convert_to(ints, AA_ARAYEH_TYPE_LINT, AA_ARAYEH_CONVERT_STRICT);
+    TEST_ASSERT_EQUAL_size_t(AA_ARAYEH_TYPE_INT16,
+                             ints->_private_properties.storage_type);
+    TEST_ASSERT_EQUAL_INT64(-5000 + 9990, arayeh_long_int_get(longs, 999));
+
+    // free arayehs.
+    ints->free_arayeh(&ints);
+    doubles->free_arayeh(&doubles);
+    longs->free_arayeh(&longs);
+}
+
+void test_convert_modes(void)
+{
+    // Test strict, saturating and wrapping conversions and rounding.
+
+    // define default arayeh size.
+    size_t arayeh_size = 10;
+
+    // create new arayeh.
+    arayeh *reals = Arayeh(AA_ARAYEH_TYPE_DOUBLE, arayeh_size);
+
+    double values[] = {-1.5, 2.5, 3.5, 300.7, NAN, 1e300, 7.2};
+    reals->merge_array(reals, 0, 1, 7, values);
+
+    // values out of range fail a strict conversion.
+    int strict   = AA_ARAYEH_CONVERT_STRICT;
+    int nearest  = AA_ARAYEH_CONVERT_SATURATE | AA_ARAYEH_ROUND_NEAREST;
+    int truncate = AA_ARAYEH_CONVERT_SATURATE | AA_ARAYEH_ROUND_TRUNCATE;
+    size_t uint8 = AA_ARAYEH_TYPE_UINT8;
+    TEST_ASSERT_NULL(reals->convert_to(reals, uint8, strict));
+
+    arayeh *rounded   = reals->convert_to(reals, uint8, nearest);
+    arayeh *truncated = reals->convert_to(reals, uint8, truncate);
+
+    uint8_t expect_nearest[]   = {0, 2, 4, 255, 0, 255, 7};
+    uint8_t expect_truncated[] = {0, 2, 3, 255, 0, 255, 7};
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expect_nearest, arayeh_uint8_data(rounded), 7);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expect_truncated, arayeh_uint8_data(truncated), 7);
+
+    // doubles saturate in a float or become infinity.
+    arayeh *floats =
+        reals->convert_to(reals, AA_ARAYEH_TYPE_FLOAT, AA_ARAYEH_CONVERT_SATURATE);
+    TEST_ASSERT_TRUE(arayeh_float_get(floats, 5) == FLT_MAX);
+    TEST_ASSERT_TRUE(isnan(arayeh_float_get(floats, 4)));
+    floats->free_arayeh(&floats);
+    floats = reals->convert_to(reals, AA_ARAYEH_TYPE_FLOAT, AA_ARAYEH_CONVERT_WRAP);
+    TEST_ASSERT_TRUE(isinf(arayeh_float_get(floats, 5)));
+
+    // integers keep their low bits when wrapping.
+    arayeh *ints = Arayeh(AA_ARAYEH_TYPE_INT, arayeh_size);
+    int numbers[] = {300, -1, 70000};
+    ints->merge_array(ints, 0, 1, 3, numbers);
+
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS,
+                          ints->change_type(ints, AA_ARAYEH_TYPE_UINT16,
+                                            AA_ARAYEH_CONVERT_WRAP));
+    TEST_ASSERT_EQUAL_UINT16(300, arayeh_uint16_get(ints, 0));
+    TEST_ASSERT_EQUAL_UINT16(65535, arayeh_uint16_get(ints, 1));
+    TEST_ASSERT_EQUAL_UINT16(70000 - 65536, arayeh_uint16_get(ints, 2));
+
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS,
+                          ints->change_type(ints, AA_ARAYEH_TYPE_INT8,
+                                            AA_ARAYEH_CONVERT_SATURATE));
+    TEST_ASSERT_EQUAL_INT8(127, arayeh_int8_get(ints, 0));
+    TEST_ASSERT_EQUAL_INT8(127, arayeh_int8_get(ints, 1));
+    TEST_ASSERT_EQUAL_INT8(127, arayeh_int8_get(ints, 2));
+
+    // free arayehs.
+    reals->free_arayeh(&reals);
+    rounded->free_arayeh(&rounded);
+    truncated->free_arayeh(&truncated);
+    floats->free_arayeh(&floats);
+    ints->free_arayeh(&ints);
+}
+
+void test_change_type_in_place(void)
+{
+    // Test in place conversions across blocks and empty cells.
+
+    // define default arayeh size.
+    size_t arayeh_size = 1000;
+
+    // create new arayeh.
+    arayeh *values = Arayeh(AA_ARAYEH_TYPE_INT16, arayeh_size);
+
+    for (int16_t value = -500; value < 500; value++) {
+        values->add(values, &value);
+    }
+
+    // an empty cell with a big value doesn't make strict conversion fail.
+    int16_t big = 30000;
+    values->insert(values, 10, &big);
+    values->delete_item(values, 10, AA_ARAYEH_OFF);
+
+    // widen, memory grows and blocks are converted backward.
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS,
+                          values->change_type(values, AA_ARAYEH_TYPE_DOUBLE,
+                                              AA_ARAYEH_CONVERT_STRICT));
+    TEST_ASSERT_EQUAL_size_t(sizeof(double), values->_private_properties.element_size);
+
+    // narrow, blocks are converted forward.
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS,
+                          values->change_type(values, AA_ARAYEH_TYPE_INT32,
+                                              AA_ARAYEH_CONVERT_STRICT));
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_OVERFLOW,
+                          values->change_type(values, AA_ARAYEH_TYPE_UINT8,
+                                              AA_ARAYEH_CONVERT_STRICT));
+
+    for (size_t index = 0; index < 1000; index++) {
+        if (index != 10) {
+            int32_t value = arayeh_int32_get(values, index);
+            TEST_ASSERT_EQUAL_INT32((int32_t) index - 500, value);
+        }
+    }
+    TEST_ASSERT_EQUAL_size_t(999, values->used);
+
+    // generic arayehs have no conversion.
+    arayeh *pairs = ArayehGeneric(16, 8, arayeh_size);
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_WRONG_TYPE,
+                          pairs->change_type(pairs, AA_ARAYEH_TYPE_INT,
+                                             AA_ARAYEH_CONVERT_SATURATE));
+
+    // free arayehs.
+    values->free_arayeh(&values);
+    pairs->free_arayeh(&pairs);
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_convert_to);
+    RUN_TEST(test_convert_modes);
+    RUN_TEST(test_change_type_in_place);
+    return UNITY_END();
+}
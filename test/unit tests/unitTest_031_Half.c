@@ -0,0 +1,262 @@
+/** test/unit tests/unitTest_031_Half.c
+ *
+ * This file is a part of:
+ * Azadeh Afzar - Arayehsaz (AA-A).
+ *
+ * Copyright (C) 2020 - 2021 Azadeh Afzar.
+ * Copyright (C) 2020 - 2021 Mohammad Mahdi Baghbani Pourvahid.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgement in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+
+#include "../../include/arayeh_typed.h"
+#include "unity.h"
+
+#include <float.h>
+#include <math.h>
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+// map stage, doubles float elements.
+static size_t twice(void *block, size_t count, void *context)
+{
+    float *elements = (float *) block;
+    (void) context;
+
+    for (size_t index = 0; index < count; index++) {
+        elements[index] *= 2;
+    }
+
+    return count;
+}
+
+// reducer, adds float elements to the sum in "accumulator".
+static void sum(const void *block, size_t count, void *accumulator)
+{
+    const float *elements = (const float *) block;
+
+    for (size_t index = 0; index < count; index++) {
+        *(float *) accumulator += elements[index];
+    }
+}
+
+void test_half_scalar(void)
+{
+    // Test rounding, limits and round trips of scalar conversions.
+
+    TEST_ASSERT_EQUAL_HEX16(0x3C00, arayeh_float_to_float16(1.0f));
+    TEST_ASSERT_EQUAL_HEX16(0xC000, arayeh_float_to_float16(-2.0f));
+    TEST_ASSERT_EQUAL_HEX16(0x7BFF, arayeh_float_to_float16(65504.0f));
+    TEST_ASSERT_EQUAL_HEX16(0x7BFF, arayeh_float_to_float16(65519.0f));
+    TEST_ASSERT_EQUAL_HEX16(0x7C00, arayeh_float_to_float16(65520.0f));
+    TEST_ASSERT_EQUAL_HEX16(0x0001, arayeh_float_to_float16(0x1p-24f));
+    TEST_ASSERT_EQUAL_HEX16(0x0000, arayeh_float_to_float16(0x1p-26f));
+
+    // ties round to even.
+    TEST_ASSERT_EQUAL_HEX16(0x3C00, arayeh_float_to_float16(1.0f + 0x1p-11f));
+    TEST_ASSERT_EQUAL_HEX16(0x3C02, arayeh_float_to_float16(1.0f + 0x3p-11f));
+
+    // every float16 survives a round trip through float.
+    for (uint32_t bits = 0; bits <= 0xFFFF; bits++) {
+        float value = arayeh_float16_to_float((uint16_t) bits);
+        if (value == value) {
+            TEST_ASSERT_EQUAL_HEX16(bits, arayeh_float_to_float16(value));
+        } else {
+            TEST_ASSERT_TRUE(arayeh_float16_to_float(arayeh_float_to_float16(value)) !=
+                             arayeh_float16_to_float(arayeh_float_to_float16(value)));
+        }
+    }
+
+    TEST_ASSERT_EQUAL_HEX16(0x3F80, arayeh_float_to_bfloat16(1.0f));
+    TEST_ASSERT_EQUAL_HEX16(0x3F80, arayeh_float_to_bfloat16(1.0f + 0x1p-8f));
+    TEST_ASSERT_EQUAL_HEX16(0x3F82, arayeh_float_to_bfloat16(1.0f + 0x3p-8f));
+    TEST_ASSERT_TRUE(arayeh_bfloat16_to_float(0xC040) == -3.0f);
+    TEST_ASSERT_TRUE(isnan(arayeh_bfloat16_to_float(arayeh_float_to_bfloat16(NAN))));
+}
+
+void test_half_elements(void)
+{
+    // Test element methods of half precision arayehs take floats.
+
+    // define default arayeh size.
+    size_t arayeh_size = 100;
+
+    // create new arayehs.
+    arayeh *halves  = Arayeh(AA_ARAYEH_TYPE_FLOAT16, arayeh_size);
+    arayeh *brains  = Arayeh(AA_ARAYEH_TYPE_BFLOAT16, arayeh_size);
+
+    TEST_ASSERT_EQUAL_size_t(2, halves->_private_properties.element_size);
+
+    for (int index = 0; index < 100; index++) {
+        float value = (float) index * 0.25f - 10;
+        halves->add(halves, &value);
+        arayeh_bfloat16_add(brains, value);
+    }
+
+    float element;
+    halves->get(halves, 3, &element);
+    TEST_ASSERT_TRUE(element == -9.25f);
+    TEST_ASSERT_TRUE(arayeh_bfloat16_get(brains, 99) == 14.75f);
+    TEST_ASSERT_TRUE(arayeh_float16_get(halves, 99) == 14.75f);
+    TEST_ASSERT_EQUAL_HEX16(0x4B60, arayeh_float16_data(halves)[99]);
+
+    // -0.0 finds 0.0, floats without an exact half are never found.
+    size_t index = 0;
+    float needle = -0.0f;
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS, halves->find(halves, &needle, &index));
+    TEST_ASSERT_EQUAL_size_t(40, index);
+    needle = 0.1f;
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_NOT_FOUND, halves->find(halves, &needle, &index));
+    needle = 2.5f;
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS, brains->find(brains, &needle, &index));
+    TEST_ASSERT_EQUAL_size_t(50, index);
+
+    // C arrays hold floats, merges and shifting inserts convert them.
+    float reals[3] = {0.5f, -1.5f, 1024.0f};
+    halves->merge_array(halves, 100, 1, 3, reals);
+    halves->insert_range_shift(halves, 0, 3, reals);
+    TEST_ASSERT_TRUE(arayeh_float16_get(halves, 1) == -1.5f);
+    TEST_ASSERT_TRUE(arayeh_float16_get(halves, 3) == -10.0f);
+    TEST_ASSERT_TRUE(arayeh_float16_get(halves, 105) == 1024.0f);
+    arayeh *copy = halves->duplicate(halves);
+    TEST_ASSERT_TRUE(arayeh_float16_get(copy, 105) == 1024.0f);
+    copy->free_arayeh(&copy);
+
+    // free arayehs.
+    halves->free_arayeh(&halves);
+    brains->free_arayeh(&brains);
+}
+
+void test_half_convert(void)
+{
+    // Test bulk conversions between floats and halves.
+
+    // define default arayeh size.
+    size_t arayeh_size = 1000;
+
+    // create new arayeh.
+    arayeh *floats = Arayeh(AA_ARAYEH_TYPE_FLOAT, arayeh_size);
+
+    for (int index = 0; index < 1000; index++) {
+        float value = (float) (index - 500) * 1.37f;
+        floats->add(floats, &value);
+    }
+    float big = 1e6f;
+    floats->insert(floats, 777, &big);
+
+    // too big for a float16, but not for a bfloat16.
+    size_t float16 = AA_ARAYEH_TYPE_FLOAT16;
+    TEST_ASSERT_NULL(floats->convert_to(floats, float16, AA_ARAYEH_CONVERT_STRICT));
+
+    arayeh *halves = floats->convert_to(floats, float16, AA_ARAYEH_CONVERT_SATURATE);
+    arayeh *brains =
+        floats->convert_to(floats, AA_ARAYEH_TYPE_BFLOAT16, AA_ARAYEH_CONVERT_STRICT);
+    TEST_ASSERT_NOT_NULL(brains);
+
+    // bulk kernels round like the scalar functions.
+    for (size_t index = 0; index < 1000; index++) {
+        float value = arayeh_float_get(floats, index);
+        if (index != 777) {
+            TEST_ASSERT_EQUAL_HEX16(arayeh_float_to_float16(value),
+                                    arayeh_float16_data(halves)[index]);
+        }
+        TEST_ASSERT_EQUAL_HEX16(arayeh_float_to_bfloat16(value),
+                                arayeh_bfloat16_data(brains)[index]);
+    }
+    TEST_ASSERT_TRUE(arayeh_float16_get(halves, 777) == 65504.0f);
+
+    // integers go through floats, halves widen in place.
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS,
+                          halves->change_type(halves, AA_ARAYEH_TYPE_INT32,
+                                              AA_ARAYEH_CONVERT_STRICT |
+                                                  AA_ARAYEH_ROUND_NEAREST));
+    TEST_ASSERT_EQUAL_INT32(65504, arayeh_int32_get(halves, 777));
+    TEST_ASSERT_EQUAL_INT32(-685, arayeh_int32_get(halves, 0));
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS,
+                          brains->change_type(brains, AA_ARAYEH_TYPE_DOUBLE,
+                                              AA_ARAYEH_CONVERT_STRICT));
+    TEST_ASSERT_TRUE(arayeh_double_get(brains, 777) == 999424.0);
+
+    // free arayehs.
+    floats->free_arayeh(&floats);
+    halves->free_arayeh(&halves);
+    brains->free_arayeh(&brains);
+}
+
+void test_half_pipeline(void)
+{
+    // Test that pipelines of half precision arayehs work on floats.
+
+    // define default arayeh size, more than two pipeline blocks.
+    size_t arayeh_size = 5000;
+
+    // create new arayeh.
+    arayeh *halves = Arayeh(AA_ARAYEH_TYPE_FLOAT16, arayeh_size);
+
+    float expected = 0;
+    for (size_t index = 0; index < arayeh_size; index++) {
+        float value = (float) (index % 64) * 0.5f;
+        arayeh_float16_add(halves, value);
+        expected += value * 2;
+    }
+
+    arayeh_stage stages[1]   = {{twice, NULL}};
+    arayeh_pipeline pipeline = {stages, 1};
+
+    float actual = 0;
+    int state    = halves->pipeline_reduce(halves, &pipeline, sum, &actual);
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS, state);
+    TEST_ASSERT_TRUE(expected == actual);
+
+    arayeh *doubled = halves->pipeline_collect(halves, &pipeline);
+    TEST_ASSERT_EQUAL_size_t(AA_ARAYEH_TYPE_FLOAT16, doubled->type);
+    TEST_ASSERT_EQUAL_size_t(arayeh_size, doubled->used);
+    TEST_ASSERT_TRUE(arayeh_float16_get(doubled, 4031) == 63.0f);
+
+    // free arayehs.
+    halves->free_arayeh(&halves);
+    doubled->free_arayeh(&doubled);
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_half_scalar);
+    RUN_TEST(test_half_elements);
+    RUN_TEST(test_half_convert);
+    RUN_TEST(test_half_pipeline);
+    return UNITY_END();
+}
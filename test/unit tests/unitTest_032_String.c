@@ -0,0 +1,248 @@
+/** test/unit tests/unitTest_032_String.c
+ *
+ * This file is a part of:
+ * Azadeh Afzar - Arayehsaz (AA-A).
+ *
+ * Copyright (C) 2020 - 2021 Azadeh Afzar.
+ * Copyright (C) 2020 - 2021 Mohammad Mahdi Baghbani Pourvahid.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgement in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+
+#include "../../include/arayeh_typed.h"
+#include "unity.h"
+
+#include <stdio.h>
+#include <string.h>
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+// asserts that "string" holds the NUL terminated "expected".
+static void assert_string(const char *expected, arayeh_string string)
+{
+    TEST_ASSERT_EQUAL_size_t(strlen(expected), string.length);
+    if (string.length != 0) {
+        TEST_ASSERT_EQUAL_MEMORY(expected, string.bytes, string.length);
+    }
+}
+
+void test_string_elements(void)
+{
+    // Test add, insert, get and search of strings.
+
+    // define default arayeh size.
+    size_t arayeh_size = 4;
+
+    // create new arayeh.
+    arayeh *names = Arayeh(AA_ARAYEH_TYPE_STRING, arayeh_size);
+
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS, arayeh_string_add(names, "azadeh"));
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS, arayeh_string_add(names, "afzar"));
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS, arayeh_string_add(names, ""));
+
+    // bytes may hold NUL and don't need a terminator.
+    arayeh_string binary = {"a\0b", 3};
+    names->insert(names, 6, &binary);
+
+    arayeh_string element;
+    names->get(names, 0, &element);
+    assert_string("azadeh", element);
+    assert_string("afzar", arayeh_string_get(names, 1));
+    assert_string("", arayeh_string_get(names, 2));
+    TEST_ASSERT_EQUAL_size_t(3, arayeh_string_get(names, 6).length);
+    TEST_ASSERT_EQUAL_size_t(4, names->used);
+
+    // bytes of strings are compared, not pointers.
+    char buffer[8] = "afzar";
+    arayeh_string needle = {buffer, 5};
+    size_t index         = 0;
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS, names->find(names, &needle, &index));
+    TEST_ASSERT_EQUAL_size_t(1, index);
+    needle.length = 4;
+    TEST_ASSERT_FALSE(names->contains(names, &needle));
+    needle.length = 0;
+    TEST_ASSERT_EQUAL_size_t(1, names->count(names, &needle));
+
+    // a string of arayeh shares its bytes.
+    size_t bytes = names->_private_properties.arena.used;
+    element      = arayeh_string_get(names, 0);
+    names->insert(names, 3, &element);
+    TEST_ASSERT_EQUAL_size_t(bytes, names->_private_properties.arena.used);
+    assert_string("azadeh", arayeh_string_get(names, 3));
+
+    // C arrays hold elements, shifting inserts convert them into cells.
+    arayeh_string words[2] = {{"x", 1}, {"yz", 2}};
+    names->merge_array(names, 10, 1, 2, words);
+    names->insert_range_shift(names, 0, 2, words);
+    assert_string("yz", arayeh_string_get(names, 1));
+    assert_string("azadeh", arayeh_string_get(names, 2));
+    assert_string("yz", arayeh_string_get(names, 13));
+
+    // copies have their own arena.
+    arayeh *copy = names->duplicate(names);
+    names->free_arayeh(&names);
+    assert_string("afzar", arayeh_string_get(copy, 3));
+    assert_string("x", arayeh_string_get(copy, 12));
+
+    // string arayehs have no numeric conversion.
+    TEST_ASSERT_NULL(copy->convert_to(copy, AA_ARAYEH_TYPE_INT, 0));
+
+    // free arayeh.
+    copy->free_arayeh(&copy);
+}
+
+void test_string_bulk(void)
+{
+    // Test appending strings in bulk and compacting the arena.
+
+    // define default arayeh size.
+    size_t arayeh_size = 10;
+
+    // create new arayeh.
+    arayeh *numbers = Arayeh(AA_ARAYEH_TYPE_STRING, arayeh_size);
+
+    // 1000 numbers in one buffer.
+    char bytes[4000];
+    size_t offsets[1001];
+    offsets[0] = 0;
+    for (int number = 0; number < 1000; number++) {
+        int written         = sprintf(bytes + offsets[number], "%d", number);
+        offsets[number + 1] = offsets[number] + (size_t) written;
+    }
+
+    numbers->add(numbers, &(arayeh_string){"first", 5});
+    int state = numbers->add_strings(numbers, bytes, offsets, 1000);
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS, state);
+    TEST_ASSERT_EQUAL_size_t(1001, numbers->used);
+    TEST_ASSERT_EQUAL_size_t(1001, numbers->next);
+    assert_string("0", arayeh_string_get(numbers, 1));
+    assert_string("999", arayeh_string_get(numbers, 1000));
+
+    // decreasing offsets are refused.
+    size_t wrong[3] = {0, 2, 1};
+    state           = numbers->add_strings(numbers, bytes, wrong, 2);
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_WRONG_INDEX, state);
+
+    // deleted and overwritten strings keep their bytes until compaction.
+    size_t bytes_used = numbers->_private_properties.arena.used;
+    numbers->delete_slice(numbers, 101, 1, 1001, AA_ARAYEH_OFF);
+    numbers->insert(numbers, 0, &(arayeh_string){"zero", 4});
+    TEST_ASSERT_EQUAL_size_t(bytes_used + 4, numbers->_private_properties.arena.used);
+
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS, numbers->compact_arena(numbers));
+    TEST_ASSERT_EQUAL_size_t(4 + 10 + 90 * 2, numbers->_private_properties.arena.used);
+    TEST_ASSERT_EQUAL_size_t(4 + 10 + 90 * 2, numbers->_private_properties.arena.size);
+    assert_string("zero", arayeh_string_get(numbers, 0));
+    assert_string("99", arayeh_string_get(numbers, 100));
+
+    // the view hands out cells and their arena.
+    arayeh_view view;
+    numbers->view(numbers, &view);
+    arayeh_string_cell cell = view.array.string_pointer[100];
+    TEST_ASSERT_EQUAL_MEMORY("99", view.arena + cell.offset, 2);
+
+    // other types have no arena.
+    arayeh *ints = Arayeh(AA_ARAYEH_TYPE_INT, arayeh_size);
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_WRONG_TYPE, ints->compact_arena(ints));
+    state = ints->add_strings(ints, bytes, offsets, 1);
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_WRONG_TYPE, state);
+
+    // free arayehs.
+    numbers->free_arayeh(&numbers);
+    ints->free_arayeh(&ints);
+}
+
+void test_string_compact_shared(void)
+{
+    // Test that compaction copies bytes shared by cells once.
+
+    // define arayeh size.
+    size_t arayeh_size = 10;
+
+    // create new arayeh.
+    arayeh *names = Arayeh(AA_ARAYEH_TYPE_STRING, arayeh_size);
+
+    const char *strings[5] = {"azadeh", "afzar", "arayeh", "saz", "aa"};
+    for (size_t index = 0; index < 5; index++) {
+        arayeh_string_add(names, strings[index]);
+    }
+    TEST_ASSERT_EQUAL_size_t(22, names->_private_properties.arena.used);
+
+    // cells sharing a string and a part of it.
+    for (size_t index = 0; index < 3; index++) {
+        arayeh_string element = arayeh_string_get(names, 0);
+        names->add(names, &element);
+    }
+    arayeh_string part = arayeh_string_get(names, 2);
+    part.bytes += 1;
+    part.length = 3;
+    names->add(names, &part);
+    TEST_ASSERT_EQUAL_size_t(22, names->_private_properties.arena.used);
+
+    // drop "afzar", the rest is kept and still shared.
+    names->delete_item(names, 1, AA_ARAYEH_OFF);
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS, names->compact_arena(names));
+    TEST_ASSERT_EQUAL_size_t(17, names->_private_properties.arena.used);
+    TEST_ASSERT_EQUAL_size_t(17, names->_private_properties.arena.size);
+
+    const char *expected[9] = {"azadeh", NULL,     "arayeh", "saz", "aa",
+                               "azadeh", "azadeh", "azadeh", "ray"};
+    for (size_t index = 0; index < 9; index++) {
+        if (expected[index] != NULL) {
+            assert_string(expected[index], arayeh_string_get(names, index));
+        }
+    }
+    arayeh_string_cell *cells = names->_private_properties.array.string_pointer;
+    TEST_ASSERT_EQUAL_size_t(cells[0].offset, cells[7].offset);
+    TEST_ASSERT_EQUAL_size_t(cells[2].offset + 1, cells[8].offset);
+
+    // compacting again keeps the same bytes.
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS, names->compact_arena(names));
+    TEST_ASSERT_EQUAL_size_t(17, names->_private_properties.arena.used);
+    assert_string("ray", arayeh_string_get(names, 8));
+
+    // free arayeh.
+    names->free_arayeh(&names);
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_string_elements);
+    RUN_TEST(test_string_bulk);
+    RUN_TEST(test_string_compact_shared);
+    return UNITY_END();
+}
@@ -0,0 +1,263 @@
+/** test/unit tests/unitTest_033_Text.c
+ *
+ * This file is a part of:
+ * Azadeh Afzar - Arayehsaz (AA-A).
+ *
+ * Copyright (C) 2020 - 2021 Azadeh Afzar.
+ * Copyright (C) 2020 - 2021 Mohammad Mahdi Baghbani Pourvahid.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgement in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+
+#include "../../include/arayeh_typed.h"
+#include "unity.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+// returns the first position of "needle" in "text" from "start" by brute force.
+static size_t naive_find(const char *text, size_t length, size_t start,
+                         const char *needle, size_t needle_length)
+{
+    for (size_t position = start; position + needle_length <= length; position++) {
+        if (memcmp(text + position, needle, needle_length) == 0) {
+            return position;
+        }
+    }
+    return SIZE_MAX;
+}
+
+void test_text_builder(void)
+{
+    // Test appending bytes and exporting the text.
+
+    // define default arayeh size.
+    size_t arayeh_size = 4;
+
+    // create new arayeh.
+    arayeh *text = Arayeh(AA_ARAYEH_TYPE_CHAR, arayeh_size);
+
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS, arayeh_text_append(text, "azadeh"));
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS, text->append_bytes(text, " afzar!", 6));
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS, text->append_bytes(text, NULL, 0));
+
+    size_t length;
+    TEST_ASSERT_EQUAL_STRING("azadeh afzar", text->c_string(text, &length));
+    TEST_ASSERT_EQUAL_size_t(12, length);
+    TEST_ASSERT_EQUAL_size_t(12, text->used);
+
+    // appended cells are ordinary elements.
+    char letter;
+    text->get(text, 7, &letter);
+    TEST_ASSERT_EQUAL_CHAR('a', letter);
+
+    // bytes of arayeh itself survive the reallocation of arayeh.
+    text->resize_memory(text, 12);
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS,
+                          text->append_bytes(text, text->c_string(text, NULL), 6));
+    TEST_ASSERT_EQUAL_STRING("azadeh afzarazadeh", text->c_string(text, NULL));
+
+    // a full arayeh grows by the terminator.
+    text->resize_memory(text, 18);
+    TEST_ASSERT_EQUAL_STRING("azadeh afzarazadeh", text->c_string(text, NULL));
+    TEST_ASSERT_TRUE(text->size > 18);
+    TEST_ASSERT_EQUAL_size_t(18, text->used);
+
+    // append starts after the last filled cell.
+    letter = '.';
+    text->insert(text, 20, &letter);
+    arayeh_text_append(text, "x");
+    TEST_ASSERT_NULL(text->c_string(text, NULL));
+    text->compact(text);
+    TEST_ASSERT_EQUAL_STRING("azadeh afzarazadeh.x", text->c_string(text, NULL));
+
+    // full arayeh that can't grow.
+    arayeh_settings settings = {.debug_messages = AA_ARAYEH_OFF,
+                                .extend_size    = AA_ARAYEH_OFF};
+    arayeh *fixed            = Arayeh(AA_ARAYEH_TYPE_CHAR, 3);
+    fixed->set_settings(fixed, &settings);
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_NOT_ENOUGH_SPACE, arayeh_text_append(fixed, "abcd"));
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS, arayeh_text_append(fixed, "abc"));
+    TEST_ASSERT_NULL(fixed->c_string(fixed, NULL));
+
+    // text methods need char arayehs.
+    arayeh *numbers = Arayeh(AA_ARAYEH_TYPE_INT, arayeh_size);
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_WRONG_TYPE, numbers->append_bytes(numbers, "ab", 2));
+    TEST_ASSERT_NULL(numbers->c_string(numbers, NULL));
+    TEST_ASSERT_EQUAL_size_t(0, numbers->split(numbers, ',', NULL, 0));
+
+    text->free_arayeh(&text);
+    fixed->free_arayeh(&fixed);
+    numbers->free_arayeh(&numbers);
+}
+
+void test_text_find(void)
+{
+    // Test searching bytes in a char arayeh against brute force search.
+
+    // create new arayeh.
+    arayeh *text = Arayeh(AA_ARAYEH_TYPE_CHAR, 16);
+
+    // a small alphabet makes a lot of partial matches.
+    char bytes[1000];
+    srand(33);
+    for (size_t index = 0; index < sizeof bytes; index++) {
+        bytes[index] = (char) ('a' + rand() % 3);
+    }
+    text->append_bytes(text, bytes, sizeof bytes);
+
+    size_t index;
+    for (size_t needle_length = 1; needle_length <= 40; needle_length++) {
+        for (size_t trial = 0; trial < 20; trial++) {
+            size_t start = (size_t) rand() % sizeof bytes;
+
+            // half of needles are taken from the text.
+            char needle[40];
+            size_t from = (size_t) rand() % (sizeof bytes - needle_length);
+            memcpy(needle, bytes + from, needle_length);
+            if (trial % 2 == 1) {
+                needle[needle_length / 2] = 'd';
+            }
+
+            size_t expected = naive_find(bytes, 1000, start, needle, needle_length);
+            int state = text->find_bytes(text, start, needle, needle_length, &index);
+
+            if (expected == SIZE_MAX) {
+                TEST_ASSERT_EQUAL_INT(AA_ARAYEH_NOT_FOUND, state);
+            } else {
+                TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS, state);
+                TEST_ASSERT_EQUAL_size_t(expected, index);
+            }
+        }
+    }
+
+    // edge cases.
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS, text->find_bytes(text, 7, "", 0, &index));
+    TEST_ASSERT_EQUAL_size_t(7, index);
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS,
+                          text->find_bytes(text, 0, bytes, 1000, &index));
+    TEST_ASSERT_EQUAL_size_t(0, index);
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_NOT_FOUND,
+                          text->find_bytes(text, 1, bytes, 1000, &index));
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_NOT_FOUND,
+                          text->find_bytes(text, 2000, "a", 1, &index));
+
+    // the last bytes of the text.
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS,
+                          text->find_bytes(text, 990, bytes + 995, 5, &index));
+    TEST_ASSERT_EQUAL_size_t(naive_find(bytes, 1000, 990, bytes + 995, 5), index);
+
+    // text with empty cells can't be searched.
+    text->delete_item(text, 10, AA_ARAYEH_OFF);
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_WRONG_INDEX,
+                          text->find_bytes(text, 0, "a", 1, &index));
+
+    text->free_arayeh(&text);
+}
+
+void test_text_split(void)
+{
+    // Test splitting the text of a char arayeh on a delimiter.
+
+    // create new arayeh.
+    arayeh *text = Arayeh(AA_ARAYEH_TYPE_CHAR, 16);
+
+    // an empty text is one empty field.
+    arayeh_range ranges[64];
+    TEST_ASSERT_EQUAL_size_t(1, text->split(text, ',', ranges, 64));
+    TEST_ASSERT_EQUAL_size_t(0, ranges[0].start);
+    TEST_ASSERT_EQUAL_size_t(0, ranges[0].end);
+
+    arayeh_text_append(text, "azadeh,,afzar,");
+    TEST_ASSERT_EQUAL_size_t(4, text->split(text, ',', ranges, 64));
+    TEST_ASSERT_EQUAL_size_t(0, ranges[0].start);
+    TEST_ASSERT_EQUAL_size_t(6, ranges[0].end);
+    TEST_ASSERT_EQUAL_size_t(7, ranges[1].start);
+    TEST_ASSERT_EQUAL_size_t(7, ranges[1].end);
+    TEST_ASSERT_EQUAL_size_t(8, ranges[2].start);
+    TEST_ASSERT_EQUAL_size_t(13, ranges[2].end);
+    TEST_ASSERT_EQUAL_size_t(14, ranges[3].start);
+    TEST_ASSERT_EQUAL_size_t(14, ranges[3].end);
+
+    // fields that don't fit are counted only.
+    ranges[1].start = 99;
+    TEST_ASSERT_EQUAL_size_t(4, text->split(text, ',', ranges, 1));
+    TEST_ASSERT_EQUAL_size_t(99, ranges[1].start);
+    TEST_ASSERT_EQUAL_size_t(4, text->split(text, ',', NULL, 0));
+
+    // long text, every field is rebuilt from its range.
+    text->delete_slice(text, 0, 1, text->size, AA_ARAYEH_ON);
+    char line[200];
+    for (size_t index = 0; index < sizeof line; index++) {
+        int is_delimiter = (index % 7 == 0 || index % 11 == 0);
+        line[index]      = is_delimiter ? ';' : (char) ('a' + index % 26);
+    }
+    text->append_bytes(text, line, sizeof line);
+
+    size_t fields = text->split(text, ';', ranges, 64);
+    TEST_ASSERT_TRUE(fields <= 64);
+
+    size_t expected_fields = 1;
+    for (size_t index = 0; index < sizeof line; index++) {
+        expected_fields += (line[index] == ';');
+    }
+    TEST_ASSERT_EQUAL_size_t(expected_fields, fields);
+
+    size_t position = 0;
+    for (size_t field = 0; field < fields; field++) {
+        TEST_ASSERT_EQUAL_size_t(position, ranges[field].start);
+        TEST_ASSERT_NULL(memchr(line + ranges[field].start, ';',
+                                ranges[field].end - ranges[field].start));
+        position = ranges[field].end + 1;
+        if (field + 1 < fields) {
+            TEST_ASSERT_EQUAL_CHAR(';', line[ranges[field].end]);
+        }
+    }
+    TEST_ASSERT_EQUAL_size_t(sizeof line, ranges[fields - 1].end);
+
+    text->free_arayeh(&text);
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_text_builder);
+    RUN_TEST(test_text_find);
+    RUN_TEST(test_text_split);
+    return UNITY_END();
+}
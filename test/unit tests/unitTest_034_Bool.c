@@ -0,0 +1,380 @@
+/** test/unit tests/unitTest_034_Bool.c
+ *
+ * This file is a part of:
+ * Azadeh Afzar - Arayehsaz (AA-A).
+ *
+ * Copyright (C) 2020 - 2021 Azadeh Afzar.
+ * Copyright (C) 2020 - 2021 Mohammad Mahdi Baghbani Pourvahid.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgement in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+
+#include "../../include/arayeh.h"
+#include "unity.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+// returns the element at "index" of boolean arayeh.
+static char get_bool(arayeh *flags, size_t index)
+{
+    char value = 2;
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS, flags->get(flags, index, &value));
+    return value;
+}
+
+// fills a boolean arayeh with a pseudo random pattern and returns its popcount.
+static size_t fill_pattern(arayeh *flags, size_t size, unsigned seed)
+{
+    size_t ones = 0;
+    for (size_t index = 0; index < size; index++) {
+        seed       = seed * 1103515245u + 12345u;
+        char value = (char) ((seed >> 16) & 1u);
+        flags->insert(flags, index, &value);
+        ones += (size_t) value;
+    }
+    return ones;
+}
+
+void test_bool_add_and_get(void)
+{
+    // Test add, get and find on packed cells.
+
+    // define default arayeh size.
+    size_t arayeh_size = 150;
+
+    // create new arayeh.
+    arayeh *flags = Arayeh(AA_ARAYEH_TYPE_BOOL, arayeh_size);
+
+    TEST_ASSERT_EQUAL_size_t(AA_ARAYEH_TYPE_BOOL, flags->_private_properties.type);
+    TEST_ASSERT_EQUAL_size_t(AA_ARAYEH_STORAGE_BIT,
+                             flags->_private_properties.storage_type);
+
+    // every third cell is true, any non zero value is stored as true.
+    for (size_t index = 0; index < arayeh_size; index++) {
+        char value = (index % 3 == 0) ? 5 : 0;
+        TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS, flags->add(flags, &value));
+    }
+
+    for (size_t index = 0; index < arayeh_size; index++) {
+        TEST_ASSERT_EQUAL_CHAR(index % 3 == 0, get_bool(flags, index));
+    }
+
+    char true_value  = 1;
+    char false_value = 0;
+    size_t index     = 0;
+    TEST_ASSERT_EQUAL_size_t(50, flags->count(flags, &true_value));
+    TEST_ASSERT_EQUAL_size_t(100, flags->count(flags, &false_value));
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS, flags->find(flags, &false_value, &index));
+    TEST_ASSERT_EQUAL_size_t(1, index);
+    TEST_ASSERT_EQUAL_size_t(50, flags->popcount(flags));
+
+    // find searches filled cells only.
+    arayeh *empty = Arayeh(AA_ARAYEH_TYPE_BOOL, 70);
+    empty->insert(empty, 66, &false_value);
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS, empty->find(empty, &false_value, &index));
+    TEST_ASSERT_EQUAL_size_t(66, index);
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_NOT_FOUND, empty->find(empty, &true_value, &index));
+
+    empty->free_arayeh(&empty);
+    flags->free_arayeh(&flags);
+}
+
+void test_bool_fill_and_popcount(void)
+{
+    // Test word level fill across word boundaries.
+
+    // define default arayeh size.
+    size_t arayeh_size = 300;
+
+    // create new arayeh.
+    arayeh *flags = Arayeh(AA_ARAYEH_TYPE_BOOL, arayeh_size);
+
+    char true_value  = 1;
+    char false_value = 0;
+
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS,
+                          flags->fill(flags, 0, 1, arayeh_size, &false_value));
+    TEST_ASSERT_EQUAL_size_t(0, flags->popcount(flags));
+
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS, flags->fill(flags, 5, 1, 203, &true_value));
+    TEST_ASSERT_EQUAL_size_t(198, flags->popcount(flags));
+    TEST_ASSERT_EQUAL_size_t(arayeh_size, flags->used);
+
+    for (size_t index = 0; index < arayeh_size; index++) {
+        TEST_ASSERT_EQUAL_CHAR(index >= 5 && index < 203, get_bool(flags, index));
+    }
+
+    // stepped fill goes cell by cell.
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS,
+                          flags->fill(flags, 0, 2, arayeh_size, &true_value));
+    size_t expected = 0;
+    for (size_t index = 0; index < arayeh_size; index++) {
+        expected += (index % 2 == 0) || (index >= 5 && index < 203);
+    }
+    TEST_ASSERT_EQUAL_size_t(expected, flags->popcount(flags));
+
+    // empty cells are not counted.
+    flags->delete_item(flags, 10, AA_ARAYEH_OFF);
+    TEST_ASSERT_EQUAL_size_t(expected - 1, flags->popcount(flags));
+
+    // popcount is only for boolean arayehs.
+    arayeh *numbers = Arayeh(AA_ARAYEH_TYPE_INT, 4);
+    TEST_ASSERT_EQUAL_size_t(0, numbers->popcount(numbers));
+
+    numbers->free_arayeh(&numbers);
+    flags->free_arayeh(&flags);
+}
+
+void test_bool_bitwise(void)
+{
+    // Test and, or, xor and not against cell by cell results.
+
+    // define default arayeh size.
+    size_t arayeh_size = 333;
+
+    int operations[] = {AA_ARAYEH_AND, AA_ARAYEH_OR, AA_ARAYEH_XOR, AA_ARAYEH_NOT};
+
+    for (size_t test = 0; test < sizeof operations / sizeof operations[0]; test++) {
+        int operation = operations[test];
+
+        // create new arayehs, "other" is shorter and has empty cells.
+        arayeh *flags = Arayeh(AA_ARAYEH_TYPE_BOOL, arayeh_size);
+        arayeh *other = Arayeh(AA_ARAYEH_TYPE_BOOL, 200);
+        fill_pattern(flags, arayeh_size, 7);
+        fill_pattern(other, 200, 11);
+        other->delete_item(other, 70, AA_ARAYEH_OFF);
+        flags->delete_item(flags, 100, AA_ARAYEH_OFF);
+
+        char before[333];
+        char operand[333];
+        for (size_t index = 0; index < arayeh_size; index++) {
+            before[index]  = (index == 100) ? 0 : get_bool(flags, index);
+            operand[index] = 0;
+            if (index < 200 && index != 70) {
+                operand[index] = get_bool(other, index);
+            }
+        }
+
+        TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS, flags->bitwise(flags, operation, other));
+
+        for (size_t index = 0; index < arayeh_size; index++) {
+            char expected = before[index];
+            switch (operation) {
+                case AA_ARAYEH_AND: expected = before[index] & operand[index]; break;
+                case AA_ARAYEH_OR: expected = before[index] | operand[index]; break;
+                case AA_ARAYEH_XOR: expected = before[index] ^ operand[index]; break;
+                default: expected = !before[index]; break;
+            }
+
+            // empty cells stay empty.
+            if (index == 100) {
+                TEST_ASSERT_EQUAL_CHAR(AA_ARAYEH_OFF,
+                                       flags->_private_properties.map[index]);
+                continue;
+            }
+            TEST_ASSERT_EQUAL_CHAR(expected, get_bool(flags, index));
+        }
+
+        other->free_arayeh(&other);
+        flags->free_arayeh(&flags);
+    }
+
+    arayeh *flags   = Arayeh(AA_ARAYEH_TYPE_BOOL, 4);
+    arayeh *numbers = Arayeh(AA_ARAYEH_TYPE_CHAR, 4);
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_WRONG_TYPE,
+                          flags->bitwise(flags, AA_ARAYEH_OR, numbers));
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_FAILURE, flags->bitwise(flags, 42, flags));
+
+    numbers->free_arayeh(&numbers);
+    flags->free_arayeh(&flags);
+}
+
+void test_bool_shift_and_compact(void)
+{
+    // Test methods that move packed cells.
+
+    // define default arayeh size.
+    size_t arayeh_size = 200;
+
+    // create new arayeh.
+    arayeh *flags = Arayeh(AA_ARAYEH_TYPE_BOOL, arayeh_size + 1);
+    fill_pattern(flags, arayeh_size, 3);
+
+    char expected[201];
+    for (size_t index = 0; index < arayeh_size; index++) {
+        expected[index] = get_bool(flags, index);
+    }
+
+    // delete with shift moves cells to the left.
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS,
+                          flags->delete_item(flags, 3, AA_ARAYEH_ON));
+    memmove(expected + 3, expected + 4, arayeh_size - 4);
+    for (size_t index = 0; index + 1 < arayeh_size; index++) {
+        TEST_ASSERT_EQUAL_CHAR(expected[index], get_bool(flags, index));
+    }
+
+    // insert with shift moves them back.
+    char true_value = 1;
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS, flags->insert_shift(flags, 3, &true_value));
+    memmove(expected + 4, expected + 3, arayeh_size - 4);
+    expected[3] = 1;
+    for (size_t index = 0; index < arayeh_size; index++) {
+        TEST_ASSERT_EQUAL_CHAR(expected[index], get_bool(flags, index));
+    }
+
+    // compact moves filled cells to the start.
+    for (size_t index = 0; index < arayeh_size; index += 7) {
+        flags->delete_item(flags, index, AA_ARAYEH_OFF);
+    }
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS, flags->compact(flags));
+    size_t position = 0;
+    for (size_t index = 0; index < arayeh_size; index++) {
+        if (index % 7 != 0) {
+            TEST_ASSERT_EQUAL_CHAR(expected[index], get_bool(flags, position++));
+        }
+    }
+    TEST_ASSERT_EQUAL_size_t(position, flags->used);
+
+    flags->free_arayeh(&flags);
+}
+
+void test_bool_unpack_and_pack(void)
+{
+    // Test unpacking for raw memory methods and packing again.
+
+    // define default arayeh size.
+    size_t arayeh_size = 130;
+
+    // create new arayeh.
+    arayeh *flags = Arayeh(AA_ARAYEH_TYPE_BOOL, arayeh_size);
+    size_t ones   = fill_pattern(flags, arayeh_size, 5);
+
+    // duplicate keeps the cells.
+    arayeh *copy = flags->duplicate(flags);
+    TEST_ASSERT_NOT_NULL(copy);
+    TEST_ASSERT_EQUAL_size_t(ones, copy->popcount(copy));
+
+    // view exposes one char per cell.
+    arayeh_view view;
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS, flags->view(flags, &view));
+    TEST_ASSERT_EQUAL_size_t(AA_ARAYEH_TYPE_BOOL,
+                             flags->_private_properties.storage_type);
+    for (size_t index = 0; index < arayeh_size; index++) {
+        TEST_ASSERT_EQUAL_CHAR(get_bool(copy, index), view.array.char_pointer[index]);
+    }
+
+    // narrow packs the cells again.
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS, flags->narrow(flags));
+    TEST_ASSERT_EQUAL_size_t(AA_ARAYEH_STORAGE_BIT,
+                             flags->_private_properties.storage_type);
+    for (size_t index = 0; index < arayeh_size; index++) {
+        TEST_ASSERT_EQUAL_CHAR(get_bool(copy, index), get_bool(flags, index));
+    }
+
+    // packed cells grow like any other arayeh.
+    char false_value = 0;
+    for (size_t index = 0; index < 100; index++) {
+        TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS, flags->add(flags, &false_value));
+    }
+    TEST_ASSERT_EQUAL_size_t(ones, flags->popcount(flags));
+
+    copy->free_arayeh(&copy);
+    flags->free_arayeh(&flags);
+}
+
+void test_bool_copies_stay_packed(void)
+{
+    // Test that methods copying cells read the bits without unpacking them.
+
+    // define default arayeh size.
+    size_t arayeh_size = 150;
+
+    // create new arayeh, the last cell is empty.
+    arayeh *flags = Arayeh(AA_ARAYEH_TYPE_BOOL, arayeh_size);
+    size_t ones   = fill_pattern(flags, arayeh_size - 1, 7);
+
+    char range[90];
+    char fill = 2;
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS,
+                          flags->get_range(flags, 60, 90, range, &fill));
+    for (size_t index = 0; index < 89; index++) {
+        TEST_ASSERT_EQUAL_CHAR(get_bool(flags, 60 + index), range[index]);
+    }
+    TEST_ASSERT_EQUAL_CHAR(2, range[89]);
+
+    size_t indices[3] = {149, 3, 127};
+    char picked[3];
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS,
+                          flags->get_indices(flags, indices, 3, picked, &fill));
+    TEST_ASSERT_EQUAL_CHAR(2, picked[0]);
+    TEST_ASSERT_EQUAL_CHAR(get_bool(flags, 3), picked[1]);
+    TEST_ASSERT_EQUAL_CHAR(get_bool(flags, 127), picked[2]);
+
+    char packed[150];
+    size_t sum = 0;
+    TEST_ASSERT_EQUAL_size_t(arayeh_size - 1, flags->pack(flags, packed, NULL));
+    for (size_t index = 0; index < arayeh_size - 1; index++) {
+        sum += (size_t) packed[index];
+    }
+    TEST_ASSERT_EQUAL_size_t(ones, sum);
+
+    arayeh *copy = Arayeh(AA_ARAYEH_TYPE_BOOL, arayeh_size);
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS, copy->merge_arayeh(copy, 0, 1, flags));
+    TEST_ASSERT_EQUAL_size_t(ones, copy->popcount(copy));
+
+    TEST_ASSERT_EQUAL_size_t(AA_ARAYEH_STORAGE_BIT,
+                             flags->_private_properties.storage_type);
+    TEST_ASSERT_EQUAL_size_t(AA_ARAYEH_STORAGE_BIT,
+                             copy->_private_properties.storage_type);
+
+    copy->free_arayeh(&copy);
+    flags->free_arayeh(&flags);
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_bool_add_and_get);
+    RUN_TEST(test_bool_fill_and_popcount);
+    RUN_TEST(test_bool_bitwise);
+    RUN_TEST(test_bool_shift_and_compact);
+    RUN_TEST(test_bool_unpack_and_pack);
+    RUN_TEST(test_bool_copies_stay_packed);
+    return UNITY_END();
+}
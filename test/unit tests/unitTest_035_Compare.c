@@ -0,0 +1,297 @@
+/** test/unit tests/unitTest_035_Compare.c
+ *
+ * This file is a part of:
+ * Azadeh Afzar - Arayehsaz (AA-A).
+ *
+ * Copyright (C) 2020 - 2021 Azadeh Afzar.
+ * Copyright (C) 2020 - 2021 Mohammad Mahdi Baghbani Pourvahid.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgement in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+
+#include "../../include/arayeh_typed.h"
+#include "unity.h"
+
+#include <math.h>
+#include <stdlib.h>
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+// returns the result of "operation" on "cell" by plain comparisons.
+static int naive_compare(double cell, int operation, double value, double upper)
+{
+    switch (operation) {
+    case AA_ARAYEH_LESS:
+        return cell < value;
+    case AA_ARAYEH_LESS_EQUAL:
+        return cell <= value;
+    case AA_ARAYEH_EQUAL:
+        return cell == value;
+    case AA_ARAYEH_GREATER_EQUAL:
+        return cell >= value;
+    case AA_ARAYEH_GREATER:
+        return cell > value;
+    default:
+        return cell >= value && cell <= upper;
+    }
+}
+
+void test_compare_int(void)
+{
+    // Test every operation on int cells against plain comparisons.
+
+    // define default arayeh size.
+    size_t arayeh_size = 333;
+
+    // create new arayeh, every 10th cell is empty.
+    arayeh *numbers = Arayeh(AA_ARAYEH_TYPE_INT, arayeh_size);
+    int values[333];
+    for (size_t index = 0; index < arayeh_size; index++) {
+        values[index] = (int) ((index * 37) % 101) - 50;
+        if (index % 10 != 3) {
+            numbers->insert(numbers, index, &values[index]);
+        }
+    }
+
+    int value = -7;
+    int upper = 20;
+    uint64_t bitmap[AA_ARAYEH_MASK_SIZE(333)];
+
+    for (int operation = AA_ARAYEH_LESS; operation <= AA_ARAYEH_BETWEEN; operation++) {
+        size_t count = numbers->compare(numbers, operation, &value, &upper, bitmap);
+
+        size_t expected = 0;
+        for (size_t index = 0; index < arayeh_size; index++) {
+            int hit = index % 10 != 3 &&
+                      naive_compare(values[index], operation, value, upper);
+            expected += (size_t) hit;
+            TEST_ASSERT_EQUAL_INT(hit, (int) ((bitmap[index / 64] >> (index % 64)) & 1));
+        }
+        TEST_ASSERT_EQUAL_size_t(expected, count);
+        count = numbers->compare(numbers, operation, &value, &upper, NULL);
+        TEST_ASSERT_EQUAL_size_t(expected, count);
+    }
+
+    numbers->free_arayeh(&numbers);
+}
+
+void test_compare_other_types(void)
+{
+    // Test comparisons of unsigned, real and half precision cells.
+
+    // define default arayeh size.
+    size_t arayeh_size = 100;
+
+    // unsigned cells above the signed range.
+    arayeh *big = Arayeh(AA_ARAYEH_TYPE_UINT64, arayeh_size);
+    for (size_t index = 0; index < arayeh_size; index++) {
+        uint64_t cell = UINT64_MAX - index;
+        big->add(big, &cell);
+    }
+    uint64_t limit = UINT64_MAX - 9;
+    TEST_ASSERT_EQUAL_size_t(10, big->compare(big, AA_ARAYEH_GREATER_EQUAL, &limit,
+                                              NULL, NULL));
+
+    // NaN never satisfies a comparison.
+    arayeh *reals = Arayeh(AA_ARAYEH_TYPE_DOUBLE, arayeh_size);
+    for (size_t index = 0; index < arayeh_size; index++) {
+        double cell = (index % 4 == 0) ? NAN : (double) index / 10.0;
+        reals->add(reals, &cell);
+    }
+    double low  = 2.5;
+    double high = 5.0;
+    size_t expected = 0;
+    for (size_t index = 0; index < arayeh_size; index++) {
+        double cell = (double) index / 10.0;
+        expected += index % 4 != 0 && cell >= low && cell <= high;
+    }
+    TEST_ASSERT_EQUAL_size_t(expected, reals->compare(reals, AA_ARAYEH_BETWEEN, &low,
+                                                      &high, NULL));
+
+    // half precision cells are compared as floats.
+    arayeh *halves = Arayeh(AA_ARAYEH_TYPE_FLOAT16, arayeh_size);
+    for (size_t index = 0; index < arayeh_size; index++) {
+        float cell = (float) index - 50.0f;
+        halves->add(halves, &cell);
+    }
+    float zero = 0.0f;
+    TEST_ASSERT_EQUAL_size_t(50, halves->compare(halves, AA_ARAYEH_LESS, &zero, NULL,
+                                                 NULL));
+    TEST_ASSERT_EQUAL_size_t(1, halves->compare(halves, AA_ARAYEH_EQUAL, &zero, NULL,
+                                                NULL));
+
+    // narrowed cells are compared after widening.
+    arayeh *narrow = Arayeh(AA_ARAYEH_TYPE_INT64, arayeh_size);
+    for (size_t index = 0; index < arayeh_size; index++) {
+        int64_t cell = (int64_t) index;
+        narrow->add(narrow, &cell);
+    }
+    narrow->narrow(narrow);
+    int64_t threshold = 90;
+    TEST_ASSERT_EQUAL_size_t(10, narrow->compare(narrow, AA_ARAYEH_GREATER_EQUAL,
+                                                 &threshold, NULL, NULL));
+
+    big->free_arayeh(&big);
+    reals->free_arayeh(&reals);
+    halves->free_arayeh(&halves);
+    narrow->free_arayeh(&narrow);
+}
+
+void test_compare_errors(void)
+{
+    // Test wrong types and operations.
+
+    arayeh *numbers = Arayeh(AA_ARAYEH_TYPE_INT, 8);
+    arayeh *flags   = Arayeh(AA_ARAYEH_TYPE_BOOL, 8);
+    int value       = 1;
+    char flag       = 1;
+
+    numbers->add(numbers, &value);
+    flags->add(flags, &flag);
+
+    TEST_ASSERT_EQUAL_size_t(0, numbers->compare(numbers, 42, &value, NULL, NULL));
+    TEST_ASSERT_EQUAL_size_t(0, numbers->compare(numbers, AA_ARAYEH_BETWEEN, &value,
+                                                 NULL, NULL));
+    TEST_ASSERT_EQUAL_size_t(0, flags->compare(flags, AA_ARAYEH_EQUAL, &flag, NULL,
+                                               NULL));
+
+    numbers->free_arayeh(&numbers);
+    flags->free_arayeh(&flags);
+}
+
+void test_select(void)
+{
+    // Test selecting the cells marked by compare method.
+
+    // define default arayeh size.
+    size_t arayeh_size = 200;
+
+    // create new arayeh, every 7th cell is empty.
+    arayeh *numbers = Arayeh(AA_ARAYEH_TYPE_DOUBLE, arayeh_size);
+
+    // define new settings.
+    arayeh_settings new_settings = {.debug_messages = AA_ARAYEH_OFF,
+                                    .extend_size    = AA_ARAYEH_ON,
+                                    .hash_index     = AA_ARAYEH_ON};
+    arayeh_size_settings new_size_settings = {.extend_add          = AA_ARAYEH_ON,
+                                              .extend_insert       = AA_ARAYEH_OFF,
+                                              .extend_fill         = AA_ARAYEH_OFF,
+                                              .extend_merge_arayeh = AA_ARAYEH_ON,
+                                              .extend_merge_array  = AA_ARAYEH_OFF};
+
+    // set new settings.
+    numbers->set_settings(numbers, &new_settings);
+    numbers->set_size_settings(numbers, &new_size_settings);
+    for (size_t index = 0; index < arayeh_size; index++) {
+        double cell = (double) ((index * 13) % 50);
+        if (index % 7 != 0) {
+            numbers->insert(numbers, index, &cell);
+        }
+    }
+
+    double value = 25.0;
+    uint64_t bitmap[AA_ARAYEH_MASK_SIZE(200)];
+    size_t count = numbers->compare(numbers, AA_ARAYEH_LESS, &value, NULL, bitmap);
+
+    arayeh *selected = numbers->select(numbers, bitmap);
+    TEST_ASSERT_NOT_NULL(selected);
+    TEST_ASSERT_EQUAL_size_t(count, selected->used);
+    TEST_ASSERT_EQUAL_size_t(count, selected->next);
+
+    size_t position = 0;
+    for (size_t index = 0; index < arayeh_size; index++) {
+        double cell = (double) ((index * 13) % 50);
+        if (index % 7 != 0 && cell < value) {
+            double copy;
+            selected->get(selected, position++, &copy);
+            TEST_ASSERT_TRUE(copy == cell);
+        }
+    }
+    TEST_ASSERT_EQUAL_size_t(count, position);
+
+    // selected arayeh has the settings of source.
+    arayeh_settings *settings = selected->_private_properties.settings;
+    TEST_ASSERT_EQUAL_CHAR(AA_ARAYEH_ON, settings->hash_index);
+    TEST_ASSERT_EQUAL_CHAR(AA_ARAYEH_ON, settings->extend_size);
+    TEST_ASSERT_EQUAL_CHAR(AA_ARAYEH_OFF, settings->method_size->extend_insert);
+    TEST_ASSERT_EQUAL_CHAR(AA_ARAYEH_ON, settings->method_size->extend_merge_arayeh);
+
+    // bits of empty cells are ignored.
+    for (size_t word = 0; word < AA_ARAYEH_MASK_SIZE(200); word++) {
+        bitmap[word] = UINT64_MAX;
+    }
+    arayeh *all = numbers->select(numbers, bitmap);
+    TEST_ASSERT_EQUAL_size_t(numbers->used, all->used);
+
+    // selected boolean cells stay packed.
+    arayeh *flags = Arayeh(AA_ARAYEH_TYPE_BOOL, 100);
+    for (size_t index = 0; index < 100; index++) {
+        char flag = (char) (index % 3 == 0);
+        flags->add(flags, &flag);
+        bitmap[index / 64] = (index % 64 == 0) ? 0 : bitmap[index / 64];
+        bitmap[index / 64] |= (uint64_t) (index % 2 == 0) << (index % 64);
+    }
+    arayeh *even = flags->select(flags, bitmap);
+    TEST_ASSERT_EQUAL_size_t(50, even->used);
+    TEST_ASSERT_EQUAL_size_t(AA_ARAYEH_STORAGE_BIT,
+                             even->_private_properties.storage_type);
+    TEST_ASSERT_EQUAL_size_t(17, even->popcount(even));
+
+    // nothing selected gives an empty arayeh.
+    for (size_t word = 0; word < AA_ARAYEH_MASK_SIZE(200); word++) {
+        bitmap[word] = 0;
+    }
+    arayeh *none = numbers->select(numbers, bitmap);
+    TEST_ASSERT_NOT_NULL(none);
+    TEST_ASSERT_EQUAL_size_t(0, none->used);
+
+    none->free_arayeh(&none);
+    even->free_arayeh(&even);
+    flags->free_arayeh(&flags);
+    all->free_arayeh(&all);
+    selected->free_arayeh(&selected);
+    numbers->free_arayeh(&numbers);
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_compare_int);
+    RUN_TEST(test_compare_other_types);
+    RUN_TEST(test_compare_errors);
+    RUN_TEST(test_select);
+    return UNITY_END();
+}
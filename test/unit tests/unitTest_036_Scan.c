@@ -0,0 +1,277 @@
+/** test/unit tests/unitTest_036_Scan.c
+ *
+ * This file is a part of:
+ * Azadeh Afzar - Arayehsaz (AA-A).
+ *
+ * Copyright (C) 2020 - 2021 Azadeh Afzar.
+ * Copyright (C) 2020 - 2021 Mohammad Mahdi Baghbani Pourvahid.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgement in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+
+#include "../../include/arayeh.h"
+#include "unity.h"
+
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_scan_int(void)
+{
+    // Test every operation and mode on int cells with empty cells.
+
+    // define default arayeh size.
+    size_t arayeh_size = 300;
+
+    int values[300];
+    for (size_t index = 0; index < arayeh_size; index++) {
+        values[index] = (int) ((index * 37) % 101) - 50;
+    }
+
+    for (int operation = AA_ARAYEH_SUM; operation <= AA_ARAYEH_MAX; operation++) {
+        for (int mode = AA_ARAYEH_INCLUSIVE; mode <= AA_ARAYEH_EXCLUSIVE; mode++) {
+            // create new arayeh, every 9th cell is empty.
+            arayeh *numbers = Arayeh(AA_ARAYEH_TYPE_INT, arayeh_size);
+            for (size_t index = 0; index < arayeh_size; index++) {
+                if (index % 9 != 4) {
+                    numbers->insert(numbers, index, &values[index]);
+                }
+            }
+
+            int state = numbers->scan(numbers, operation, mode);
+            TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS, state);
+
+            int total = (operation == AA_ARAYEH_SUM)   ? 0
+                        : (operation == AA_ARAYEH_MIN) ? INT32_MAX
+                                                       : INT32_MIN;
+            for (size_t index = 0; index < arayeh_size; index++) {
+                if (index % 9 == 4) {
+                    TEST_ASSERT_EQUAL_CHAR(AA_ARAYEH_OFF,
+                                           numbers->_private_properties.map[index]);
+                    continue;
+                }
+
+                int next = (operation == AA_ARAYEH_SUM)   ? total + values[index]
+                           : (operation == AA_ARAYEH_MIN) ? (values[index] < total
+                                                                 ? values[index]
+                                                                 : total)
+                                                          : (values[index] > total
+                                                                 ? values[index]
+                                                                 : total);
+                int cell;
+                numbers->get(numbers, index, &cell);
+                TEST_ASSERT_EQUAL_INT((mode == AA_ARAYEH_EXCLUSIVE) ? total : next, cell);
+                total = next;
+            }
+
+            numbers->free_arayeh(&numbers);
+        }
+    }
+}
+
+void test_scan_dense_blocks(void)
+{
+    // Test full blocks of 32 and 64 bit sums and float min and max.
+
+    // define default arayeh size.
+    size_t arayeh_size = 1000;
+
+    arayeh *small = Arayeh(AA_ARAYEH_TYPE_INT32, arayeh_size);
+    arayeh *large = Arayeh(AA_ARAYEH_TYPE_INT64, arayeh_size);
+    arayeh *reals = Arayeh(AA_ARAYEH_TYPE_FLOAT, arayeh_size);
+    for (size_t index = 0; index < arayeh_size; index++) {
+        // 32 bit sums wrap around.
+        int32_t small_cell = (int32_t) (index * 7919u) + INT32_MAX / 2;
+        int64_t large_cell = (int64_t) index * 1000003 - 500;
+        float real_cell    = (index % 13 == 5) ? NAN : (float) ((index * 61) % 997);
+        small->add(small, &small_cell);
+        large->add(large, &large_cell);
+        reals->add(reals, &real_cell);
+    }
+
+    arayeh *sums    = small->scan_to(small, AA_ARAYEH_SUM, AA_ARAYEH_INCLUSIVE);
+    arayeh *offsets = large->scan_to(large, AA_ARAYEH_SUM, AA_ARAYEH_EXCLUSIVE);
+    arayeh *minimum = reals->scan_to(reals, AA_ARAYEH_MIN, AA_ARAYEH_INCLUSIVE);
+    arayeh *maximum = reals->scan_to(reals, AA_ARAYEH_MAX, AA_ARAYEH_EXCLUSIVE);
+    TEST_ASSERT_NOT_NULL(sums);
+    TEST_ASSERT_NOT_NULL(offsets);
+    TEST_ASSERT_NOT_NULL(minimum);
+    TEST_ASSERT_NOT_NULL(maximum);
+
+    uint32_t small_total = 0;
+    int64_t large_total  = 0;
+    float low            = INFINITY;
+    float high           = -INFINITY;
+    for (size_t index = 0; index < arayeh_size; index++) {
+        int32_t small_cell, small_sum;
+        int64_t large_cell, large_sum;
+        float real_cell, real_low, real_high;
+
+        small->get(small, index, &small_cell);
+        large->get(large, index, &large_cell);
+        reals->get(reals, index, &real_cell);
+        sums->get(sums, index, &small_sum);
+        offsets->get(offsets, index, &large_sum);
+        minimum->get(minimum, index, &real_low);
+        maximum->get(maximum, index, &real_high);
+
+        small_total += (uint32_t) small_cell;
+        TEST_ASSERT_EQUAL_INT32((int32_t) small_total, small_sum);
+
+        TEST_ASSERT_TRUE(large_total == large_sum);
+        large_total += large_cell;
+
+        low = (real_cell < low) ? real_cell : low;
+        TEST_ASSERT_TRUE(low == real_low);
+
+        TEST_ASSERT_TRUE(high == real_high);
+        high = (real_cell > high) ? real_cell : high;
+    }
+
+    small->free_arayeh(&small);
+    large->free_arayeh(&large);
+    reals->free_arayeh(&reals);
+    sums->free_arayeh(&sums);
+    offsets->free_arayeh(&offsets);
+    minimum->free_arayeh(&minimum);
+    maximum->free_arayeh(&maximum);
+}
+
+void test_scan_parallel(void)
+{
+    // Test that the two pass scan matches the sequential one.
+
+    // define default arayeh size, several parallel blocks.
+    size_t arayeh_size = 300000;
+
+    arayeh *numbers = Arayeh(AA_ARAYEH_TYPE_UINT16, arayeh_size);
+    for (size_t index = 0; index < arayeh_size; index++) {
+        uint16_t cell = (uint16_t) (index % 251);
+        if (index % 1000 != 7) {
+            numbers->insert(numbers, index, &cell);
+        }
+    }
+
+    arayeh_settings settings = *numbers->_private_properties.settings;
+    settings.parallel        = AA_ARAYEH_ON;
+    numbers->set_settings(numbers, &settings);
+
+    arayeh *maximum = numbers->scan_to(numbers, AA_ARAYEH_MAX, AA_ARAYEH_INCLUSIVE);
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS,
+                          numbers->scan(numbers, AA_ARAYEH_SUM, AA_ARAYEH_EXCLUSIVE));
+
+    uint16_t total = 0;
+    for (size_t index = 0; index < arayeh_size; index++) {
+        uint16_t cell = (uint16_t) (index % 251);
+        uint16_t sum, largest;
+        if (index % 1000 == 7) {
+            continue;
+        }
+        numbers->get(numbers, index, &sum);
+        maximum->get(maximum, index, &largest);
+        TEST_ASSERT_EQUAL_UINT16(total, sum);
+        TEST_ASSERT_EQUAL_UINT16((index < 250) ? cell : 250, largest);
+        total = (uint16_t) (total + cell);
+    }
+
+    maximum->free_arayeh(&maximum);
+    numbers->free_arayeh(&numbers);
+}
+
+void test_scan_other_types(void)
+{
+    // Test half precision, narrowed and wrong types.
+
+    // define default arayeh size.
+    size_t arayeh_size = 100;
+
+    // half precision cells are scanned as floats.
+    arayeh *halves = Arayeh(AA_ARAYEH_TYPE_FLOAT16, arayeh_size);
+    for (size_t index = 0; index < arayeh_size; index++) {
+        float cell = (float) (index % 4);
+        halves->add(halves, &cell);
+    }
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS,
+                          halves->scan(halves, AA_ARAYEH_SUM, AA_ARAYEH_INCLUSIVE));
+    float last;
+    halves->get(halves, arayeh_size - 1, &last);
+    TEST_ASSERT_TRUE(last == 150.0f);
+
+    // narrowed cells are widened, sums don't fit in the narrow type.
+    arayeh *narrow = Arayeh(AA_ARAYEH_TYPE_INT64, arayeh_size);
+    for (size_t index = 0; index < arayeh_size; index++) {
+        int64_t cell = 100;
+        narrow->add(narrow, &cell);
+    }
+    narrow->narrow(narrow);
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_SUCCESS,
+                          narrow->scan(narrow, AA_ARAYEH_SUM, AA_ARAYEH_INCLUSIVE));
+    int64_t sum;
+    narrow->get(narrow, arayeh_size - 1, &sum);
+    TEST_ASSERT_TRUE(sum == 10000);
+
+    // scan_to doesn't change arayeh.
+    arayeh *copy = narrow->scan_to(narrow, AA_ARAYEH_MAX, AA_ARAYEH_EXCLUSIVE);
+    narrow->get(narrow, 0, &sum);
+    TEST_ASSERT_TRUE(sum == 100);
+    copy->get(copy, 0, &sum);
+    TEST_ASSERT_TRUE(sum == INT64_MIN);
+
+    arayeh *flags = Arayeh(AA_ARAYEH_TYPE_BOOL, 4);
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_WRONG_TYPE,
+                          flags->scan(flags, AA_ARAYEH_SUM, AA_ARAYEH_INCLUSIVE));
+    TEST_ASSERT_NULL(flags->scan_to(flags, AA_ARAYEH_SUM, AA_ARAYEH_INCLUSIVE));
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_FAILURE,
+                          narrow->scan(narrow, 42, AA_ARAYEH_INCLUSIVE));
+    TEST_ASSERT_EQUAL_INT(AA_ARAYEH_FAILURE, narrow->scan(narrow, AA_ARAYEH_SUM, 42));
+
+    flags->free_arayeh(&flags);
+    copy->free_arayeh(&copy);
+    narrow->free_arayeh(&narrow);
+    halves->free_arayeh(&halves);
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_scan_int);
+    RUN_TEST(test_scan_dense_blocks);
+    RUN_TEST(test_scan_parallel);
+    RUN_TEST(test_scan_other_types);
+    return UNITY_END();
+}